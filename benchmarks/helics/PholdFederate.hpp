@@ -35,6 +35,7 @@ class PholdFederate: public BenchmarkFederate {
     double randTimeMean_{
         deltaTime * .9};  // mean for the exponential distribution used when picking event times
     double lookahead_{deltaTime * .1};
+    bool declareLookahead_{false};  // declare the lookahead to helics as the output delay
 
     // classes related to the exponential and uniform distribution random number generator
     bool generateRandomSeed{false};
@@ -55,6 +56,7 @@ class PholdFederate: public BenchmarkFederate {
     void setInitialEventCount(unsigned int count) { initEvCount_ = count; }
     void setLocalProbability(double p) { localProbability_ = p; }
     void setLookahead(double v) { lookahead_ = v; }
+    void setDeclareLookahead(bool declare) { declareLookahead_ = declare; }
 
     std::string getName() override { return "phold_" + std::to_string(index); }
 
@@ -70,6 +72,9 @@ class PholdFederate: public BenchmarkFederate {
         app->add_flag("--gen_rand_seed", generateRandomSeed, "enable generating a random seed");
         app->add_option("--set_rand_seed", seed, "set the random seed");
         app->add_option("--set_phold_lookahead", lookahead_, "set the lookahead used by phold");
+        app->add_flag("--declare_lookahead",
+                      declareLookahead_,
+                      "declare the phold lookahead to helics so federates can advance concurrently");
     }
 
     void doAddBenchmarkResults() override
@@ -77,8 +82,12 @@ class PholdFederate: public BenchmarkFederate {
         addResult("EVENT COUNT", "EvCount", std::to_string(evCount));
     }
 
-    void doParamInit(helics::FederateInfo& /*fi*/) override
+    void doParamInit(helics::FederateInfo& fi) override
     {
+        if (declareLookahead_) {
+            // every event is scheduled at least the lookahead after the current time
+            fi.setProperty(helics_property_time_output_delay, helics::Time(lookahead_));
+        }
         if (app->get_option("--set_rand_seed")->count() == 0) {
             std::mt19937 random_engine(0x600d5eed);  // NOLINT
             std::uniform_int_distribution<unsigned int> rand_seed_uniform;
@@ -31,6 +31,7 @@ class WattsStrogatzFederate: public BenchmarkFederate {
     // (so k=K/2 in this benchmark)
     int k{1};  // degree
     double b{0.6};  // re-wire probability for each of k rightmost neighbors
+    bool declareLookahead{false};  // declare the message delay to helics as the output delay
 
     // Classes related to the exponential and uniform distribution random number generator
     bool generateRandomSeed{true};
@@ -72,12 +73,19 @@ class WattsStrogatzFederate: public BenchmarkFederate {
         app->add_option("--initial_message_count",
                         initialMessageCount,
                         "the initial number of messages this federate should send");
+        app->add_flag("--declare_lookahead",
+                      declareLookahead,
+                      "declare the message delay to helics as a lookahead");
         opt_index->required();
         opt_max_index->required();
     }
 
-    void doParamInit(helics::FederateInfo& /*fi*/) override
+    void doParamInit(helics::FederateInfo& fi) override
     {
+        if (declareLookahead) {
+            // messages are always passed on one time step after they are received
+            fi.setProperty(helics_property_time_output_delay, deltaTime);
+        }
         if (k < 1 || k > maxIndex - 1) {
             std::cerr << "ERROR: Degree can't be less than 1 or more than the federate count - 1"
                       << std::endl;
@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/common/LzCompression.hpp"
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/flagOperations.hpp"
+#include "helics_benchmark_main.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/** the number of payload bytes sent through the link in each iteration*/
+static constexpr int64_t linkBytesPerIteration{1 << 20};
+
+/** a loopback link with a limited bandwidth
+@details each packet is scheduled for delivery once the link has finished transmitting the packets
+ahead of it,  the sender is blocked if more than a window of data is waiting on the link as a socket
+with a full send buffer would*/
+class ThrottledLink {
+  public:
+    /** construct a link
+    @param megabitsPerSecond the bandwidth of the link*/
+    explicit ThrottledLink(int64_t megabitsPerSecond):
+        nanosecondsPerByte(8000.0 / static_cast<double>(megabitsPerSecond))
+    {
+    }
+    /** transmit a packet over the link*/
+    void send(std::string packet)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (linkFree < now) {
+            linkFree = now;
+        }
+        linkFree += std::chrono::nanoseconds(
+            static_cast<int64_t>(nanosecondsPerByte * static_cast<double>(packet.size())));
+        // limit the amount of data in flight
+        std::this_thread::sleep_until(linkFree - window);
+        std::lock_guard<std::mutex> lock(linkLock);
+        packets.emplace_back(linkFree, std::move(packet));
+        packetReady.notify_one();
+    }
+    /** receive a packet once it has made it across the link*/
+    std::string receive()
+    {
+        std::unique_lock<std::mutex> lock(linkLock);
+        packetReady.wait(lock, [this]() { return !packets.empty(); });
+        auto packet = std::move(packets.front());
+        packets.pop_front();
+        lock.unlock();
+        std::this_thread::sleep_until(packet.first);
+        return std::move(packet.second);
+    }
+
+  private:
+    const double nanosecondsPerByte;
+    const std::chrono::milliseconds window{2};
+    std::chrono::steady_clock::time_point linkFree;
+    std::mutex linkLock;
+    std::condition_variable packetReady;
+    std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> packets;
+};
+
+/** generate a text payload similar to json encoded values*/
+static std::string textPayload(std::size_t size)
+{
+    std::string payload;
+    int index{0};
+    while (payload.size() < size) {
+        payload.append("{\"name\":\"bus_");
+        payload.append(std::to_string(index % 97));
+        payload.append("\",\"voltage\":");
+        payload.append(std::to_string(1.0 + static_cast<double>(index % 23) * 0.001));
+        payload.append("},");
+        ++index;
+    }
+    payload.resize(size);
+    return payload;
+}
+
+/** generate a payload of doubles from a slowly varying quantized measurement*/
+static std::string vectorPayload(std::size_t size)
+{
+    std::vector<double> values(size / sizeof(double) + 1);
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> step(-1, 1);
+    double value{120.0};
+    for (auto& val : values) {
+        value += 0.5 * static_cast<double>(step(generator));
+        val = value;
+    }
+    std::string payload(size, '\0');
+    std::memcpy(&payload[0], values.data(), size);
+    return payload;
+}
+
+/** send messages across a throttled link with or without compressing the payloads
+@details the sender serializes and optionally compresses each message,  the receiver deserializes
+and decompresses them,  the measured time includes the transfer across the link*/
+static void BMthrottledLink(benchmark::State& state, bool text, bool compress)
+{
+    const auto payloadSize = static_cast<std::size_t>(state.range(0));
+    const int64_t messageCount =
+        (state.range(0) < linkBytesPerIteration) ? linkBytesPerIteration / state.range(0) : 1;
+    ThrottledLink link(state.range(1));
+    const std::string payload = text ? textPayload(payloadSize) : vectorPayload(payloadSize);
+
+    std::atomic<int64_t> received{0};
+    std::atomic<int64_t> linkBytes{0};
+    std::thread reader([&link, &received]() {
+        std::string decompressed;
+        while (true) {
+            auto packet = link.receive();
+            if (packet == "close") {
+                return;
+            }
+            helics::ActionMessage cmd(packet);
+            if (checkActionFlag(cmd, compressed_payload_flag)) {
+                helics::lzDecompress(cmd.payload.data(), cmd.payload.size(), decompressed);
+                cmd.payload = std::move(decompressed);
+            }
+            ++received;
+        }
+    });
+
+    int64_t target{0};
+    for (auto _ : state) {
+        for (int64_t ii = 0; ii < messageCount; ++ii) {
+            helics::ActionMessage cmd(helics::CMD_PUB);
+            cmd.payload = payload;
+            if (compress) {
+                auto compressed = helics::lzCompress(cmd.payload.data(), cmd.payload.size());
+                if (!compressed.empty()) {
+                    cmd.payload = std::move(compressed);
+                    setActionFlag(cmd, compressed_payload_flag);
+                }
+            }
+            auto packet = cmd.to_string();
+            linkBytes += static_cast<int64_t>(packet.size());
+            link.send(std::move(packet));
+        }
+        target += messageCount;
+        while (received.load() < target) {
+            std::this_thread::yield();
+        }
+    }
+    link.send("close");
+    reader.join();
+    state.SetItemsProcessed(state.iterations() * messageCount);
+    state.SetBytesProcessed(state.iterations() * messageCount * state.range(0));
+    state.counters["link_bytes"] = static_cast<double>(linkBytes.load()) /
+        static_cast<double>(state.iterations() * messageCount);
+}
+
+// the arguments are the payload size and the link bandwidth in megabits per second
+static void linkArguments(benchmark::internal::Benchmark* b)
+{
+    for (int64_t bandwidth : {10, 100, 1000}) {
+        for (int64_t size : {4096, 65536, 1 << 20}) {
+            b->Args({size, bandwidth});
+        }
+    }
+}
+
+// clang-format off
+BENCHMARK_CAPTURE(BMthrottledLink, text_uncompressed, true, false)
+    // clang-format on
+    ->Apply(linkArguments)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMthrottledLink, text_compressed, true, true)
+    // clang-format on
+    ->Apply(linkArguments)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMthrottledLink, vector_uncompressed, false, false)
+    // clang-format on
+    ->Apply(linkArguments)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMthrottledLink, vector_compressed, false, true)
+    // clang-format on
+    ->Apply(linkArguments)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(compressionBenchmark);
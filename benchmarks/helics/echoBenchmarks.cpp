@@ -17,6 +17,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <fstream>
 #include <gmlc/concurrency/Barrier.hpp>
 #include <iostream>
+#include <string>
 #include <thread>
 
 using helics::core_type;
@@ -65,7 +66,9 @@ BENCHMARK(BMecho_singleCore)
     ->Iterations(1)
     ->UseRealTime();
 
-static void BMecho_multiCore(benchmark::State& state, core_type cType)
+static void BMecho_multiCore(benchmark::State& state,
+                             core_type cType,
+                             const std::string& extraArgs = std::string{})
 {
     for (auto _ : state) {
         state.PauseTiming();
@@ -76,17 +79,19 @@ static void BMecho_multiCore(benchmark::State& state, core_type cType)
         auto broker =
             helics::BrokerFactory::create(cType,
                                           "brokerb",
-                                          std::string("--federates=") + std::to_string(feds + 1));
+                                          std::string("--federates=") + std::to_string(feds + 1) +
+                                              extraArgs);
         broker->setLoggingLevel(helics_log_level_no_print);
-        auto wcore =
-            helics::CoreFactory::create(cType, std::string("--federates=1 --log_level=no_print"));
+        auto wcore = helics::CoreFactory::create(
+            cType, std::string("--federates=1 --log_level=no_print") + extraArgs);
         // this is to delay until the threads are ready
         EchoHub hub;
         hub.initialize(wcore->getIdentifier(), "--num_leafs=" + std::to_string(feds));
         std::vector<EchoLeaf> leafs(feds);
         std::vector<std::shared_ptr<helics::Core>> cores(feds);
         for (int ii = 0; ii < feds; ++ii) {
-            cores[ii] = helics::CoreFactory::create(cType, "-f 1 --log_level=no_print");
+            cores[ii] =
+                helics::CoreFactory::create(cType, "-f 1 --log_level=no_print" + extraArgs);
             cores[ii]->connect();
             std::string bmInit = "--index=" + std::to_string(ii);
             leafs[ii].initialize(cores[ii]->getIdentifier(), bmInit);
@@ -123,6 +128,25 @@ BENCHMARK_CAPTURE(BMecho_multiCore, inprocCore, core_type::INPROC)
     ->Unit(benchmark::TimeUnit::kMillisecond)
     ->UseRealTime();
 
+#ifdef ENABLE_TEST_CORE
+// Register the test core benchmarks
+BENCHMARK_CAPTURE(BMecho_multiCore, testCore, core_type::TEST)
+    ->RangeMultiplier(2)
+    ->Range(1, maxscale)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+#endif
+
+// Register the inproc core benchmarks delivering messages without the comms thread
+BENCHMARK_CAPTURE(BMecho_multiCore,
+                  inprocDirectCore,
+                  core_type::INPROC,
+                  std::string(" --direct_dispatch"))
+    ->RangeMultiplier(2)
+    ->Range(1, maxscale)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
 #ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BMecho_multiCore, zmqCore, core_type::ZMQ)
@@ -127,6 +127,15 @@ BENCHMARK_CAPTURE(BMecho_multiCore, inprocCore, core_type::INPROC)
     ->Unit(benchmark::TimeUnit::kMillisecond)
     ->UseRealTime();
 
+#ifdef ENABLE_TEST_CORE
+// Register the test core benchmarks
+BENCHMARK_CAPTURE(BMecho_multiCore, testCore, core_type::TEST)
+    ->RangeMultiplier(2)
+    ->Range(1, maxscale * 2)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+#endif
+
 #ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BMecho_multiCore, zmqCore, core_type::ZMQ)
@@ -147,6 +147,15 @@ BENCHMARK_CAPTURE(BMfilter_multiCore, inprocCore, core_type::INPROC)
     ->Ranges({{1, maxscale * 2}, {1, 2}})
     ->Unit(benchmark::TimeUnit::kMillisecond)
     ->UseRealTime();
+
+#ifdef ENABLE_TEST_CORE
+// Register the test core benchmarks
+BENCHMARK_CAPTURE(BMfilter_multiCore, testCore, core_type::TEST)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, maxscale * 2}, {1, 2}})
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+#endif
 #ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BMfilter_multiCore, zmqCore, core_type::ZMQ)
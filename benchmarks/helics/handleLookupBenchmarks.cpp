@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/application_api/Inputs.hpp"
+#include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueFederate.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics/helics-config.h"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <gmlc/concurrency/Barrier.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using helics::core_type;
+
+static constexpr int lookupCalls{20000};
+
+/** time API calls that resolve handles in the core from many federate threads at once
+@details every federate shares a single core,  the publications have no subscribers so a publish
+is only the handle lookup in the core and the input value is read from the federate's own
+publication*/
+static void BMhandleLookup(benchmark::State& state)
+{
+    const int feds = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto wcore = helics::CoreFactory::create(core_type::INPROC,
+                                                 std::string("--autobroker --federates=") +
+                                                     std::to_string(feds) +
+                                                     " --log_level=no_print");
+        helics::FederateInfo fi(core_type::INPROC);
+        fi.coreName = wcore->getIdentifier();
+        std::vector<std::unique_ptr<helics::ValueFederate>> vfeds(static_cast<size_t>(feds));
+        std::vector<helics::Publication*> unused(static_cast<size_t>(feds));
+        std::vector<helics::Input*> inputs(static_cast<size_t>(feds));
+        for (int ii = 0; ii < feds; ++ii) {
+            vfeds[ii] =
+                std::make_unique<helics::ValueFederate>("fed" + std::to_string(ii), fi);
+            unused[ii] = &vfeds[ii]->registerPublication<double>("unused");
+            auto& pub = vfeds[ii]->registerPublication<double>("value");
+            inputs[ii] = &vfeds[ii]->registerSubscription(pub.getKey());
+        }
+        for (auto& vfed : vfeds) {
+            vfed->enterExecutingModeAsync();
+        }
+        for (auto& vfed : vfeds) {
+            vfed->enterExecutingModeComplete();
+        }
+        gmlc::concurrency::Barrier brr(static_cast<size_t>(feds) + 1);
+        std::vector<std::thread> threadlist(static_cast<size_t>(feds));
+        for (int ii = 0; ii < feds; ++ii) {
+            threadlist[ii] = std::thread([&brr, pub = unused[ii], inp = inputs[ii]]() {
+                brr.wait();
+                double sum{0.0};
+                for (int jj = 0; jj < lookupCalls; ++jj) {
+                    pub->publish(static_cast<double>(jj));
+                    sum += inp->getValue<double>();
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        state.ResumeTiming();
+        brr.wait();
+        for (auto& thrd : threadlist) {
+            thrd.join();
+        }
+        state.PauseTiming();
+        for (auto& vfed : vfeds) {
+            vfed->finalize();
+        }
+        vfeds.clear();
+        wcore.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(feds) * lookupCalls * 2);
+}
+// Register the function as a benchmark
+BENCHMARK(BMhandleLookup)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(handleLookupBenchmark);
@@ -0,0 +1,476 @@
+# -*- coding: utf-8 -*-
+"""
+Runs the standard HELICS benchmark suite and compares the results of two runs.
+
+The ``run`` command executes the Google Benchmark based HELICS benchmarks for
+a set of core types and writes all the samples along with information about
+the build and machine to a single versioned JSON file.  The network cores only
+use the loopback interface so the suite can be run without any network access.
+
+The ``compare`` command loads two result files and uses a Mann-Whitney U test
+on the repetitions of each benchmark to flag statistically significant
+regressions.  It exits with a non-zero code if any are found so it can be used
+as a gate in CI.
+
+Only the python standard library is required.
+
+    python helics_benchmark_suite.py run --bin-dir build/bin -o new.json
+    python helics_benchmark_suite.py compare base.json new.json
+"""
+
+import argparse
+import datetime
+import json
+import math
+import os
+import platform
+import shlex
+import subprocess
+import sys
+import tempfile
+
+SCHEMA_NAME = "helics-benchmark-results"
+SCHEMA_VERSION = 1
+
+# the benchmarks in the standard suite and the executable implementing each
+SUITE = {
+    "echo": "echoBenchmarks",
+    "ring": "ringBenchmarks",
+    "phold": "pholdBenchmarks",
+    "timing": "timingBenchmarks",
+    "conversion": "conversionBenchmarks",
+    "filter": "filterBenchmarks",
+    "messageLookup": "messageLookupBenchmarks",
+}
+
+# benchmarks that do not depend on a core type
+CORELESS_BENCHMARKS = {"conversion"}
+
+# the core types and the name used to register the benchmarks for each
+CORE_TYPES = {
+    "inproc": "inprocCore",
+    "test": "testCore",
+    "ipc": "ipcCore",
+    "tcp": "tcpCore",
+    "tcpss": "tcpssCore",
+    "udp": "udpCore",
+    "zmq": "zmqCore",
+    "zmqss": "zmqssCore",
+}
+
+# build information printed by the benchmark executables
+BUILD_INFO_KEYS = {
+    "HELICS VERSION": "helics_version",
+    "ZMQ VERSION": "zmq_version",
+    "COMPILER INFO": "compiler",
+    "BUILD FLAGS": "build_flags",
+    "HOST PROCESSOR TYPE": "host_processor",
+    "CPU MODEL": "cpu_model",
+}
+
+# google benchmark context fields copied into the environment
+CONTEXT_KEYS = [
+    "host_name",
+    "num_cpus",
+    "mhz_per_cpu",
+    "cpu_scaling_enabled",
+    "caches",
+    "load_avg",
+    "library_build_type",
+]
+
+# environment fields that make two result files hard to compare if they differ
+ENVIRONMENT_CHECK_KEYS = [
+    "helics_version",
+    "compiler",
+    "build_flags",
+    "cpu_model",
+    "num_cpus",
+    "library_build_type",
+]
+
+TIME_UNIT_SCALE = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def executable_path(bin_dir, name):
+    for candidate in (name, name + ".exe"):
+        path = os.path.join(bin_dir, candidate)
+        if os.path.isfile(path):
+            return path
+    return None
+
+
+def benchmark_filter(suite_name, core_types):
+    """generate the google benchmark filter selecting the requested core types"""
+    if suite_name in CORELESS_BENCHMARKS:
+        return None
+    patterns = ["/{}/".format(CORE_TYPES[ct]) for ct in core_types]
+    if "inproc" in core_types:
+        # the single core benchmarks all use an inproc core
+        patterns.append("_singleCore/")
+    return "|".join(patterns)
+
+
+def core_type_of(run_name):
+    for core_type, capture in CORE_TYPES.items():
+        if "/{}/".format(capture) in run_name or run_name.endswith("/" + capture):
+            return core_type
+    if "_singleCore" in run_name:
+        return "inproc"
+    return None
+
+
+def parse_build_info(text):
+    info = {}
+    for line in text.splitlines():
+        key, sep, value = line.partition(":")
+        if sep and key.strip() in BUILD_INFO_KEYS:
+            info[BUILD_INFO_KEYS[key.strip()]] = value.strip()
+    return info
+
+
+def collect_environment(build_info, context):
+    env = {
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "python_version": platform.python_version(),
+    }
+    env.update(build_info)
+    for key in CONTEXT_KEYS:
+        if key in context:
+            env[key] = context[key]
+    if "num_cpus" not in env:
+        env["num_cpus"] = os.cpu_count()
+    return env
+
+
+def collect_samples(suite_name, gbench_results, samples):
+    """group the individual repetitions of each benchmark"""
+    for bm in gbench_results.get("benchmarks", []):
+        if bm.get("run_type", "iteration") != "iteration" or "error_occurred" in bm:
+            continue
+        name = bm.get("run_name", bm["name"])
+        scale = TIME_UNIT_SCALE.get(bm.get("time_unit", "ns"), 1e-9)
+        entry = samples.get(name)
+        if entry is None:
+            entry = {
+                "name": name,
+                "suite": suite_name,
+                "core_type": core_type_of(name),
+                "real_time": [],
+                "cpu_time": [],
+                "iterations": [],
+            }
+            samples[name] = entry
+        entry["real_time"].append(bm["real_time"] * scale)
+        entry["cpu_time"].append(bm["cpu_time"] * scale)
+        entry["iterations"].append(bm.get("iterations", 1))
+
+
+def run_benchmark(exe, bm_filter, repetitions, extra_args):
+    """run a single benchmark executable returning its console output and json results"""
+    fd, out_file = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+    cmd = [
+        exe,
+        "--benchmark_out=" + out_file,
+        "--benchmark_out_format=json",
+        "--benchmark_repetitions={}".format(repetitions),
+    ]
+    if bm_filter:
+        cmd.append("--benchmark_filter=" + bm_filter)
+    cmd.extend(extra_args)
+    try:
+        proc = subprocess.run(
+            cmd,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            universal_newlines=True,
+        )
+        results = {}
+        if os.path.getsize(out_file) > 0:
+            with open(out_file) as f:
+                results = json.load(f)
+        return proc.returncode, proc.stdout, results
+    finally:
+        os.remove(out_file)
+
+
+def run_suite(args):
+    core_types = args.core_types.split(",")
+    for ct in core_types:
+        if ct not in CORE_TYPES:
+            sys.exit("unknown core type {}".format(ct))
+    suites = args.benchmarks.split(",")
+    for name in suites:
+        if name not in SUITE:
+            sys.exit("unknown benchmark {}".format(name))
+
+    samples = {}
+    build_info = {}
+    context = {}
+    skipped = []
+    failed = []
+    for name in suites:
+        exe = executable_path(args.bin_dir, SUITE[name])
+        if exe is None:
+            print("skipping {}: {} not found".format(name, SUITE[name]))
+            skipped.append(name)
+            continue
+        print("running {}".format(name), flush=True)
+        code, output, results = run_benchmark(
+            exe,
+            benchmark_filter(name, core_types),
+            args.repetitions,
+            shlex.split(args.extra_args),
+        )
+        if code != 0:
+            print(output)
+            failed.append(name)
+        if not build_info:
+            build_info = parse_build_info(output)
+        if not context:
+            context = results.get("context", {})
+        collect_samples(name, results, samples)
+
+    report = {
+        "schema": SCHEMA_NAME,
+        "schema_version": SCHEMA_VERSION,
+        "created": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "label": args.label,
+        "environment": collect_environment(build_info, context),
+        "config": {
+            "benchmarks": suites,
+            "core_types": core_types,
+            "repetitions": args.repetitions,
+            "skipped": skipped,
+            "failed": failed,
+        },
+        "benchmarks": sorted(samples.values(), key=lambda b: b["name"]),
+    }
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2)
+    print("wrote {} benchmarks to {}".format(len(samples), args.output))
+    return 1 if failed else 0
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    if data.get("schema") != SCHEMA_NAME:
+        sys.exit("{} is not a helics benchmark result file".format(path))
+    if data.get("schema_version", 0) > SCHEMA_VERSION:
+        sys.exit(
+            "{} uses schema version {}, this tool supports up to {}".format(
+                path, data.get("schema_version"), SCHEMA_VERSION
+            )
+        )
+    return data
+
+
+def median(values):
+    ordered = sorted(values)
+    mid = len(ordered) // 2
+    if len(ordered) % 2 == 1:
+        return ordered[mid]
+    return (ordered[mid - 1] + ordered[mid]) / 2.0
+
+
+def exact_u_distribution(n1, n2):
+    """count the number of orderings giving each value of the U statistic"""
+    # counts[i][j] is the distribution for i samples in the first set and j in the second
+    counts = [[None] * (n2 + 1) for _ in range(n1 + 1)]
+    for i in range(n1 + 1):
+        for j in range(n2 + 1):
+            if i == 0 or j == 0:
+                counts[i][j] = [1]
+                continue
+            dist = [0] * (i * j + 1)
+            # the largest value comes from the first set and is above all j values in the second
+            for u, c in enumerate(counts[i - 1][j]):
+                dist[u + j] += c
+            for u, c in enumerate(counts[i][j - 1]):
+                dist[u] += c
+            counts[i][j] = dist
+    return counts[n1][n2]
+
+
+def mann_whitney_p(a, b):
+    """two sided p value of the Mann-Whitney U test for samples a and b"""
+    n1 = len(a)
+    n2 = len(b)
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    has_ties = False
+    ii = 0
+    while ii < len(combined):
+        jj = ii
+        while jj + 1 < len(combined) and combined[jj + 1][0] == combined[ii][0]:
+            jj += 1
+        avg_rank = (ii + jj) / 2.0 + 1.0
+        for kk in range(ii, jj + 1):
+            ranks[kk] = avg_rank
+        tied = jj - ii + 1
+        if tied > 1:
+            has_ties = True
+            tie_term += tied**3 - tied
+        ii = jj + 1
+    rank_sum = sum(r for r, (_, src) in zip(ranks, combined) if src == 0)
+    u1 = rank_sum - n1 * (n1 + 1) / 2.0
+    u = min(u1, n1 * n2 - u1)
+    if not has_ties and n1 + n2 <= 30:
+        dist = exact_u_distribution(n1, n2)
+        total = float(sum(dist))
+        tail = sum(dist[: int(u) + 1]) / total
+        return min(1.0, 2.0 * tail)
+    n = n1 + n2
+    mean_u = n1 * n2 / 2.0
+    var_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return 1.0
+    z = (abs(u - mean_u) - 0.5) / math.sqrt(var_u)
+    return min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2.0)))
+
+
+def compare_results(args):
+    base = load_results(args.baseline)
+    contender = load_results(args.contender)
+
+    for key in ENVIRONMENT_CHECK_KEYS:
+        base_value = base["environment"].get(key)
+        new_value = contender["environment"].get(key)
+        if base_value != new_value:
+            print(
+                "warning: {} differs between the runs ({} vs {})".format(
+                    key, base_value, new_value
+                )
+            )
+
+    base_benchmarks = {b["name"]: b for b in base["benchmarks"]}
+    regressions = []
+    rows = []
+    for bm in contender["benchmarks"]:
+        old = base_benchmarks.get(bm["name"])
+        if old is None:
+            continue
+        old_samples = old[args.metric]
+        new_samples = bm[args.metric]
+        old_median = median(old_samples)
+        new_median = median(new_samples)
+        change = (new_median - old_median) / old_median if old_median > 0 else 0.0
+        if min(len(old_samples), len(new_samples)) < args.min_samples:
+            p_value = None
+            status = "too few samples"
+        else:
+            p_value = mann_whitney_p(old_samples, new_samples)
+            if p_value < args.alpha and change > args.threshold:
+                status = "REGRESSION"
+                regressions.append(bm["name"])
+            elif p_value < args.alpha and change < -args.threshold:
+                status = "improvement"
+            else:
+                status = ""
+        rows.append((bm["name"], old_median, new_median, change, p_value, status))
+
+    name_width = max([len(r[0]) for r in rows] + [9])
+    print(
+        "{:<{w}} {:>12} {:>12} {:>9} {:>8}  {}".format(
+            "benchmark", "base(s)", "new(s)", "change", "p", "", w=name_width
+        )
+    )
+    for name, old_median, new_median, change, p_value, status in rows:
+        print(
+            "{:<{w}} {:>12.6g} {:>12.6g} {:>+8.1%} {:>8} {}".format(
+                name,
+                old_median,
+                new_median,
+                change,
+                "-" if p_value is None else "{:.4f}".format(p_value),
+                status,
+                w=name_width,
+            )
+        )
+    print(
+        "{} benchmarks compared, {} significant regressions".format(
+            len(rows), len(regressions)
+        )
+    )
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    commands = parser.add_subparsers(dest="command")
+    commands.required = True
+
+    run_parser = commands.add_parser("run", help="run the benchmark suite")
+    run_parser.add_argument(
+        "--bin-dir",
+        default=os.path.dirname(os.path.abspath(__file__)),
+        help="the directory containing the benchmark executables",
+    )
+    run_parser.add_argument(
+        "-o", "--output", default="helics_benchmarks.json", help="the result file"
+    )
+    run_parser.add_argument(
+        "--core-types",
+        default=",".join(CORE_TYPES),
+        help="comma separated list of the core types to run",
+    )
+    run_parser.add_argument(
+        "--benchmarks",
+        default=",".join(SUITE),
+        help="comma separated list of the benchmarks to run",
+    )
+    run_parser.add_argument(
+        "--repetitions",
+        type=int,
+        default=5,
+        help="the number of samples to collect for each benchmark",
+    )
+    run_parser.add_argument(
+        "--label", default="", help="a label stored with the results"
+    )
+    run_parser.add_argument(
+        "--extra-args",
+        default="",
+        help="additional arguments passed to each benchmark executable",
+    )
+    run_parser.set_defaults(func=run_suite)
+
+    compare_parser = commands.add_parser("compare", help="compare two result files")
+    compare_parser.add_argument("baseline", help="the reference result file")
+    compare_parser.add_argument("contender", help="the result file to check")
+    compare_parser.add_argument(
+        "--metric",
+        choices=["real_time", "cpu_time"],
+        default="real_time",
+        help="the measurement to compare",
+    )
+    compare_parser.add_argument(
+        "--alpha",
+        type=float,
+        default=0.05,
+        help="the significance level for the statistical test",
+    )
+    compare_parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="the minimum relative change in the median to report",
+    )
+    compare_parser.add_argument(
+        "--min-samples",
+        type=int,
+        default=3,
+        help="the minimum number of samples in each run needed to test a benchmark",
+    )
+    compare_parser.set_defaults(func=compare_results)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
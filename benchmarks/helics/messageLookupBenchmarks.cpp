@@ -210,77 +210,64 @@ BENCHMARK_CAPTURE(BMmgen_multiCore, inprocCore_big8, core_type::INPROC)
     ->Ranges({{1 << 17, 1 << 19}, {8, 8}})
     ->Iterations(1)
     ->UseRealTime();
-/*
-// Register the ZMQ benchmarks
-BENCHMARK_CAPTURE (BM_ring_multiCore, zmqCore, core_type::ZMQ)
-  ->Unit (benchmark::TimeUnit::kMillisecond)
-  ->Iterations (3)
-  ->Arg (2)
-  ->Arg (3)
-  ->Arg (4)
-  ->Arg (6)
-  ->Arg (10)
-  ->Arg (20)
-  ->UseRealTime ();
 
+#ifdef ENABLE_TEST_CORE
+// Register the test core benchmarks
+BENCHMARK_CAPTURE(BMmgen_multiCore, testCore, core_type::TEST)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 15}, {2, 64}})
+    ->Iterations(1)
+    ->UseRealTime();
+#endif
+
+#ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
-BENCHMARK_CAPTURE (BM_ring_multiCore, zmqssCore, core_type::ZMQ_SS)
-  ->Unit (benchmark::TimeUnit::kMillisecond)
-  ->Iterations (3)
-  ->Arg (2)
-  ->Arg (3)
-  ->Arg (4)
-  ->Arg (6)
-  ->Arg (10)
-  ->Arg (20)
-  ->UseRealTime ();
+BENCHMARK_CAPTURE(BMmgen_multiCore, zmqCore, core_type::ZMQ)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 12}, {2, 8}})
+    ->Iterations(1)
+    ->UseRealTime();
 
+// Register the ZMQ SS benchmarks
+BENCHMARK_CAPTURE(BMmgen_multiCore, zmqssCore, core_type::ZMQ_SS)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 12}, {2, 8}})
+    ->Iterations(1)
+    ->UseRealTime();
+#endif
+
+#ifdef ENABLE_IPC_CORE
 // Register the IPC benchmarks
-BENCHMARK_CAPTURE (BM_ring_multiCore, ipcCore, core_type::IPC)
-  ->Unit (benchmark::TimeUnit::kMillisecond)
-  ->Iterations (3)
-  ->Arg (2)
-  ->Arg (3)
-  ->Arg (4)
-  ->Arg (10)
-  ->Arg (20)
-  ->UseRealTime ();
+BENCHMARK_CAPTURE(BMmgen_multiCore, ipcCore, core_type::IPC)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 10}, {2, 4}})
+    ->Iterations(1)
+    ->UseRealTime();
+#endif
 
+#ifdef ENABLE_TCP_CORE
 // Register the TCP benchmarks
-BENCHMARK_CAPTURE (BM_ring_multiCore, tcpCore, core_type::TCP)
-  ->Unit (benchmark::TimeUnit::kMillisecond)
-  ->Iterations (3)
-  ->Arg (2)
-  ->Arg (3)
-  ->Arg (4)
-  ->Arg (6)
-  ->Arg (10)
-  ->Arg (20)
-  ->UseRealTime ();
+BENCHMARK_CAPTURE(BMmgen_multiCore, tcpCore, core_type::TCP)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 12}, {2, 8}})
+    ->Iterations(1)
+    ->UseRealTime();
 
 // Register the TCP SS benchmarks
-BENCHMARK_CAPTURE (BM_ring_multiCore, tcpssCore, core_type::TCP_SS)
-  ->Unit (benchmark::TimeUnit::kMillisecond)
-  ->Iterations (3)
-  ->Arg (2)
-  ->Arg (3)
-  ->Arg (4)
-  ->Arg (6)
-  ->Arg (10)
-  ->Arg (20)
-  ->UseRealTime ();
+BENCHMARK_CAPTURE(BMmgen_multiCore, tcpssCore, core_type::TCP_SS)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 12}, {2, 8}})
+    ->Iterations(1)
+    ->UseRealTime();
+#endif
 
+#ifdef ENABLE_UDP_CORE
 // Register the UDP benchmarks
-BENCHMARK_CAPTURE (BM_ring_multiCore, udpCore, core_type::UDP)
-  ->Unit (benchmark::TimeUnit::kMillisecond)
-  ->Iterations (3)
-  ->Arg (2)
-  ->Arg (3)
-  ->Arg (4)
-  ->Arg (6)
-  ->Arg (10)
-  ->Arg (20)
-  ->UseRealTime ();
-  */
+BENCHMARK_CAPTURE(BMmgen_multiCore, udpCore, core_type::UDP)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Ranges({{32, 1 << 12}, {2, 8}})
+    ->Iterations(1)
+    ->UseRealTime();
+#endif
 
 HELICS_BENCHMARK_MAIN(messageLookupBenchmark);
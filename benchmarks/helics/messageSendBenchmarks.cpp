@@ -207,9 +207,7 @@ BENCHMARK_CAPTURE(BMsendMessage, multiCore/tcpssCore, core_type::TCP_SS)
 BENCHMARK_CAPTURE(BMsendMessage, multiCore/udpCore, core_type::UDP)
     // clang-format on
     //->RangeMultiplier (2)
-    ->Ranges({{1, 1 << 15},
-              {1, 1}})  // msg size of 65536 bytes causes error/terminate, though somewhere about 8K
-    // the benchmark time drops from several ms to <1ms
+    ->Ranges({{1, 1 << 17}, {1, 1}})  // messages above 65000 bytes are sent as fragments
     ->Ranges({{1, 1}, {1, 1 << 6}})  // msg count has a bigger effect on time taken (increasing size
                                      // had minimal effect on times);
     // larger sizes/counts did seem to result in hanging, maybe an important packet was lost
@@ -72,7 +72,8 @@ BENCHMARK(BMphold_singleCore)
     ->Iterations(1)
     ->UseRealTime();
 
-static void BMphold_multiCore(benchmark::State& state, core_type cType)
+static void
+    BMphold_multiCore(benchmark::State& state, core_type cType, bool declareLookahead = false)
 {
     for (auto _ : state) {
         state.PauseTiming();
@@ -98,6 +99,9 @@ static void BMphold_multiCore(benchmark::State& state, core_type cType)
             feds[ii].setGenerateRandomSeed(false);
             std::string bmInit =
                 "--index=" + std::to_string(ii) + " --max_index=" + std::to_string(fed_count);
+            if (declareLookahead) {
+                bmInit.append(" --declare_lookahead");
+            }
             feds[ii].initialize(cores[ii]->getIdentifier(), bmInit);
         }
 
@@ -139,6 +143,22 @@ BENCHMARK_CAPTURE(BMphold_multiCore, inprocCore, core_type::INPROC)
     ->Unit(benchmark::TimeUnit::kMillisecond)
     ->UseRealTime();
 
+#ifdef ENABLE_TEST_CORE
+// Register the test core benchmarks
+BENCHMARK_CAPTURE(BMphold_multiCore, testCore, core_type::TEST)
+    ->RangeMultiplier(2)
+    ->Range(1, maxscale * 2)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+#endif
+
+// the same federation with the phold lookahead declared to helics
+BENCHMARK_CAPTURE(BMphold_multiCore, inprocCoreLookahead, core_type::INPROC, true)
+    ->RangeMultiplier(2)
+    ->Range(1, maxscale * 2)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
 #ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BMphold_multiCore, zmqCore, core_type::ZMQ)
@@ -148,6 +168,13 @@ BENCHMARK_CAPTURE(BMphold_multiCore, zmqCore, core_type::ZMQ)
     ->Unit(benchmark::TimeUnit::kMillisecond)
     ->UseRealTime();
 
+BENCHMARK_CAPTURE(BMphold_multiCore, zmqCoreLookahead, core_type::ZMQ, true)
+    ->RangeMultiplier(2)
+    ->Range(1, maxscale)
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BMphold_multiCore, zmqssCore, core_type::ZMQ_SS)
     ->RangeMultiplier(2)
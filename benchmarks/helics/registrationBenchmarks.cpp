@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/application_api/Inputs.hpp"
+#include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueFederate.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics/helics-config.h"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <future>
+#include <memory>
+#include <string>
+
+using helics::core_type;
+
+/** time the registration of a large number of interfaces and the connection setup between two
+federates, each publishing half the interfaces and subscribing to the other half*/
+static void BMregistration_twoFed(benchmark::State& state, core_type cType)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        const int interfaceCount = static_cast<int>(state.range(0));
+        auto broker = helics::BrokerFactory::create(cType, "--federates=2 --log_level=no_print");
+        auto core1 = helics::CoreFactory::create(
+            cType, "--federates=1 --log_level=no_print --broker=" + broker->getIdentifier());
+        auto core2 = helics::CoreFactory::create(
+            cType, "--federates=1 --log_level=no_print --broker=" + broker->getIdentifier());
+        core1->connect();
+        core2->connect();
+        helics::FederateInfo fi1;
+        fi1.coreName = core1->getIdentifier();
+        helics::FederateInfo fi2;
+        fi2.coreName = core2->getIdentifier();
+        state.ResumeTiming();
+
+        auto fed1 = std::make_unique<helics::ValueFederate>("regfed1", fi1);
+        auto fed2 = std::make_unique<helics::ValueFederate>("regfed2", fi2);
+        auto registerInterfaces = [interfaceCount](helics::ValueFederate& fed,
+                                                   const std::string& pubPrefix,
+                                                   const std::string& subPrefix) {
+            for (int ii = 0; ii < interfaceCount / 2; ++ii) {
+                fed.registerGlobalPublication<double>(pubPrefix + std::to_string(ii));
+                fed.registerSubscription(subPrefix + std::to_string(ii));
+            }
+        };
+        auto reg2 = std::async(std::launch::async, [&]() {
+            registerInterfaces(*fed2, "pubB_", "pubA_");
+            fed2->enterExecutingMode();
+        });
+        registerInterfaces(*fed1, "pubA_", "pubB_");
+        fed1->enterExecutingMode();
+        reg2.get();
+
+        state.PauseTiming();
+        fed1->finalize();
+        fed2->finalize();
+        fed1.reset();
+        fed2.reset();
+        core1.reset();
+        core2.reset();
+        broker.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+    state.counters["interfaces"] = static_cast<double>(state.range(0));
+}
+
+// Register the inproc core benchmarks
+BENCHMARK_CAPTURE(BMregistration_twoFed, inprocCore, core_type::INPROC)
+    ->RangeMultiplier(4)
+    ->Range(64, 1 << 17)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+#ifdef ENABLE_ZMQ_CORE
+// Register the ZMQ benchmarks
+BENCHMARK_CAPTURE(BMregistration_twoFed, zmqCore, core_type::ZMQ)
+    ->RangeMultiplier(4)
+    ->Range(64, 1 << 15)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+#endif
+
+/** generate a json configuration with half the interfaces as publications and the other half as
+subscriptions to those publications*/
+static std::string generateConfig(int interfaceCount)
+{
+    std::string config = "{\"defaultglobal\":true,\"publications\":[";
+    config.reserve(static_cast<std::size_t>(interfaceCount) * 48);
+    for (int ii = 0; ii < interfaceCount / 2; ++ii) {
+        config += "{\"key\":\"pub_" + std::to_string(ii) + "\",\"type\":\"double\"},";
+    }
+    config.back() = ']';
+    config += ",\"subscriptions\":[";
+    for (int ii = 0; ii < interfaceCount / 2; ++ii) {
+        config += "{\"key\":\"pub_" + std::to_string(ii) + "\"},";
+    }
+    config.back() = ']';
+    config.push_back('}');
+    return config;
+}
+
+/** time the startup of a single federate with a large number of interfaces loaded from a
+configuration string or registered one at a time through the API*/
+static void BMconfigStartup(benchmark::State& state, bool fromConfig)
+{
+    const int interfaceCount = static_cast<int>(state.range(0));
+    const auto config = generateConfig(interfaceCount);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto core = helics::CoreFactory::create(core_type::INPROC,
+                                                "--autobroker --federates=1 --log_level=no_print");
+        helics::FederateInfo fi(core_type::INPROC);
+        fi.coreName = core->getIdentifier();
+        state.ResumeTiming();
+
+        auto fed = std::make_unique<helics::ValueFederate>("cfgfed", fi);
+        if (fromConfig) {
+            fed->registerInterfaces(config);
+        } else {
+            for (int ii = 0; ii < interfaceCount / 2; ++ii) {
+                fed->registerGlobalPublication<double>("pub_" + std::to_string(ii));
+            }
+            for (int ii = 0; ii < interfaceCount / 2; ++ii) {
+                fed->registerSubscription("pub_" + std::to_string(ii));
+            }
+        }
+        fed->enterExecutingMode();
+
+        state.PauseTiming();
+        fed->finalize();
+        fed.reset();
+        core.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+    state.counters["interfaces"] = static_cast<double>(interfaceCount);
+    state.SetItemsProcessed(state.iterations() * interfaceCount);
+}
+
+// clang-format off
+BENCHMARK_CAPTURE(BMconfigStartup, config, true)
+    // clang-format on
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMconfigStartup, individual, false)
+    // clang-format on
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(registrationBenchmark);
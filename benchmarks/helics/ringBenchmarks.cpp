@@ -124,6 +124,19 @@ BENCHMARK_CAPTURE(BMring_multiCore, inprocCore, core_type::INPROC)
     ->Arg(20)
     ->UseRealTime();
 
+#ifdef ENABLE_TEST_CORE
+// Register the test core benchmarks
+BENCHMARK_CAPTURE(BMring_multiCore, testCore, core_type::TEST)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Arg(2)
+    ->Arg(3)
+    ->Arg(4)
+    ->Arg(6)
+    ->Arg(10)
+    ->Arg(20)
+    ->UseRealTime();
+#endif
+
 #ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BMring_multiCore, zmqCore, core_type::ZMQ)
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/apps/Source.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics/helics-config.h"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+using helics::core_type;
+
+/** the ways the source app can drive a set of publications*/
+enum class sourceMode {
+    scalar,  //!< a scalar generator call and publication per channel
+    bulk,  //!< a bulk generator with a double publication per channel
+    bulkVector  //!< a bulk generator with a single vector publication
+};
+
+static constexpr int sourceSteps{20};
+
+/** time a source federate generating values for a large number of channels*/
+static void BMsource(benchmark::State& state, sourceMode mode)
+{
+    const int channels = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto broker = helics::BrokerFactory::create(core_type::INPROC,
+                                                    "--federates=1 --log_level=no_print");
+        helics::FederateInfo fi(core_type::INPROC);
+        fi.coreInitString = "--log_level=no_print --broker=" + broker->getIdentifier();
+        auto src = std::make_unique<helics::apps::Source>("source", fi);
+        if (mode == sourceMode::scalar) {
+            auto gen = src->getGenerator(src->addSignalGenerator("sine", "sine"));
+            gen->set("freq", 0.05);
+            gen->set("amplitude", 1.0);
+            for (int ii = 0; ii < channels; ++ii) {
+                src->addPublication(
+                    "pub_" + std::to_string(ii), "sine", helics::data_type::helics_double, 1.0);
+            }
+        } else {
+            auto gen =
+                src->getBulkGenerator(src->addBulkSignalGenerator("sine", "sine", channels));
+            gen->set("freq", 0.05);
+            gen->set("amplitude", 1.0);
+            src->addBulkPublication("pub", "sine", channels, 1.0, mode == sourceMode::bulkVector);
+        }
+        src->initialize();
+        state.ResumeTiming();
+
+        src->runTo(sourceSteps);
+
+        state.PauseTiming();
+        src->finalize();
+        src.reset();
+        broker.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(channels) *
+                            (sourceSteps + 1));
+    state.counters["channels"] = static_cast<double>(channels);
+}
+
+// Register the source benchmarks
+BENCHMARK_CAPTURE(BMsource, scalar, sourceMode::scalar)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BMsource, bulk, sourceMode::bulk)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BMsource, bulkVector, sourceMode::bulkVector)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(sourceBenchmark);
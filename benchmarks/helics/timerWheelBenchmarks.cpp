@@ -0,0 +1,56 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/TimerWheel.hpp"
+#include "helics_benchmark_main.h"
+
+#include <vector>
+
+using helics::TimerWheel;
+
+/** rearm a large set of timers in a round robin,  the way connection timeouts are pushed back on
+each ping*/
+static void BMtimerWheel_update(benchmark::State& state)
+{
+    TimerWheel wheel;
+    const auto timerCount = static_cast<int>(state.range(0));
+    std::vector<int32_t> timers;
+    timers.reserve(timerCount);
+    auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < timerCount; ++ii) {
+        timers.push_back(wheel.addTimer(start + std::chrono::seconds(30), []() {}));
+    }
+    int index{0};
+    for (auto _ : state) {
+        wheel.updateTimer(timers[index],
+                          std::chrono::steady_clock::now() + std::chrono::seconds(30) +
+                              std::chrono::milliseconds(index % 1000));
+        if (++index == timerCount) {
+            index = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    for (auto timer : timers) {
+        wheel.releaseTimer(timer);
+    }
+}
+BENCHMARK(BMtimerWheel_update)->Arg(1000)->Arg(100000);
+
+/** add and cancel timers*/
+static void BMtimerWheel_addCancel(benchmark::State& state)
+{
+    TimerWheel wheel;
+    for (auto _ : state) {
+        auto timer = wheel.addTimer(std::chrono::steady_clock::now() + std::chrono::seconds(5),
+                                    []() {});
+        wheel.releaseTimer(timer);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BMtimerWheel_addCancel);
+
+HELICS_BENCHMARK_MAIN(timerWheelBenchmark);
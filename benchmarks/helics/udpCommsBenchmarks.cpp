@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/ActionMessage.hpp"
+#include "helics/network/udp/UdpDatagrams.h"
+#include "helics_benchmark_main.h"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/udp.hpp>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using asio::ip::udp;
+
+static constexpr int loopbackMessageCount{1000};
+
+/** transmit messages over the loopback interface one datagram per send or in batches
+@details a separate thread drains the receiving socket so the measurement is the transmit rate,
+the fraction of the datagrams that arrived is reported as a counter*/
+static void BMudpLoopback(benchmark::State& state, bool batched)
+{
+    asio::io_context context;
+    udp::socket rxSocket(context, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+    udp::socket txSocket(context, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+    const auto destination = rxSocket.local_endpoint();
+
+    std::atomic<int64_t> received{0};
+    std::atomic<bool> stopped{false};
+    std::thread reader([&rxSocket, &received, &stopped]() {
+        helics::udp::DatagramReceiver receiver;
+        std::error_code error;
+        while (true) {
+            auto count = receiver.receive(rxSocket, error);
+            if (error) {
+                break;
+            }
+            for (std::size_t ii = 0; ii < count; ++ii) {
+                if (receiver.size(ii) == 5 && std::memcmp(receiver.data(ii), "close", 5) == 0) {
+                    stopped = true;
+                    return;
+                }
+            }
+            received += static_cast<int64_t>(count);
+        }
+        stopped = true;
+    });
+
+    helics::ActionMessage cmd(helics::CMD_SEND_MESSAGE);
+    cmd.payload = std::string(static_cast<std::size_t>(state.range(0)), 'a');
+    helics::udp::DatagramBatch batch;
+    std::error_code error;
+    for (auto _ : state) {
+        for (int ii = 0; ii < loopbackMessageCount; ++ii) {
+            if (batched) {
+                batch.add(cmd, destination);
+                if (batch.full()) {
+                    batch.send(txSocket, nullptr);
+                }
+            } else {
+                txSocket.send_to(asio::buffer(cmd.to_string()), destination, 0, error);
+            }
+        }
+        if (!batch.empty()) {
+            batch.send(txSocket, nullptr);
+        }
+    }
+    // the close datagram can be dropped if the receive buffer is full so repeat it
+    const std::string close("close");
+    while (!stopped) {
+        txSocket.send_to(asio::buffer(close), destination, 0, error);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    reader.join();
+    const auto sent = state.iterations() * loopbackMessageCount;
+    state.SetItemsProcessed(sent);
+    state.counters["delivered"] =
+        static_cast<double>(received.load()) / static_cast<double>((sent > 0) ? sent : 1);
+}
+
+// clang-format off
+BENCHMARK_CAPTURE(BMudpLoopback, single, false)
+    // clang-format on
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 12)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMudpLoopback, batched, true)
+    // clang-format on
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 12)
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(udpCommsBenchmark);
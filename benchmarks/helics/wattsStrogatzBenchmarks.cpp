@@ -82,7 +82,9 @@ BENCHMARK(BM_wattsStrogatz2_singleCore)
     ->UseRealTime()
     ->Iterations(3);
 
-static void BM_wattsStrogatz_multiCore(benchmark::State& state, core_type cType)
+static void BM_wattsStrogatz_multiCore(benchmark::State& state,
+                                       core_type cType,
+                                       bool declareLookahead = false)
 {
     for (auto _ : state) {
         state.PauseTiming();
@@ -110,6 +112,9 @@ static void BM_wattsStrogatz_multiCore(benchmark::State& state, core_type cType)
             std::string bmInit = "--index=" + std::to_string(ii) +
                 " --max_index=" + std::to_string(feds) + " --degree=" + std::to_string(degree) +
                 " --rewire_probability=" + std::to_string(rewireP);
+            if (declareLookahead) {
+                bmInit.append(" --declare_lookahead");
+            }
             links[ii].initialize(cores[ii]->getIdentifier(), bmInit);
         }
         std::vector<std::thread> threadlist(feds - 1);
@@ -142,6 +147,12 @@ BENCHMARK_CAPTURE(BM_wattsStrogatz_multiCore, inprocCore, core_type::INPROC)
     ->Apply(WattsStrogatzArguments)
     ->UseRealTime();
 
+// the same federation with the message delay declared to helics as a lookahead
+BENCHMARK_CAPTURE(BM_wattsStrogatz_multiCore, inprocCoreLookahead, core_type::INPROC, true)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Apply(WattsStrogatzArguments)
+    ->UseRealTime();
+
 #ifdef ENABLE_ZMQ_CORE
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE(BM_wattsStrogatz_multiCore, zmqCore, core_type::ZMQ)
@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "cppzmq/zmq.hpp"
+#include "helics/core/ActionMessage.hpp"
+#include "helics/network/zmq/ZmqContextManager.h"
+#include "helics/network/zmq/ZmqMessageFrames.h"
+#include "helics_benchmark_main.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr int pushMessageCount{1000};
+
+/** transmit messages from a push socket to a pull socket over the loopback interface
+@details the copy mode serializes each message into a buffer which zmq copies into its own message
+as the zmq comms did previously,  the framed mode uses MessageFrames which batches the small
+messages and hands large payloads to zmq without copying.  A separate thread receives and
+deserializes the messages*/
+static void BMzmqPushPull(benchmark::State& state, bool framed)
+{
+    auto ctx = ZmqContextManager::getContextPointer();
+    zmq::socket_t pullSocket(ctx->getContext(), ZMQ_PULL);
+    pullSocket.setsockopt(ZMQ_LINGER, 0);
+    pullSocket.bind("tcp://127.0.0.1:*");
+    char endpoint[256];
+    std::size_t endpointSize = sizeof(endpoint);
+    pullSocket.getsockopt(ZMQ_LAST_ENDPOINT, endpoint, &endpointSize);
+    zmq::socket_t pushSocket(ctx->getContext(), ZMQ_PUSH);
+    pushSocket.setsockopt(ZMQ_LINGER, 0);
+    pushSocket.connect(endpoint);
+
+    std::atomic<int64_t> received{0};
+    std::thread reader([&pullSocket, &received]() {
+        std::vector<helics::ActionMessage> messages;
+        zmq::message_t msg;
+        while (true) {
+            pullSocket.recv(msg);
+            if (msg.size() == 5 && std::memcmp(msg.data(), "close", 5) == 0) {
+                return;
+            }
+            messages.clear();
+            helics::zeromq::extractMessages(pullSocket, msg, messages);
+            received += static_cast<int64_t>(messages.size());
+        }
+    });
+
+    const std::string payload(static_cast<std::size_t>(state.range(0)), 'a');
+    helics::zeromq::MessageFrames frames;
+    std::vector<char> buffer;
+    int64_t target{0};
+    for (auto _ : state) {
+        for (int ii = 0; ii < pushMessageCount; ++ii) {
+            helics::ActionMessage cmd(helics::CMD_SEND_MESSAGE);
+            cmd.payload = payload;
+            if (framed) {
+                frames.add(cmd);
+                if (frames.full()) {
+                    frames.send(pushSocket);
+                }
+            } else {
+                cmd.to_vector(buffer);
+                pushSocket.send(zmq::const_buffer(buffer.data(), buffer.size()),
+                                zmq::send_flags::none);
+            }
+        }
+        if (!frames.empty()) {
+            frames.send(pushSocket);
+        }
+        // wait for the receiver so the deserialization is part of the measurement
+        target += pushMessageCount;
+        while (received.load() < target) {
+            std::this_thread::yield();
+        }
+    }
+    pushSocket.send(zmq::const_buffer("close", 5), zmq::send_flags::none);
+    reader.join();
+    state.SetItemsProcessed(state.iterations() * pushMessageCount);
+    state.SetBytesProcessed(state.iterations() * pushMessageCount * state.range(0));
+}
+
+// clang-format off
+BENCHMARK_CAPTURE(BMzmqPushPull, copy, false)
+    // clang-format on
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 20)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMzmqPushPull, framed, true)
+    // clang-format on
+    ->RangeMultiplier(8)
+    ->Range(8, 1 << 20)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(zmqCommsBenchmark);
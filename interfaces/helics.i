@@ -28,6 +28,11 @@
 %ignore helicsMessageGetRawDataPointer;
 %ignore helicsMessageResize;
 
+// filling a caller supplied buffer needs language specific typemaps
+#ifndef HELICS_VECTOR_BUFFER_MAPS
+%ignore helicsInputGetVectorBuffer;
+#endif
+
 %include "../helics_enums.h"
 %include "api-data.h"
 %include "helics.h"
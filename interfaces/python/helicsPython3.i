@@ -10,3 +10,26 @@
 import atexit
 atexit.register(helicsCloseLibrary)
 %}
+
+/* vector values as float64 buffers */
+%pythoncode %{
+def helicsInputGetVectorView(ipt):
+    """Get a vector from an input as a memoryview of float64 values.
+
+    The values are copied once from the input into a new buffer,  use helicsInputGetVectorBuffer to reuse an existing buffer.
+    """
+    size = helicsInputGetVectorSize(ipt)
+    view = memoryview(bytearray(8 * size)).cast("d")
+    count = helicsInputGetVectorBuffer(ipt, view)
+    return view[: min(count, size)]
+
+
+def helicsInputGetVectorArray(ipt):
+    """Get a vector from an input as a numpy float64 array.
+
+    The array holds a copy of the input values,  it is built over the buffer from helicsInputGetVectorView without a second copy.
+    """
+    import numpy
+
+    return numpy.frombuffer(helicsInputGetVectorView(ipt), dtype=numpy.float64)
+%}
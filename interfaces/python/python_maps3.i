@@ -143,28 +143,57 @@ PyModule_AddObject(m, "HelicsException", pHelicsException);
   free((char *) $2);
 }
 
-// typemap for vector input functions
-%typemap(in) (const double *vectorInput, int vectorLength) {
-  int i;
-  if (!PyList_Check($input)) {
-    PyErr_SetString(PyExc_ValueError,"Expected a list");
-    return NULL;
+%{
+/* check if a buffer holds contiguous values in the native double format */
+static int helicsIsDoubleBuffer(const Py_buffer *view) {
+  const char *format=view->format;
+  if (view->itemsize!=sizeof(double) || format==NULL) {
+    return 0;
   }
-  $2=(int)(PyList_Size($input));
-  $1 = (double *) malloc($2*sizeof(double));
-
-  for (i = 0; i < $2; i++) {
-    PyObject *o = PyList_GetItem($input,i);
-    if (PyFloat_Check(o)) {
-      $1[i] = PyFloat_AsDouble(o);
-    }else if (PyInt_Check(o))
-    {
-        $1[i] = (double)(PyInt_AsLong(o));
+  if (format[0]=='@' || format[0]=='=') {
+    ++format;
+  }
+  return (format[0]=='d' && format[1]=='\0');
+}
+%}
+
+// typemap for vector input functions
+// buffers of float64 values (numpy arrays, array.array('d'), memoryviews) are passed through without a copy,
+// any other sequence of numbers is converted element by element
+%typemap(in) (const double *vectorInput, int vectorLength) (Py_buffer view, int usingBuffer=0) {
+  Py_ssize_t i;
+  Py_ssize_t count;
+  PyObject *seq;
+  if (PyObject_CheckBuffer($input) && PyObject_GetBuffer($input, &view, PyBUF_C_CONTIGUOUS|PyBUF_FORMAT)==0) {
+    if (helicsIsDoubleBuffer(&view)) {
+      usingBuffer=1;
+      $1=(double *)(view.buf);
+      $2=(int)(view.len/(Py_ssize_t)sizeof(double));
     } else {
-      PyErr_SetString(PyExc_ValueError,"List elements must be numbers");
-      free($1);
+      PyBuffer_Release(&view);
+    }
+  } else {
+    PyErr_Clear();
+  }
+  if (!usingBuffer) {
+    seq=PySequence_Fast($input, "Expected a list");
+    if (seq==NULL) {
+      PyErr_SetString(PyExc_ValueError,"Expected a list");
       return NULL;
     }
+    count=PySequence_Fast_GET_SIZE(seq);
+    $2=(int)(count);
+    $1 = (double *) malloc((count>0?count:1)*sizeof(double));
+    for (i = 0; i < count; i++) {
+      $1[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq,i));
+      if (PyErr_Occurred()) {
+        PyErr_SetString(PyExc_ValueError,"List elements must be numbers");
+        Py_DECREF(seq);
+        free((double *)$1);
+        return NULL;
+      }
+    }
+    Py_DECREF(seq);
   }
 }
 
@@ -173,7 +202,11 @@ PyModule_AddObject(m, "HelicsException", pHelicsException);
 }
 
 %typemap(freearg) (const double *vectorInput, int vectorLength) {
-   if ($1) free($1);
+  if (usingBuffer$argnum) {
+    PyBuffer_Release(&view$argnum);
+  } else if ($1) {
+    free((double *)$1);
+  }
 }
 
 // typemap for vector output functions
@@ -208,6 +241,34 @@ PyModule_AddObject(m, "HelicsException", pHelicsException);
 }
 
 
+// typemap for filling a caller supplied buffer of float64 values in place
+#define HELICS_VECTOR_BUFFER_MAPS
+%typemap(in) (double *vectorBuffer, int bufferLength, int *actualSize) (Py_buffer view, int actualLength=0) {
+  if (PyObject_GetBuffer($input, &view, PyBUF_WRITABLE|PyBUF_C_CONTIGUOUS|PyBUF_FORMAT)!=0) {
+    PyErr_SetString(PyExc_ValueError,"Expected a writable contiguous buffer of float64 values");
+    return NULL;
+  }
+  if (!helicsIsDoubleBuffer(&view)) {
+    PyBuffer_Release(&view);
+    PyErr_SetString(PyExc_ValueError,"Expected a writable contiguous buffer of float64 values");
+    return NULL;
+  }
+  $1=(double *)(view.buf);
+  $2=(int)(view.len/(Py_ssize_t)sizeof(double));
+  $3=&actualLength;
+}
+
+%typemap(argout) (double *vectorBuffer, int bufferLength, int *actualSize) {
+  $result = SWIG_Python_AppendOutput($result, PyLong_FromLong(*$3));
+}
+
+%typemap(freearg) (double *vectorBuffer, int bufferLength, int *actualSize) {
+  if ($1) {
+    PyBuffer_Release(&view$argnum);
+  }
+}
+
+
 // typemap for raw data input
 %typemap(in) (const void *data, int inputDataLength) {
   if (PyUnicode_Check($input)) {
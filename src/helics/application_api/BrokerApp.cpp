@@ -247,6 +247,13 @@ void BrokerApp::clearTimeBarrier()
     }
 }
 
+void BrokerApp::setCheckpointBarrier(Time checkpointTime, const std::string& filePrefix)
+{
+    if (broker) {
+        broker->setCheckpointBarrier(checkpointTime, filePrefix);
+    }
+}
+
 /** set the log file to use for the broker*/
 void BrokerApp::setLogFile(const std::string& logFile)
 {
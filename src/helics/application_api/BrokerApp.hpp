@@ -139,6 +139,8 @@ class HELICS_CXX_EXPORT BrokerApp {
     void setTimeBarrier(Time barrierTime);
     /** clear a global time Barrier*/
     void clearTimeBarrier();
+    /** set a global time barrier at which all the federates save a checkpoint*/
+    void setCheckpointBarrier(Time checkpointTime, const std::string& filePrefix);
 
   private:
     void processArgs(std::unique_ptr<helicsCLI11App>& app);
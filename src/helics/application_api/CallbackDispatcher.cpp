@@ -0,0 +1,213 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "CallbackDispatcher.hpp"
+
+#include "../common/JsonProcessingFunctions.hpp"
+
+#include <chrono>
+
+namespace helics {
+CallbackDispatcher::CallbackDispatcher(int threads, int order)
+{
+    setThreadCount(threads);
+    setOrdering(order);
+}
+
+CallbackDispatcher::~CallbackDispatcher()
+{
+    stopWorkers();
+}
+
+void CallbackDispatcher::setThreadCount(int threads)
+{
+    threads = (threads < 0) ? 0 : threads;
+    if (threads != threadCount) {
+        stopWorkers();
+        threadCount = threads;
+    }
+}
+
+void CallbackDispatcher::setOrdering(int order)
+{
+    switch (order) {
+        case helics_callback_ordering_global:
+        case helics_callback_ordering_per_interface:
+        case helics_callback_ordering_none:
+            ordering = order;
+            break;
+        default:
+            break;
+    }
+}
+
+void CallbackDispatcher::startWorkers()
+{
+    if (!workers.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(taskLock);
+        halted = false;
+    }
+    workers.reserve(static_cast<std::size_t>(threadCount));
+    for (int ii = 0; ii < threadCount; ++ii) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+void CallbackDispatcher::stopWorkers()
+{
+    if (workers.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(taskLock);
+        halted = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void CallbackDispatcher::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(taskLock);
+    while (true) {
+        taskAvailable.wait(lock, [this]() {
+            return halted || ((pending != nullptr) && (nextTask.load() < pending->size()));
+        });
+        if (halted) {
+            return;
+        }
+        auto* tasks = pending;
+        ++activeWorkers;
+        lock.unlock();
+        workOnTasks(*tasks);
+        lock.lock();
+        --activeWorkers;
+        if ((activeWorkers == 0) && (remaining.load() == 0)) {
+            tasksComplete.notify_all();
+        }
+    }
+}
+
+void CallbackDispatcher::workOnTasks(std::vector<std::function<void()>>& tasks)
+{
+    auto active = ++concurrent;
+    auto currentMax = maxConcurrency.load();
+    while ((active > currentMax) && (!maxConcurrency.compare_exchange_weak(currentMax, active))) {
+    }
+    while (true) {
+        auto index = nextTask++;
+        if (index >= tasks.size()) {
+            break;
+        }
+        auto start = std::chrono::steady_clock::now();
+        try {
+            tasks[index]();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(taskLock);
+            if (!taskError) {
+                taskError = std::current_exception();
+            }
+        }
+        taskNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+        if (--remaining == 0) {
+            std::lock_guard<std::mutex> lock(taskLock);
+            tasksComplete.notify_all();
+        }
+    }
+    --concurrent;
+}
+
+void CallbackDispatcher::run(std::vector<std::function<void()>>& tasks)
+{
+    if (tasks.empty()) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    if ((!isParallel()) || (tasks.size() == 1)) {
+        for (auto& task : tasks) {
+            task();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        taskNanoseconds += elapsed;
+        std::lock_guard<std::mutex> lock(taskLock);
+        serialTasks += static_cast<std::int64_t>(tasks.size());
+        dispatchNanoseconds += elapsed;
+        return;
+    }
+    startWorkers();
+    {
+        std::lock_guard<std::mutex> lock(taskLock);
+        pending = &tasks;
+        taskError = nullptr;
+        remaining.store(tasks.size());
+        nextTask.store(0);
+    }
+    taskAvailable.notify_all();
+    // the calling thread works on the tasks as well
+    workOnTasks(tasks);
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(taskLock);
+        // wait for the workers to leave as well so the tasks can be safely destroyed
+        tasksComplete.wait(lock,
+                           [this]() { return (remaining.load() == 0) && (activeWorkers == 0); });
+        pending = nullptr;
+        error = taskError;
+        taskError = nullptr;
+        ++dispatches;
+        parallelTasks += static_cast<std::int64_t>(tasks.size());
+        dispatchNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+std::string CallbackDispatcher::generateMetrics() const
+{
+    Json::Value base;
+    std::lock_guard<std::mutex> lock(taskLock);
+    base["threads"] = threadCount;
+    switch (ordering) {
+        case helics_callback_ordering_none:
+            base["ordering"] = "none";
+            break;
+        case helics_callback_ordering_per_interface:
+            base["ordering"] = "per_interface";
+            break;
+        case helics_callback_ordering_global:
+        default:
+            base["ordering"] = "global";
+            break;
+    }
+    base["dispatches"] = static_cast<Json::Int64>(dispatches);
+    base["parallel_callbacks"] = static_cast<Json::Int64>(parallelTasks);
+    base["serial_callbacks"] = static_cast<Json::Int64>(serialTasks);
+    base["max_concurrency"] = maxConcurrency.load();
+    auto callbackTime = static_cast<double>(taskNanoseconds.load()) / 1e9;
+    auto dispatchTime = static_cast<double>(dispatchNanoseconds) / 1e9;
+    base["callback_time"] = callbackTime;
+    base["dispatch_time"] = dispatchTime;
+    // the average number of callbacks running at once while callbacks were being run
+    base["parallelism"] = (dispatchTime > 0.0) ? callbackTime / dispatchTime : 0.0;
+    return generateJsonString(base);
+}
+
+}  // namespace helics
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "../helics_enums.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace helics {
+/** class running input and endpoint callbacks on a pool of worker threads
+@details the worker threads are started the first time a set of callbacks is run in parallel,  the
+thread calling run also executes callbacks and run does not return until all the callbacks are
+complete so the callbacks never extend past the time request that triggered them*/
+class CallbackDispatcher {
+  public:
+    CallbackDispatcher() = default;
+    /** construct with a thread count and ordering*/
+    CallbackDispatcher(int threads, int order);
+    /** destructor stops and joins the worker threads*/
+    ~CallbackDispatcher();
+    CallbackDispatcher(const CallbackDispatcher&) = delete;
+    CallbackDispatcher& operator=(const CallbackDispatcher&) = delete;
+
+    /** set the number of worker threads,  0 runs all callbacks on the calling thread
+    @details must not be called while callbacks are running*/
+    void setThreadCount(int threads);
+    /** get the number of worker threads*/
+    int getThreadCount() const { return threadCount; }
+    /** set the ordering of the callbacks see /ref helics_callback_orderings*/
+    void setOrdering(int order);
+    /** get the ordering of the callbacks*/
+    int getOrdering() const { return ordering; }
+    /** check if callbacks should be gathered and run on the worker threads*/
+    bool isParallel() const
+    {
+        return (threadCount > 0) && (ordering != helics_callback_ordering_global);
+    }
+    /** run a set of independent tasks and wait for all of them to complete
+    @details the first exception thrown by a task is rethrown after all the tasks have finished*/
+    void run(std::vector<std::function<void()>>& tasks);
+    /** generate a json string with the callback metrics*/
+    std::string generateMetrics() const;
+
+  private:
+    int threadCount{0};  //!< the number of worker threads
+    int ordering{helics_callback_ordering_global};  //!< the ordering of the callbacks
+    std::vector<std::thread> workers;  //!< the worker threads
+    mutable std::mutex taskLock;  //!< lock protecting the task coordination
+    std::condition_variable taskAvailable;  //!< notification of new tasks for the workers
+    std::condition_variable tasksComplete;  //!< notification that a set of tasks has finished
+    std::vector<std::function<void()>>* pending{nullptr};  //!< the tasks being run
+    std::atomic<std::size_t> nextTask{0};  //!< the index of the next task to start
+    std::atomic<std::size_t> remaining{0};  //!< the number of tasks not yet finished
+    int activeWorkers{0};  //!< the number of workers operating on the pending tasks
+    bool halted{false};  //!< indicator that the workers should terminate
+    std::exception_ptr taskError;  //!< the first exception thrown by a task
+
+    // metrics
+    std::atomic<int> concurrent{0};  //!< the number of threads running tasks
+    std::atomic<int> maxConcurrency{0};  //!< the most threads seen running tasks at once
+    std::atomic<std::int64_t> taskNanoseconds{0};  //!< total time spent in the tasks
+    std::int64_t dispatches{0};  //!< the number of sets of tasks run in parallel
+    std::int64_t parallelTasks{0};  //!< the number of tasks run through the worker pool
+    std::int64_t serialTasks{0};  //!< the number of tasks run on the calling thread
+    std::int64_t dispatchNanoseconds{0};  //!< total wall clock time spent running tasks
+
+    /** start the worker threads if they are not running*/
+    void startWorkers();
+    /** stop and join all the worker threads*/
+    void stopWorkers();
+    /** the loop executed by the worker threads*/
+    void workerLoop();
+    /** execute tasks from a set until none are left*/
+    void workOnTasks(std::vector<std::function<void()>>& tasks);
+};
+}  // namespace helics
@@ -17,6 +17,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../core/helics_definitions.hpp"
 #include "../network/loadCores.hpp"
 #include "AsyncFedCallInfo.hpp"
+#include "CallbackDispatcher.hpp"
 #include "CoreApp.hpp"
 #include "FilterFederateManager.hpp"
 #include "Filters.hpp"
@@ -79,6 +80,10 @@ Federate::Federate(const std::string& fedName, const FederateInfo& fi): name(fed
     currentTime = coreObject->getCurrentTime(fedID);
     asyncCallInfo = std::make_unique<shared_guarded_m<AsyncFedCallInfo>>();
     fManager = std::make_unique<FilterFederateManager>(coreObject.get(), this, fedID);
+    callbackDispatcher = std::make_unique<CallbackDispatcher>(
+        fi.checkIntProperty(helics_property_int_callback_threads, 0),
+        fi.checkIntProperty(helics_property_int_callback_ordering,
+                            helics_callback_ordering_global));
 }
 
 Federate::Federate(const std::string& fedname, CoreApp& core, const FederateInfo& fi):
@@ -117,6 +122,10 @@ Federate::Federate(const std::string& fedName,
     currentTime = coreObject->getCurrentTime(fedID);
     asyncCallInfo = std::make_unique<shared_guarded_m<AsyncFedCallInfo>>();
     fManager = std::make_unique<FilterFederateManager>(coreObject.get(), this, fedID);
+    callbackDispatcher = std::make_unique<CallbackDispatcher>(
+        fi.checkIntProperty(helics_property_int_callback_threads, 0),
+        fi.checkIntProperty(helics_property_int_callback_ordering,
+                            helics_callback_ordering_global));
 }
 
 Federate::Federate(const std::string& fedName, const std::string& configString):
@@ -146,6 +155,7 @@ Federate::Federate(Federate&& fed) noexcept
     strictConfigChecking = fed.strictConfigChecking;
     asyncCallInfo = std::move(fed.asyncCallInfo);
     fManager = std::move(fed.fManager);
+    callbackDispatcher = std::move(fed.callbackDispatcher);
     name = std::move(fed.name);
 }
 
@@ -160,6 +170,7 @@ Federate& Federate::operator=(Federate&& fed) noexcept
     strictConfigChecking = fed.strictConfigChecking;
     asyncCallInfo = std::move(fed.asyncCallInfo);
     fManager = std::move(fed.fManager);
+    callbackDispatcher = std::move(fed.callbackDispatcher);
     name = std::move(fed.name);
     return *this;
 }
@@ -286,7 +297,7 @@ iteration_result Federate::enterExecutingMode(iteration_request iterate)
             switch (res) {
                 case iteration_result::next_step:
                     currentMode = modes::executing;
-                    currentTime = timeZero;
+                    currentTime = coreObject->getCurrentTime(fedID);
                     initializeToExecuteStateTransition();
                     break;
                 case iteration_result::iterating:
@@ -372,7 +383,7 @@ iteration_result Federate::enterExecutingModeComplete()
                 switch (res) {
                     case iteration_result::next_step:
                         currentMode = modes::executing;
-                        currentTime = timeZero;
+                        currentTime = coreObject->getCurrentTime(fedID);
                         initializeToExecuteStateTransition();
                         break;
                     case iteration_result::iterating:
@@ -413,7 +424,21 @@ void Federate::setProperty(int32_t option, Time timeValue)
 
 void Federate::setProperty(int32_t option, int32_t optionValue)
 {
-    coreObject->setIntegerProperty(fedID, option, static_cast<int16_t>(optionValue));
+    switch (option) {
+        case helics_property_int_callback_threads:
+            if (callbackDispatcher) {
+                callbackDispatcher->setThreadCount(optionValue);
+            }
+            break;
+        case helics_property_int_callback_ordering:
+            if (callbackDispatcher) {
+                callbackDispatcher->setOrdering(optionValue);
+            }
+            break;
+        default:
+            coreObject->setIntegerProperty(fedID, option, static_cast<int16_t>(optionValue));
+            break;
+    }
 }
 
 Time Federate::getTimeProperty(int32_t option) const
@@ -423,7 +448,15 @@ Time Federate::getTimeProperty(int32_t option) const
 
 int32_t Federate::getIntegerProperty(int32_t option) const
 {
-    return coreObject->getIntegerProperty(fedID, option);
+    switch (option) {
+        case helics_property_int_callback_threads:
+            return (callbackDispatcher) ? callbackDispatcher->getThreadCount() : 0;
+        case helics_property_int_callback_ordering:
+            return (callbackDispatcher) ? callbackDispatcher->getOrdering() :
+                                          helics_callback_ordering_global;
+        default:
+            return coreObject->getIntegerProperty(fedID, option);
+    }
 }
 
 void Federate::setLoggingCallback(
@@ -1092,6 +1125,8 @@ std::string Federate::query(const std::string& queryStr)
         }
     } else if (queryStr == "time") {
         res = std::to_string(currentTime);
+    } else if (queryStr == "callbacks") {
+        res = (callbackDispatcher) ? callbackDispatcher->generateMetrics() : std::string("{}");
     } else {
         res = localQuery(queryStr);
     }
@@ -1162,6 +1197,39 @@ void Federate::setQueryCallback(const std::function<std::string(const std::strin
     }
 }
 
+void Federate::setCheckpointCallbacks(std::function<std::string()> saveFunction,
+                                      std::function<void(const std::string&)> restoreFunction)
+{
+    if (coreObject) {
+        coreObject->setCheckpointCallbacks(fedID,
+                                           std::move(saveFunction),
+                                           std::move(restoreFunction));
+    } else {
+        throw(InvalidFunctionCall(
+            "set checkpoint callbacks cannot be called on uninitialized federate or after finalize call"));
+    }
+}
+
+void Federate::saveCheckpoint(const std::string& filename)
+{
+    if (currentMode != modes::executing) {
+        throw(InvalidFunctionCall("checkpoints can only be saved in executing mode"));
+    }
+    coreObject->checkpointFederate(fedID, filename);
+}
+
+Time Federate::restoreCheckpoint(const std::string& filename)
+{
+    if (currentMode != modes::initializing) {
+        throw(InvalidFunctionCall("checkpoints can only be restored in initializing mode"));
+    }
+    auto checkpointTime = coreObject->restoreFederate(fedID, filename);
+    checkpointRestored();
+    return checkpointTime;
+}
+
+void Federate::checkpointRestored() {}
+
 bool Federate::isQueryCompleted(query_id_t queryIndex) const  // NOLINT
 {
     auto asyncInfo = asyncCallInfo->lock();
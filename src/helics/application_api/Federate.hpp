@@ -36,6 +36,7 @@ class CoreApp;
 class AsyncFedCallInfo;
 class MessageOperator;
 class FilterFederateManager;
+class CallbackDispatcher;
 class Filter;
 class CloningFilter;
 
@@ -70,6 +71,8 @@ class HELICS_CXX_EXPORT Federate {
   protected:
     std::shared_ptr<Core> coreObject;  //!< reference to the core simulation API
     Time currentTime = Time::minVal();  //!< the current simulation time
+    std::unique_ptr<CallbackDispatcher>
+        callbackDispatcher;  //!< runner for input and endpoint callbacks
   private:
     std::unique_ptr<gmlc::libguarded::shared_guarded<AsyncFedCallInfo, std::mutex>>
         asyncCallInfo;  //!< pointer to a class defining the async call information
@@ -373,6 +376,36 @@ class HELICS_CXX_EXPORT Federate {
     */
     void setQueryCallback(const std::function<std::string(const std::string&)>& queryFunction);
 
+    /** set the callbacks used to include model state in checkpoints
+    @details the callbacks are executed on the federate thread, including for checkpoints triggered
+    by a checkpoint barrier on the broker
+    @param saveFunction a function returning a binary blob of the model state to store in a
+    checkpoint
+    @param restoreFunction a function called with the blob from a checkpoint to restore the model
+    state
+    */
+    void setCheckpointCallbacks(std::function<std::string()> saveFunction,
+                                std::function<void(const std::string&)> restoreFunction);
+
+    /** save a checkpoint of the federate to a file
+    @details the checkpoint includes the current granted time, the pending input values and
+    endpoint messages, and any model state from the checkpoint callback.  It must be called in
+    executing mode, to checkpoint an entire co-simulation at the same time use
+    Broker::setCheckpointBarrier which writes a checkpoint for each federate as it reaches the
+    barrier
+    @param filename the name of the file to write the checkpoint to
+    */
+    void saveCheckpoint(const std::string& filename);
+
+    /** restore the federate from a checkpoint file
+    @details must be called in initializing mode with the same interfaces as when the checkpoint
+    was saved,  on entering executing mode the federate is granted the checkpoint time and the
+    restored input values are available without being marked as updated
+    @param filename the name of the checkpoint file
+    @return the granted time of the federate when the checkpoint was saved
+    */
+    Time restoreCheckpoint(const std::string& filename);
+
     /** set a federation global value
     @details this overwrites any previous value for this name
     @param valueName the name of the global to set
@@ -499,6 +532,8 @@ class HELICS_CXX_EXPORT Federate {
     /** function to deal with any operations that need to occur on the transition from startup to
      * initialize*/
     virtual void initializeToExecuteStateTransition();
+    /** function to deal with any operations that need to occur after the core restored a checkpoint*/
+    virtual void checkpointRestored();
     /** function to generate results for a local Query
     @details should return an empty string if the query is not recognized*/
     virtual std::string localQuery(const std::string& queryStr) const;
@@ -64,6 +64,10 @@ static const std::unordered_map<std::string, int> propStringsTranslations{
     {"time_rt_lead", helics_property_time_rt_lead},
     {"time_rt_lag", helics_property_time_rt_lag},
     {"time_rt_tolerance", helics_property_time_rt_tolerance},
+    {"rtspin", helics_property_time_rt_spin},
+    {"rt_spin", helics_property_time_rt_spin},
+    {"rtSpin", helics_property_time_rt_spin},
+    {"time_rt_spin", helics_property_time_rt_spin},
     {"inputdelay", helics_property_time_input_delay},
     {"outputdelay", helics_property_time_output_delay},
     {"inputDelay", helics_property_time_input_delay},
@@ -74,6 +78,8 @@ static const std::unordered_map<std::string, int> propStringsTranslations{
     {"timeoutputdelay", helics_property_time_output_delay},
     {"time_input_delay", helics_property_time_input_delay},
     {"time_output_delay", helics_property_time_output_delay},
+    {"lookahead", helics_property_time_output_delay},
+    {"time_lookahead", helics_property_time_output_delay},
     {"loglevel", helics_property_int_log_level},
     {"log_level", helics_property_int_log_level},
     {"logLevel", helics_property_int_log_level},
@@ -92,7 +98,19 @@ static const std::unordered_map<std::string, int> propStringsTranslations{
     {"maxIterations", helics_property_int_max_iterations},
     {"intmaxiterations", helics_property_int_max_iterations},
     {"int_max_iterations", helics_property_int_max_iterations},
-    {"iterations", helics_property_int_max_iterations}};
+    {"iterations", helics_property_int_max_iterations},
+    {"rtcpu", helics_property_int_rt_cpu_affinity},
+    {"rt_cpu", helics_property_int_rt_cpu_affinity},
+    {"rt_cpu_affinity", helics_property_int_rt_cpu_affinity},
+    {"int_rt_cpu_affinity", helics_property_int_rt_cpu_affinity},
+    {"callbackthreads", helics_property_int_callback_threads},
+    {"callback_threads", helics_property_int_callback_threads},
+    {"callbackThreads", helics_property_int_callback_threads},
+    {"int_callback_threads", helics_property_int_callback_threads},
+    {"callbackordering", helics_property_int_callback_ordering},
+    {"callback_ordering", helics_property_int_callback_ordering},
+    {"callbackOrdering", helics_property_int_callback_ordering},
+    {"int_callback_ordering", helics_property_int_callback_ordering}};
 
 static const std::unordered_map<std::string, int> flagStringsTranslations{
     {"source_only", helics_flag_source_only},
@@ -113,6 +131,9 @@ static const std::unordered_map<std::string, int> flagStringsTranslations{
     {"realtime", helics_flag_realtime},
     {"real_time", helics_flag_realtime},
     {"realTime", helics_flag_realtime},
+    {"realtime_high_precision", helics_flag_realtime_high_precision},
+    {"high_precision_realtime", helics_flag_realtime_high_precision},
+    {"realtimeHighPrecision", helics_flag_realtime_high_precision},
     {"restrictive_time_policy", helics_flag_restrictive_time_policy},
     {"conservative_time_policy", helics_flag_restrictive_time_policy},
     {"restrictive_time", helics_flag_restrictive_time_policy},
@@ -249,6 +270,13 @@ static const std::map<std::string, int> log_level_map{{"none", helics_log_level_
                                                       /** all internal messages*/
                                                       {"trace", helics_log_level_trace}};
 
+static const std::map<std::string, int> callback_ordering_map{
+    {"global", helics_callback_ordering_global},
+    {"per_interface", helics_callback_ordering_per_interface},
+    {"per_input", helics_callback_ordering_per_interface},
+    {"per_endpoint", helics_callback_ordering_per_interface},
+    {"none", helics_callback_ordering_none}};
+
 static void loadFlags(FederateInfo& fi, const std::string& flags)
 {
     auto sflgs = gmlc::utilities::stringOps::splitline(flags);
@@ -486,6 +514,19 @@ std::unique_ptr<helicsCLI11App> FederateInfo::makeCLIApp()
             [this](Time val) { setProperty(helics_property_time_rt_tolerance, val); },
             "the time tolerance of the real time mode (default in ms)")
         ->configurable(false);
+    rtgroup
+        ->add_option_function<Time>(
+            "--rtspin",
+            [this](Time val) { setProperty(helics_property_time_rt_spin, val); },
+            "the time before each step a high precision real time federate stops sleeping and "
+            "spins on the clock (default in ms)")
+        ->configurable(false);
+    rtgroup
+        ->add_option_function<int>(
+            "--rtcpu",
+            [this](int val) { setProperty(helics_property_int_rt_cpu_affinity, val); },
+            "the cpu to pin the thread of a real time federate to")
+        ->configurable(false);
 
     app->add_option_function<Time>(
            "--inputdelay",
@@ -494,9 +535,10 @@ std::unique_ptr<helicsCLI11App> FederateInfo::makeCLIApp()
         ->ignore_underscore()
         ->configurable(false);
     app->add_option_function<Time>(
-           "--outputdelay",
+           "--outputdelay,--lookahead",
            [this](Time val) { setProperty(helics_property_time_output_delay, val); },
-           "the output delay for outgoing communication of the federate (default in ms)")
+           "the output delay for outgoing communication of the federate, this is also the "
+           "lookahead promised to federates depending on it (default in ms)")
         ->ignore_underscore()
         ->configurable(false);
     app->add_option_function<int>(
@@ -513,6 +555,21 @@ std::unique_ptr<helicsCLI11App> FederateInfo::makeCLIApp()
         ->transform(
             CLI::CheckedTransformer(&log_level_map, CLI::ignore_case, CLI::ignore_underscore));
 
+    app->add_option_function<int>(
+           "--callbackthreads",
+           [this](int val) { setProperty(helics_property_int_callback_threads, val); },
+           "the number of worker threads to run input and endpoint callbacks on")
+        ->ignore_underscore()
+        ->check(CLI::NonNegativeNumber);
+    app->add_option_function<int>(
+           "--callbackordering",
+           [this](int val) { setProperty(helics_property_int_callback_ordering, val); },
+           "the ordering of callbacks run on worker threads (global, per_interface, none)")
+        ->ignore_underscore()
+        ->transform(CLI::CheckedTransformer(&callback_ordering_map,
+                                            CLI::ignore_case,
+                                            CLI::ignore_underscore));
+
     app->add_option("--separator", separator, "separator character for local federates")
         ->default_str(std::string(1, separator));
     app->add_option("--flags,-f,--flag", "named flag for the federate")
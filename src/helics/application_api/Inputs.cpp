@@ -782,7 +782,7 @@ char Input::getValueChar()
 
 int Input::getValue(double* data, int maxsize)
 {
-    auto V = getValueRef<std::vector<double>>();
+    const auto& V = getValueRef<std::vector<double>>();
     int length = 0;
     if (data != nullptr && maxsize > 0) {
         length = std::min(static_cast<int>(V.size()), maxsize);
@@ -15,32 +15,47 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "Endpoints.hpp"
 #include "MessageFederateManager.hpp"
 
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace helics {
 MessageFederate::MessageFederate(const std::string& fedName, const FederateInfo& fi):
     Federate(fedName, fi)
 {
-    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(), this, getID());
+    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(),
+                                                         this,
+                                                         getID(),
+                                                         callbackDispatcher.get());
 }
 MessageFederate::MessageFederate(const std::string& fedName,
                                  const std::shared_ptr<Core>& core,
                                  const FederateInfo& fi):
     Federate(fedName, core, fi)
 {
-    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(), this, getID());
+    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(),
+                                                         this,
+                                                         getID(),
+                                                         callbackDispatcher.get());
 }
 
 MessageFederate::MessageFederate(const std::string& fedName, CoreApp& core, const FederateInfo& fi):
     Federate(fedName, core, fi)
 {
-    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(), this, getID());
+    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(),
+                                                         this,
+                                                         getID(),
+                                                         callbackDispatcher.get());
 }
 
 MessageFederate::MessageFederate(const std::string& fedName, const std::string& configString):
     Federate(fedName, loadFederateInfo(configString))
 {
-    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(), this, getID());
+    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(),
+                                                         this,
+                                                         getID(),
+                                                         callbackDispatcher.get());
     if (looksLikeFile(configString)) {
         MessageFederate::registerInterfaces(configString);
     }
@@ -65,7 +80,10 @@ MessageFederate::MessageFederate(bool /*unused*/)
 {  // this constructor should only be called by child class that has already constructed the
    // underlying federate in
     // a virtual inheritance
-    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(), this, getID());
+    mfManager = std::make_unique<MessageFederateManager>(coreObject.get(),
+                                                         this,
+                                                         getID(),
+                                                         callbackDispatcher.get());
 }
 MessageFederate::MessageFederate(MessageFederate&&) noexcept = default;
 
@@ -177,21 +195,64 @@ static void loadOptions(MessageFederate* fed, const Inp& data, Endpoint& ept)
     }
 }
 
+/** the number of endpoints from a configuration section registered through each core call*/
+static constexpr std::size_t configBatchSize{4096};
+
+/** register the endpoints described by a configuration section in batches
+@details each batch of endpoints is registered through a single core call then the options for each
+endpoint in the batch are loaded in order
+@param prefix the string to prepend to the names of non-global endpoints*/
+template<class Arr>
+static void loadEndpointSection(MessageFederate* fed,
+                                MessageFederateManager& mfm,
+                                const Arr& section,
+                                const std::string& prefix,
+                                bool defaultGlobal)
+{
+    using element_type = std::decay_t<decltype(*std::begin(section))>;
+    std::vector<const element_type*> batch;
+    std::vector<InterfaceDefinition> definitions;
+    batch.reserve(configBatchSize);
+    definitions.reserve(configBatchSize);
+
+    auto registerBatch = [&]() {
+        if (batch.empty()) {
+            return;
+        }
+        auto epts = mfm.registerEndpoints(definitions);
+        for (std::size_t ii = 0; ii < batch.size(); ++ii) {
+            loadOptions(fed, *batch[ii], *epts[ii]);
+        }
+        batch.clear();
+        definitions.clear();
+    };
+
+    for (const auto& ept : section) {
+        InterfaceDefinition def;
+        def.kind = interface_kind::endpoint;
+        def.key = getKey(ept);
+        def.type = getOrDefault(ept, "type", emptyStr);
+        bool global = getOrDefault(ept, "global", defaultGlobal);
+        if (!global && !def.key.empty()) {
+            def.key.insert(0, prefix);
+        }
+        batch.push_back(&ept);
+        definitions.push_back(std::move(def));
+        if (batch.size() >= configBatchSize) {
+            registerBatch();
+        }
+    }
+    registerBatch();
+}
+
 void MessageFederate::registerMessageInterfacesJson(const std::string& jsonString)
 {
     auto doc = loadJson(jsonString);
     bool defaultGlobal = false;
     replaceIfMember(doc, "defaultglobal", defaultGlobal);
     if (doc.isMember("endpoints")) {
-        for (const auto& ept : doc["endpoints"]) {
-            auto eptName = getKey(ept);
-            auto type = getOrDefault(ept, "type", emptyStr);
-            bool global = getOrDefault(ept, "global", defaultGlobal);
-            Endpoint& epObj =
-                (global) ? registerGlobalEndpoint(eptName, type) : registerEndpoint(eptName, type);
-
-            loadOptions(this, ept, epObj);
-        }
+        loadEndpointSection(
+            this, *mfManager, doc["endpoints"], getName() + nameSegmentSeparator, defaultGlobal);
     }
 }
 
@@ -208,20 +269,12 @@ void MessageFederate::registerMessageInterfacesToml(const std::string& tomlStrin
     replaceIfMember(doc, "defaultglobal", defaultGlobal);
 
     if (isMember(doc, "endpoints")) {
-        auto epts = toml::find(doc, "endpoints");
+        const auto& epts = toml::find(doc, "endpoints");
         if (!epts.is_array()) {
             throw(helics::InvalidParameter("endpoints section in toml file must be an array"));
         }
-        auto& eptArray = epts.as_array();
-        for (auto& ept : eptArray) {
-            auto key = getKey(ept);
-            auto type = getOrDefault(ept, "type", emptyStr);
-            bool global = getOrDefault(ept, "global", defaultGlobal);
-            Endpoint& epObj =
-                (global) ? registerGlobalEndpoint(key, type) : registerEndpoint(key, type);
-
-            loadOptions(this, ept, epObj);
-        }
+        loadEndpointSection(
+            this, *mfManager, epts.as_array(), getName() + nameSegmentSeparator, defaultGlobal);
     }
 }
 
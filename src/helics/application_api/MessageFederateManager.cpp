@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../core/Core.hpp"
 #include "../core/queryHelpers.hpp"
+#include "CallbackDispatcher.hpp"
 #include "helics/core/core-exceptions.hpp"
 
 #include <cassert>
@@ -16,9 +17,10 @@ SPDX-License-Identifier: BSD-3-Clause
 namespace helics {
 MessageFederateManager::MessageFederateManager(Core* coreOb,
                                                MessageFederate* fed,
-                                               local_federate_id id):
+                                               local_federate_id id,
+                                               CallbackDispatcher* dispatch):
     coreObject(coreOb),
-    mFed(fed), fedID(id)
+    mFed(fed), fedID(id), dispatcher(dispatch)
 {
 }
 MessageFederateManager::~MessageFederateManager() = default;
@@ -59,6 +61,34 @@ Endpoint& MessageFederateManager::registerEndpoint(const std::string& name, cons
     throw(RegistrationFailure("Unable to register Endpoint"));
 }
 
+std::vector<Endpoint*>
+    MessageFederateManager::registerEndpoints(const std::vector<InterfaceDefinition>& definitions)
+{
+    auto handles = coreObject->registerInterfaces(fedID, definitions);
+    std::vector<Endpoint*> epts;
+    epts.reserve(handles.size());
+    // same lock order as updateTime
+    auto datHandle = eptData.lock();
+    auto eptHandle = local_endpoints.lock();
+    for (std::size_t ii = 0; ii < handles.size(); ++ii) {
+        const auto& name = definitions[ii].key;
+        auto handle = handles[ii];
+        auto edat = std::make_unique<EndpointData>();
+        auto loc = eptHandle->insert(name, handle, mFed, name, handle, edat.get());
+        if (!loc) {
+            throw(RegistrationFailure("Unable to register Endpoint"));
+        }
+        auto& ref = eptHandle->back();
+        ref.referenceIndex = static_cast<int>(*loc);
+        if (datHandle->size() <= *loc) {
+            datHandle->resize(*loc + 1);
+        }
+        (*datHandle)[*loc] = std::move(edat);
+        epts.push_back(&ref);
+    }
+    return epts;
+}
+
 void MessageFederateManager::registerKnownCommunicationPath(const Endpoint& localEndpoint,
                                                             const std::string& remoteEndpoint)
 {
@@ -167,6 +197,10 @@ void MessageFederateManager::updateTime(Time newTime, Time /*oldTime*/)
 {
     CurrentTime = newTime;
     auto epCount = coreObject->receiveCountAny(fedID);
+    if ((dispatcher != nullptr) && (dispatcher->isParallel()) && (epCount > 1)) {
+        updateTimeDispatch(epCount);
+        return;
+    }
     // lock the data updates
     auto eptDat = eptData.lock();
 
@@ -207,6 +241,70 @@ void MessageFederateManager::updateTime(Time newTime, Time /*oldTime*/)
     }
 }
 
+void MessageFederateManager::updateTimeDispatch(uint64_t epCount)
+{
+    using callback_type = std::function<void(Endpoint&, Time)>;
+    struct endpointCalls {
+        Endpoint* ept;
+        callback_type callback;
+        int count;
+    };
+    std::vector<endpointCalls> calls;
+    std::unordered_map<int, std::size_t> callIndex;
+    {
+        auto eptDat = eptData.lock();
+        auto epts = local_endpoints.lock();
+        auto mcall = allCallback.load();
+        interface_handle endpoint_id;
+        for (size_t ii = 0; ii < epCount; ++ii) {
+            auto message = coreObject->receiveAny(fedID, endpoint_id);
+            if (!message) {
+                break;
+            }
+            auto fid = epts->find(endpoint_id);
+            if (fid == epts->end()) {
+                continue;
+            }
+            auto localEndpointIndex = fid->referenceIndex;
+            auto& dat = (*eptDat)[localEndpointIndex];
+            dat->messages.emplace(std::move(message));
+            // copy the callbacks so they are not modified while running without the locks
+            const auto& cb = (dat->callback) ? dat->callback : mcall;
+            if (!cb) {
+                continue;
+            }
+            auto fnd = callIndex.find(localEndpointIndex);
+            if (fnd != callIndex.end()) {
+                ++calls[fnd->second].count;
+            } else {
+                callIndex.emplace(localEndpointIndex, calls.size());
+                calls.push_back(endpointCalls{&(*fid), cb, 1});
+            }
+        }
+    }
+    // all the messages are queued before any callbacks run
+    std::vector<std::function<void()>> tasks;
+    auto time = CurrentTime;
+    if (dispatcher->getOrdering() == helics_callback_ordering_per_interface) {
+        // the callbacks for an endpoint run sequentially in the order the messages arrived
+        tasks.reserve(calls.size());
+        for (auto& call : calls) {
+            tasks.emplace_back([&call, time]() {
+                for (int jj = 0; jj < call.count; ++jj) {
+                    call.callback(*call.ept, time);
+                }
+            });
+        }
+    } else {
+        for (auto& call : calls) {
+            for (int jj = 0; jj < call.count; ++jj) {
+                tasks.emplace_back([&call, time]() { call.callback(*call.ept, time); });
+            }
+        }
+    }
+    dispatcher->run(tasks);
+}
+
 void MessageFederateManager::startupToInitializeStateTransition() {}
 
 void MessageFederateManager::initializeToExecuteStateTransition() {}
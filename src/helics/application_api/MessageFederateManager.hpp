@@ -27,6 +27,7 @@ SPDX-License-Identifier: BSD-3-Clause
 namespace helics {
 class Core;
 class MessageFederate;
+class CallbackDispatcher;
 /** class handling the implementation details of a value Federate
 @details the functions will parallel those in message Federate and contain the actual implementation
 details
@@ -34,8 +35,12 @@ details
 class MessageFederateManager {
   public:
     /** construct from a pointer to a core and a specified federate id
+    @param dispatch an optional dispatcher for running the endpoint callbacks in parallel
      */
-    MessageFederateManager(Core* coreOb, MessageFederate* mFed, local_federate_id id);
+    MessageFederateManager(Core* coreOb,
+                           MessageFederate* mFed,
+                           local_federate_id id,
+                           CallbackDispatcher* dispatch = nullptr);
     ~MessageFederateManager();
     /** register an endpoint
     @details call is only valid in startup mode
@@ -43,6 +48,12 @@ class MessageFederateManager {
     @param type the defined type of the interface for endpoint checking if requested
     */
     Endpoint& registerEndpoint(const std::string& name, const std::string& type);
+    /** register a set of endpoints through a single call to the core
+    @details call is only valid in startup mode
+    @param definitions the definitions of the endpoints with the complete names
+    @return pointers to the new endpoints in the order of the definitions
+    */
+    std::vector<Endpoint*> registerEndpoints(const std::vector<InterfaceDefinition>& definitions);
 
     /** @brief give the core a hint for known communication paths
     Specifying a path that is not present will cause the simulation to abort with an error message
@@ -145,11 +156,14 @@ class MessageFederateManager {
     Core* coreObject;  //!< the pointer to the actual core
     MessageFederate* mFed;  //!< pointer back to the message Federate
     const local_federate_id fedID;  //!< storage for the federate ID
+    CallbackDispatcher* dispatcher{nullptr};  //!< runner for the endpoint callbacks
     shared_guarded<std::vector<std::unique_ptr<EndpointData>>>
         eptData;  //!< the storage for the message queues and other unique Endpoint information
     guarded<std::vector<unsigned int>>
         messageOrder;  //!< maintaining a list of the ordered messages
   private:  // private functions
     void removeOrderedMessage(unsigned int index);
+    /** queue all the waiting messages then run the callbacks through the dispatcher*/
+    void updateTimeDispatch(uint64_t epCount);
 };
 }  // namespace helics
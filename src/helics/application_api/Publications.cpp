@@ -176,6 +176,40 @@ void Publication::publish(const std::string& val)
         fed->publishRaw(*this, db);
     }
 }
+/** check if an array of doubles published with a type is sent as an encoded vector*/
+static bool isVectorEncoded(data_type type)
+{
+    switch (type) {
+        case data_type::helics_double:
+        case data_type::helics_int:
+        case data_type::helics_complex:
+        case data_type::helics_bool:
+        case data_type::helics_string:
+        case data_type::helics_named_point:
+        case data_type::helics_complex_vector:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/** check if an array of complex values published with a type is sent as an encoded complex
+vector*/
+static bool isComplexVectorEncoded(data_type type)
+{
+    switch (type) {
+        case data_type::helics_double:
+        case data_type::helics_int:
+        case data_type::helics_complex:
+        case data_type::helics_bool:
+        case data_type::helics_string:
+        case data_type::helics_named_point:
+            return false;
+        default:
+            return true;
+    }
+}
+
 void Publication::publish(const std::vector<double>& val)
 {
     bool doPublish = true;
@@ -187,6 +221,10 @@ void Publication::publish(const std::vector<double>& val)
         }
     }
     if (doPublish) {
+        if (!val.empty() && isVectorEncoded(pubType)) {
+            fed->publishBuffer(*this, encodeVector(val.data(), val.size()));
+            return;
+        }
         auto db = typeConvert(pubType, val);
         fed->publishRaw(*this, db);
     }
@@ -203,6 +241,10 @@ void Publication::publish(const std::vector<std::complex<double>>& val)
         }
     }
     if (doPublish) {
+        if (!val.empty() && isComplexVectorEncoded(pubType)) {
+            fed->publishBuffer(*this, encodeComplexVector(val.data(), val.size()));
+            return;
+        }
         auto db = typeConvert(pubType, val);
         fed->publishRaw(*this, db);
     }
@@ -219,11 +261,43 @@ void Publication::publish(const double* vals, int size)
         }
     }
     if (doPublish) {
+        if ((size > 0) && isVectorEncoded(pubType)) {
+            fed->publishBuffer(*this, encodeVector(vals, static_cast<size_t>(size)));
+            return;
+        }
         auto db = typeConvert(pubType, vals, size);
         fed->publishRaw(*this, db);
     }
 }
 
+void Publication::publish(const std::complex<double>* vals, int size)
+{
+    if ((size > 0) && !changeDetectionEnabled && isComplexVectorEncoded(pubType)) {
+        fed->publishBuffer(*this, encodeComplexVector(vals, static_cast<size_t>(size)));
+        return;
+    }
+    publish((size > 0) ? std::vector<std::complex<double>>(vals, vals + size) :
+                         std::vector<std::complex<double>>());
+}
+
+void Publication::publish(const int64_t* vals, int size)
+{
+    if ((size > 0) && !changeDetectionEnabled && isVectorEncoded(pubType)) {
+        fed->publishBuffer(*this, encodeVector(vals, static_cast<size_t>(size)));
+        return;
+    }
+    publish((size > 0) ? std::vector<double>(vals, vals + size) : std::vector<double>());
+}
+
+void Publication::publish(const int32_t* vals, int size)
+{
+    if ((size > 0) && !changeDetectionEnabled && isVectorEncoded(pubType)) {
+        fed->publishBuffer(*this, encodeVector(vals, static_cast<size_t>(size)));
+        return;
+    }
+    publish((size > 0) ? std::vector<double>(vals, vals + size) : std::vector<double>());
+}
+
 void Publication::publish(std::complex<double> val)
 {
     bool doPublish = true;
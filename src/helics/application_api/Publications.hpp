@@ -227,7 +227,15 @@ class HELICS_CXX_EXPORT Publication {
     void publish(const std::string& val);
     void publish(const std::vector<double>& val);
     void publish(const std::vector<std::complex<double>>& val);
+    /** publish an array of values as a vector
+    @details for vector publications the values are encoded directly into the buffer sent by the
+    core without an intermediate vector
+    @param vals a pointer to the first value
+    @param size the number of values*/
     void publish(const double* vals, int size);
+    void publish(const std::complex<double>* vals, int size);
+    void publish(const int64_t* vals, int size);
+    void publish(const int32_t* vals, int size);
     void publish(std::complex<double> val);
     void publish(const defV& val);
     void publish(bool val);
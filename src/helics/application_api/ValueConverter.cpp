@@ -10,9 +10,70 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "ValueConverter_impl.hpp"
 
 #include <complex>
+#include <cstring>
 #include <vector>
 
 namespace helics {
+/** the size of the header the portable binary archive writes for a vector,  a byte indicating the
+endianness followed by the element count*/
+static constexpr size_t vectorHeaderSize{1 + sizeof(cereal::size_type)};
+
+/** size a buffer for a vector and write the header
+@return a pointer to the location of the first element*/
+static char* prepareVectorBuffer(std::string& buffer, size_t size, size_t elementSize)
+{
+    buffer.resize(vectorHeaderSize + size * elementSize);
+    auto* data = &buffer[0];
+    // the archive is written in the native byte order
+    data[0] = static_cast<char>(cereal::portable_binary_detail::is_little_endian() ? 1 : 0);
+    auto count = static_cast<cereal::size_type>(size);
+    std::memcpy(data + 1, &count, sizeof(count));
+    return data + vectorHeaderSize;
+}
+
+template<class X>
+static std::string encodeAsDoubles(const X* vals, size_t size)
+{
+    std::string buffer;
+    auto* data = prepareVectorBuffer(buffer, size, sizeof(double));
+    for (size_t ii = 0; ii < size; ++ii) {
+        auto val = static_cast<double>(vals[ii]);
+        std::memcpy(data + ii * sizeof(double), &val, sizeof(double));
+    }
+    return buffer;
+}
+
+std::string encodeVector(const double* vals, size_t size)
+{
+    std::string buffer;
+    auto* data = prepareVectorBuffer(buffer, size, sizeof(double));
+    if (size > 0) {
+        std::memcpy(data, vals, size * sizeof(double));
+    }
+    return buffer;
+}
+
+std::string encodeVector(const int64_t* vals, size_t size)
+{
+    return encodeAsDoubles(vals, size);
+}
+
+std::string encodeVector(const int32_t* vals, size_t size)
+{
+    return encodeAsDoubles(vals, size);
+}
+
+std::string encodeComplexVector(const std::complex<double>* vals, size_t size)
+{
+    std::string buffer;
+    // std::complex is required to have the layout of an array of two values
+    auto* data = prepareVectorBuffer(buffer, size, 2 * sizeof(double));
+    if (size > 0) {
+        std::memcpy(data, vals, size * 2 * sizeof(double));
+    }
+    return buffer;
+}
+
 template class ValueConverter<int64_t>;
 template class ValueConverter<uint64_t>;
 template class ValueConverter<char>;
@@ -16,6 +16,8 @@ algorithms
 #include "data_view.hpp"
 #include "helicsTypes.hpp"
 
+#include <complex>
+#include <cstdint>
 #include <string>
 #include <utility>
 namespace helics {
@@ -58,6 +60,18 @@ class ValueConverter<std::string> {
     static void interpret(const data_view& block, std::string& val) { val = interpret(block); }
     static std::string type() { return "string"; }
 };
+
+/** encode an array of values in the serialized form of a vector of doubles
+@details the values are written directly into a single buffer of the final size without an
+intermediate vector or stream,  integer values are converted to doubles
+@return a buffer that can be transferred to the core without further copies*/
+HELICS_CXX_EXPORT std::string encodeVector(const double* vals, size_t size);
+/** encode an array of 64 bit integers in the serialized form of a vector of doubles*/
+HELICS_CXX_EXPORT std::string encodeVector(const int64_t* vals, size_t size);
+/** encode an array of 32 bit integers in the serialized form of a vector of doubles*/
+HELICS_CXX_EXPORT std::string encodeVector(const int32_t* vals, size_t size);
+/** encode an array of complex values in the serialized form of a vector of complex doubles*/
+HELICS_CXX_EXPORT std::string encodeComplexVector(const std::complex<double>* vals, size_t size);
 }  // namespace helics
 
 // This should be at the end since it depends on the definitions in here
@@ -19,6 +19,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <deque>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -29,26 +31,38 @@ ValueFederate::ValueFederate(const std::string& fedName, const FederateInfo& fi)
     Federate(fedName, fi)
 {
     // the core object get instantiated in the Federate constructor
-    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(), this, getID());
+    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(),
+                                                       this,
+                                                       getID(),
+                                                       callbackDispatcher.get());
 }
 ValueFederate::ValueFederate(const std::string& fedName,
                              const std::shared_ptr<Core>& core,
                              const FederateInfo& fi):
     Federate(fedName, core, fi)
 {
-    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(), this, getID());
+    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(),
+                                                       this,
+                                                       getID(),
+                                                       callbackDispatcher.get());
 }
 
 ValueFederate::ValueFederate(const std::string& fedName, CoreApp& core, const FederateInfo& fi):
     Federate(fedName, core, fi)
 {
-    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(), this, getID());
+    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(),
+                                                       this,
+                                                       getID(),
+                                                       callbackDispatcher.get());
 }
 
 ValueFederate::ValueFederate(const std::string& fedName, const std::string& configString):
     Federate(fedName, loadFederateInfo(configString))
 {
-    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(), this, getID());
+    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(),
+                                                       this,
+                                                       getID(),
+                                                       callbackDispatcher.get());
     if (looksLikeFile(configString)) {
         ValueFederate::registerInterfaces(configString);
     }
@@ -68,7 +82,10 @@ ValueFederate::ValueFederate() = default;
 
 ValueFederate::ValueFederate(bool /*res*/)
 {
-    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(), this, getID());
+    vfManager = std::make_unique<ValueFederateManager>(coreObject.get(),
+                                                       this,
+                                                       getID(),
+                                                       callbackDispatcher.get());
 }
 
 ValueFederate::ValueFederate(ValueFederate&&) noexcept = default;
@@ -215,68 +232,146 @@ static void loadOptions(ValueFederate* fed, const Inp& data, Obj& objUpdate)
     });
 }
 
+namespace {
+/** the sections of a configuration file describing value interfaces*/
+enum class value_section { publications, subscriptions, inputs };
+}  // namespace
+
+/** the number of interfaces from a configuration section registered through each core call*/
+static constexpr std::size_t configBatchSize{4096};
+
+/** register the interfaces described by a section of a configuration file in batches
+@details the interfaces that don't already exist are registered through a single core call per
+batch then the options for each element of the batch are loaded in order
+@param prefix the string to prepend to the key of non-global interfaces*/
+template<class Arr>
+static void loadValueSection(ValueFederate* fed,
+                             ValueFederateManager& vfm,
+                             const Arr& section,
+                             value_section sectionType,
+                             const std::string& prefix,
+                             bool defaultGlobal)
+{
+    using element_type = std::decay_t<decltype(*std::begin(section))>;
+    struct batchEntry {
+        const element_type* data{nullptr};
+        std::string key;
+        Publication* pub{nullptr};
+        Input* inp{nullptr};
+        int definition{-1};
+    };
+    std::vector<batchEntry> batch;
+    std::vector<InterfaceDefinition> definitions;
+    std::unordered_set<std::string> pendingKeys;
+    batch.reserve(configBatchSize);
+    definitions.reserve(configBatchSize);
+
+    auto registerBatch = [&]() {
+        if (!definitions.empty()) {
+            if (sectionType == value_section::publications) {
+                auto pubs = vfm.registerPublications(definitions);
+                for (auto& entry : batch) {
+                    if (entry.definition >= 0) {
+                        entry.pub = pubs[static_cast<std::size_t>(entry.definition)];
+                    }
+                }
+            } else {
+                auto inps = vfm.registerInputs(definitions);
+                for (auto& entry : batch) {
+                    if (entry.definition >= 0) {
+                        entry.inp = inps[static_cast<std::size_t>(entry.definition)];
+                        if (sectionType == value_section::subscriptions) {
+                            entry.inp->addTarget(entry.key);
+                        }
+                    }
+                }
+            }
+        }
+        for (auto& entry : batch) {
+            if (entry.pub != nullptr) {
+                loadOptions(fed, *entry.data, *entry.pub);
+            } else {
+                loadOptions(fed, *entry.data, *entry.inp);
+            }
+        }
+        batch.clear();
+        definitions.clear();
+        pendingKeys.clear();
+    };
+
+    for (const auto& element : section) {
+        batchEntry entry;
+        entry.data = &element;
+        entry.key = getKey(element);
+        if (pendingKeys.find(entry.key) != pendingKeys.end()) {
+            // a repeated key refers to the interface registered by the earlier element
+            registerBatch();
+        }
+        bool exists{false};
+        switch (sectionType) {
+            case value_section::publications:
+                entry.pub = &vfm.getPublication(entry.key);
+                exists = entry.pub->isValid();
+                break;
+            case value_section::subscriptions:
+                entry.inp = &vfm.getSubscription(entry.key);
+                exists = entry.inp->isValid();
+                break;
+            case value_section::inputs:
+                entry.inp = &vfm.getInput(entry.key);
+                exists = entry.inp->isValid();
+                break;
+        }
+        if (!exists) {
+            InterfaceDefinition def;
+            def.kind = (sectionType == value_section::publications) ? interface_kind::publication :
+                                                                      interface_kind::input;
+            def.type = getOrDefault(element, "type", emptyStr);
+            def.units = getOrDefault(element, "unit", emptyStr);
+            replaceIfMember(element, "units", def.units);
+            if (sectionType != value_section::subscriptions) {
+                bool global = getOrDefault(element, "global", defaultGlobal);
+                def.key = (global || entry.key.empty()) ? entry.key : prefix + entry.key;
+            }
+            entry.pub = nullptr;
+            entry.inp = nullptr;
+            entry.definition = static_cast<int>(definitions.size());
+            definitions.push_back(std::move(def));
+            pendingKeys.insert(entry.key);
+        }
+        batch.push_back(std::move(entry));
+        if (batch.size() >= configBatchSize) {
+            registerBatch();
+        }
+    }
+    registerBatch();
+}
+
 void ValueFederate::registerValueInterfacesJson(const std::string& jsonString)
 {
     auto doc = loadJson(jsonString);
     bool defaultGlobal = false;
     replaceIfMember(doc, "defaultglobal", defaultGlobal);
+    const std::string prefix = getName() + nameSegmentSeparator;
     if (doc.isMember("publications")) {
-        auto pubs = doc["publications"];
-        for (const auto& pub : pubs) {
-            auto key = getKey(pub);
-
-            Publication* pubAct = &vfManager->getPublication(key);
-            if (!pubAct->isValid()) {
-                auto type = getOrDefault(pub, "type", emptyStr);
-                auto units = getOrDefault(pub, "unit", emptyStr);
-                replaceIfMember(pub, "units", units);
-                bool global = getOrDefault(pub, "global", defaultGlobal);
-                if (global) {
-                    pubAct = &registerGlobalPublication(key, type, units);
-                } else {
-                    pubAct = &registerPublication(key, type, units);
-                }
-            }
-
-            loadOptions(this, pub, *pubAct);
-        }
+        loadValueSection(this,
+                         *vfManager,
+                         doc["publications"],
+                         value_section::publications,
+                         prefix,
+                         defaultGlobal);
     }
     if (doc.isMember("subscriptions")) {
-        auto subs = doc["subscriptions"];
-        for (const auto& sub : subs) {
-            auto key = getKey(sub);
-            auto* subAct = &vfManager->getSubscription(key);
-            if (!subAct->isValid()) {
-                auto type = getOrDefault(sub, "type", emptyStr);
-                auto units = getOrDefault(sub, "unit", emptyStr);
-                replaceIfMember(sub, "units", units);
-                subAct = &registerInput(emptyStr, type, units);
-                subAct->addTarget(key);
-            }
-
-            loadOptions(this, sub, *subAct);
-        }
+        loadValueSection(this,
+                         *vfManager,
+                         doc["subscriptions"],
+                         value_section::subscriptions,
+                         prefix,
+                         defaultGlobal);
     }
     if (doc.isMember("inputs")) {
-        auto ipts = doc["inputs"];
-        for (const auto& ipt : ipts) {
-            auto key = getKey(ipt);
-
-            Input* inp = &vfManager->getInput(key);
-            if (!inp->isValid()) {
-                auto type = getOrDefault(ipt, "type", emptyStr);
-                auto units = getOrDefault(ipt, "unit", emptyStr);
-                replaceIfMember(ipt, "units", units);
-                bool global = getOrDefault(ipt, "global", defaultGlobal);
-                if (global) {
-                    inp = &registerGlobalInput(key, type, units);
-                } else {
-                    inp = &registerInput(key, type, units);
-                }
-            }
-
-            loadOptions(this, ipt, *inp);
-        }
+        loadValueSection(
+            this, *vfManager, doc["inputs"], value_section::inputs, prefix, defaultGlobal);
     }
 }
 
@@ -291,80 +386,43 @@ void ValueFederate::registerValueInterfacesToml(const std::string& tomlString)
     }
     bool defaultGlobal = false;
     replaceIfMember(doc, "defaultglobal", defaultGlobal);
+    const std::string prefix = getName() + nameSegmentSeparator;
 
     if (isMember(doc, "publications")) {
-        auto pubs = toml::find(doc, "publications");
+        const auto& pubs = toml::find(doc, "publications");
         if (!pubs.is_array()) {
             throw(helics::InvalidParameter("publications section in toml file must be an array"));
         }
-        auto& pubArray = pubs.as_array();
-        for (const auto& pub : pubArray) {
-            auto key = getKey(pub);
-
-            Publication* pubObj = &vfManager->getPublication(key);
-            if (!pubObj->isValid()) {
-                auto type = getOrDefault(pub, "type", emptyStr);
-                auto units = getOrDefault(pub, "unit", emptyStr);
-                replaceIfMember(pub, "units", units);
-                bool global = getOrDefault(pub, "global", defaultGlobal);
-                if (global) {
-                    pubObj = &registerGlobalPublication(key, type, units);
-                } else {
-                    pubObj = &registerPublication(key, type, units);
-                }
-            }
-            loadOptions(this, pub, *pubObj);
-        }
+        loadValueSection(this,
+                         *vfManager,
+                         pubs.as_array(),
+                         value_section::publications,
+                         prefix,
+                         defaultGlobal);
     }
     if (isMember(doc, "subscriptions")) {
-        auto subs = toml::find(doc, "subscriptions");
+        const auto& subs = toml::find(doc, "subscriptions");
         if (!subs.is_array()) {
             // this line is tested in the publications section so not really necessary to check
             // again since it is an expensive test
             throw(helics::InvalidParameter(
                 "subscriptions section in toml file must be an array"));  // LCOV_EXCL_LINE
         }
-        auto& subArray = subs.as_array();
-        for (const auto& sub : subArray) {
-            auto key = getKey(sub);
-            Input* id = &vfManager->getSubscription(key);
-            if (!id->isValid()) {
-                auto type = getOrDefault(sub, "type", emptyStr);
-                auto units = getOrDefault(sub, "unit", emptyStr);
-                replaceIfMember(sub, "units", units);
-
-                id = &registerInput(emptyStr, type, units);
-            }
-            id->addTarget(key);
-
-            loadOptions(this, sub, *id);
-        }
+        loadValueSection(this,
+                         *vfManager,
+                         subs.as_array(),
+                         value_section::subscriptions,
+                         prefix,
+                         defaultGlobal);
     }
     if (isMember(doc, "inputs")) {
-        auto ipts = toml::find(doc, "inputs");
+        const auto& ipts = toml::find(doc, "inputs");
         if (!ipts.is_array()) {
             throw(helics::InvalidParameter(
                 "inputs section in toml file must be an array"));  // LCOV_EXCL_LINE
         }
-        auto& iptArray = ipts.as_array();
-        for (const auto& ipt : iptArray) {
-            auto key = getKey(ipt);
-
-            Input* id = &vfManager->getInput(key);
-            if (!id->isValid()) {
-                auto type = getOrDefault(ipt, "type", emptyStr);
-                auto units = getOrDefault(ipt, "unit", emptyStr);
-                replaceIfMember(ipt, "units", units);
-                bool global = getOrDefault(ipt, "global", defaultGlobal);
-                if (global) {
-                    id = &registerGlobalInput(key, type, units);
-                } else {
-                    id = &registerInput(key, type, units);
-                }
-            }
-
-            loadOptions(this, ipt, *id);
-        }
+        loadValueSection(
+            this, *vfManager, ipts.as_array(), value_section::inputs, prefix, defaultGlobal);
     }
 }
 
@@ -393,6 +451,16 @@ void ValueFederate::publishRaw(const Publication& pub, data_view block)  // NOLI
     }
 }
 
+void ValueFederate::publishBuffer(const Publication& pub, std::string&& buffer)
+{
+    if ((currentMode == modes::executing) || (currentMode == modes::initializing)) {
+        vfManager->publish(pub, std::move(buffer));
+    } else {
+        throw(InvalidFunctionCall(
+            "publications not allowed outside of execution and initialization state"));
+    }
+}
+
 void ValueFederate::publish(Publication& pub, const std::string& str)
 {
     pub.publish(str);
@@ -502,6 +570,11 @@ void ValueFederate::initializeToExecuteStateTransition()
     vfManager->initializeToExecuteStateTransition();
 }
 
+void ValueFederate::checkpointRestored()
+{
+    vfManager->loadRestoredValues();
+}
+
 std::string ValueFederate::localQuery(const std::string& queryStr) const
 {
     return vfManager->localQuery(queryStr);
@@ -512,6 +585,11 @@ std::vector<int> ValueFederate::queryUpdates()
     return vfManager->queryUpdates();
 }
 
+const std::vector<int>& ValueFederate::queryLastUpdates() const
+{
+    return vfManager->queryLastUpdates();
+}
+
 const std::string& ValueFederate::getTarget(const Input& inp) const
 {
     return vfManager->getTarget(inp);
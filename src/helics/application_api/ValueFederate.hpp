@@ -451,6 +451,13 @@ class HELICS_CXX_EXPORT ValueFederate:
         publishRaw(pub, data_view{data, data_size});
     }
 
+    /** publish an encoded buffer transferring ownership of the buffer to the core
+    @param pub the publication identifier
+    @param buffer the encoded data
+    @throw invalid_argument if the publication id is invalid
+    */
+    void publishBuffer(const Publication& pub, std::string&& buffer);
+
     /** direct publish a string
    @param pub the publication to use
    @param str a string to publish
@@ -540,6 +547,7 @@ class HELICS_CXX_EXPORT ValueFederate:
     virtual void updateTime(Time newTime, Time oldTime) override;
     virtual void startupToInitializeStateTransition() override;
     virtual void initializeToExecuteStateTransition() override;
+    virtual void checkpointRestored() override;
     virtual std::string localQuery(const std::string& queryStr) const override;
 
   public:
@@ -548,6 +556,13 @@ class HELICS_CXX_EXPORT ValueFederate:
     */
     std::vector<int> queryUpdates();
 
+    /** get the indices of the inputs updated by the most recent time request
+    @details unlike queryUpdates this does not search all the inputs, the list is generated when
+    the time is granted and does not change as values are retrieved
+    @return a reference to a vector of input indices which is valid until the next time request
+    */
+    const std::vector<int>& queryLastUpdates() const;
+
     /** get the name of the first target for an input
     @return empty string if an invalid input is passed or it has no target*/
     const std::string& getTarget(const Input& inp) const;
@@ -9,13 +9,18 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../common/JsonBuilder.hpp"
 #include "../core/core-exceptions.hpp"
 #include "../core/queryHelpers.hpp"
+#include "CallbackDispatcher.hpp"
 #include "Inputs.hpp"
 #include "Publications.hpp"
 
 #include <utility>
 namespace helics {
-ValueFederateManager::ValueFederateManager(Core* coreOb, ValueFederate* vfed, local_federate_id id):
-    coreObject(coreOb), fed(vfed), fedID(id)
+ValueFederateManager::ValueFederateManager(Core* coreOb,
+                                           ValueFederate* vfed,
+                                           local_federate_id id,
+                                           CallbackDispatcher* dispatch):
+    coreObject(coreOb),
+    fed(vfed), fedID(id), dispatcher(dispatch)
 {
 }
 ValueFederateManager::~ValueFederateManager() = default;
@@ -96,6 +101,63 @@ Input& ValueFederateManager::registerInput(const std::string& key,
     throw(RegistrationFailure("Unable to register Input"));
 }
 
+std::vector<Publication*>
+    ValueFederateManager::registerPublications(const std::vector<InterfaceDefinition>& definitions)
+{
+    auto coreIDs = coreObject->registerInterfaces(fedID, definitions);
+    std::vector<Publication*> pubs;
+    pubs.reserve(coreIDs.size());
+    auto pubHandle = publications.lock();
+    for (std::size_t ii = 0; ii < coreIDs.size(); ++ii) {
+        const auto& def = definitions[ii];
+        auto coreID = coreIDs[ii];
+        decltype(pubHandle->insert(def.key, coreID, fed, coreID, def.key, def.type, def.units))
+            active;
+        if (!def.key.empty()) {
+            active = pubHandle->insert(def.key, coreID, fed, coreID, def.key, def.type, def.units);
+        } else {
+            active =
+                pubHandle->insert(no_search, coreID, fed, coreID, def.key, def.type, def.units);
+        }
+        if (!active) {
+            throw(RegistrationFailure("Unable to register Publication"));
+        }
+        pubs.push_back(&pubHandle->back());
+    }
+    return pubs;
+}
+
+std::vector<Input*>
+    ValueFederateManager::registerInputs(const std::vector<InterfaceDefinition>& definitions)
+{
+    auto coreIDs = coreObject->registerInterfaces(fedID, definitions);
+    std::vector<Input*> inps;
+    inps.reserve(coreIDs.size());
+    auto inpHandle = inputs.lock();
+    auto datHandle = inputData.lock();
+    for (std::size_t ii = 0; ii < coreIDs.size(); ++ii) {
+        const auto& def = definitions[ii];
+        auto coreID = coreIDs[ii];
+        decltype(inpHandle->insert(def.key, coreID, fed, coreID, def.key, def.units)) active;
+        if (!def.key.empty()) {
+            active = inpHandle->insert(def.key, coreID, fed, coreID, def.key, def.units);
+        } else {
+            active = inpHandle->insert(no_search, coreID, fed, coreID, def.key, def.units);
+        }
+        if (!active) {
+            throw(RegistrationFailure("Unable to register Input"));
+        }
+        auto& ref = inpHandle->back();
+        auto edat = std::make_unique<input_info>(def.key, def.type, def.units);
+        // non-owning pointer
+        ref.dataReference = edat.get();
+        datHandle->push_back(std::move(edat));
+        ref.referenceIndex = static_cast<int>(datHandle->size() - 1);
+        inps.push_back(&ref);
+    }
+    return inps;
+}
+
 void ValueFederateManager::addAlias(const Input& inp, const std::string& shortcutName)
 {
     if (inp.isValid()) {
@@ -212,6 +274,11 @@ void ValueFederateManager::publish(const Publication& pub, const data_view& bloc
     coreObject->setValue(pub.handle, block.data(), block.size());
 }
 
+void ValueFederateManager::publish(const Publication& pub, std::string&& buffer)
+{
+    coreObject->setValue(pub.handle, std::move(buffer));
+}
+
 bool ValueFederateManager::hasUpdate(const Input& inp)
 {
     auto* iData = static_cast<input_info*>(inp.dataReference);
@@ -233,53 +300,69 @@ Time ValueFederateManager::getLastUpdateTime(const Input& inp)
 void ValueFederateManager::updateTime(Time newTime, Time /*oldTime*/)
 {
     CurrentTime = newTime;
-    auto handles = coreObject->getValueUpdates(fedID);
-    if (handles.empty()) {
+    lastUpdates.clear();
+    const auto& updates = coreObject->getInputUpdates(fedID);
+    if (updates.empty()) {
         return;
     }
-    // lock the data updates
-    auto inpHandle = inputs.lock();
     auto allCall = allCallback.load();
-    for (auto handle : handles) {
-        /** find the id*/
-        auto fid = inpHandle->find(handle);
-        if (fid != inpHandle->end()) {  // assign the data
+    std::vector<Input*> callbackInputs;
+    {
+        // lock the data updates once for all the inputs
+        auto inpHandle = inputs.lock();
+        for (const auto& update : updates) {
+            /** find the id*/
+            auto fid = inpHandle->find(update.handle);
+            if (fid == inpHandle->end()) {
+                continue;
+            }
+            // assign the data
             auto* iData = static_cast<input_info*>(fid->dataReference);
             iData->lastUpdate = CurrentTime;
 
             bool updated = false;
             if (fid->getMultiInputMode() == multi_input_handling_method::no_op) {
-                const auto& data = coreObject->getValue(handle);
-                iData->lastData = data;
+                iData->lastData = *update.data;
                 iData->hasUpdate = true;
                 updated = fid->checkUpdate(true);
             } else {
-                const auto& dataV = coreObject->getAllValues(handle);
                 iData->hasUpdate = false;
-                updated = fid->vectorDataProcess(dataV);
+                updated = fid->vectorDataProcess(*update.allData);
             }
 
             if (updated) {
-                if (iData->callback) {
-                    Input& inp = *fid;
-
-                    inpHandle.unlock();  // need to free the lock
-
-                    // callbacks can do all sorts of things, best not to have it locked during the
-                    // callback
-                    iData->callback(inp, CurrentTime);
-                    inpHandle = inputs.lock();
-                } else if (allCall) {
-                    Input& inp = *fid;
-                    inpHandle.unlock();  // need to free the lock
-                    // callbacks can do all sorts of strange things, best not to have it locked
-                    // during the callback
-                    allCall(inp, CurrentTime);
-                    inpHandle = inputs.lock();
+                lastUpdates.push_back(fid->referenceIndex);
+                if ((iData->callback) || (allCall)) {
+                    callbackInputs.push_back(&(*fid));
                 }
             }
         }
     }
+    // callbacks can do all sorts of things, best not to have the inputs locked during them
+    if ((dispatcher != nullptr) && (dispatcher->isParallel()) && (callbackInputs.size() > 1)) {
+        // each input is updated once per time step so the ordering per input is always preserved
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(callbackInputs.size());
+        auto time = CurrentTime;
+        for (auto* inp : callbackInputs) {
+            auto* iData = static_cast<input_info*>(inp->dataReference);
+            if (iData->callback) {
+                tasks.emplace_back([inp, iData, time]() { iData->callback(*inp, time); });
+            } else {
+                tasks.emplace_back([inp, &allCall, time]() { allCall(*inp, time); });
+            }
+        }
+        dispatcher->run(tasks);
+        return;
+    }
+    for (auto* inp : callbackInputs) {
+        auto* iData = static_cast<input_info*>(inp->dataReference);
+        if (iData->callback) {
+            iData->callback(*inp, CurrentTime);
+        } else {
+            allCall(*inp, CurrentTime);
+        }
+    }
 }
 
 void ValueFederateManager::startupToInitializeStateTransition()
@@ -294,6 +377,23 @@ void ValueFederateManager::initializeToExecuteStateTransition()
     updateTime(0.0, 0.0);
 }
 
+void ValueFederateManager::loadRestoredValues()
+{
+    auto inpHandle = inputs.lock();
+    for (auto& inp : *inpHandle) {
+        const auto& data = coreObject->getValue(inp.handle);
+        if (!data) {
+            continue;
+        }
+        auto* iData = static_cast<input_info*>(inp.dataReference);
+        iData->lastData = data_view(data);
+        iData->hasUpdate = true;
+        // reading the value loads the cached value in the input and clears the update flags
+        auto restored = inp.lastValue;
+        mpark::visit([&inp](auto& val) { inp.getValue(val); }, restored);
+    }
+}
+
 std::string ValueFederateManager::localQuery(const std::string& queryStr) const
 {
     std::string ret;
@@ -385,6 +485,11 @@ std::vector<int> ValueFederateManager::queryUpdates()
     return updates;
 }
 
+const std::vector<int>& ValueFederateManager::queryLastUpdates() const
+{
+    return lastUpdates;
+}
+
 static const std::string emptyStr;
 
 const std::string& ValueFederateManager::getTarget(const Input& inp) const
@@ -7,6 +7,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 
 #include "../common/GuardedTypes.hpp"
+#include "../core/Core.hpp"
 #include "../core/federate_id.hpp"
 #include "Inputs.hpp"
 #include "Publications.hpp"
@@ -23,6 +24,7 @@ namespace helics {
 /** forward declaration of Core*/
 class Core;
 class ValueFederate;
+class CallbackDispatcher;
 
 /** structure used to contain information about a publication*/
 struct publication_info {
@@ -65,7 +67,10 @@ struct input_info {
 /** class handling the implementation details of a value Federate*/
 class ValueFederateManager {
   public:
-    ValueFederateManager(Core* coreOb, ValueFederate* vfed, local_federate_id id);
+    ValueFederateManager(Core* coreOb,
+                         ValueFederate* vfed,
+                         local_federate_id id,
+                         CallbackDispatcher* dispatch = nullptr);
     ~ValueFederateManager();
 
     Publication& registerPublication(const std::string& key,
@@ -75,6 +80,15 @@ class ValueFederateManager {
     @details call is only valid in startup mode
     */
     Input& registerInput(const std::string& key, const std::string& type, const std::string& units);
+    /** register a set of publications through a single call to the core
+    @param definitions the definitions of the publications with the complete keys
+    @return pointers to the new publications in the order of the definitions*/
+    std::vector<Publication*>
+        registerPublications(const std::vector<InterfaceDefinition>& definitions);
+    /** register a set of inputs through a single call to the core
+    @param definitions the definitions of the inputs with the complete keys
+    @return pointers to the new inputs in the order of the definitions*/
+    std::vector<Input*> registerInputs(const std::vector<InterfaceDefinition>& definitions);
 
     /** add a shortcut for locating a subscription
     @details primarily for use in looking up an id from a different location
@@ -128,6 +142,8 @@ class ValueFederateManager {
 
     /** publish a value*/
     void publish(const Publication& pub, const data_view& block);
+    /** publish an encoded buffer,  the buffer is moved into the core*/
+    void publish(const Publication& pub, std::string&& buffer);
 
     /** check if a given subscription has and update*/
     static bool hasUpdate(const Input& inp);
@@ -143,6 +159,9 @@ class ValueFederateManager {
     void startupToInitializeStateTransition();
     /** transition from initialize to execution State*/
     void initializeToExecuteStateTransition();
+    /** load the input values restored from a checkpoint into the inputs without marking them as
+     * updated*/
+    void loadRestoredValues();
     /** generate results for a local query */
     std::string localQuery(const std::string& queryStr) const;
     /** get a list of all the values that have been updated since the last call
@@ -150,6 +169,10 @@ class ValueFederateManager {
     updated
     */
     std::vector<int> queryUpdates();
+    /** get the indices of the inputs updated by the most recent time request
+    @details the list is generated when the time is granted so no search of the inputs is needed,
+    it is replaced on the next time request*/
+    const std::vector<int>& queryLastUpdates() const;
 
     /** get the target of a input*/
     const std::string& getTarget(const Input& inp) const;
@@ -215,10 +238,12 @@ class ValueFederateManager {
                                                         reference_stability::stable>>
         publications;
     Time CurrentTime = Time(-1.0);  //!< the current simulation time
+    std::vector<int> lastUpdates;  //!< indices of the inputs updated by the last time request
     Core* coreObject;  //!< the pointer to the actual core
     ValueFederate*
         fed;  //!< pointer back to the value Federate for creation of the Publication/Inputs
     local_federate_id fedID;  //!< the federation ID from the core API
+    CallbackDispatcher* dispatcher{nullptr};  //!< runner for the callbacks
     atomic_guarded<std::function<void(Input&, Time)>>
         allCallback;  //!< the global callback function
     shared_guarded<std::vector<std::unique_ptr<input_info>>>
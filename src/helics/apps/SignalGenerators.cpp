@@ -7,7 +7,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "SignalGenerators.hpp"
 
 #include <cmath>
+#include <initializer_list>
 #include <string>
+#include <vector>
 
 constexpr double pi = 3.14159265358979323846;
 
@@ -129,5 +131,163 @@ namespace apps {
         lastTime = signalTime;
         return amplitude * state + std::complex<double>(bias_real, bias_imag);
     }
+
+    void BulkParameter::set(const std::vector<double>& vals, int channels)
+    {
+        values = vals;
+        values.resize(channels, defaultValue);
+    }
+
+    void BulkRampGenerator::set(const std::string& parameter, double val)
+    {
+        if (parameter == "level") {
+            rebase();
+            level.set(val, channels);
+        } else if (parameter == "ramp") {
+            rebase();
+            ramp.set(val, channels);
+        } else {
+            BulkSignalGenerator::set(parameter, val);
+        }
+    }
+
+    void BulkRampGenerator::setChannels(const std::string& parameter,
+                                        const std::vector<double>& vals)
+    {
+        if (static_cast<int>(vals.size()) > channels) {
+            setChannelCount(static_cast<int>(vals.size()));
+        }
+        if (parameter == "level") {
+            rebase();
+            level.set(vals, channels);
+        } else if (parameter == "ramp") {
+            rebase();
+            ramp.set(vals, channels);
+        } else {
+            BulkSignalGenerator::setChannels(parameter, vals);
+        }
+    }
+
+    void BulkRampGenerator::setChannelCount(int channelCount)
+    {
+        level.resize(channelCount);
+        ramp.resize(channelCount);
+        channels = channelCount;
+    }
+
+    void BulkRampGenerator::rebase()
+    {
+        if (lastTime > keyTime) {
+            const double dt = lastTime - keyTime;
+            double* lvl = level.data();
+            const double* rmp = ramp.data();
+            for (int ii = 0; ii < channels; ++ii) {
+                lvl[ii] += rmp[ii] * dt;
+            }
+            keyTime = lastTime;
+        }
+    }
+
+    void BulkRampGenerator::generate(Time signalTime, double* values)
+    {
+        const double dt = signalTime - keyTime;
+        const double* lvl = level.data();
+        const double* rmp = ramp.data();
+        for (int ii = 0; ii < channels; ++ii) {
+            values[ii] = lvl[ii] + rmp[ii] * dt;
+        }
+        lastTime = signalTime;
+    }
+
+    BulkParameter* BulkSineGenerator::getParameter(const std::string& parameter)
+    {
+        if ((parameter == "frequency") || (parameter == "freq") || (parameter == "f")) {
+            return &frequency;
+        }
+        if (parameter == "dfdt") {
+            return &dfdt;
+        }
+        if (parameter == "dadt") {
+            return &dAdt;
+        }
+        if ((parameter == "amplitude") || (parameter == "amp") || (parameter == "a")) {
+            return &amplitude;
+        }
+        if (parameter == "level") {
+            return &level;
+        }
+        if (parameter == "offset") {
+            return &offset;
+        }
+        return nullptr;
+    }
+
+    void BulkSineGenerator::set(const std::string& parameter, double val)
+    {
+        if (parameter == "period") {
+            frequency.set(1.0 / val, channels);
+            return;
+        }
+        auto* param = getParameter(parameter);
+        if (param != nullptr) {
+            param->set(val, channels);
+        } else {
+            BulkSignalGenerator::set(parameter, val);
+        }
+    }
+
+    void BulkSineGenerator::setChannels(const std::string& parameter,
+                                        const std::vector<double>& vals)
+    {
+        if (static_cast<int>(vals.size()) > channels) {
+            setChannelCount(static_cast<int>(vals.size()));
+        }
+        if (parameter == "period") {
+            std::vector<double> freqs(vals.size());
+            for (std::size_t ii = 0; ii < vals.size(); ++ii) {
+                freqs[ii] = 1.0 / vals[ii];
+            }
+            frequency.set(freqs, channels);
+            return;
+        }
+        auto* param = getParameter(parameter);
+        if (param != nullptr) {
+            param->set(vals, channels);
+        } else {
+            BulkSignalGenerator::setChannels(parameter, vals);
+        }
+    }
+
+    void BulkSineGenerator::setChannelCount(int channelCount)
+    {
+        for (auto* param : {&level, &frequency, &offset, &amplitude, &dAdt, &dfdt, &phase}) {
+            param->resize(channelCount);
+        }
+        channels = channelCount;
+    }
+
+    void BulkSineGenerator::generate(Time signalTime, double* values)
+    {
+        constexpr double twoPi = 2.0 * pi;
+        const double dt = signalTime - lastTime;
+        double* freq = frequency.data();
+        double* amp = amplitude.data();
+        double* ph = phase.data();
+        const double* lvl = level.data();
+        const double* off = offset.data();
+        const double* df = dfdt.data();
+        const double* da = dAdt.data();
+        // account for the frequency and amplitude shift and advance the phase
+        for (int ii = 0; ii < channels; ++ii) {
+            freq[ii] += df[ii] * dt;
+            amp[ii] += da[ii] * dt;
+            ph[ii] += twoPi * freq[ii] * dt;
+            ph[ii] -= twoPi * std::floor(ph[ii] / twoPi);
+        }
+        for (int ii = 0; ii < channels; ++ii) {
+            values[ii] = lvl[ii] + amp[ii] * std::sin(ph[ii] + off[ii]);
+        }
+        lastTime = signalTime;
+    }
 }  // namespace apps
 }  // namespace helics
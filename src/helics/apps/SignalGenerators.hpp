@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include <complex>
 #include <string>
+#include <vector>
 
 namespace helics {
 namespace apps {
@@ -69,5 +70,68 @@ namespace apps {
         virtual void setString(const std::string& parameter, const std::string& val) override;
         virtual defV generate(Time signalTime) override;
     };
+
+    /** storage for a parameter of a bulk generator with a value for each channel*/
+    class BulkParameter {
+      public:
+        explicit BulkParameter(double defVal = 0.0): defaultValue(defVal) {}
+        /** set the value for all channels*/
+        void set(double val, int channels)
+        {
+            defaultValue = val;
+            values.assign(channels, val);
+        }
+        /** set the values of the channels individually*/
+        void set(const std::vector<double>& vals, int channels);
+        /** change the number of channels,  new channels get the last value set for all channels*/
+        void resize(int channels) { values.resize(channels, defaultValue); }
+        const double* data() const { return values.data(); }
+        double* data() { return values.data(); }
+
+      private:
+        double defaultValue;
+        std::vector<double> values;
+    };
+
+    /** generate a ramp function on each channel*/
+    class BulkRampGenerator: public BulkSignalGenerator {
+      private:
+        BulkParameter level;  //!< the starting level of the ramps
+        BulkParameter ramp;  //!< the ramp rates in X/sec
+
+      public:
+        virtual void set(const std::string& parameter, double val) override;
+        virtual void setChannels(const std::string& parameter,
+                                 const std::vector<double>& vals) override;
+        virtual void setChannelCount(int channelCount) override;
+        virtual void generate(Time signalTime, double* values) override;
+
+      private:
+        /** move the key time to the last generation time keeping the ramps continuous*/
+        void rebase();
+    };
+
+    /** generate a sinusoidal signal on each channel*/
+    class BulkSineGenerator: public BulkSignalGenerator {
+      private:
+        BulkParameter level;  //!< the dc level of the sinusoids
+        BulkParameter frequency;  //!< the oscillation rate of the sinusoids
+        BulkParameter offset;  //!< the phase offset of the sinusoids
+        BulkParameter amplitude;  //!< the peak amplitude of the sinusoids
+        BulkParameter dAdt;  //!< the rate of change of the amplitudes
+        BulkParameter dfdt;  //!< the rate of change of the frequencies
+        BulkParameter phase;  //!< the accumulated phase of each sinusoid
+
+      public:
+        virtual void set(const std::string& parameter, double val) override;
+        virtual void setChannels(const std::string& parameter,
+                                 const std::vector<double>& vals) override;
+        virtual void setChannelCount(int channelCount) override;
+        virtual void generate(Time signalTime, double* values) override;
+
+      private:
+        /** get the parameter referenced by name or nullptr if not a recognized parameter*/
+        BulkParameter* getParameter(const std::string& parameter);
+    };
 }  // namespace apps
 }  // namespace helics
@@ -31,6 +31,12 @@ namespace apps {
     /** set a string parameter*/
     void SignalGenerator::setString(const std::string& /*parameter*/, const std::string& /*val*/) {}
 
+    void BulkSignalGenerator::set(const std::string& /*parameter*/, double /*val*/) {}
+    void BulkSignalGenerator::setChannels(const std::string& /*parameter*/,
+                                          const std::vector<double>& /*vals*/)
+    {
+    }
+
     Source::Source(int argc, char* argv[]): App("source", argc, argv) { processArgs(); }
 
     Source::Source(std::vector<std::string> args): App("source", std::move(args)) { processArgs(); }
@@ -144,6 +150,56 @@ namespace apps {
                 }
             }
         }
+        if (doc.isMember("bulk_generators")) {
+            auto genArray = doc["bulk_generators"];
+            for (const auto& genElement : genArray) {
+                auto key = getKey(genElement);
+                auto type = genElement["type"];
+                if (type.isNull()) {
+                    std::cout << "bulk generator " << key << " does not specify a type\n";
+                    continue;
+                }
+                auto index = addBulkSignalGenerator(key,
+                                                    type.asString(),
+                                                    genElement.get("channels", 0).asInt());
+                auto* gen = bulkGenerators[index].get();
+                auto mnames = genElement.getMemberNames();
+                for (auto& el : mnames) {
+                    if ((el == "type") || (el == "name") || (el == "key") || (el == "channels")) {
+                        continue;
+                    }
+                    const auto& prop = genElement[el];
+                    if (prop.isArray()) {
+                        std::vector<double> vals;
+                        vals.reserve(prop.size());
+                        for (const auto& val : prop) {
+                            vals.push_back(val.asDouble());
+                        }
+                        gen->setChannels(el, vals);
+                    } else if (prop.isNumeric()) {
+                        gen->set(el, prop.asDouble());
+                    }
+                }
+            }
+        }
+        if (doc.isMember("bulk_publications")) {
+            auto pubArray = doc["bulk_publications"];
+            for (const auto& pubElement : pubArray) {
+                auto key = getKey(pubElement);
+                auto period = (pubElement.isMember("period")) ?
+                    loadJsonTime(pubElement["period"]) :
+                    defaultPeriod;
+                addBulkPublication(key,
+                                   pubElement.get("generator", "").asString(),
+                                   pubElement.get("channels", 0).asInt(),
+                                   period,
+                                   pubElement.get("vector", true).asBool(),
+                                   pubElement.get("units", "").asString());
+                if (pubElement.isMember("start")) {
+                    setStartTime(key, loadJsonTime(pubElement["start"]));
+                }
+            }
+        }
         if (doc.isMember("generators")) {
             auto genArray = doc["generators"];
             for (const auto& genElement : genArray) {
@@ -213,6 +269,38 @@ namespace apps {
             }
         }
 
+        for (auto& bulk : bulkSources) {
+            if (bulk.generatorIndex < 0) {
+                auto fnd = bulkGeneratorLookup.find(bulk.generatorName);
+                if (fnd != bulkGeneratorLookup.end()) {
+                    bulk.generatorIndex = fnd->second;
+                } else {
+                    std::cout << "unable to link to bulk signal generator " << bulk.generatorName
+                              << std::endl;
+                    bulk.nextTime = Time::maxVal();
+                    continue;
+                }
+            }
+            auto& gen = bulkGenerators[bulk.generatorIndex];
+            if (!gen) {
+                std::cerr << "invalid bulk generator for " << bulk.generatorName
+                          << " disabling output\n";
+                bulk.nextTime = Time::maxVal();
+                continue;
+            }
+            if (gen->getChannelCount() < bulk.channels) {
+                gen->setChannelCount(bulk.channels);
+            }
+        }
+        // generators may be shared so size the buffers only after all channel counts are set
+        for (auto& bulk : bulkSources) {
+            if (bulk.generatorIndex >= 0 &&
+                bulk.generatorIndex < static_cast<int>(bulkGenerators.size()) &&
+                bulkGenerators[bulk.generatorIndex]) {
+                bulk.values.resize(bulkGenerators[bulk.generatorIndex]->getChannelCount());
+            }
+        }
+
         fed->enterInitializingMode();
     }
 
@@ -241,6 +329,11 @@ namespace apps {
                     nextRequestTime = src.nextTime;
                 }
             }
+            for (auto& bulk : bulkSources) {
+                if (bulk.nextTime < nextRequestTime) {
+                    nextRequestTime = bulk.nextTime;
+                }
+            }
         }
         helics::Time nextPrintTime = currentTime + 10.0;
         while ((nextRequestTime < Time::maxVal()) && (nextRequestTime <= stopTime_input)) {
@@ -260,7 +353,7 @@ namespace apps {
                                 const std::string& units)
     {
         // skip already existing publications
-        if (pubids.find(key) != pubids.end()) {
+        if ((pubids.find(key) != pubids.end()) || (bulkids.find(key) != bulkids.end())) {
             std::cerr << "publication already exists\n";
             return;
         }
@@ -306,12 +399,79 @@ namespace apps {
         return nullptr;
     }
 
+    int Source::addBulkSignalGenerator(const std::string& name,
+                                       const std::string& type,
+                                       int channelCount)
+    {
+        std::shared_ptr<BulkSignalGenerator> gen;
+        if (type == "sine") {
+            gen = std::make_shared<BulkSineGenerator>();
+        } else if (type == "ramp") {
+            gen = std::make_shared<BulkRampGenerator>();
+        } else {
+            throw(InvalidParameter(type + " is not a valid bulk generator type"));
+        }
+        gen->setChannelCount(channelCount);
+        bulkGenerators.push_back(std::move(gen));
+        auto index = static_cast<int>(bulkGenerators.size() - 1);
+        bulkGeneratorLookup.emplace(name, index);
+        return index;
+    }
+
+    std::shared_ptr<BulkSignalGenerator> Source::getBulkGenerator(int index)
+    {
+        if (index >= 0 && index < static_cast<int>(bulkGenerators.size())) {
+            return bulkGenerators[index];
+        }
+        return nullptr;
+    }
+
+    void Source::addBulkPublication(const std::string& key,
+                                    const std::string& generator,
+                                    int channelCount,
+                                    Time period,
+                                    bool vectorOutput,
+                                    const std::string& units)
+    {
+        if ((pubids.find(key) != pubids.end()) || (bulkids.find(key) != bulkids.end())) {
+            std::cerr << "publication already exists\n";
+            return;
+        }
+        auto visibility = useLocal ? interface_visibility::local : interface_visibility::global;
+        BulkSourceObject newObj(channelCount, period, vectorOutput);
+        if (vectorOutput) {
+            newObj.pubs.emplace_back(
+                visibility, fed, key, typeNameStringRef(data_type::helics_vector), units);
+        } else {
+            newObj.pubs.reserve(channelCount);
+            for (int ii = 0; ii < channelCount; ++ii) {
+                newObj.pubs.emplace_back(visibility,
+                                         fed,
+                                         key + '_' + std::to_string(ii),
+                                         typeNameStringRef(data_type::helics_double),
+                                         units);
+            }
+        }
+        newObj.generatorName = generator;
+        auto res = bulkGeneratorLookup.find(generator);
+        if (res != bulkGeneratorLookup.end()) {
+            newObj.generatorIndex = res->second;
+        }
+        bulkSources.push_back(std::move(newObj));
+        bulkids[key] = static_cast<int>(bulkSources.size()) - 1;
+    }
+
     /** set the start time for a publication */
     void Source::setStartTime(const std::string& key, Time startTime)
     {
         auto fnd = pubids.find(key);
         if (fnd != pubids.end()) {
             sources[fnd->second].nextTime = startTime;
+            return;
+        }
+        auto fndBulk = bulkids.find(key);
+        if (fndBulk != bulkids.end()) {
+            bulkSources[fndBulk->second].nextTime = startTime;
         }
     }
     /** set the start time for a publication */
@@ -320,6 +480,11 @@ namespace apps {
         auto fnd = pubids.find(key);
         if (fnd != pubids.end()) {
             sources[fnd->second].period = period;
+            return;
+        }
+        auto fndBulk = bulkids.find(key);
+        if (fndBulk != bulkids.end()) {
+            bulkSources[fndBulk->second].period = period;
         }
     }
 
@@ -367,6 +532,38 @@ namespace apps {
         return obj.nextTime;
     }
 
+    Time Source::runBulkSource(BulkSourceObject& obj, Time currentTime)
+    {
+        if (currentTime >= obj.nextTime) {
+            if (obj.generatorIndex < 0 ||
+                obj.generatorIndex >= static_cast<int>(bulkGenerators.size())) {
+                return Time::maxVal();
+            }
+            auto& gen = bulkGenerators[obj.generatorIndex];
+            if (!gen) {
+                return Time::maxVal();
+            }
+            if (obj.values.size() < static_cast<size_t>(gen->getChannelCount())) {
+                obj.values.resize(gen->getChannelCount());
+            }
+            gen->generate(currentTime, obj.values.data());
+            if (obj.vectorOutput) {
+                obj.pubs.front().publish(obj.values.data(), obj.channels);
+            } else {
+                const auto* vals = obj.values.data();
+                for (auto& pub : obj.pubs) {
+                    pub.publish(*vals++);
+                }
+            }
+            obj.nextTime += obj.period;
+            if (obj.nextTime < currentTime) {
+                auto periods = std::floor((currentTime - obj.nextTime) / obj.period);
+                obj.nextTime += periods * obj.period + obj.period;
+            }
+        }
+        return obj.nextTime;
+    }
+
     Time Source::runSourceLoop(Time currentTime)
     {
         if (currentTime < timeZero) {
@@ -376,6 +573,12 @@ namespace apps {
                     src.nextTime = timeZero;
                 }
             }
+            for (auto& bulk : bulkSources) {
+                if (bulk.nextTime < timeZero) {
+                    runBulkSource(bulk, currentTime);
+                    bulk.nextTime = timeZero;
+                }
+            }
             return timeZero;
         }
         Time minTime = Time::maxVal();
@@ -385,6 +588,12 @@ namespace apps {
                 minTime = tm;
             }
         }
+        for (auto& bulk : bulkSources) {
+            auto tm = runBulkSource(bulk, currentTime);
+            if (tm < minTime) {
+                minTime = tm;
+            }
+        }
         return minTime;
     }
 
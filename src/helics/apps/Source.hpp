@@ -31,6 +31,23 @@ namespace apps {
         // source type
     };
 
+    /** helper class for a group of publications driven by a single bulk signal generator*/
+    struct BulkSourceObject {
+        std::vector<Publication> pubs;  //!< a single vector publication or one per channel
+        std::vector<double> values;  //!< storage for the generated values of all channels
+        Time period;
+        Time nextTime{timeZero};
+        int channels{0};
+        int generatorIndex{-1};
+        std::string generatorName;
+        bool vectorOutput{true};  //!< publish all the channels as a single vector
+        BulkSourceObject() = default;
+        BulkSourceObject(int channelCount, Time per, bool vectorPub):
+            period(per), channels(channelCount), vectorOutput(vectorPub)
+        {
+        }
+    };
+
     /** parent class for a signal generator which generates values to feed into a helics
      * federation*/
     class HELICS_CXX_EXPORT SignalGenerator {
@@ -52,6 +69,35 @@ namespace apps {
         void setTime(Time indexTime) { keyTime = indexTime; }
     };
 
+    /** parent class for a signal generator producing values for many channels at once
+    @details the parameters of each channel are stored in contiguous arrays so a call to generate
+    is a single pass over the arrays for all the channels instead of a virtual call per value*/
+    class HELICS_CXX_EXPORT BulkSignalGenerator {
+      protected:
+        Time lastTime{timeZero};
+        Time keyTime{timeZero};
+        int channels{0};  //!< the number of channels generated
+
+      public:
+        BulkSignalGenerator() = default;
+        virtual ~BulkSignalGenerator() = default;
+        /** set a numerical parameter on all the channels*/
+        virtual void set(const std::string& parameter, double val);
+        /** set a numerical parameter with a separate value for each channel*/
+        virtual void setChannels(const std::string& parameter, const std::vector<double>& vals);
+        /** set the number of channels,  new channels use the last value set for all channels*/
+        virtual void setChannelCount(int channelCount) { channels = channelCount; }
+        /** get the number of channels*/
+        int getChannelCount() const { return channels; }
+        /** generate new values for all the channels at time signalTime
+    @param signalTime the time of the values
+    @param values an array to store the results in with space for all the channels
+    */
+        virtual void generate(Time signalTime, double* values) = 0;
+        /** set the key time*/
+        void setTime(Time indexTime) { keyTime = indexTime; }
+    };
+
     /** class implementing a source federate, which is capable of generating signals of various
 kinds and sending signals at the appropriate times
 @details  the source class is NOT threadsafe,  don't try to use it from multiple threads without
@@ -151,6 +197,33 @@ external protection, that will result in undefined behavior
         /** get a pointer to the signal generator*/
         std::shared_ptr<SignalGenerator> getGenerator(int index);
 
+        /** add a bulk signal generator to the source object
+    @param name the name of the generator
+    @param type the type of generator ("ramp" or "sine")
+    @param channelCount the number of channels to generate
+    @return an index for later reference of the bulk generator
+    */
+        int addBulkSignalGenerator(const std::string& name,
+                                   const std::string& type,
+                                   int channelCount = 0);
+        /** get a pointer to a bulk signal generator*/
+        std::shared_ptr<BulkSignalGenerator> getBulkGenerator(int index);
+        /** add a group of publications driven by a bulk signal generator
+    @param key the key of the vector publication or the prefix for the channel publications
+    @param generator the name of the bulk generator to link with
+    @param channelCount the number of channels in the group
+    @param period the period of the publications
+    @param vectorOutput set to true to publish the group as a single vector publication, false for
+    a double publication for each channel named key_index
+    @param units the units associated with the publications
+    */
+        void addBulkPublication(const std::string& key,
+                                const std::string& generator,
+                                int channelCount,
+                                Time period,
+                                bool vectorOutput = true,
+                                const std::string& units = std::string());
+
       private:
         /** process remaining command line arguments*/
         void processArgs();
@@ -160,6 +233,8 @@ external protection, that will result in undefined behavior
         virtual void loadJsonFile(const std::string& jsonString) override;
         /** execute a source object and update its time return the next execution time*/
         Time runSource(SourceObject& obj, Time currentTime);
+        /** execute a bulk source group and return its next execution time*/
+        Time runBulkSource(BulkSourceObject& obj, Time currentTime);
         /** execute all the sources*/
         Time runSourceLoop(Time currentTime);
 
@@ -169,6 +244,11 @@ external protection, that will result in undefined behavior
         std::map<std::string, int> generatorLookup;  //!< map of generator names to indices
         std::vector<Endpoint> endpoints;  //!< the actual endpoint objects
         std::map<std::string, int> pubids;  //!< publication id map
+        std::vector<BulkSourceObject> bulkSources;  //!< the bulk publication groups
+        std::vector<std::shared_ptr<BulkSignalGenerator>>
+            bulkGenerators;  //!< the bulk signal generators
+        std::map<std::string, int> bulkGeneratorLookup;  //!< map of bulk generator names to indices
+        std::map<std::string, int> bulkids;  //!< bulk group id map
         Time defaultPeriod = 1.0;  //!< the default period of publication
     };
 }  // namespace apps
@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "Tracer.hpp"
 
 #include "../application_api/Filters.hpp"
+#include "../application_api/HelicsPrimaryTypes.hpp"
 #include "../application_api/Subscriptions.hpp"
 #include "../application_api/ValueFederate.hpp"
 #include "../application_api/queryFunctions.hpp"
@@ -16,10 +17,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../core/helicsCLI11.hpp"
 #include "../core/helicsVersion.hpp"
 #include "PrecHelper.hpp"
+#include "gmlc/containers/BlockingQueue.hpp"
 #include "gmlc/utilities/stringOps.h"
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <regex>
@@ -27,11 +30,130 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 namespace helics {
 namespace apps {
+    /** class formatting and writing the text output of the Tracer on a separate thread
+    @details the Tracer thread collects the raw values and messages for each time step and hands
+    them off as a single block so the string conversion and formatting never delay the Tracer*/
+    class TracerOutput {
+      public:
+        explicit TracerOutput(bool useCout): skiplog(useCout)
+        {
+            writer = std::thread([this]() { writeLoop(); });
+        }
+        ~TracerOutput()
+        {
+            send();
+            outputBlock last;
+            last.halt = true;
+            queue.push(std::move(last));
+            writer.join();
+        }
+        TracerOutput(const TracerOutput&) = delete;
+        TracerOutput& operator=(const TracerOutput&) = delete;
+
+        /** register any subscriptions added since the last call*/
+        void addSubscriptions(const std::vector<Input>& subscriptions)
+        {
+            for (auto ii = subscriptionCount; ii < subscriptions.size(); ++ii) {
+                pending.subscriptions.emplace_back(
+                    subscriptions[ii].getTarget(),
+                    getTypeFromString(subscriptions[ii].getPublicationType()));
+            }
+            subscriptionCount = subscriptions.size();
+        }
+        void addValue(const TracedValue& value) { pending.values.push_back(value); }
+        void addMessage(Time time, bool cloned, std::unique_ptr<Message> message)
+        {
+            pending.messages.emplace_back(time, cloned, std::move(message));
+        }
+        /** send the collected output to the writer thread*/
+        void send()
+        {
+            if (!pending.values.empty() || !pending.messages.empty() ||
+                !pending.subscriptions.empty()) {
+                queue.push(std::move(pending));
+                pending = outputBlock{};
+            }
+        }
+
+      private:
+        struct outputBlock {
+            std::vector<std::pair<std::string, data_type>> subscriptions;
+            std::vector<TracedValue> values;
+            std::vector<std::tuple<Time, bool, std::unique_ptr<Message>>> messages;
+            bool halt{false};
+        };
+        const bool skiplog;
+        outputBlock pending;  //!< the output being collected,  used only by the Tracer thread
+        std::size_t subscriptionCount{0};  //!< the number of subscriptions already registered
+        gmlc::containers::BlockingQueue<outputBlock> queue;
+        std::thread writer;
+
+        void writeLoop()
+        {
+            std::vector<std::pair<std::string, data_type>> subscriptionInfo;
+            std::vector<std::string> lines;
+            std::string val;
+            while (true) {
+                auto block = queue.pop();
+                if (block.halt) {
+                    return;
+                }
+                std::move(block.subscriptions.begin(),
+                          block.subscriptions.end(),
+                          std::back_inserter(subscriptionInfo));
+                lines.clear();
+                for (const auto& value : block.values) {
+                    const auto& info = subscriptionInfo[value.index];
+                    valueExtract(value.value, info.second, val);
+                    std::string valstr = (val.size() < 150) ? val :
+                                                              fmt::format("block[{}]", val.size());
+                    if (value.iteration > 0) {
+                        lines.push_back(fmt::format(
+                            "[{}:{}]value {}={}", value.time, value.iteration, info.first, valstr));
+                    } else {
+                        lines.push_back(
+                            fmt::format("[{}]value {}={}", value.time, info.first, valstr));
+                    }
+                }
+                for (const auto& message : block.messages) {
+                    const auto& mess = std::get<2>(message);
+                    const auto& dest = (std::get<1>(message)) ? mess->original_dest : mess->dest;
+                    if (mess->data.size() < 50) {
+                        lines.push_back(fmt::format("[{}]message from {} to {}::{}",
+                                                    std::get<0>(message),
+                                                    mess->source,
+                                                    dest,
+                                                    mess->data.to_string()));
+                    } else {
+                        lines.push_back(fmt::format("[{}]message from {} to {}:: size {}",
+                                                    std::get<0>(message),
+                                                    mess->source,
+                                                    dest,
+                                                    mess->data.size()));
+                    }
+                }
+                if (skiplog) {
+                    std::string text;
+                    for (const auto& line : lines) {
+                        text.append(line);
+                        text.push_back('\n');
+                    }
+                    std::cout << text;
+                } else {
+                    for (const auto& line : lines) {
+                        spdlog::info(line);
+                    }
+                }
+            }
+        }
+    };
+
     Tracer::Tracer(const std::string& appName, FederateInfo& fi): App(appName, fi)
     {
         fed->setFlagOption(helics_flag_observer);
@@ -75,7 +197,15 @@ namespace apps {
         Tracer::loadJsonFile(file);
     }
 
-    Tracer::~Tracer() = default;
+    Tracer::~Tracer()
+    {
+        try {
+            flushBatch();
+        }
+        catch (...) {
+            // the callback should not throw out of the destructor
+        }
+    }
 
     void Tracer::loadJsonFile(const std::string& jsonString)
     {
@@ -239,6 +369,10 @@ namespace apps {
 
     void Tracer::captureForCurrentTime(Time currentTime, int iteration)
     {
+        if (batchMode) {
+            captureBatch(currentTime, iteration);
+            return;
+        }
         for (auto& sub : subscriptions) {
             if (sub.isUpdated()) {
                 auto val = sub.getValue<std::string>();
@@ -341,6 +475,94 @@ namespace apps {
         }
     }
 
+    TracerOutput& Tracer::batchOutput()
+    {
+        if (!output) {
+            output = std::make_unique<TracerOutput>(skiplog);
+        }
+        output->addSubscriptions(subscriptions);
+        return *output;
+    }
+
+    void Tracer::captureBatch(Time currentTime, int iteration)
+    {
+        TracerOutput* out = (printMessage) ? &batchOutput() : nullptr;
+        const auto subCount = static_cast<int>(subscriptions.size());
+        for (int ii = 0; ii < subCount; ++ii) {
+            auto& sub = subscriptions[ii];
+            if (sub.isUpdated()) {
+                TracedValue update{currentTime, iteration, ii, sub.getRawValue()};
+                if (out != nullptr) {
+                    out->addValue(update);
+                }
+                if (batchValueCallback) {
+                    valueBatch.push_back(std::move(update));
+                }
+            }
+        }
+        if (!valueBatch.empty() &&
+            (valueBatchSize <= 0 || static_cast<int>(valueBatch.size()) >= valueBatchSize)) {
+            flushBatch();
+        }
+
+        for (auto& ept : endpoints) {
+            while (ept.hasMessage()) {
+                auto mess = ept.getMessage();
+                if (out != nullptr) {
+                    if (endpointMessageCallback) {
+                        out->addMessage(currentTime, false, std::make_unique<Message>(*mess));
+                    } else {
+                        out->addMessage(currentTime, false, std::move(mess));
+                        continue;
+                    }
+                }
+                if (endpointMessageCallback) {
+                    endpointMessageCallback(currentTime, ept.getName(), std::move(mess));
+                }
+            }
+        }
+
+        if (cloneEndpoint) {
+            while (cloneEndpoint->hasMessage()) {
+                auto mess = cloneEndpoint->getMessage();
+                if (out != nullptr) {
+                    if (clonedMessageCallback) {
+                        out->addMessage(currentTime, true, std::make_unique<Message>(*mess));
+                    } else {
+                        out->addMessage(currentTime, true, std::move(mess));
+                        continue;
+                    }
+                }
+                if (clonedMessageCallback) {
+                    clonedMessageCallback(currentTime, std::move(mess));
+                }
+            }
+        }
+        if (out != nullptr) {
+            out->send();
+        }
+    }
+
+    void Tracer::flushBatch()
+    {
+        if (valueBatch.empty()) {
+            return;
+        }
+        if (batchValueCallback) {
+            batchValueCallback(valueBatch);
+        }
+        valueBatch.clear();
+    }
+
+    const std::string& Tracer::getSubscriptionTarget(int index) const
+    {
+        static const std::string emptyString;
+        if (index < 0 || index >= static_cast<int>(subscriptions.size())) {
+            return emptyString;
+        }
+        return subscriptions[index].getTarget();
+    }
+
     /** run the Player until the specified time*/
     void Tracer::runTo(Time runToTime)
     {
@@ -375,6 +597,7 @@ namespace apps {
                     captureForCurrentTime(T);
                 }
                 if (T >= runToTime) {
+                    flushBatch();
                     break;
                 }
                 if (T >= nextPrintTime) {
@@ -442,6 +665,14 @@ namespace apps {
             ->ignore_underscore();
         app->add_flag("--print", printMessage, "print messages to the screen");
         app->add_flag("--skiplog", skiplog, "print messages to the screen through cout");
+        app->add_flag("--batch",
+                      batchMode,
+                      "capture values as raw data and write any text output from a separate "
+                      "thread");
+        app->add_option("--batch_size",
+                        valueBatchSize,
+                        "the number of values delivered in each batch, 0 for each time step")
+            ->ignore_underscore();
         auto* clone_group = app->add_option_group(
             "cloning", "Options related to endpoint cloning operations and specifications");
         clone_group->add_option("--clone", "existing endpoints to clone all packets to and from")
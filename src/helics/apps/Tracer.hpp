@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../application_api/Endpoints.hpp"
 #include "../application_api/Subscriptions.hpp"
+#include "../application_api/data_view.hpp"
 #include "helicsApp.hpp"
 
 #include <functional>
@@ -21,6 +22,16 @@ namespace helics {
 class CloningFilter;
 
 namespace apps {
+    class TracerOutput;
+
+    /** a value update captured by the Tracer in batch mode*/
+    struct TracedValue {
+        Time time;  //!< the time the value was captured
+        int iteration{0};  //!< the iteration count at the time of capture
+        int index{0};  //!< the index of the subscription the value came from
+        data_view value;  //!< the raw data of the value
+    };
+
     /** class designed to capture data points from a set of subscriptions or endpoints*/
     class HELICS_CXX_EXPORT Tracer: public App {
       public:
@@ -98,6 +109,34 @@ namespace apps {
         {
             valueCallback = std::move(callback);
         }
+        /** set the callback for batches of values
+    @details setting the callback enables batch mode,  values are delivered as raw data views
+    along with the index of the subscription instead of being converted to strings
+    @param callback the function to call with each batch of values
+    @param batchSize the number of values to collect before calling the callback,  if <=0 the
+    callback is called once for each time step with updates
+    */
+        void setBatchValueCallback(std::function<void(const std::vector<TracedValue>&)> callback,
+                                   int batchSize = 0)
+        {
+            batchValueCallback = std::move(callback);
+            enableBatchMode(batchSize);
+        }
+        /** enable batch mode
+    @details in batch mode values are not converted to strings and any text output is formatted
+    and written by a separate thread
+    @param batchSize the number of values to collect in a batch, if <=0 a batch is delivered for
+    each time step with updates
+    */
+        void enableBatchMode(int batchSize = 0)
+        {
+            batchMode = true;
+            valueBatchSize = batchSize;
+        }
+        /** deliver any values waiting to complete a batch*/
+        void flushBatch();
+        /** get the target of the subscription at a particular index*/
+        const std::string& getSubscriptionTarget(int index) const;
         /** turn the screen display on for values and messages*/
         void enableTextOutput() { printMessage = true; }
         /** turn the screen display off for values and messages*/
@@ -114,6 +153,10 @@ namespace apps {
         virtual void initialize() override;
         void generateInterfaces();
         void captureForCurrentTime(Time currentTime, int iteration = 0);
+        /** capture the current values without any string conversion*/
+        void captureBatch(Time currentTime, int iteration);
+        /** get the output object for writing text in batch mode*/
+        TracerOutput& batchOutput();
         void loadCaptureInterfaces();
 
         /** build the command line argument processing application*/
@@ -126,6 +169,8 @@ namespace apps {
         bool allow_iteration =
             false;  //!< flag to allow iteration of the federate for time requests
         bool skiplog = false;  //!< skip the log function and print directly to cout
+        bool batchMode = false;  //!< deliver values in batches without string conversion
+        int valueBatchSize{0};  //!< the number of values in a batch, <=0 for one per time step
         std::unique_ptr<CloningFilter> cFilt;  //!< a pointer to a clone filter
 
         std::vector<Input> subscriptions;  //!< the actual subscription objects
@@ -140,6 +185,9 @@ namespace apps {
         std::function<void(Time, const std::string&, std::unique_ptr<Message>)>
             endpointMessageCallback;
         std::function<void(Time, const std::string&, const std::string&)> valueCallback;
+        std::function<void(const std::vector<TracedValue>&)> batchValueCallback;
+        std::vector<TracedValue> valueBatch;  //!< the values waiting to be delivered
+        std::unique_ptr<TracerOutput> output;  //!< the text output writer for batch mode
     };
 
 }  // namespace apps
@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "../core/ActionMessageDefintions.hpp"
+#include "../core/FlightRecorder.hpp"
+#include "../core/core-exceptions.hpp"
+#include "../core/helicsCLI11.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+/** accumulated statistics for a single action type*/
+struct actionStatistics {
+    uint64_t count{0};
+    uint64_t totalProcessing{0};
+    uint64_t maxProcessing{0};
+};
+
+static const char* actionName(int32_t action)
+{
+    return helics::actionMessageType(static_cast<helics::action_message_def::action_t>(action));
+}
+
+/** write the records as complete events in the chrome trace event format*/
+static bool writeChromeTrace(const std::string& fileName,
+                             const helics::FlightRecorder::FileContents& contents)
+{
+    std::ofstream out(fileName);
+    if (!out) {
+        return false;
+    }
+    out << "{\"otherData\":{\"name\":\"" << contents.name << "\",\"total\":"
+        << contents.totalRecorded << "},\n\"traceEvents\":[\n";
+    out << std::fixed << std::setprecision(3);
+    bool first{true};
+    for (const auto& rec : contents.records) {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+        out << "{\"name\":\"" << actionName(rec.action) << "\",\"ph\":\"X\",\"ts\":"
+            << static_cast<double>(rec.clockTime) / 1000.0
+            << ",\"dur\":" << static_cast<double>(rec.processingTime) / 1000.0
+            << ",\"pid\":0,\"tid\":0,\"args\":{\"message_id\":" << rec.messageID
+            << ",\"source\":" << rec.sourceId << ",\"source_handle\":" << rec.sourceHandle
+            << ",\"dest\":" << rec.destId << ",\"dest_handle\":" << rec.destHandle
+            << ",\"time_code\":" << rec.actionTime << ",\"payload_size\":" << rec.payloadSize
+            << ",\"counter\":" << rec.counter << ",\"flags\":" << rec.flags << "}}";
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+/** print the per action latency and throughput statistics*/
+static void printSummary(const helics::FlightRecorder::FileContents& contents)
+{
+    std::cout << "flight recorder from " << contents.name << '\n';
+    std::cout << contents.records.size() << " records of " << contents.totalRecorded
+              << " messages processed\n";
+    if (contents.records.empty()) {
+        return;
+    }
+    std::map<int32_t, actionStatistics> stats;
+    for (const auto& rec : contents.records) {
+        auto& stat = stats[rec.action];
+        ++stat.count;
+        stat.totalProcessing += rec.processingTime;
+        stat.maxProcessing = (std::max)(stat.maxProcessing, uint64_t{rec.processingTime});
+    }
+    const auto span = contents.records.back().clockTime - contents.records.front().clockTime;
+    const double seconds = static_cast<double>(span) * 1e-9;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "span " << seconds << "s";
+    if (span > 0) {
+        std::cout << ", " << static_cast<double>(contents.records.size()) / seconds
+                  << " messages/s";
+    }
+    std::cout << "\n\n";
+    std::cout << std::left << std::setw(32) << "action" << std::right << std::setw(10) << "count"
+              << std::setw(14) << "mean(us)" << std::setw(14) << "max(us)" << std::setw(16)
+              << "rate(msg/s)" << '\n';
+    for (const auto& stat : stats) {
+        std::cout << std::left << std::setw(32) << actionName(stat.first) << std::right
+                  << std::setw(10) << stat.second.count << std::setw(14)
+                  << static_cast<double>(stat.second.totalProcessing) /
+                static_cast<double>(stat.second.count) / 1000.0
+                  << std::setw(14) << static_cast<double>(stat.second.maxProcessing) / 1000.0
+                  << std::setw(16);
+        if (span > 0) {
+            std::cout << static_cast<double>(stat.second.count) / seconds;
+        } else {
+            std::cout << '-';
+        }
+        std::cout << '\n';
+    }
+}
+
+int main(int argc, char* argv[])  // NOLINT
+{
+    std::string inputFile;
+    std::string traceFile;
+    bool quiet{false};
+    helics::helicsCLI11App cmdLine(
+        "decode a binary flight recorder file written by a helics broker or core");
+    cmdLine.add_option("file", inputFile, "the flight recorder file to decode")->required();
+    cmdLine.add_option("--trace",
+                       traceFile,
+                       "write the records to a file in the chrome trace event json format");
+    cmdLine.add_flag("--quiet", quiet, "don't print the latency and throughput summary");
+    auto res = cmdLine.helics_parse(argc, argv);
+    if (res != helics::helicsCLI11App::parse_output::ok) {
+        switch (res) {
+            case helics::helicsCLI11App::parse_output::help_call:
+            case helics::helicsCLI11App::parse_output::help_all_call:
+            case helics::helicsCLI11App::parse_output::version_call:
+                return 0;
+            default:
+                return static_cast<int>(res);
+        }
+    }
+    helics::FlightRecorder::FileContents contents;
+    try {
+        contents = helics::FlightRecorder::readFile(inputFile);
+    }
+    catch (const helics::InvalidParameter& ip) {
+        std::cerr << ip.what() << std::endl;
+        return -1;
+    }
+    if (!quiet) {
+        printSummary(contents);
+    }
+    if (!traceFile.empty()) {
+        if (!writeChromeTrace(traceFile, contents)) {
+            std::cerr << "unable to write trace file " << traceFile << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -26,9 +26,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../core/BrokerFactory.hpp"
 #include "../core/coreTypeOperations.hpp"
 #include "../utilities/timeStringOps.hpp"
+#include "gmlc/utilities/stringOps.h"
 
 #include <algorithm>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
@@ -39,10 +42,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <boost/uuid/uuid.hpp>  // uuid class
 #include <boost/uuid/uuid_generators.hpp>  // generators
 #include <boost/uuid/uuid_io.hpp>  // streaming operators etc.
+#include <chrono>
 #include <cstdlib>
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <streambuf>
@@ -447,14 +453,268 @@ static void fail(beast::error_code ec, char const* what)
 
 // LCOV_EXCL_STOP
 
-// Echoes back all received WebSocket messages
+/** the queries used to generate each topic available for websocket subscriptions*/
+static const std::map<std::string, std::string> subscriptionTopics{{"time", "global_time"},
+                                                                   {"state", "current_state"},
+                                                                   {"counters", "counts"}};
+
+/** flatten a json value into a map of paths to leaf values
+@details array elements with a name member are keyed by the name so the paths stay stable as
+objects are added or removed*/
+static void flattenJson(const Json::Value& val,
+                        const std::string& path,
+                        std::map<std::string, Json::Value>& values)
+{
+    if (val.isObject()) {
+        for (const auto& member : val.getMemberNames()) {
+            flattenJson(val[member], path + '/' + member, values);
+        }
+    } else if (val.isArray()) {
+        for (Json::ArrayIndex ii = 0; ii < val.size(); ++ii) {
+            const auto& element = val[ii];
+            if (element.isObject() && element["name"].isString()) {
+                flattenJson(element, path + '/' + element["name"].asString(), values);
+            } else {
+                flattenJson(element, path + '/' + std::to_string(ii), values);
+            }
+        }
+    } else {
+        values[path] = val;
+    }
+}
+
+/** cache of broker state shared by all the websocket subscriptions
+@details each broker with subscribers is queried once per refresh period no matter how many clients
+are subscribed, every cached value carries the version it last changed in so each client only gets
+the values that changed since its last update.  All operations run on the io_context thread.
+*/
+class MetricsHub: public std::enable_shared_from_this<MetricsHub> {
+  public:
+    using sink_type = std::function<bool(std::string)>;
+    MetricsHub(net::io_context& context, std::chrono::milliseconds period):
+        timer(context), refreshPeriod(period)
+    {
+    }
+    /** start the refresh timer*/
+    void start() { scheduleRefresh(); }
+    /** subscribe a client to a set of topics on a broker
+    @param client identifier for the client
+    @param broker the name of the broker to monitor
+    @param topics the topics the client is interested in
+    @param period the minimum time between updates to the client
+    @param sink function to send a message to the client,  returns false if the client is gone
+    */
+    void subscribe(const void* client,
+                   const std::string& broker,
+                   std::vector<std::string> topics,
+                   std::chrono::milliseconds period,
+                   sink_type sink)
+    {
+        unsubscribe(client, broker);
+        subscription sub;
+        sub.client = client;
+        sub.topics = std::move(topics);
+        sub.period = (std::max)(period, refreshPeriod);
+        sub.sink = std::move(sink);
+        caches[broker].subscribers.push_back(std::move(sub));
+    }
+    /** remove the subscriptions of a client,  an empty broker name removes all of them*/
+    void unsubscribe(const void* client, const std::string& broker = std::string{})
+    {
+        for (auto& cache : caches) {
+            if (!broker.empty() && cache.first != broker) {
+                continue;
+            }
+            auto& subs = cache.second.subscribers;
+            subs.erase(std::remove_if(subs.begin(),
+                                      subs.end(),
+                                      [client](const subscription& sub) {
+                                          return sub.client == client;
+                                      }),
+                       subs.end());
+        }
+    }
+
+  private:
+    struct subscription {
+        const void* client{nullptr};
+        std::vector<std::string> topics;
+        std::chrono::milliseconds period{0};
+        std::chrono::steady_clock::time_point nextUpdate;
+        std::uint64_t lastVersion{0};  //!< the cache version last sent, 0 if nothing was sent
+        sink_type sink;
+    };
+    struct brokerCache {
+        std::map<std::string, std::pair<Json::Value, std::uint64_t>> values;
+        std::map<std::string, std::uint64_t> removed;  //!< paths removed and the version removed
+        std::uint64_t version{0};
+        std::vector<subscription> subscribers;
+    };
+
+    net::steady_timer timer;
+    const std::chrono::milliseconds refreshPeriod;
+    std::map<std::string, brokerCache> caches;
+
+    void scheduleRefresh()
+    {
+        timer.expires_after(refreshPeriod);
+        timer.async_wait([self = shared_from_this()](beast::error_code ec) {
+            if (ec) {
+                return;
+            }
+            self->refresh();
+            self->scheduleRefresh();
+        });
+    }
+
+    static bool matchesTopics(const std::string& path, const std::vector<std::string>& topics)
+    {
+        for (const auto& topic : topics) {
+            if (path.compare(0, topic.size(), topic) == 0 && path.size() > topic.size() &&
+                path[topic.size()] == '/') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void refresh()
+    {
+        auto now = std::chrono::steady_clock::now();
+        for (auto cit = caches.begin(); cit != caches.end();) {
+            auto& cache = cit->second;
+            if (cache.subscribers.empty()) {
+                cit = caches.erase(cit);
+                continue;
+            }
+            std::vector<std::string> topics;
+            for (const auto& sub : cache.subscribers) {
+                if (now < sub.nextUpdate) {
+                    continue;
+                }
+                for (const auto& topic : sub.topics) {
+                    if (std::find(topics.begin(), topics.end(), topic) == topics.end()) {
+                        topics.push_back(topic);
+                    }
+                }
+            }
+            if (!topics.empty()) {
+                updateCache(cit->first, cache, topics);
+                sendUpdates(cit->first, cache, now);
+            }
+            ++cit;
+        }
+    }
+
+    void updateCache(const std::string& brokerName,
+                     brokerCache& cache,
+                     const std::vector<std::string>& topics)
+    {
+        auto brk = helics::BrokerFactory::findBroker(brokerName);
+        const bool connected = (brk) && brk->isConnected();
+        std::map<std::string, Json::Value> current;
+        current["status/connected"] = connected;
+        std::vector<std::string> refreshed{"status"};
+        if (connected) {
+            for (const auto& topic : topics) {
+                auto res = brk->query("broker", subscriptionTopics.at(topic));
+                if (res.empty() || (res.front() != '{' && res.front() != '[')) {
+                    // leave the cached values alone if the query could not be answered
+                    continue;
+                }
+                flattenJson(loadJsonStr(res), topic, current);
+                refreshed.push_back(topic);
+            }
+        }
+        ++cache.version;
+        for (auto vit = cache.values.begin(); vit != cache.values.end();) {
+            if (current.find(vit->first) == current.end() &&
+                matchesTopics(vit->first, refreshed)) {
+                cache.removed[vit->first] = cache.version;
+                vit = cache.values.erase(vit);
+            } else {
+                ++vit;
+            }
+        }
+        for (auto& value : current) {
+            auto& cached = cache.values[value.first];
+            if (cached.second == 0 || !(cached.first == value.second)) {
+                cached.first = std::move(value.second);
+                cached.second = cache.version;
+                cache.removed.erase(value.first);
+            }
+        }
+    }
+
+    void sendUpdates(const std::string& brokerName,
+                     brokerCache& cache,
+                     std::chrono::steady_clock::time_point now)
+    {
+        auto minVersion = cache.version;
+        auto& subs = cache.subscribers;
+        for (auto sit = subs.begin(); sit != subs.end();) {
+            auto& sub = *sit;
+            if (now < sub.nextUpdate) {
+                minVersion = (std::min)(minVersion, sub.lastVersion);
+                ++sit;
+                continue;
+            }
+            std::vector<std::string> topics = sub.topics;
+            topics.emplace_back("status");
+            Json::Value update;
+            update["type"] = (sub.lastVersion == 0) ? "snapshot" : "delta";
+            update["broker"] = brokerName;
+            update["version"] = static_cast<Json::UInt64>(cache.version);
+            update["values"] = Json::objectValue;
+            bool changed{sub.lastVersion == 0};
+            for (const auto& value : cache.values) {
+                if (value.second.second > sub.lastVersion && matchesTopics(value.first, topics)) {
+                    update["values"][value.first] = value.second.first;
+                    changed = true;
+                }
+            }
+            if (sub.lastVersion > 0) {
+                update["removed"] = Json::arrayValue;
+                for (const auto& removed : cache.removed) {
+                    if (removed.second > sub.lastVersion && matchesTopics(removed.first, topics)) {
+                        update["removed"].append(removed.first);
+                        changed = true;
+                    }
+                }
+            }
+            sub.lastVersion = cache.version;
+            sub.nextUpdate = now + sub.period;
+            if (changed && !sub.sink(generateJsonString(update))) {
+                sit = subs.erase(sit);
+                continue;
+            }
+            minVersion = (std::min)(minVersion, sub.lastVersion);
+            ++sit;
+        }
+        // every client has seen these removals
+        for (auto rit = cache.removed.begin(); rit != cache.removed.end();) {
+            if (rit->second <= minVersion) {
+                rit = cache.removed.erase(rit);
+            } else {
+                ++rit;
+            }
+        }
+    }
+};
+
+// Handles a websocket connection,  responding to requests and pushing subscribed updates
 class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
     websocket::stream<beast::tcp_stream> ws;
     beast::flat_buffer buffer;
+    std::deque<std::string> writeQueue;
+    std::shared_ptr<MetricsHub> hub;
 
   public:
     // Take ownership of the socket
-    explicit WebSocketsession(tcp::socket&& socket): ws(std::move(socket)) {}
+    WebSocketsession(tcp::socket&& socket, std::shared_ptr<MetricsHub> metricsHub):
+        ws(std::move(socket)), hub(std::move(metricsHub))
+    {
+    }
 
     // Get on the correct executor
     void run()
@@ -505,31 +765,33 @@ class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
 
         // This indicates that the session was closed
         if (ec == websocket::error::closed) {
-            return;
+            return close();
         }
 
         if (ec) {
             fail(ec, "read");
+            return close();
         }
 
         beast::string_view result{boost::asio::buffer_cast<const char*>(buffer.data()),
                                   buffer.size()};
-        // Echo the message
         auto reqpr = processRequestParameters("", result);
+        // Clear the buffer
+        buffer.consume(buffer.size());
 
+        auto cmdloc = reqpr.second.find("command");
+        if (cmdloc != reqpr.second.end() &&
+            (cmdloc->second == "subscribe" || cmdloc->second == "unsubscribe")) {
+            send(processSubscription(cmdloc->second == "subscribe", reqpr.second));
+            return do_read();
+        }
         cmd command{cmd::unknown};
 
         auto res = generateResults(command, {}, "", "", reqpr.second);
-        // Clear the buffer
-        buffer.consume(buffer.size());
 
-        ws.text(true);
         if (res.first == return_val::ok && !res.second.empty() && res.second.front() == '{') {
-            boost::beast::ostream(buffer) << res.second;  // NOLINT
-            ws.async_write(buffer.data(),
-                           beast::bind_front_handler(&WebSocketsession::on_write,
-                                                     shared_from_this()));
-            return;
+            send(std::move(res.second));
+            return do_read();
         }
         Json::Value response;
         switch (res.first) {
@@ -551,9 +813,117 @@ class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
                 break;
         }
 
-        boost::beast::ostream(buffer) << generateJsonString(response);  // NOLINT
-        ws.async_write(buffer.data(),
-                       beast::bind_front_handler(&WebSocketsession::on_write, shared_from_this()));
+        send(generateJsonString(response));
+        do_read();
+    }
+
+    /** queue a message to send to the client from any thread*/
+    void push(std::string message)
+    {
+        net::post(ws.get_executor(),
+                  [self = shared_from_this(), msg = std::move(message)]() mutable {
+                      self->send(std::move(msg));
+                  });
+    }
+
+  private:
+    std::string processSubscription(
+        bool subscribe,
+        const boost::container::flat_map<std::string, std::string>& fields)
+    {
+        Json::Value response;
+        std::string brokerName;
+        auto field = fields.find("broker");
+        if (field != fields.end()) {
+            brokerName = field->second;
+        } else {
+            auto brk = getValidBroker();
+            if (brk) {
+                brokerName = brk->getIdentifier();
+            }
+        }
+        if (!subscribe) {
+            hub->unsubscribe(this, brokerName);
+            response["status"] = 0;
+            return generateJsonString(response);
+        }
+        if (brokerName.empty() || !helics::BrokerFactory::findBroker(brokerName)) {
+            response["status"] = static_cast<int>(http::status::not_found);
+            response["error"] = brokerName + " not found";
+            return generateJsonString(response);
+        }
+        std::vector<std::string> topics;
+        field = fields.find("topics");
+        if (field != fields.end()) {
+            if (!field->second.empty() && field->second.front() == '[') {
+                try {
+                    auto topicList = loadJsonStr(field->second);
+                    for (const auto& topic : topicList) {
+                        topics.push_back(topic.asString());
+                    }
+                }
+                catch (const std::exception& e) {
+                    response["status"] = static_cast<int>(http::status::bad_request);
+                    response["error"] = std::string("invalid topic list: ") + e.what();
+                    return generateJsonString(response);
+                }
+            } else {
+                topics = gmlc::utilities::stringOps::splitline(
+                    field->second, ", ", gmlc::utilities::stringOps::delimiter_compression::on);
+            }
+            for (const auto& topic : topics) {
+                if (subscriptionTopics.find(topic) == subscriptionTopics.end()) {
+                    response["status"] = static_cast<int>(http::status::bad_request);
+                    response["error"] = topic + " is not a valid topic";
+                    return generateJsonString(response);
+                }
+            }
+        } else {
+            for (const auto& topic : subscriptionTopics) {
+                topics.push_back(topic.first);
+            }
+        }
+        std::chrono::milliseconds period{0};
+        field = fields.find("period");
+        if (field != fields.end()) {
+            try {
+                period =
+                    gmlc::utilities::loadTimeFromString<helics::Time>(field->second).to_ms();
+            }
+            catch (const std::exception& e) {
+                response["status"] = static_cast<int>(http::status::bad_request);
+                response["error"] = field->second + " is not a valid period: " + e.what();
+                return generateJsonString(response);
+            }
+        }
+        std::weak_ptr<WebSocketsession> weakSession = shared_from_this();
+        hub->subscribe(this, brokerName, topics, period, [weakSession](std::string message) {
+            auto session = weakSession.lock();
+            if (!session) {
+                return false;
+            }
+            session->push(std::move(message));
+            return true;
+        });
+        response["status"] = 0;
+        response["broker"] = brokerName;
+        return generateJsonString(response);
+    }
+
+    void send(std::string message)
+    {
+        writeQueue.push_back(std::move(message));
+        if (writeQueue.size() == 1) {
+            do_write();
+        }
+    }
+
+    void do_write()
+    {
+        ws.text(true);
+        ws.async_write(net::buffer(writeQueue.front()),
+                       beast::bind_front_handler(&WebSocketsession::on_write,
+                                                 shared_from_this()));
     }
 
     void on_write(beast::error_code ec, std::size_t bytes_transferred)
@@ -561,14 +931,20 @@ class WebSocketsession: public std::enable_shared_from_this<WebSocketsession> {
         boost::ignore_unused(bytes_transferred);
 
         if (ec) {
-            return fail(ec, "write");
+            fail(ec, "write");
+            return close();
         }
+        writeQueue.pop_front();
+        if (!writeQueue.empty()) {
+            do_write();
+        }
+    }
 
-        // Clear the buffer
-        buffer.consume(buffer.size());
-
-        // Do another read
-        do_read();
+    void close()
+    {
+        if (hub) {
+            hub->unsubscribe(this);
+        }
     }
 };
 
@@ -796,11 +1172,14 @@ class HttpSession: public std::enable_shared_from_this<HttpSession> {
 class Listener: public std::enable_shared_from_this<Listener> {
     net::io_context& ioc;
     tcp::acceptor acceptor;
-    bool websocket{false};
+    std::shared_ptr<MetricsHub> hub;  //!< the subscription cache if this is a websocket listener
 
   public:
-    Listener(net::io_context& context, const tcp::endpoint& endpoint, bool webs = false):
-        ioc(context), acceptor(net::make_strand(ioc)), websocket{webs}
+    Listener(net::io_context& context,
+             const tcp::endpoint& endpoint,
+             std::shared_ptr<MetricsHub> metricsHub = nullptr):
+        ioc(context),
+        acceptor(net::make_strand(ioc)), hub(std::move(metricsHub))
     {
         beast::error_code ec;
 
@@ -849,9 +1228,9 @@ class Listener: public std::enable_shared_from_this<Listener> {
         if (ec) {
             fail(ec, "accept");
         } else {
-            if (websocket) {
+            if (hub) {
                 // Create the session and run it
-                std::make_shared<WebSocketsession>(std::move(socket))->run();
+                std::make_shared<WebSocketsession>(std::move(socket), hub)->run();
             } else {
                 // Create the session and run it
                 std::make_shared<HttpSession>(std::move(socket))->run();
@@ -921,13 +1300,18 @@ namespace apps {
                 auto V = (*config)["websocket"];
                 replaceIfMember(V, "interface", websocketAddress_);
                 replaceIfMember(V, "port", websocketPort_);
+                if (V.isMember("push_period")) {
+                    websocketPushPeriod_ = loadJsonTime(V["push_period"]).to_ms();
+                }
             }
             auto const address = net::ip::make_address(websocketAddress_);
+            auto hub = std::make_shared<MetricsHub>(context->ioc, websocketPushPeriod_);
+            hub->start();
             // Create and launch a listening port
             std::make_shared<Listener>(context->ioc,
                                        tcp::endpoint{address,
                                                      static_cast<std::uint16_t>(websocketPort_)},
-                                       true)
+                                       hub)
                 ->run();
         }
         executing.store(true);
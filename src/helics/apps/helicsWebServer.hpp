@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "TypedBrokerServer.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -49,6 +50,8 @@ namespace apps {
         int httpPort_{80};
         std::string websocketAddress_{"127.0.0.1"};
         int websocketPort_{80};
+        /** the period to refresh the state pushed to websocket subscribers*/
+        std::chrono::milliseconds websocketPushPeriod_{500};
         bool http_enabled_{false};
         bool websocket_enabled_{false};
         std::atomic<bool> executing{false};
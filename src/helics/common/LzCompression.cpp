@@ -0,0 +1,224 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "LzCompression.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace helics {
+/** the number of bytes used to store the original size*/
+constexpr std::size_t headerSize{4};
+/** the log2 of the number of entries in the hash table*/
+constexpr unsigned int hashLog{12};
+/** the shortest match that can be encoded*/
+constexpr std::size_t minMatch{4};
+/** the block format requires the last bytes to be literals*/
+constexpr std::size_t lastLiterals{5};
+/** the last match must start at least this many bytes before the end of the block*/
+constexpr std::size_t matchFindLimit{12};
+/** the largest distance back a match can be*/
+constexpr std::size_t maxOffset{65535};
+/** the value of a length field indicating additional length bytes follow*/
+constexpr std::size_t runMask{15};
+
+static std::uint32_t read32(const unsigned char* data)
+{
+    std::uint32_t val;
+    std::memcpy(&val, data, sizeof(val));
+    return val;
+}
+
+static std::uint32_t hashSequence(std::uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32U - hashLog);
+}
+
+/** write a length value exceeding the token field as a series of bytes*/
+static unsigned char* writeLength(unsigned char* op, std::size_t length)
+{
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<unsigned char>(length);
+    return op;
+}
+
+/** read additional length bytes
+@return false if the input ended before the length was complete*/
+static bool
+    readLength(const unsigned char* data, std::size_t size, std::size_t& ip, std::size_t& length)
+{
+    unsigned char byte{255};
+    while (byte == 255) {
+        if (ip >= size) {
+            return false;
+        }
+        byte = data[ip++];
+        length += byte;
+    }
+    return true;
+}
+
+std::string lzCompress(const char* data, std::size_t size)
+{
+    std::string result;
+    if (size <= headerSize + lastLiterals || size > maxLzBlockSize) {
+        return result;
+    }
+    const auto* input = reinterpret_cast<const unsigned char*>(data);
+    // the worst case size of the block,  the compression is abandoned if it would not be smaller
+    result.resize(headerSize + size + size / 255 + 16);
+    auto* const start = reinterpret_cast<unsigned char*>(&result[0]);
+    const auto* const outputLimit = start + size;
+    start[0] = static_cast<unsigned char>((size >> 24U) & 0xFFU);
+    start[1] = static_cast<unsigned char>((size >> 16U) & 0xFFU);
+    start[2] = static_cast<unsigned char>((size >> 8U) & 0xFFU);
+    start[3] = static_cast<unsigned char>(size & 0xFFU);
+    auto* op = start + headerSize;
+
+    std::vector<std::uint32_t> table(std::size_t{1} << hashLog, 0U);
+    std::size_t anchor{0};
+    std::size_t ip{0};
+    const std::size_t matchLimit = size - lastLiterals;
+    if (size > matchFindLimit) {
+        const std::size_t searchLimit = size - matchFindLimit;
+        while (ip <= searchLimit) {
+            auto sequence = read32(input + ip);
+            auto hash = hashSequence(sequence);
+            std::size_t candidate = table[hash];
+            table[hash] = static_cast<std::uint32_t>(ip);
+            if ((candidate >= ip) || (ip - candidate > maxOffset) ||
+                (read32(input + candidate) != sequence)) {
+                // skip ahead faster through data that is not compressing
+                ip += 1 + ((ip - anchor) >> 6U);
+                continue;
+            }
+            while ((ip > anchor) && (candidate > 0) && (input[ip - 1] == input[candidate - 1])) {
+                --ip;
+                --candidate;
+            }
+            std::size_t matchLength{minMatch};
+            while ((ip + matchLength < matchLimit) &&
+                   (input[candidate + matchLength] == input[ip + matchLength])) {
+                ++matchLength;
+            }
+            const std::size_t literalLength = ip - anchor;
+            if (op + literalLength + literalLength / 255 + 8 > outputLimit) {
+                result.clear();
+                return result;
+            }
+            auto* token = op++;
+            if (literalLength >= runMask) {
+                *token = static_cast<unsigned char>(runMask << 4U);
+                op = writeLength(op, literalLength - runMask);
+            } else {
+                *token = static_cast<unsigned char>(literalLength << 4U);
+            }
+            std::memcpy(op, input + anchor, literalLength);
+            op += literalLength;
+            const std::size_t offset = ip - candidate;
+            *op++ = static_cast<unsigned char>(offset & 0xFFU);
+            *op++ = static_cast<unsigned char>((offset >> 8U) & 0xFFU);
+            const std::size_t extraLength = matchLength - minMatch;
+            if (extraLength >= runMask) {
+                *token |= static_cast<unsigned char>(runMask);
+                op = writeLength(op, extraLength - runMask);
+            } else {
+                *token |= static_cast<unsigned char>(extraLength);
+            }
+            ip += matchLength;
+            anchor = ip;
+            if (ip <= searchLimit) {
+                table[hashSequence(read32(input + ip - 2))] = static_cast<std::uint32_t>(ip - 2);
+            }
+        }
+    }
+    // the remaining bytes are written as a final sequence of literals
+    const std::size_t literalLength = size - anchor;
+    if (op + literalLength + literalLength / 255 + 1 >= outputLimit) {
+        result.clear();
+        return result;
+    }
+    auto* token = op++;
+    if (literalLength >= runMask) {
+        *token = static_cast<unsigned char>(runMask << 4U);
+        op = writeLength(op, literalLength - runMask);
+    } else {
+        *token = static_cast<unsigned char>(literalLength << 4U);
+    }
+    std::memcpy(op, input + anchor, literalLength);
+    op += literalLength;
+    result.resize(static_cast<std::size_t>(op - start));
+    return result;
+}
+
+bool lzDecompress(const char* data, std::size_t size, std::string& result)
+{
+    if (size < headerSize + 1) {
+        return false;
+    }
+    const auto* input = reinterpret_cast<const unsigned char*>(data);
+    const std::size_t originalSize = (static_cast<std::size_t>(input[0]) << 24U) |
+        (static_cast<std::size_t>(input[1]) << 16U) | (static_cast<std::size_t>(input[2]) << 8U) |
+        static_cast<std::size_t>(input[3]);
+    if (originalSize > maxLzBlockSize) {
+        return false;
+    }
+    result.resize(originalSize);
+    auto* output = reinterpret_cast<unsigned char*>(&result[0]);
+    std::size_t ip{headerSize};
+    std::size_t op{0};
+    while (ip < size) {
+        const auto token = input[ip++];
+        std::size_t literalLength = token >> 4U;
+        if (literalLength == runMask && !readLength(input, size, ip, literalLength)) {
+            return false;
+        }
+        if ((literalLength > size - ip) || (literalLength > originalSize - op)) {
+            return false;
+        }
+        std::memcpy(output + op, input + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == size) {
+            // the last sequence contains only literals
+            break;
+        }
+        if (size - ip < 2) {
+            return false;
+        }
+        const std::size_t offset =
+            static_cast<std::size_t>(input[ip]) | (static_cast<std::size_t>(input[ip + 1]) << 8U);
+        ip += 2;
+        if ((offset == 0) || (offset > op)) {
+            return false;
+        }
+        std::size_t matchLength = token & runMask;
+        if (matchLength == runMask && !readLength(input, size, ip, matchLength)) {
+            return false;
+        }
+        matchLength += minMatch;
+        if (matchLength > originalSize - op) {
+            return false;
+        }
+        if (offset >= matchLength) {
+            std::memcpy(output + op, output + op - offset, matchLength);
+            op += matchLength;
+        } else {
+            // overlapping matches repeat the preceding bytes
+            for (std::size_t ii = 0; ii < matchLength; ++ii) {
+                output[op] = output[op - offset];
+                ++op;
+            }
+        }
+    }
+    return op == originalSize;
+}
+
+}  // namespace helics
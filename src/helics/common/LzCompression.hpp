@@ -0,0 +1,37 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/** @file
+functions for a fast LZ77 style compression of message payloads
+@details the compressed data uses the LZ4 block format preceded by the size of the original data as
+a 4 byte big endian integer.  The compressor favors speed over compression ratio,  it uses a single
+hash table lookup per position and does no match searching beyond that
+*/
+namespace helics {
+/** the largest block of data that can be compressed*/
+constexpr std::size_t maxLzBlockSize{(1U << 24U) - 1U};
+
+/** compress a block of data
+@param data pointer to the data to compress
+@param size the number of bytes to compress
+@return a string containing the size header and the compressed block,  or an empty string if the
+data could not be compressed to a size smaller than the original*/
+std::string lzCompress(const char* data, std::size_t size);
+
+/** decompress a block generated by lzCompress
+@param data pointer to the compressed block including the size header
+@param size the number of bytes in the compressed block
+@param[out] result the string to store the decompressed data in,  it is left in an unspecified
+state if the block is not valid
+@return true if the block was valid and decompressed to the size stored in its header*/
+bool lzDecompress(const char* data, std::size_t size, std::string& result);
+
+}  // namespace helics
@@ -630,6 +630,7 @@ static constexpr std::pair<action_message_def::action_t, const char*> actionStri
     {action_message_def::action_t::cmd_error, "error"},
 
     {action_message_def::action_t::cmd_send_route, "send_route"},
+    {action_message_def::action_t::cmd_lane_sync, "lane_sync"},
     {action_message_def::action_t::cmd_add_dependency, "add_dependency"},
     {action_message_def::action_t::cmd_remove_dependency, "remove_dependency"},
     {action_message_def::action_t::cmd_add_dependent, "add_dependent"},
@@ -665,6 +666,7 @@ static constexpr std::pair<action_message_def::action_t, const char*> actionStri
     {action_message_def::action_t::cmd_add_named_input, "add_named_input"},
     {action_message_def::action_t::cmd_add_named_publication, "add_named_publication"},
     {action_message_def::action_t::cmd_add_named_filter, "add_named_filter"},
+    {action_message_def::action_t::cmd_endpoint_location, "endpoint_location"},
     {action_message_def::action_t::cmd_remove_named_endpoint, "remove_named_endpoint"},
     {action_message_def::action_t::cmd_disconnect_fed, "disconnect_fed"},
     {action_message_def::action_t::cmd_disconnect_broker, "disconnect_broker"},
@@ -828,6 +830,41 @@ int appendMessage(ActionMessage& m, const ActionMessage& newMessage)
     return (-1);
 }
 
+std::vector<ActionMessage> packageMultiMessages(std::vector<ActionMessage>&& commands,
+                                                int maxPackageSize)
+{
+    static constexpr std::size_t maxPackageCount{255};
+    std::vector<ActionMessage> packages;
+    std::size_t groupStart{0};
+    int packageSize{action_message_base_size};
+    auto closeGroup = [&](std::size_t groupEnd) {
+        if (groupEnd - groupStart == 1) {
+            packages.push_back(std::move(commands[groupStart]));
+        } else if (groupEnd > groupStart) {
+            ActionMessage package(CMD_MULTI_MESSAGE);
+            for (auto ii = groupStart; ii < groupEnd; ++ii) {
+                appendMessage(package, commands[ii]);
+            }
+            packages.push_back(std::move(package));
+        }
+        groupStart = groupEnd;
+        packageSize = action_message_base_size;
+    };
+    for (std::size_t ii = 0; ii < commands.size(); ++ii) {
+        auto commandSize =
+            commands[ii].serializedByteCount() + static_cast<int>(sizeof(uint32_t));
+        if ((ii > groupStart) &&
+            ((packageSize + commandSize > maxPackageSize) ||
+             (ii - groupStart >= maxPackageCount))) {
+            closeGroup(ii);
+        }
+        packageSize += commandSize;
+    }
+    closeGroup(commands.size());
+    commands.clear();
+    return packages;
+}
+
 void setIterationFlags(ActionMessage& command, iteration_request iterate)
 {
     switch (iterate) {
@@ -325,6 +325,19 @@ std::ostream& operator<<(std::ostream& os, const ActionMessage& command);
 @return the integer location of the message in the stringData section*/
 int appendMessage(ActionMessage& m, const ActionMessage& newMessage);
 
+/** the largest package size accepted by all the comms types with their default settings*/
+constexpr int defaultPackageSize{4000};
+
+/** package a sequence of commands into multi message commands
+@details the commands are grouped in order so no package contains more than 255 commands or
+exceeds the specified size unless a single command is larger,  groups of a single command are
+passed through without being packaged
+@param commands the commands to package
+@param maxPackageSize the maximum serialized size of a package in bytes
+@return the commands to transmit in the order they should be sent*/
+std::vector<ActionMessage> packageMultiMessages(std::vector<ActionMessage>&& commands,
+                                                int maxPackageSize);
+
 /** generate a string representing an error from an ActionMessage
 @param command the command to generate the error string for
 @return a string describing the error, if the string is not an error the string is empty
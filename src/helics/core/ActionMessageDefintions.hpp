@@ -90,6 +90,7 @@ across different compilers*/
         cmd_error_check = 10001,  //!< check some status for error and error timeouts
         cmd_invalid = 1010101,  //!< indicates that command has generated an invalid state
         cmd_send_route = 75,  //!< command to define a route information
+        cmd_lane_sync = 77,  //!< marker from a core processing lane [internal to a core only]
         cmd_search_dependency = 1464,  //!< command to add a dependency by name
         cmd_add_dependency = 140,  //!< command to send a federate dependency information
         cmd_remove_dependency = 141,  //!< command to remove a dependency
@@ -152,6 +153,8 @@ across different compilers*/
         cmd_add_named_filter = 105,  //!< command to add named filter as a target
         cmd_add_named_publication = 106,  //!< command to add a named publication as a target
         cmd_add_named_endpoint = 107,  //!< command to add a named endpoint as a target
+        cmd_endpoint_location =
+            108,  //!< command to notify a core of the global handle for a named endpoint
         cmd_remove_named_input = 124,  //!< cmd to remove a target from connection by name
         cmd_remove_named_filter = 125,  //!< cmd to remove a filter from connection by name
         cmd_remove_named_publication =
@@ -213,6 +216,7 @@ across different compilers*/
 #define CMD_EXEC_GRANT action_message_def::action_t::cmd_exec_grant
 #define CMD_EXEC_CHECK action_message_def::action_t::cmd_exec_check
 #define CMD_REG_ROUTE action_message_def::action_t::cmd_register_route
+#define CMD_SEND_ROUTE action_message_def::action_t::cmd_send_route
 #define CMD_ROUTE_ACK action_message_def::action_t::cmd_route_ack
 #define CMD_STOP action_message_def::action_t::cmd_stop
 #define CMD_TERMINATE_IMMEDIATELY action_message_def::action_t::cmd_terminate_immediately
@@ -228,6 +232,7 @@ across different compilers*/
 #define CMD_TIME_BARRIER_REQUEST action_message_def::action_t::cmd_time_barrier_request
 #define CMD_TIME_BARRIER action_message_def::action_t::cmd_time_barrier
 #define CMD_TIME_BARRIER_CLEAR action_message_def::action_t::cmd_time_barrier_clear
+#define CMD_LANE_SYNC action_message_def::action_t::cmd_lane_sync
 
 #define CMD_SEND_MESSAGE action_message_def::action_t::cmd_send_message
 #define CMD_SEND_FOR_FILTER action_message_def::action_t::cmd_send_for_filter
@@ -258,6 +263,7 @@ across different compilers*/
 #define CMD_ADD_NAMED_FILTER action_message_def::action_t::cmd_add_named_filter
 #define CMD_ADD_NAMED_PUBLICATION action_message_def::action_t::cmd_add_named_publication
 #define CMD_ADD_NAMED_INPUT action_message_def::action_t::cmd_add_named_input
+#define CMD_ENDPOINT_LOCATION action_message_def::action_t::cmd_endpoint_location
 
 #define CMD_REMOVE_NAMED_ENDPOINT action_message_def::action_t::cmd_remove_named_endpoint
 #define CMD_REMOVE_NAMED_FILTER action_message_def::action_t::cmd_remove_named_filter
@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "AsyncLogWriter.hpp"
+
+#include "../helics_enums.h"
+
+#include <chrono>
+#include <utility>
+
+namespace helics {
+/** the maximum number of entries written in a single batch*/
+static constexpr std::size_t maxBatchSize{512};
+
+static std::size_t roundCapacity(std::size_t capacity)
+{
+    std::size_t size{2};
+    while (size < capacity) {
+        size <<= 1U;
+    }
+    return size;
+}
+
+AsyncLogWriter::AsyncLogWriter(std::size_t capacity, batchWriter writer):
+    cellCount(roundCapacity(capacity)), mask(cellCount - 1),
+    cells(std::make_unique<Cell[]>(cellCount)), writeBatch(std::move(writer))
+{
+    for (std::size_t ii = 0; ii < cellCount; ++ii) {
+        cells[ii].sequence.store(ii, std::memory_order_relaxed);
+    }
+    writerThread = std::thread([this]() { writerLoop(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(waitLock);
+        halt = true;
+    }
+    wakeCondition.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+}
+
+bool AsyncLogWriter::push(LogEntry&& entry)
+{
+    auto position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[position & mask];
+        auto sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (diff == 0) {
+            if (enqueuePosition.compare_exchange_weak(position,
+                                                      position + 1,
+                                                      std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the queue is full so drop the entry rather than blocking the caller
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    cell->entry = std::move(entry);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    if (writerSleeping.load(std::memory_order_acquire)) {
+        wakeCondition.notify_one();
+    }
+    return true;
+}
+
+void AsyncLogWriter::flush()
+{
+    auto target = enqueuePosition.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(waitLock);
+    if (halt) {
+        return;
+    }
+    wakeCondition.notify_one();
+    flushCondition.wait(lock, [this, target]() {
+        return halt || written.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void AsyncLogWriter::execute(const std::function<void()>& task)
+{
+    flush();
+    std::lock_guard<std::mutex> lock(outputLock);
+    task();
+}
+
+std::size_t AsyncLogWriter::popBatch(std::vector<LogEntry>& batch, std::size_t maxCount)
+{
+    std::size_t count{0};
+    while (count < maxCount) {
+        auto& cell = cells[dequeuePosition & mask];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeuePosition + 1) {
+            // empty or the producer has not finished writing the slot
+            break;
+        }
+        batch.push_back(std::move(cell.entry));
+        cell.sequence.store(dequeuePosition + cellCount, std::memory_order_release);
+        ++dequeuePosition;
+        ++count;
+    }
+    return count;
+}
+
+void AsyncLogWriter::writerLoop()
+{
+    std::vector<LogEntry> batch;
+    batch.reserve(maxBatchSize);
+    while (true) {
+        batch.clear();
+        popBatch(batch, maxBatchSize);
+        auto droppedNow = dropped.load(std::memory_order_relaxed);
+        if (droppedNow > droppedReported) {
+            LogEntry report;
+            report.level = helics_log_level_warning;
+            report.alwaysLog = true;
+            report.name = "logging";
+            report.message = std::to_string(droppedNow - droppedReported) +
+                " log messages were dropped because the log queue was full";
+            batch.push_back(std::move(report));
+            droppedReported = droppedNow;
+        }
+        if (!batch.empty()) {
+            try {
+                std::lock_guard<std::mutex> outLock(outputLock);
+                writeBatch(batch);
+            }
+            catch (...) {
+                // a failure writing the log should not stop the writer
+            }
+            written.store(dequeuePosition, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(waitLock);
+            }
+            flushCondition.notify_all();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(waitLock);
+        if (halt) {
+            // write anything pushed while stopping
+            lock.unlock();
+            batch.clear();
+            while (popBatch(batch, maxBatchSize) > 0) {
+                try {
+                    std::lock_guard<std::mutex> outLock(outputLock);
+                    writeBatch(batch);
+                }
+                catch (...) {
+                    // nothing more can be done with the failure while stopping
+                }
+                batch.clear();
+            }
+            written.store(dequeuePosition, std::memory_order_release);
+            flushCondition.notify_all();
+            return;
+        }
+        writerSleeping.store(true, std::memory_order_release);
+        // the timeout covers a push that raced with setting the sleeping flag
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(10));
+        writerSleeping.store(false, std::memory_order_release);
+    }
+}
+
+}  // namespace helics
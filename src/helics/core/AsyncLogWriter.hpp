@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace helics {
+/** class moving log output to a background thread
+@details log entries are placed in a bounded lock free queue by any number of threads and are
+formatted and written in batches by a single writer thread.  If the queue is full new entries are
+dropped and counted instead of blocking the caller, the writer reports the number of dropped entries
+through the normal output with the next batch.
+*/
+class AsyncLogWriter {
+  public:
+    /** the unformatted contents of a single log message*/
+    struct LogEntry {
+        int level{0};  //!< the helics log level of the message
+        int32_t federateID{0};  //!< the id of the source of the message
+        bool alwaysLog{false};  //!< the message should ignore the output level checks
+        std::string name;  //!< the name of the source of the message
+        std::string message;  //!< the message itself
+    };
+    /** callback to write a batch of entries, called only from the writer thread*/
+    using batchWriter = std::function<void(std::vector<LogEntry>& entries)>;
+    /** construct the writer
+    @param capacity the maximum number of entries waiting to be written, rounded up to a power of 2
+    @param writer the function to write out a batch of entries
+    */
+    AsyncLogWriter(std::size_t capacity, batchWriter writer);
+    /** destructor writes out all the entries in the queue and stops the writer thread*/
+    ~AsyncLogWriter();
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    /** add an entry to the queue without blocking
+    @return false if the queue was full and the entry was dropped*/
+    bool push(LogEntry&& entry);
+    /** wait until everything pushed before the call has been written*/
+    void flush();
+    /** run a function once everything pushed before the call has been written
+    @details the function runs on the calling thread while holding the lock the writer thread holds
+    while writing a batch, so it can safely modify the objects used by the batch writer*/
+    void execute(const std::function<void()>& task);
+    /** get the total number of entries that were dropped*/
+    uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    /** get the maximum number of entries in the queue*/
+    std::size_t capacity() const { return cellCount; }
+
+  private:
+    /** a slot in the queue,  the sequence number controls which side owns the slot*/
+    struct Cell {
+        std::atomic<uint64_t> sequence{0};
+        LogEntry entry;
+    };
+    const std::size_t cellCount;  //!< the number of slots in the queue
+    const uint64_t mask;  //!< mask for converting a position to a slot index
+    std::unique_ptr<Cell[]> cells;  //!< the slots of the queue
+    std::atomic<uint64_t> enqueuePosition{0};  //!< the next position to push to
+    uint64_t dequeuePosition{0};  //!< the next position to pop from, used only by the writer
+    std::atomic<uint64_t> written{0};  //!< the number of positions that have been written
+    std::atomic<uint64_t> dropped{0};  //!< the number of entries that have been dropped
+    uint64_t droppedReported{0};  //!< the number of dropped entries already reported
+    batchWriter writeBatch;  //!< the function writing the output
+    std::mutex outputLock;  //!< lock held while a batch is being written
+    std::mutex waitLock;  //!< lock for the sleep and flush conditions
+    std::condition_variable wakeCondition;  //!< condition the writer sleeps on
+    std::condition_variable flushCondition;  //!< condition flush waits on
+    std::atomic<bool> writerSleeping{false};  //!< the writer is waiting for entries
+    bool halt{false};  //!< flag to stop the writer thread
+    std::thread writerThread;  //!< the background writer thread
+
+    /** pop up to maxCount entries from the queue*/
+    std::size_t popBatch(std::vector<LogEntry>& batch, std::size_t maxCount);
+    /** the loop executed by the writer thread*/
+    void writerLoop();
+};
+}  // namespace helics
@@ -130,5 +130,15 @@ class Broker {
 
     /** update a time barrier with a new time*/
     virtual void clearTimeBarrier() = 0;
+
+    /** set a time barrier at which all federates save a checkpoint
+    @details each federate writes its checkpoint to <filePrefix><federate name>.hckp when it
+    requests a time at or beyond the barrier,  once all the federates are held at the barrier the
+    files hold a consistent state of the co-simulation and the barrier can be cleared with
+    clearTimeBarrier
+    @param checkpointTime the time of the barrier
+    @param filePrefix the prefix for the checkpoint files which can include a directory
+    */
+    virtual void setCheckpointBarrier(Time checkpointTime, const std::string& filePrefix) = 0;
 };
 }  // namespace helics
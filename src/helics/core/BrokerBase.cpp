@@ -7,14 +7,19 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "BrokerBase.hpp"
 
+#include "../common/JsonProcessingFunctions.hpp"
 #include "../common/fmt_format.h"
+#include "AsyncLogWriter.hpp"
+#include "FlightRecorder.hpp"
 #include "ForwardingTimeCoordinator.hpp"
+#include "TimerWheel.hpp"
 #include "flagOperations.hpp"
 #include "gmlc/libguarded/guarded.hpp"
 #include "gmlc/utilities/stringOps.h"
 #include "helics/core/helicsCLI11JsonConfig.hpp"
 #include "helicsCLI11.hpp"
 #include "loggingHelper.hpp"
+#include "threadAffinity.hpp"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
@@ -22,20 +27,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #    include "spdlog/sinks/syslog_sink.h"
 #endif
 
-#ifndef HELICS_DISABLE_ASIO
-#    include "../common/AsioContextManager.h"
-
-#    include <asio/steady_timer.hpp>
-#else
-#    ifdef _WIN32
-#        include <windows.h>
-#    else
-#        include <unistd.h>
-#    endif
-#endif
-
+#include <chrono>
 #include <iostream>
 #include <map>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -66,10 +61,6 @@ BrokerBase::BrokerBase(const std::string& broker_name, bool DisableQueue):
 
 BrokerBase::~BrokerBase()
 {
-    consoleLogger.reset();
-    if (fileLogger) {
-        spdlog::drop(identifier);
-    }
     if (!queueDisabled) {
         try {
             joinAllThreads();
@@ -78,6 +69,12 @@ BrokerBase::~BrokerBase()
             // no exceptions in the destructor
         }
     }
+    // write out anything still queued while the loggers are valid
+    asyncLog.reset();
+    consoleLogger.reset();
+    if (fileLogger) {
+        spdlog::drop(identifier);
+    }
 }
 std::function<void(int, const std::string&, const std::string&)>
     BrokerBase::getLoggingCallback() const
@@ -102,6 +99,9 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateCLI()
     return hApp;
 }
 
+/** the number of messages kept for the dumplog if no flight recorder size was given*/
+static constexpr int defaultDumpLogSize{16383};
+
 static const std::map<std::string, int> log_level_map{{"none", helics_log_level_no_print},
                                                       {"no_print", helics_log_level_no_print},
                                                       {"error", helics_log_level_error},
@@ -153,6 +153,9 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
     hApp->add_flag("--terminate_on_error,--halt_on_error",
                    terminate_on_error,
                    "specify that a broker should cause the federation to terminate on an error");
+    hApp->add_option("--cpu_affinity",
+                     cpuAffinity,
+                     "the cpu to pin the message processing thread to for low jitter operation");
     auto* logging_group =
         hApp->add_option_group("logging", "Options related to file and message logging");
     logging_group->add_flag_function(
@@ -164,6 +167,15 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
         },
         "flush the log after every message");
     logging_group->add_option("--logfile", logFile, "the file to log the messages to");
+    logging_group->add_flag(
+        "--asynclog",
+        asyncLogging,
+        "format and write log messages from a background thread, messages are dropped and counted instead of blocking if the log buffer is full");
+    logging_group
+        ->add_option("--logbuffer",
+                     logBufferSize,
+                     "the number of log messages that can be waiting to be written with --asynclog")
+        ->check(CLI::PositiveNumber);
     logging_group
         ->add_option_function<int>(
             "--loglevel,--log-level",
@@ -188,7 +200,16 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
     logging_group->add_flag(
         "--dumplog",
         dumplog,
-        "capture a record of all messages and dump a complete log to file or console on termination");
+        "capture a record of the most recent messages and dump a log of them to file or console on termination");
+    logging_group
+        ->add_option("--flight_recorder",
+                     flightRecorderSize,
+                     "the number of recent messages to keep in the binary flight recorder")
+        ->check(CLI::NonNegativeNumber);
+    logging_group->add_option(
+        "--flight_recorder_file",
+        flightRecorderFile,
+        "file to write the flight recorder to on an error or termination, it can be decoded with helics_flight_decoder");
 
     auto* timeout_group =
         hApp->add_option_group("timeouts", "Options related to network and process timeouts");
@@ -244,13 +265,32 @@ void BrokerBase::generateLoggers()
             fileLogger = spdlog::basic_logger_mt(identifier, logFile);
         }
         if (fileLogger) {
-            fileLogger->flush_on(spdlog::level::info);
+            // the asynchronous writer flushes once per batch instead of once per message
+            fileLogger->flush_on((asyncLogging) ? spdlog::level::off : spdlog::level::info);
             fileLogger->set_level(spdlog::level::trace);
         }
     }
     catch (const spdlog::spdlog_ex& ex) {
         std::cerr << "Log init failed in " << identifier << " : " << ex.what() << std::endl;
     }
+    if (asyncLogging && !asyncLog) {
+        asyncLog = std::make_unique<AsyncLogWriter>(
+            logBufferSize, [this](std::vector<AsyncLogWriter::LogEntry>& entries) {
+                for (const auto& entry : entries) {
+                    writeLogMessage(entry.federateID,
+                                    entry.level,
+                                    entry.name,
+                                    entry.message,
+                                    entry.alwaysLog);
+                }
+                if (consoleLogger) {
+                    consoleLogger->flush();
+                }
+                if (fileLogger) {
+                    fileLogger->flush();
+                }
+            });
+    }
 }
 
 int BrokerBase::parseArgs(int argc, char* argv[])
@@ -330,72 +370,69 @@ bool BrokerBase::sendToLogger(global_federate_id federateID,
         }
         if (loggerFunction) {
             loggerFunction(logLevel, fmt::format("{} ({})", name, federateID.baseValue()), message);
-        } else {
-            if (consoleLogLevel >= logLevel || alwaysLog) {
-                if (logLevel >= helics_log_level_trace) {
-                    consoleLogger->log(
-                        spdlog::level::trace, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_timing) {
-                    consoleLogger->log(
-                        spdlog::level::debug, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_summary) {
-                    consoleLogger->log(
-                        spdlog::level::info, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_warning) {
-                    consoleLogger->log(
-                        spdlog::level::warn, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_error) {
-                    consoleLogger->log(
-                        spdlog::level::err, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel == -10) {  // dumplog
-                    consoleLogger->log(spdlog::level::trace, "{}", message);
-                } else {
-                    consoleLogger->log(spdlog::level::critical,
-                                       "{} ({})::{}",
-                                       name,
-                                       federateID.baseValue(),
-                                       message);
-                }
-                if (forceLoggingFlush) {
-                    consoleLogger->flush();
-                }
-            }
-            if (fileLogger && (logLevel <= fileLogLevel || alwaysLog)) {
-                if (logLevel >= helics_log_level_trace) {
-                    fileLogger->log(
-                        spdlog::level::trace, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_timing) {
-                    fileLogger->log(
-                        spdlog::level::debug, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_summary) {
-                    fileLogger->log(
-                        spdlog::level::info, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_warning) {
-                    fileLogger->log(
-                        spdlog::level::warn, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel >= helics_log_level_error) {
-                    fileLogger->log(
-                        spdlog::level::err, "{} ({})::{}", name, federateID.baseValue(), message);
-                } else if (logLevel == -10) {  // dumplog
-                    fileLogger->log(spdlog::level::trace, message);
-                } else {
-                    fileLogger->log(spdlog::level::critical,
-                                    "{} ({})::{}",
-                                    name,
-                                    federateID.baseValue(),
-                                    message);
-                }
-
-                if (forceLoggingFlush) {
-                    fileLogger->flush();
-                }
+        } else if (asyncLog) {
+            // the file logger is owned by the writer thread so only the levels are checked here
+            if (consoleLogLevel >= logLevel || alwaysLog || logLevel <= fileLogLevel) {
+                // formatting and output are deferred to the writer thread
+                asyncLog->push({logLevel, federateID.baseValue(), alwaysLog, name, message});
             }
+        } else {
+            writeLogMessage(federateID.baseValue(), logLevel, name, message, alwaysLog);
         }
         return true;
     }
     return false;
 }
 
+void BrokerBase::writeLogMessage(int32_t federateID,
+                                 int logLevel,
+                                 const std::string& name,
+                                 const std::string& message,
+                                 bool alwaysLog) const
+{
+    if (consoleLogLevel >= logLevel || alwaysLog) {
+        if (logLevel >= helics_log_level_trace) {
+            consoleLogger->log(spdlog::level::trace, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_timing) {
+            consoleLogger->log(spdlog::level::debug, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_summary) {
+            consoleLogger->log(spdlog::level::info, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_warning) {
+            consoleLogger->log(spdlog::level::warn, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_error) {
+            consoleLogger->log(spdlog::level::err, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel == -10) {  // dumplog
+            consoleLogger->log(spdlog::level::trace, "{}", message);
+        } else {
+            consoleLogger->log(spdlog::level::critical, "{} ({})::{}", name, federateID, message);
+        }
+        if (forceLoggingFlush && !asyncLog) {
+            consoleLogger->flush();
+        }
+    }
+    if (fileLogger && (logLevel <= fileLogLevel || alwaysLog)) {
+        if (logLevel >= helics_log_level_trace) {
+            fileLogger->log(spdlog::level::trace, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_timing) {
+            fileLogger->log(spdlog::level::debug, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_summary) {
+            fileLogger->log(spdlog::level::info, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_warning) {
+            fileLogger->log(spdlog::level::warn, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel >= helics_log_level_error) {
+            fileLogger->log(spdlog::level::err, "{} ({})::{}", name, federateID, message);
+        } else if (logLevel == -10) {  // dumplog
+            fileLogger->log(spdlog::level::trace, message);
+        } else {
+            fileLogger->log(spdlog::level::critical, "{} ({})::{}", name, federateID, message);
+        }
+
+        if (forceLoggingFlush && !asyncLog) {
+            fileLogger->flush();
+        }
+    }
+}
+
 void BrokerBase::generateNewIdentifier()
 {
     identifier = genId();
@@ -418,19 +455,76 @@ void BrokerBase::setErrorState(int eCode, const std::string& estring)
     }
 
     sendToLogger(global_id.load(), helics_log_level_error, identifier, estring);
+    writeFlightRecorderFile();
+}
+
+void BrokerBase::processQueueIdle() {}
+
+std::string BrokerBase::generateCompressionStatistics() const
+{
+    Json::Value base;
+    base["enabled"] = false;
+    return generateJsonString(base);
+}
+
+std::string BrokerBase::dumpFlightRecorder() const
+{
+    Json::Value base;
+    base["name"] = identifier;
+    base["records"] = Json::arrayValue;
+    if (!flightRecorder) {
+        base["capacity"] = 0;
+        base["total"] = 0;
+        return generateJsonString(base);
+    }
+    base["capacity"] = static_cast<Json::UInt64>(flightRecorder->capacity());
+    base["total"] = static_cast<Json::UInt64>(flightRecorder->totalRecorded());
+    for (const auto& rec : flightRecorder->snapshot()) {
+        Json::Value record;
+        record["clock"] = static_cast<Json::Int64>(rec.clockTime);
+        record["action"] = actionMessageType(static_cast<action_message_def::action_t>(rec.action));
+        Time actionTime;
+        actionTime.setBaseTimeCode(rec.actionTime);
+        record["time"] = static_cast<double>(actionTime);
+        record["message_id"] = rec.messageID;
+        record["source"] = rec.sourceId;
+        record["source_handle"] = rec.sourceHandle;
+        record["dest"] = rec.destId;
+        record["dest_handle"] = rec.destHandle;
+        record["payload_size"] = rec.payloadSize;
+        record["processing"] = rec.processingTime;
+        base["records"].append(record);
+    }
+    return generateJsonString(base);
+}
+
+bool BrokerBase::writeFlightRecorderFile() const
+{
+    if (!flightRecorder || flightRecorderFile.empty()) {
+        return false;
+    }
+    return flightRecorder->writeFile(flightRecorderFile, identifier) > 0;
 }
 
 void BrokerBase::setLoggingFile(const std::string& lfile)
 {
     if (logFile.empty() || lfile != logFile) {
         logFile = lfile;
-        if (!logFile.empty()) {
-            fileLogger = spdlog::basic_logger_mt(identifier, logFile);
-        } else {
-            if (fileLogger) {
-                spdlog::drop(identifier);
-                fileLogger.reset();
+        auto swapLogger = [this]() {
+            if (!logFile.empty()) {
+                fileLogger = spdlog::basic_logger_mt(identifier, logFile);
+            } else {
+                if (fileLogger) {
+                    spdlog::drop(identifier);
+                    fileLogger.reset();
+                }
             }
+        };
+        if (asyncLog) {
+            // the writer thread uses the file logger so it can only be swapped between batches
+            asyncLog->execute(swapLogger);
+        } else {
+            swapLogger();
         }
     }
 }
@@ -460,11 +554,18 @@ void BrokerBase::setLogLevel(int32_t level)
 
 void BrokerBase::logFlush()
 {
-    if (consoleLogger) {
-        consoleLogger->flush();
-    }
-    if (fileLogger) {
-        fileLogger->flush();
+    auto flushLoggers = [this]() {
+        if (consoleLogger) {
+            consoleLogger->flush();
+        }
+        if (fileLogger) {
+            fileLogger->flush();
+        }
+    };
+    if (asyncLog) {
+        asyncLog->execute(flushLoggers);
+    } else {
+        flushLoggers();
     }
 }
 /** set the logging levels
@@ -497,67 +598,6 @@ void BrokerBase::addActionMessage(ActionMessage&& m)
         actionQueue.emplace(std::move(m));
     }
 }
-#ifndef HELICS_DISABLE_ASIO
-using activeProtector = gmlc::libguarded::guarded<std::pair<bool, bool>>;
-
-static bool haltTimer(activeProtector& active, asio::steady_timer& tickTimer)
-{
-    bool TimerRunning = true;
-    {
-        auto p = active.lock();
-        if (p->second) {
-            p->first = false;
-            p.unlock();
-            auto cancelled = tickTimer.cancel();
-            if (cancelled == 0) {
-                TimerRunning = false;
-            }
-        } else {
-            TimerRunning = false;
-        }
-    }
-    int ii = 0;
-    while (TimerRunning) {
-        if (ii % 4 != 3) {
-            std::this_thread::yield();
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(40));
-        }
-        auto res = active.load();
-        TimerRunning = res.second;
-        ++ii;
-        if (ii == 100) {
-            // assume the timer was never started so just exit and hope it doesn't somehow get
-            // called later and generate a seg fault.
-            return false;
-        }
-    }
-    return true;
-}
-
-static void
-    timerTickHandler(BrokerBase* bbase, activeProtector& active, const std::error_code& error)
-{
-    auto p = active.lock();
-    if (p->first) {
-        if (error != asio::error::operation_aborted) {
-            try {
-                bbase->addActionMessage(CMD_TICK);
-            }
-            catch (std::exception& e) {
-                std::cerr << "exception caught from addActionMessage" << e.what() << std::endl;
-            }
-        } else {
-            ActionMessage M(CMD_TICK);
-            setActionFlag(M, error_flag);
-            bbase->addActionMessage(M);
-        }
-    }
-    p->second = false;
-}
-
-#endif
-
 bool BrokerBase::tryReconnect()
 {
     return false;
@@ -570,50 +610,61 @@ void BrokerBase::queueProcessingLoop()
         mainLoopIsRunning.store(false);
         return;
     }
-    std::vector<ActionMessage> dumpMessages;
-#ifndef HELICS_DISABLE_ASIO
-    auto serv = AsioContextManager::getContextPointer();
-    auto contextLoop = serv->startContextLoop();
-    asio::steady_timer ticktimer(serv->getBaseContext());
-    activeProtector active(true, false);
-
-    auto timerCallback = [this, &active](const std::error_code& ec) {
-        timerTickHandler(this, active, ec);
+    if ((dumplog || flightRecorderSize > 0) && !flightRecorder) {
+        flightRecorder = std::make_unique<FlightRecorder>(
+            (flightRecorderSize > 0) ? flightRecorderSize : defaultDumpLogSize);
+    }
+    if (cpuAffinity >= 0 && !setThreadCpuAffinity(cpuAffinity)) {
+        sendToLogger(global_id.load(),
+                     log_level::warning,
+                     identifier,
+                     "unable to set the cpu affinity of the processing thread");
+    }
+    auto wheel = TimerWheel::getSharedWheel();
+    int32_t tickTimerIndex{-1};
+    auto setTickTimer = [&, this](TimerWheel::time_type expirationTime) {
+        if (tickTimerIndex < 0) {
+            tickTimerIndex =
+                wheel->addTimer(expirationTime, [this]() { addActionMessage(CMD_TICK); });
+        } else {
+            wheel->updateTimer(tickTimerIndex, expirationTime);
+        }
     };
     if (tickTimer > timeZero && !disable_timer) {
         if (tickTimer < Time(0.5)) {
             tickTimer = Time(0.5);
         }
-        active = std::make_pair(true, true);
-        ticktimer.expires_at(std::chrono::steady_clock::now() + tickTimer.to_ns());
-        ticktimer.async_wait(timerCallback);
-    }
-    auto timerStop = [&, this]() {
-        if (!haltTimer(active, ticktimer)) {
-            sendToLogger(global_broker_id_local,
-                         log_level::warning,
-                         identifier,
-                         "timer unable to cancel properly");
+        setTickTimer(std::chrono::steady_clock::now() + tickTimer.to_ns());
+    }
+    auto timerStop = [&]() {
+        if (tickTimerIndex >= 0) {
+            wheel->releaseTimer(tickTimerIndex);
+            tickTimerIndex = -1;
         }
-        contextLoop = nullptr;
     };
-#else
-    auto timerStop = []() {};
-#endif
 
     global_broker_id_local = global_id.load();
     int messagesSinceLastTick = 0;
-    auto logDump = [&, this]() {
-        if (!dumpMessages.empty()) {
-            for (auto& act : dumpMessages) {
-                sendToLogger(parent_broker_id,
-                             -10,
-                             identifier,
-                             fmt::format("|| dl cmd:{} from {} to {}",
-                                         prettyPrintString(act),
-                                         act.source_id.baseValue(),
-                                         act.dest_id.baseValue()));
-            }
+    auto logDump = [this]() {
+        writeFlightRecorderFile();
+        // a recorder created only for the dumplog gets logged even if the flag was turned off
+        if (!flightRecorder || (!dumplog && flightRecorderSize > 0)) {
+            return;
+        }
+        for (const auto& rec : flightRecorder->snapshot()) {
+            sendToLogger(parent_broker_id,
+                         -10,
+                         identifier,
+                         fmt::format("|| dl cmd:{}({}) from ({}:{}) to ({}:{}) size {} in {}ns",
+                                     actionMessageType(
+                                         static_cast<action_message_def::action_t>(rec.action)),
+                                     rec.messageID,
+                                     rec.sourceId,
+                                     rec.sourceHandle,
+                                     rec.destId,
+                                     rec.destHandle,
+                                     rec.payloadSize,
+                                     rec.processingTime));
         }
     };
     if (haltOperations) {
@@ -622,27 +673,27 @@ void BrokerBase::queueProcessingLoop()
         return;
     }
     while (true) {
+        if (idleProcessingPending && actionQueue.empty()) {
+            idleProcessingPending = false;
+            processQueueIdle();
+        }
         auto command = actionQueue.pop();
         ++messageCounter;
-        if (dumplog) {
-            dumpMessages.push_back(command);
-        }
         if (command.action() == CMD_IGNORE) {
             continue;
         }
+        const bool recording = (flightRecorderSize > 0 || dumplog) && flightRecorder;
+        const auto recordIndex = (recording) ? flightRecorder->record(command) : uint64_t{0};
         auto ret = commandProcessor(command);
+        if (recording) {
+            flightRecorder->finishRecord(recordIndex);
+        }
         if (ret == CMD_IGNORE) {
             ++messagesSinceLastTick;
             continue;
         }
         switch (ret) {
             case CMD_TICK:
-                if (checkActionFlag(command, error_flag)) {
-#ifndef HELICS_DISABLE_ASIO
-                    contextLoop = nullptr;
-                    contextLoop = serv->startContextLoop();
-#endif
-                }
                 // deal with error state timeout
                 if (brokerState.load() == broker_state_t::errored) {
                     auto ctime = std::chrono::steady_clock::now();
@@ -651,19 +702,12 @@ void BrokerBase::queueProcessingLoop()
                         command.setAction(CMD_USER_DISCONNECT);
                         addActionMessage(command);
                     } else {
-#ifndef HELICS_DISABLE_ASIO
                         if (!disable_timer) {
-                            ticktimer.expires_at(errorTimeStart + errorDelay.to_ns());
-                            active = std::make_pair(true, true);
-                            ticktimer.async_wait(timerCallback);
+                            setTickTimer(errorTimeStart + errorDelay.to_ns());
                         } else {
                             command.setAction(CMD_ERROR_CHECK);
                             addActionMessage(command);
                         }
-#else
-                        command.setAction(CMD_ERROR_CHECK);
-                        addActionMessage(command);
-#endif
                     }
                     break;
                 }
@@ -673,14 +717,10 @@ void BrokerBase::queueProcessingLoop()
 #endif
                 }
                 messagesSinceLastTick = 0;
-// reschedule the timer
-#ifndef HELICS_DISABLE_ASIO
+                // reschedule the timer
                 if (tickTimer > timeZero && !disable_timer) {
-                    ticktimer.expires_at(std::chrono::steady_clock::now() + tickTimer.to_ns());
-                    active = std::make_pair(true, true);
-                    ticktimer.async_wait(timerCallback);
+                    setTickTimer(std::chrono::steady_clock::now() + tickTimer.to_ns());
                 }
-#endif
                 break;
             case CMD_ERROR_CHECK:
                 if (brokerState.load() == broker_state_t::errored) {
@@ -690,15 +730,10 @@ void BrokerBase::queueProcessingLoop()
                         command.setAction(CMD_USER_DISCONNECT);
                         addActionMessage(command);
                     } else {
-#ifndef HELICS_DISABLE_ASIO
                         if (tickTimer > td * 2 || disable_timer) {
                             std::this_thread::sleep_for(std::chrono::milliseconds(200));
                             addActionMessage(command);
                         }
-#else
-                        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-                        addActionMessage(command);
-#endif
                     }
                 }
                 break;
@@ -762,6 +797,9 @@ void BrokerBase::baseConfigure(ActionMessage& command)
         switch (command.messageID) {
             case helics_flag_dumplog:
                 dumplog = checkActionFlag(command, indicator_flag);
+                if (dumplog && !flightRecorder) {
+                    flightRecorder = std::make_unique<FlightRecorder>(defaultDumpLogSize);
+                }
                 break;
             case helics_flag_force_logging_flush:
                 forceLoggingFlush = checkActionFlag(command, indicator_flag);
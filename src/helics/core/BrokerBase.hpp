@@ -26,6 +26,8 @@ class logger;
 }
 namespace helics {
 class ForwardingTimeCoordinator;
+class FlightRecorder;
+class AsyncLogWriter;
 class helicsCLI11App;
 /** base class for broker like objects
  */
@@ -71,11 +73,18 @@ class BrokerBase {
     bool terminate_on_error{
         false};  //!< flag indicating that the federation should halt on any error
     bool debugging{false};  //!< flag indicating operation in a user debugging mode
+    int cpuAffinity{-1};  //!< the cpu to pin the queue processing thread to
   private:
     std::atomic<bool> mainLoopIsRunning{
         false};  //!< flag indicating that the main processing loop is running
     bool dumplog{false};  //!< flag indicating the broker should capture a dump log
+    int flightRecorderSize{0};  //!< the number of messages to keep in the flight recorder
+    std::string flightRecorderFile;  //!< the file to write the flight recorder to on errors
+    std::unique_ptr<FlightRecorder> flightRecorder;  //!< recorder of the most recent messages
     std::atomic<bool> forceLoggingFlush{false};  //!< force the log to flush after every message
+    bool asyncLogging{false};  //!< flag indicating log output should be written from a separate thread
+    int logBufferSize{4096};  //!< the number of log messages that can be waiting for the writer
+    std::unique_ptr<AsyncLogWriter> asyncLog;  //!< the background log writer
     bool queueDisabled{
         false};  //!< flag indicating that the message queue should not be used and all functions
     //!< called directly instead of distinct thread
@@ -112,6 +121,8 @@ class BrokerBase {
     bool forwardTick{
         false};  //!< indicator that ticks should be forwarded to the command processor regardless
     bool no_ping{false};  //!< indicator that the broker is not very responsive to ping requests
+    bool idleProcessingPending{
+        false};  //!< indicator that processQueueIdle should be called once the queue is empty
     bool uuid_like{false};  //!< will be set to true if the name looks like a uuid
     decltype(std::chrono::steady_clock::now())
         errorTimeStart;  //!< time when the error condition started related to the errorDelay
@@ -176,6 +187,12 @@ class BrokerBase {
     std::shared_ptr<helicsCLI11App> generateBaseCLI();
     /** generate the loggers for the broker*/
     void generateLoggers();
+    /** format and write a message to the console and file loggers*/
+    void writeLogMessage(int32_t federateID,
+                         int logLevel,
+                         const std::string& name,
+                         const std::string& message,
+                         bool alwaysLog) const;
     /** handle some configuration options for the base*/
     void baseConfigure(ActionMessage& command);
 
@@ -194,6 +211,10 @@ class BrokerBase {
     @param command the command to process
     */
     virtual void processPriorityCommand(ActionMessage&& command) = 0;
+    /** function called by the processing loop once the queue is empty if idleProcessingPending
+    was set
+    @details used to send out work held back while more messages were waiting*/
+    virtual void processQueueIdle();
 
     /** send a Message to the logging system
     @return true if the message was actually logged
@@ -207,6 +228,9 @@ class BrokerBase {
     void generateNewIdentifier();
     /** generate the local address information*/
     virtual std::string generateLocalAddressString() const = 0;
+    /** generate a json string with statistics on the compression of payloads sent to other
+    brokers and cores*/
+    virtual std::string generateCompressionStatistics() const;
     /** generate a CLI11 Application for subprocesses for processing of command line arguments*/
     virtual std::shared_ptr<helicsCLI11App> generateCLI();
     /** set the broker error state and error string*/
@@ -215,6 +239,11 @@ class BrokerBase {
     void setLoggingFile(const std::string& lfile);
     /** get the value of a particular flag*/
     bool getFlagValue(int32_t flag) const;
+    /** generate a json string with the contents of the flight recorder*/
+    std::string dumpFlightRecorder() const;
+    /** write the flight recorder to its file if one was specified
+    @return true if the file was written*/
+    bool writeFlightRecorderFile() const;
 
   public:
     /** generate a callback function for the logging purposes*/
@@ -19,11 +19,14 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "ForwardingTimeCoordinator.hpp"
 #include "InputInfo.hpp"
 #include "PublicationInfo.hpp"
+#include "TimeCoordinator.hpp"
 #include "TimeoutMonitor.h"
+#include "TimerWheel.hpp"
 #include "core-exceptions.hpp"
 #include "coreTypeOperations.hpp"
 #include "fileConnections.hpp"
 #include "gmlc/concurrency/DelayedObjects.hpp"
+#include "helicsCLI11.hpp"
 #include "helicsVersion.hpp"
 #include "helics_definitions.hpp"
 #include "loggingHelper.hpp"
@@ -34,9 +37,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <cstring>
 #include <fstream>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -58,6 +64,20 @@ const std::string& state_string(operation_state state)
     }
 }
 
+/** stages of setting up a direct route to another core carried in the messageID of
+CMD_SEND_ROUTE*/
+static constexpr int32_t directRouteRegister{0};
+static constexpr int32_t directRouteRequest{1};
+static constexpr int32_t directRouteReply{2};
+static constexpr int32_t directRouteExpire{3};
+
+/** get the time to wait for the reply to a direct route request, one tick or the connection timeout
+if the tick is disabled*/
+static std::chrono::nanoseconds directRouteTimeout(Time tick, Time connectionTimeout)
+{
+    return (tick > timeZero) ? tick.to_ns() : connectionTimeout.to_ns();
+}
+
 // timeoutMon is a unique_ptr
 CommonCore::CommonCore() noexcept: timeoutMon(new TimeoutMonitor) {}
 
@@ -119,6 +139,26 @@ void CommonCore::configureFromVector(std::vector<std::string> args)
     }
 }
 
+std::shared_ptr<helicsCLI11App> CommonCore::generateCLI()
+{
+    auto app = std::make_shared<helicsCLI11App>("Options for cores");
+    app->remove_helics_specifics();
+    app->add_option(
+           "--processing_lanes",
+           processingLaneCount,
+           "the number of processing lanes to split the messages from the local federates into, "
+           "publications and time messages between local federates are delivered from the lanes "
+           "instead of the main processing loop, 0 to disable")
+        ->check(CLI::NonNegativeNumber);
+    app->add_option(
+           "--direct_route_threshold",
+           directRouteThreshold,
+           "the number of messages sent to a federate on another core before a direct route to "
+           "that core is established, 0 to disable")
+        ->check(CLI::NonNegativeNumber);
+    return app;
+}
+
 bool CommonCore::connect()
 {
     if (brokerState >= broker_state_t::configured) {
@@ -143,6 +183,7 @@ bool CommonCore::connect()
                     setActionFlag(m, slow_responding_flag);
                 }
                 transmit(parent_route_id, m);
+                startProcessingLanes();
                 brokerState = broker_state_t::connected;
                 disconnection.activate();
             } else {
@@ -196,6 +237,7 @@ void CommonCore::processDisconnect(bool skipUnregister)
         brokerDisconnect();
     }
     brokerState = broker_state_t::terminated;
+    stopProcessingLanes();
     if (!skipUnregister) {
         unregister();
     }
@@ -258,9 +300,223 @@ void CommonCore::unregister()
 }
 CommonCore::~CommonCore()
 {
+    if (directRouteTimer >= 0) {
+        routeTimerWheel->releaseTimer(directRouteTimer);
+    }
+    stopProcessingLanes();
     joinAllThreads();
 }
 
+void CommonCore::startProcessingLanes()
+{
+    if (processingLaneCount <= 0 || !processingLanes.empty()) {
+        return;
+    }
+    processingLanes.reserve(processingLaneCount);
+    for (int32_t ii = 0; ii < processingLaneCount; ++ii) {
+        processingLanes.push_back(std::make_unique<ProcessingLane>());
+    }
+    lanesActive.store(true);
+    for (int32_t ii = 0; ii < processingLaneCount; ++ii) {
+        auto& lane = *processingLanes[ii];
+        lane.laneThread = std::thread([this, &lane, ii]() { processLane(lane, ii); });
+    }
+}
+
+void CommonCore::stopProcessingLanes()
+{
+    {
+        // once this completes no federate can be in the middle of pushing to a lane
+        std::lock_guard<std::shared_mutex> laneGuard(laneLock);
+        if (!lanesActive.exchange(false)) {
+            return;
+        }
+    }
+    for (auto& lane : processingLanes) {
+        lane->queue.push(CMD_TERMINATE_IMMEDIATELY);
+    }
+    for (auto& lane : processingLanes) {
+        if (lane->laneThread.joinable()) {
+            lane->laneThread.join();
+        }
+        // anything a federate added while the lane was stopping still goes to the main queue
+        auto cmd = lane->queue.try_pop();
+        while (cmd) {
+            if (cmd->action() != CMD_TERMINATE_IMMEDIATELY) {
+                addActionMessage(std::move(*cmd));
+            }
+            cmd = lane->queue.try_pop();
+        }
+    }
+}
+
+void CommonCore::addFederateMessage(const FederateState* fed, const ActionMessage& message)
+{
+    if (fed != nullptr) {
+        std::shared_lock<std::shared_mutex> laneGuard(laneLock);
+        if (lanesActive.load()) {
+            auto index = fed->local_id.baseValue() % static_cast<int32_t>(processingLanes.size());
+            processingLanes[index]->queue.push(message);
+            return;
+        }
+    }
+    addActionMessage(message);
+}
+
+void CommonCore::addFederateMessage(const FederateState* fed, ActionMessage&& message)
+{
+    if (fed != nullptr) {
+        std::shared_lock<std::shared_mutex> laneGuard(laneLock);
+        if (lanesActive.load()) {
+            auto index = fed->local_id.baseValue() % static_cast<int32_t>(processingLanes.size());
+            processingLanes[index]->queue.push(std::move(message));
+            return;
+        }
+    }
+    addActionMessage(std::move(message));
+}
+
+FederateState* CommonCore::getLaneDestination(
+    const ActionMessage& command,
+    std::unordered_map<global_federate_id, FederateState*>& laneFederates) const
+{
+    switch (command.action()) {
+        case CMD_PUB:
+            break;
+        case CMD_TIME_REQUEST:
+        case CMD_TIME_GRANT:
+            // time messages are held in the main loop while filters are processing messages
+            if (filtersPresent.load()) {
+                return nullptr;
+            }
+            break;
+        default:
+            return nullptr;
+    }
+    if (brokerState.load() != broker_state_t::operating) {
+        return nullptr;
+    }
+    auto fnd = laneFederates.find(command.dest_id);
+    if (fnd == laneFederates.end()) {
+        FederateState* dest{nullptr};
+        {
+            auto feds = federates.lock_shared();
+            for (size_t ii = 0; ii < feds->size(); ++ii) {
+                auto* fed = (*feds)[ii];
+                if (fed->global_id.load() == command.dest_id) {
+                    dest = fed;
+                    break;
+                }
+            }
+        }
+        // the global ids of the local federates are all known once the core is operating so
+        // the ids of federates in other cores can be stored as well
+        fnd = laneFederates.emplace(command.dest_id, dest).first;
+    }
+    if (fnd->second == nullptr) {
+        return nullptr;
+    }
+    auto state = fnd->second->getState();
+    if (state == HELICS_FINISHED || state == HELICS_ERROR) {
+        return nullptr;
+    }
+    return fnd->second;
+}
+
+void CommonCore::processLane(ProcessingLane& lane, int32_t laneIndex)
+{
+    // the local federates by global id, only used by this thread
+    std::unordered_map<global_federate_id, FederateState*> laneFederates;
+    // the sequence number of the last marker sent to the main loop
+    uint32_t markerSequence{0};
+    // messages have been forwarded to the main loop since the last marker
+    bool forwarded{false};
+    // a message can only be delivered directly if everything forwarded before it has been
+    // processed by the main loop,  otherwise it could pass an earlier message
+    auto canDeliver = [&]() {
+        return !forwarded && lane.syncedSequence.load() == markerSequence;
+    };
+    auto forward = [&](ActionMessage&& cmd) {
+        addActionMessage(std::move(cmd));
+        ++lane.forwardCount;
+        forwarded = true;
+    };
+
+    while (true) {
+        auto cmd = lane.queue.pop();
+        if (cmd.action() == CMD_TERMINATE_IMMEDIATELY) {
+            return;
+        }
+        if (cmd.action() == CMD_MULTI_MESSAGE) {
+            int index{0};
+            while (index < cmd.counter && canDeliver()) {
+                ActionMessage subCommand(cmd.getString(index));
+                auto* dest = getLaneDestination(subCommand, laneFederates);
+                if (dest == nullptr) {
+                    break;
+                }
+                dest->addAction(std::move(subCommand));
+                ++lane.directCount;
+                ++index;
+            }
+            if (index == 0) {
+                forward(std::move(cmd));
+            } else if (index < cmd.counter) {
+                // the remainder goes to the main loop as a single package
+                ActionMessage remainder(CMD_MULTI_MESSAGE);
+                remainder.source_id = cmd.source_id;
+                remainder.source_handle = cmd.source_handle;
+                for (int ii = index; ii < cmd.counter; ++ii) {
+                    remainder.setString(remainder.counter++, cmd.getString(ii));
+                }
+                forward(std::move(remainder));
+            }
+        } else {
+            auto* dest = canDeliver() ? getLaneDestination(cmd, laneFederates) : nullptr;
+            if (dest != nullptr) {
+                dest->addAction(std::move(cmd));
+                ++lane.directCount;
+            } else {
+                forward(std::move(cmd));
+            }
+        }
+        // send a marker once the lane is idle or the previous marker has been processed
+        if (forwarded &&
+            (lane.syncedSequence.load() == markerSequence || lane.queue.empty())) {
+            ActionMessage marker(CMD_LANE_SYNC);
+            marker.messageID = laneIndex;
+            marker.sequenceID = ++markerSequence;
+            addActionMessage(std::move(marker));
+            ++lane.markerCount;
+            forwarded = false;
+        }
+    }
+}
+
+std::string CommonCore::generateLaneStatistics() const
+{
+    Json::Value base;
+    base["lanes"] = static_cast<int>(processingLanes.size());
+    Json::Int64 direct{0};
+    Json::Int64 forwardedCount{0};
+    Json::Int64 markers{0};
+    base["details"] = Json::arrayValue;
+    for (const auto& lane : processingLanes) {
+        Json::Value laneBlock;
+        laneBlock["direct"] = static_cast<Json::Int64>(lane->directCount.load());
+        laneBlock["forwarded"] = static_cast<Json::Int64>(lane->forwardCount.load());
+        laneBlock["markers"] = static_cast<Json::Int64>(lane->markerCount.load());
+        direct += laneBlock["direct"].asInt64();
+        forwardedCount += laneBlock["forwarded"].asInt64();
+        markers += laneBlock["markers"].asInt64();
+        base["details"].append(laneBlock);
+    }
+    base["direct"] = direct;
+    base["forwarded"] = forwardedCount;
+    base["markers"] = markers;
+    return generateJsonString(base);
+}
+
 FederateState* CommonCore::getFederateAt(local_federate_id federateID) const
 {
     /*
@@ -287,6 +543,11 @@ FederateState* CommonCore::getFederateAt(local_federate_id federateID) const
     #endif
     #endif
     */
+    const auto* snapshot = handleSnapshot.load(std::memory_order_acquire);
+    if (snapshot != nullptr && federateID.isValid() &&
+        federateID.baseValue() < static_cast<int32_t>(snapshot->federates.size())) {
+        return snapshot->federates[federateID.baseValue()];
+    }
     auto feds = federates.lock();
     return (*feds)[federateID.baseValue()];
 }
@@ -299,10 +560,9 @@ FederateState* CommonCore::getFederate(const std::string& federateName) const
 
 FederateState* CommonCore::getHandleFederate(interface_handle handle)
 {
-    auto local_fed_id = handles.read([handle](auto& hand) { return hand.getLocalFedID(handle); });
-    if (local_fed_id.isValid()) {
-        auto feds = federates.lock();
-        return (*feds)[local_fed_id.baseValue()];
+    const auto* handleInfo = getHandleInfo(handle);
+    if ((handleInfo != nullptr) && (handleInfo->local_fed_id.isValid())) {
+        return getFederateAt(handleInfo->local_fed_id);
     }
 
     return nullptr;
@@ -332,9 +592,42 @@ FederateState* CommonCore::getHandleFederateCore(interface_handle handle)
 
 const BasicHandleInfo* CommonCore::getHandleInfo(interface_handle handle) const
 {
+    const auto* snapshot = handleSnapshot.load(std::memory_order_acquire);
+    if (snapshot != nullptr) {
+        auto index = handle.baseValue();
+        if (index >= 0 && index < static_cast<int32_t>(snapshot->handles.size())) {
+            return snapshot->handles[index];
+        }
+    }
     return handles.read([handle](auto& hand) { return hand.getHandleInfo(handle.baseValue()); });
 }
 
+void CommonCore::publishHandleSnapshot()
+{
+    auto snapshot = std::make_unique<HandleSnapshot>();
+    handles.read([&snapshot](auto& hand) {
+        snapshot->handles.reserve(hand.size());
+        for (const auto& handleInfo : hand) {
+            snapshot->handles.push_back(&handleInfo);
+        }
+    });
+    {
+        auto feds = federates.lock();
+        snapshot->federates.reserve(feds->size());
+        for (size_t ii = 0; ii < feds->size(); ++ii) {
+            snapshot->federates.push_back((*feds)[ii]);
+        }
+    }
+    auto snapshots = handleSnapshots.lock();
+    const auto* current = handleSnapshot.load(std::memory_order_acquire);
+    if ((current != nullptr) && (current->handles.size() >= snapshot->handles.size()) &&
+        (current->federates.size() >= snapshot->federates.size())) {
+        return;
+    }
+    handleSnapshot.store(snapshot.get(), std::memory_order_release);
+    snapshots->push_back(std::move(snapshot));
+}
+
 const BasicHandleInfo* CommonCore::getLocalEndpoint(const std::string& name) const
 {
     return handles.read([&name](auto& hand) { return hand.getEndpoint(name); });
@@ -351,6 +644,286 @@ route_id CommonCore::getRoute(global_federate_id global_fedid) const
     return (fnd != routing_table.end()) ? fnd->second : parent_route_id;
 }
 
+void CommonCore::transmitToRemote(global_federate_id dest, const ActionMessage& cmd)
+{
+    if (!locationHeldMessages.empty()) {
+        locationHeldMessages.emplace_back(dest, cmd);
+        return;
+    }
+    auto pending = pendingDirectRoutes.find(dest);
+    if (pending != pendingDirectRoutes.end()) {
+        pending->second.held.push_back(cmd);
+        return;
+    }
+    if ((directRouteThreshold > 0) &&
+        ((cmd.action() == CMD_SEND_MESSAGE) || (cmd.action() == CMD_PUB)) &&
+        (routing_table.find(dest) == routing_table.end())) {
+        if (++remoteTrafficCount[dest] >= directRouteThreshold) {
+            remoteTrafficCount.erase(dest);
+            if (requestDirectRoute(dest)) {
+                pendingDirectRoutes[dest].held.push_back(cmd);
+                return;
+            }
+        }
+    }
+    transmit(getRoute(dest), cmd);
+}
+
+bool CommonCore::requestDirectRoute(global_federate_id fedID)
+{
+    if ((!fedID.isFederate()) || (isLocal(fedID)) ||
+        (routing_table.find(fedID) != routing_table.end()) ||
+        (pendingDirectRoutes.find(fedID) != pendingDirectRoutes.end())) {
+        return false;
+    }
+    if ((!global_broker_id_local.isValid()) || (global_broker_id_local == parent_broker_id)) {
+        return false;
+    }
+    // the request follows the same path through the brokers as everything already sent to the
+    // federate so once the reply comes back nothing sent earlier can be passed on the new route
+    ActionMessage request(CMD_SEND_ROUTE);
+    request.messageID = directRouteRequest;
+    request.source_id = global_broker_id_local;
+    request.dest_id = fedID;
+    transmit(parent_route_id, request);
+    auto requestTime = std::chrono::steady_clock::now();
+    pendingDirectRoutes.emplace(fedID, PendingDirectRoute{requestTime, {}});
+    // without a reply in time the held messages go through the broker
+    armDirectRouteTimer(requestTime + directRouteTimeout(tickTimer, timeout));
+    return true;
+}
+
+void CommonCore::armDirectRouteTimer(decltype(std::chrono::steady_clock::now()) expiration)
+{
+    if (!routeTimerWheel) {
+        routeTimerWheel = TimerWheel::getSharedWheel();
+    }
+    if (directRouteTimer < 0) {
+        directRouteTimer = routeTimerWheel->addTimer(expiration, [this]() {
+            ActionMessage expire(CMD_SEND_ROUTE);
+            expire.messageID = directRouteExpire;
+            addActionMessage(std::move(expire));
+        });
+    } else if (!routeTimerWheel->isActive(directRouteTimer)) {
+        routeTimerWheel->updateTimer(directRouteTimer, expiration);
+    }
+}
+
+bool CommonCore::usingDirectRoutes() const
+{
+    if (!pendingDirectRoutes.empty()) {
+        return true;
+    }
+    return std::any_of(routing_table.begin(), routing_table.end(), [](const auto& rt) {
+        return rt.second != parent_route_id;
+    });
+}
+
+void CommonCore::holdForEndpointLocation(ActionMessage& message)
+{
+    const auto& endpointName = message.getString(targetStringLoc);
+    if (pendingEndpointLocations.find(endpointName) == pendingEndpointLocations.end()) {
+        // the broker answers with the handle of the endpoint or an error if it does not exist
+        ActionMessage request(CMD_ENDPOINT_LOCATION);
+        request.source_id = message.source_id;
+        request.dest_id = parent_broker_id;
+        request.name = endpointName;
+        transmit(parent_route_id, request);
+        auto requestTime = std::chrono::steady_clock::now();
+        pendingEndpointLocations.emplace(endpointName, requestTime);
+        armDirectRouteTimer(requestTime + directRouteTimeout(tickTimer, timeout));
+    }
+    locationHeldMessages.emplace_back(parent_broker_id, message);
+}
+
+void CommonCore::releaseLocationHeldMessages()
+{
+    std::vector<std::pair<global_federate_id, ActionMessage>> held;
+    held.swap(locationHeldMessages);
+    for (auto msg = held.begin(); msg != held.end(); ++msg) {
+        if ((msg->second.action() != CMD_SEND_MESSAGE) ||
+            (msg->second.dest_id != parent_broker_id)) {
+            transmitToRemote(msg->first, msg->second);
+            continue;
+        }
+        const auto& endpointName = msg->second.getString(targetStringLoc);
+        if (pendingEndpointLocations.find(endpointName) != pendingEndpointLocations.end()) {
+            // everything after this message waits for the next reply
+            locationHeldMessages.insert(locationHeldMessages.end(),
+                                        std::make_move_iterator(msg),
+                                        std::make_move_iterator(held.end()));
+            return;
+        }
+        auto kfnd = knownExternalEndpoints.find(endpointName);
+        if (kfnd != knownExternalEndpoints.end()) {
+            msg->second.setDestination(kfnd->second);
+            transmitToRemote(msg->second.dest_id, msg->second);
+        } else {
+            transmit(parent_route_id, msg->second);
+        }
+    }
+}
+
+void CommonCore::expireDirectRouteRequests()
+{
+    auto now = std::chrono::steady_clock::now();
+    auto nextExpiration = decltype(now)::max();
+    for (auto pending = pendingDirectRoutes.begin(); pending != pendingDirectRoutes.end();) {
+        auto expiration = pending->second.requestTime + directRouteTimeout(tickTimer, timeout);
+        if (expiration > now) {
+            nextExpiration = (std::min)(nextExpiration, expiration);
+            ++pending;
+            continue;
+        }
+        LOG_WARNING(global_broker_id_local,
+                    getIdentifier(),
+                    fmt::format("no reply to direct route request for federate {}, using broker",
+                                pending->first.baseValue()));
+        // a parent route entry marks the federate so no further requests are made
+        routing_table[pending->first] = parent_route_id;
+        for (auto& held : pending->second.held) {
+            transmit(parent_route_id, held);
+        }
+        pending = pendingDirectRoutes.erase(pending);
+    }
+    bool locationExpired{false};
+    for (auto pending = pendingEndpointLocations.begin();
+         pending != pendingEndpointLocations.end();) {
+        auto expiration = pending->second + directRouteTimeout(tickTimer, timeout);
+        if (expiration > now) {
+            nextExpiration = (std::min)(nextExpiration, expiration);
+            ++pending;
+            continue;
+        }
+        LOG_WARNING(global_broker_id_local,
+                    getIdentifier(),
+                    fmt::format("no reply to location request for endpoint {}, routing by name",
+                                pending->first));
+        pending = pendingEndpointLocations.erase(pending);
+        locationExpired = true;
+    }
+    if (locationExpired) {
+        releaseLocationHeldMessages();
+    }
+    if (!pendingDirectRoutes.empty() || !pendingEndpointLocations.empty()) {
+        routeTimerWheel->updateTimer(directRouteTimer, nextExpiration);
+    }
+}
+
+void CommonCore::removeDirectRoute(global_federate_id fedID)
+{
+    remoteTrafficCount.erase(fedID);
+    auto pending = pendingDirectRoutes.find(fedID);
+    if (pending != pendingDirectRoutes.end()) {
+        for (auto& held : pending->second.held) {
+            transmit(parent_route_id, held);
+        }
+        pendingDirectRoutes.erase(pending);
+    }
+    auto route = routing_table.find(fedID);
+    if (route == routing_table.end()) {
+        return;
+    }
+    auto rid = route->second;
+    routing_table.erase(route);
+    if (rid == parent_route_id) {
+        return;
+    }
+    bool inUse = std::any_of(routing_table.begin(), routing_table.end(), [rid](const auto& rt) {
+        return rt.second == rid;
+    });
+    if (!inUse) {
+        removeRoute(rid);
+        LOG_CONNECTIONS(global_broker_id_local,
+                        getIdentifier(),
+                        fmt::format("removed direct route to core {}", rid.baseValue()));
+    }
+}
+
+std::string CommonCore::generateDirectRouteInfo() const
+{
+    Json::Value base;
+    base["name"] = getIdentifier();
+    base["id"] = global_broker_id_local.baseValue();
+    base["routes"] = Json::arrayValue;
+    for (const auto& route : routing_table) {
+        if (route.second == parent_route_id) {
+            continue;
+        }
+        Json::Value routeBlock;
+        routeBlock["federate"] = route.first.baseValue();
+        routeBlock["route"] = route.second.baseValue();
+        base["routes"].append(routeBlock);
+    }
+    base["pending"] = Json::arrayValue;
+    for (const auto& pending : pendingDirectRoutes) {
+        base["pending"].append(pending.first.baseValue());
+    }
+    return generateJsonString(base);
+}
+
+void CommonCore::processDirectRouteCommand(ActionMessage& cmd)
+{
+    switch (cmd.messageID) {
+        case directRouteRegister: {
+            if (loopHandles.getEndpoint(cmd.name) != nullptr) {
+                // local endpoints don't need a route
+                break;
+            }
+            auto kfnd = knownExternalEndpoints.find(cmd.name);
+            if (kfnd != knownExternalEndpoints.end()) {
+                requestDirectRoute(kfnd->second.fed_id);
+            } else {
+                directRouteEndpoints.insert(cmd.name);
+            }
+        } break;
+        case directRouteRequest: {
+            ActionMessage reply(CMD_SEND_ROUTE);
+            reply.messageID = directRouteReply;
+            reply.source_id = global_broker_id_local;
+            reply.dest_id = cmd.source_id;
+            reply.setExtraDestData(cmd.dest_id.baseValue());
+            if (isLocal(cmd.dest_id)) {
+                reply.payload = getAddress();
+            }
+            transmit(parent_route_id, reply);
+        } break;
+        case directRouteReply: {
+            global_federate_id fedID(cmd.getExtraDestData());
+            auto pending = pendingDirectRoutes.find(fedID);
+            if (pending == pendingDirectRoutes.end()) {
+                break;
+            }
+            route_id rid{parent_route_id};
+            if (!cmd.payload.empty()) {
+                rid = route_id{cmd.source_id.baseValue()};
+                bool known = std::any_of(routing_table.begin(),
+                                         routing_table.end(),
+                                         [rid](const auto& rt) { return rt.second == rid; });
+                if (!known) {
+                    addRoute(rid, 0, cmd.payload);
+                    LOG_CONNECTIONS(global_broker_id_local,
+                                    getIdentifier(),
+                                    fmt::format("added direct route to core {} at {}",
+                                                cmd.source_id.baseValue(),
+                                                cmd.payload));
+                }
+            }
+            // a parent route entry marks the federate so no further requests are made
+            routing_table[fedID] = rid;
+            for (auto& held : pending->second.held) {
+                transmit(rid, held);
+            }
+            pendingDirectRoutes.erase(pending);
+        } break;
+        case directRouteExpire:
+            expireDirectRouteRequests();
+            break;
+        default:
+            break;
+    }
+}
+
 bool CommonCore::isConfigured() const
 {
     return (brokerState >= broker_state_t::configured);
@@ -372,7 +945,7 @@ void CommonCore::globalError(local_federate_id federateID,
     m.source_id = fed->global_id.load();
     m.messageID = errorCode;
     m.payload = errorString;
-    addActionMessage(m);
+    addFederateMessage(fed, m);
     fed->addAction(m);
     iteration_result ret = iteration_result::next_step;
     while (ret != iteration_result::error) {
@@ -395,7 +968,7 @@ void CommonCore::localError(local_federate_id federateID,
     m.source_id = fed->global_id.load();
     m.messageID = errorCode;
     m.payload = errorString;
-    addActionMessage(m);
+    addFederateMessage(fed, m);
     fed->addAction(m);
     iteration_result ret = iteration_result::next_step;
     while (ret != iteration_result::error) {
@@ -415,7 +988,7 @@ void CommonCore::finalize(local_federate_id federateID)
     ActionMessage bye(CMD_DISCONNECT);
     bye.source_id = fed->global_id.load();
     bye.dest_id = bye.source_id;
-    addActionMessage(bye);
+    addFederateMessage(fed, bye);
     fed->finalize();
 }
 
@@ -538,7 +1111,12 @@ iteration_result CommonCore::enterExecutingMode(local_federate_id federateID,
     ActionMessage exec(CMD_EXEC_CHECK);
     fed->addAction(exec);
     // TODO(PT): check for error conditions?
-    return fed->enterExecutingMode(iterate);
+    auto res = fed->enterExecutingMode(iterate);
+    if (res == iteration_result::next_step) {
+        // the interfaces are fixed so API calls can look up handles without locking
+        publishHandleSnapshot();
+    }
+    return res;
 }
 
 local_federate_id CommonCore::registerFederate(const std::string& name,
@@ -918,6 +1496,87 @@ interface_handle CommonCore::registerInput(local_federate_id federateID,
     return id;
 }
 
+std::vector<interface_handle>
+    CommonCore::registerInterfaces(local_federate_id federateID,
+                                   const std::vector<InterfaceDefinition>& interfaces)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("federateID not valid (registerInterfaces)"));
+    }
+    std::vector<interface_handle> ids;
+    if (interfaces.empty()) {
+        return ids;
+    }
+    LOG_INTERFACES(parent_broker_id,
+                   fed->getIdentifier(),
+                   fmt::format("registering {} interfaces", interfaces.size()));
+    ids.reserve(interfaces.size());
+    const auto flags = fed->getInterfaceFlags();
+    const auto fedID = fed->global_id.load();
+    handles.modify([&](auto& hand) {
+        // check every key first so a failure does not leave a partial registration
+        std::unordered_set<std::string> newKeys;
+        for (const auto& def : interfaces) {
+            if (def.key.empty()) {
+                continue;
+            }
+            const BasicHandleInfo* existing{nullptr};
+            switch (def.kind) {
+                case interface_kind::publication:
+                    existing = hand.getPublication(def.key);
+                    break;
+                case interface_kind::input:
+                    existing = hand.getInput(def.key);
+                    break;
+                case interface_kind::endpoint:
+                    existing = hand.getEndpoint(def.key);
+                    break;
+                default:
+                    throw(InvalidParameter("unrecognized interface kind (registerInterfaces)"));
+            }
+            if ((existing != nullptr) ||
+                (!newKeys.insert(std::string(1, static_cast<char>(def.kind)) + def.key).second)) {
+                throw(RegistrationFailure(fmt::format("interface key {} already exists", def.key)));
+            }
+        }
+        for (const auto& def : interfaces) {
+            auto& hndl = hand.addHandle(
+                fedID, static_cast<handle_type>(def.kind), def.key, def.type, def.units);
+            hndl.local_fed_id = fed->local_id;
+            hndl.flags = flags;
+            ids.push_back(hndl.getInterfaceHandle());
+        }
+    });
+    fed->createInterfaces(interfaces, ids);
+
+    for (std::size_t ii = 0; ii < interfaces.size(); ++ii) {
+        const auto& def = interfaces[ii];
+        ActionMessage m(CMD_REG_PUB);
+        switch (def.kind) {
+            case interface_kind::publication:
+            default:
+                m.setStringData(def.type, def.units);
+                break;
+            case interface_kind::input:
+                m.setAction(CMD_REG_INPUT);
+                m.setStringData(def.type, def.units);
+                break;
+            case interface_kind::endpoint:
+                m.setAction(CMD_REG_ENDPOINT);
+                m.setStringData(def.type);
+                break;
+        }
+        m.source_id = fedID;
+        m.source_handle = ids[ii];
+        m.name = def.key;
+        m.flags = flags;
+        // the queue processing groups the registrations into packages for the broker
+        actionQueue.push(std::move(m));
+    }
+    return ids;
+}
+
 interface_handle CommonCore::getInput(local_federate_id federateID, const std::string& key) const
 {
     const auto* ci = handles.read([&key](auto& hand) { return hand.getInput(key); });
@@ -1244,7 +1903,10 @@ void CommonCore::addSourceTarget(interface_handle handle, const std::string& tar
     addActionMessage(std::move(cmd));
 }
 
-void CommonCore::setValue(interface_handle handle, const char* data, uint64_t len)
+const BasicHandleInfo* CommonCore::checkValueTransmission(interface_handle handle,
+                                                          const char* data,
+                                                          uint64_t len,
+                                                          std::vector<global_handle>& subs)
 {
     const auto* handleInfo = getHandleInfo(handle);
     if (handleInfo == nullptr) {
@@ -1254,58 +1916,83 @@ void CommonCore::setValue(interface_handle handle, const char* data, uint64_t le
         throw(InvalidIdentifier("handle does not point to a publication or control output"));
     }
     if (checkActionFlag(*handleInfo, disconnected_flag)) {
-        return;
+        return nullptr;
     }
     if (!handleInfo->used) {
-        return;  // if the value is not required do nothing
+        return nullptr;  // if the value is not required do nothing
     }
     auto* fed = getFederateAt(handleInfo->local_fed_id);
-    if (fed->checkAndSetValue(handle, data, len)) {
-        if (fed->loggingLevel() >= helics_log_level_data) {
-            fed->logMessage(helics_log_level_data,
-                            fed->getIdentifier(),
-                            fmt::format("setting value for {} size {}", handleInfo->key, len));
-        }
-        auto subs = fed->getSubscribers(handle);
-        if (subs.empty()) {
-            return;
-        }
-        if (subs.size() == 1) {
-            ActionMessage mv(CMD_PUB);
-            mv.source_id = handleInfo->getFederateId();
-            mv.source_handle = handle;
-            mv.setDestination(subs[0]);
-            mv.counter = static_cast<uint16_t>(fed->getCurrentIteration());
-            mv.payload = std::string(data, len);
-            mv.actionTime = fed->nextAllowedSendTime();
-
-            actionQueue.push(std::move(mv));
-            return;
-        }
-        ActionMessage package(CMD_MULTI_MESSAGE);
-        package.source_id = handleInfo->getFederateId();
-        package.source_handle = handle;
+    if (!fed->checkAndSetValue(handle, data, len)) {
+        return nullptr;
+    }
+    if (fed->loggingLevel() >= helics_log_level_data) {
+        fed->logMessage(helics_log_level_data,
+                        fed->getIdentifier(),
+                        fmt::format("setting value for {} size {}", handleInfo->key, len));
+    }
+    subs = fed->getSubscribers(handle);
+    return (subs.empty()) ? nullptr : handleInfo;
+}
 
+void CommonCore::transmitValue(const BasicHandleInfo& pubInfo,
+                               const std::vector<global_handle>& subs,
+                               std::string&& data)
+{
+    auto* fed = getFederateAt(pubInfo.local_fed_id);
+    auto handle = pubInfo.getInterfaceHandle();
+    if (subs.size() == 1) {
         ActionMessage mv(CMD_PUB);
-        mv.source_id = handleInfo->getFederateId();
+        mv.source_id = pubInfo.getFederateId();
         mv.source_handle = handle;
+        mv.setDestination(subs[0]);
         mv.counter = static_cast<uint16_t>(fed->getCurrentIteration());
-        mv.payload = std::string(data, len);
+        mv.payload = std::move(data);
         mv.actionTime = fed->nextAllowedSendTime();
 
-        for (auto& target : subs) {
-            mv.setDestination(target);
-            auto res = appendMessage(package, mv);
-            if (res < 0)  // deal with max package size if there are a lot of subscribers
-            {
-                actionQueue.push(std::move(package));
-                package = ActionMessage(CMD_MULTI_MESSAGE);
-                package.source_id = handleInfo->getFederateId();
-                package.source_handle = handle;
-                appendMessage(package, mv);
-            }
+        addFederateMessage(fed, std::move(mv));
+        return;
+    }
+    ActionMessage package(CMD_MULTI_MESSAGE);
+    package.source_id = pubInfo.getFederateId();
+    package.source_handle = handle;
+
+    ActionMessage mv(CMD_PUB);
+    mv.source_id = pubInfo.getFederateId();
+    mv.source_handle = handle;
+    mv.counter = static_cast<uint16_t>(fed->getCurrentIteration());
+    mv.payload = std::move(data);
+    mv.actionTime = fed->nextAllowedSendTime();
+
+    for (const auto& target : subs) {
+        mv.setDestination(target);
+        auto res = appendMessage(package, mv);
+        if (res < 0)  // deal with max package size if there are a lot of subscribers
+        {
+            addFederateMessage(fed, std::move(package));
+            package = ActionMessage(CMD_MULTI_MESSAGE);
+            package.source_id = pubInfo.getFederateId();
+            package.source_handle = handle;
+            appendMessage(package, mv);
         }
-        actionQueue.push(std::move(package));
+    }
+    addFederateMessage(fed, std::move(package));
+}
+
+void CommonCore::setValue(interface_handle handle, const char* data, uint64_t len)
+{
+    std::vector<global_handle> subs;
+    const auto* handleInfo = checkValueTransmission(handle, data, len, subs);
+    if (handleInfo != nullptr) {
+        transmitValue(*handleInfo, subs, std::string(data, len));
+    }
+}
+
+void CommonCore::setValue(interface_handle handle, std::string&& data)
+{
+    std::vector<global_handle> subs;
+    const auto* handleInfo = checkValueTransmission(handle, data.data(), data.size(), subs);
+    if (handleInfo != nullptr) {
+        transmitValue(*handleInfo, subs, std::move(data));
     }
 }
 
@@ -1350,6 +2037,16 @@ const std::vector<interface_handle>& CommonCore::getValueUpdates(local_federate_
     return fed->getEvents();
 }
 
+const std::vector<InputUpdate>& CommonCore::getInputUpdates(local_federate_id federateID)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("federateID not valid (getInputUpdates)"));
+    }
+    std::lock_guard<FederateState> lk(*fed);
+    return fed->getInputUpdates();
+}
+
 interface_handle CommonCore::registerEndpoint(local_federate_id federateID,
                                               const std::string& name,
                                               const std::string& type)
@@ -1495,6 +2192,7 @@ FilterInfo* CommonCore::createFilter(global_broker_id dest,
                                              type_out,
                                              false);
 
+    filtersPresent.store(true);
     auto* retTarget = filt.get();
     auto actualKey = key;
     retTarget->cloning = cloning;
@@ -1513,10 +2211,19 @@ FilterInfo* CommonCore::createFilter(global_broker_id dest,
     return retTarget;
 }
 
-void CommonCore::registerFrequentCommunicationsPair(const std::string& /*source*/,
-                                                    const std::string& /*dest*/)
+void CommonCore::registerFrequentCommunicationsPair(const std::string& source,
+                                                    const std::string& dest)
 {
-    // std::lock_guard<std::mutex> lock (_mutex);
+    const auto* hndl = getLocalEndpoint(source);
+    if (hndl == nullptr) {
+        throw(InvalidIdentifier("source must be a local endpoint"));
+    }
+    ActionMessage route(CMD_SEND_ROUTE);
+    route.messageID = directRouteRegister;
+    route.source_id = hndl->getFederateId();
+    route.source_handle = hndl->getInterfaceHandle();
+    route.name = dest;
+    addActionMessage(std::move(route));
 }
 
 void CommonCore::makeConnections(const std::string& file)
@@ -1589,7 +2296,7 @@ void CommonCore::send(interface_handle sourceHandle,
     m.payload = std::string(data, length);
     m.setStringData(destination, hndl->key, hndl->key);
     m.actionTime = fed->nextAllowedSendTime();
-    addActionMessage(std::move(m));
+    addFederateMessage(fed, std::move(m));
 }
 
 void CommonCore::sendEvent(Time time,
@@ -1608,12 +2315,13 @@ void CommonCore::sendEvent(Time time,
     ActionMessage m(CMD_SEND_MESSAGE);
     m.source_handle = sourceHandle;
     m.source_id = hndl->getFederateId();
-    auto minTime = getFederateAt(hndl->local_fed_id)->nextAllowedSendTime();
+    auto* fed = getFederateAt(hndl->local_fed_id);
+    auto minTime = fed->nextAllowedSendTime();
     m.actionTime = std::max(time, minTime);
     m.payload = std::string(data, length);
     m.setStringData(destination, hndl->key, hndl->key);
     m.messageID = ++messageCounter;
-    addActionMessage(std::move(m));
+    addFederateMessage(fed, std::move(m));
 }
 
 void CommonCore::sendMessage(interface_handle sourceHandle, std::unique_ptr<Message> message)
@@ -1655,7 +2363,7 @@ void CommonCore::sendMessage(interface_handle sourceHandle, std::unique_ptr<Mess
                         "",
                         fmt::format("receive_message {}", prettyPrintString(m)));
     }
-    addActionMessage(std::move(m));
+    addFederateMessage(fed, std::move(m));
 }
 
 void CommonCore::deliverMessage(ActionMessage& message)
@@ -1667,12 +2375,24 @@ void CommonCore::deliverMessage(ActionMessage& message)
                 loopHandles.getEndpoint(message.getString(targetStringLoc)) :
                 loopHandles.findHandle(message.getDest());
             if (localP == nullptr) {
-                auto kfnd = knownExternalEndpoints.find(message.getString(targetStringLoc));
-                if (kfnd != knownExternalEndpoints.end()) {  // destination is known
-                    transmit(kfnd->second, message);
-                } else {
+                if (message.dest_id == parent_broker_id) {
+                    auto kfnd = knownExternalEndpoints.find(message.getString(targetStringLoc));
+                    if (kfnd != knownExternalEndpoints.end()) {  // destination is known
+                        // route by handle so the brokers don't need to search by name
+                        message.setDestination(kfnd->second);
+                        transmitToRemote(message.dest_id, message);
+                        return;
+                    }
+                    if (usingDirectRoutes() || !locationHeldMessages.empty()) {
+                        // the broker path is slower than the direct routes so the message waits
+                        // for the location of the endpoint to keep its place in line
+                        holdForEndpointLocation(message);
+                        return;
+                    }
                     transmit(parent_route_id, message);
+                    return;
                 }
+                transmitToRemote(message.dest_id, message);
                 return;
             }
             // now we deal with local processing
@@ -1776,7 +2496,7 @@ void CommonCore::deliverMessage(ActionMessage& message)
         case CMD_NULL_MESSAGE:
         case CMD_NULL_DEST_MESSAGE:
         default: {
-            transmit(getRoute(message.dest_id), message);
+            transmitToRemote(message.dest_id, message);
         } break;
     }
 }
@@ -1942,6 +2662,7 @@ FilterCoordinator* CommonCore::getFilterCoordinator(interface_handle handle)
     if (fnd == filterCoord.end()) {
         if (brokerState < broker_state_t::operating) {
             // just make a dummy filterFunction so we have something to return
+            filtersPresent.store(true);
             auto ff = std::make_unique<FilterCoordinator>();
             auto* ffp = ff.get();
             filterCoord.emplace(handle, std::move(ff));
@@ -1969,6 +2690,8 @@ enum subqueries : std::uint16_t {
     dependency_graph = 3,
     data_flow_graph = 4,
     global_state = 6,
+    critical_path = 7,
+    time_blockers = 8,
 };
 
 static const std::map<std::string, std::pair<std::uint16_t, bool>> mapIndex{
@@ -1976,6 +2699,8 @@ static const std::map<std::string, std::pair<std::uint16_t, bool>> mapIndex{
     {"dependency_graph", {dependency_graph, false}},
     {"data_flow_graph", {data_flow_graph, false}},
     {"global_state", {global_state, true}},
+    {"critical_path", {critical_path, true}},
+    {"time_blockers", {time_blockers, true}},
 };
 
 void CommonCore::setQueryCallback(local_federate_id federateID,
@@ -1988,6 +2713,44 @@ void CommonCore::setQueryCallback(local_federate_id federateID,
     fed->setQueryCallback(std::move(queryFunction));
 }
 
+void CommonCore::setCheckpointCallbacks(local_federate_id federateID,
+                                        std::function<std::string()> saveFunction,
+                                        std::function<void(const std::string&)> restoreFunction)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("FederateID is invalid (setCheckpointCallbacks)"));
+    }
+    std::lock_guard<FederateState> lk(*fed);
+    fed->setCheckpointCallbacks(std::move(saveFunction), std::move(restoreFunction));
+}
+
+void CommonCore::checkpointFederate(local_federate_id federateID, const std::string& filename)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("FederateID is invalid (checkpointFederate)"));
+    }
+    if (fed->getState() != HELICS_EXECUTING) {
+        throw(InvalidFunctionCall("checkpoints can only be generated in executing mode"));
+    }
+    std::lock_guard<FederateState> lk(*fed);
+    fed->saveCheckpoint(filename);
+}
+
+Time CommonCore::restoreFederate(local_federate_id federateID, const std::string& filename)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("FederateID is invalid (restoreFederate)"));
+    }
+    if (fed->getState() != HELICS_INITIALIZING) {
+        throw(InvalidFunctionCall("checkpoints can only be restored in initializing mode"));
+    }
+    std::lock_guard<FederateState> lk(*fed);
+    return fed->restoreCheckpoint(filename);
+}
+
 std::string CommonCore::filteredEndpointQuery(const FederateState* fed) const
 {
     Json::Value base;
@@ -2091,7 +2854,7 @@ std::string CommonCore::quickCoreQueries(const std::string& queryStr) const
 {
     if ((queryStr == "queries") || (queryStr == "available_queries")) {
         return "[isinit;isconnected;exists;name;identifier;address;queries;address;federates;inputs;endpoints;filtered_endpoints;"
-               "publications;filters;version;version_all;counter;federate_map;dependency_graph;data_flow_graph;dependencies;dependson;dependents;current_time;global_time;global_state;current_state]";
+               "publications;filters;version;version_all;counter;federate_map;dependency_graph;data_flow_graph;dependencies;dependson;dependents;current_time;global_time;global_state;current_state;flight_recorder;critical_path;time_blockers;compression;processing_lanes;direct_routes]";
     }
     if (queryStr == "isconnected") {
         return (isConnected()) ? "true" : "false";
@@ -2311,6 +3074,9 @@ std::string CommonCore::coreQuery(const std::string& queryStr) const
 
         initializeMapBuilder(queryStr, index, mi->second.second);
         if (std::get<0>(mapBuilders[index]).isCompleted()) {
+            if (index == critical_path) {
+                generateCriticalPathSummary(std::get<0>(mapBuilders[index]).getJValue());
+            }
             if (!mi->second.second) {
                 auto center = generateMapObjectCounter();
                 std::get<0>(mapBuilders[index]).setCounterCode(center);
@@ -2346,6 +3112,18 @@ std::string CommonCore::coreQuery(const std::string& queryStr) const
         loadBasicJsonInfo(base, [](Json::Value& /*val*/, const FedInfo& /*fed*/) {});
         return generateJsonString(base);
     }
+    if (queryStr == "flight_recorder") {
+        return dumpFlightRecorder();
+    }
+    if (queryStr == "compression") {
+        return generateCompressionStatistics();
+    }
+    if (queryStr == "processing_lanes") {
+        return generateLaneStatistics();
+    }
+    if (queryStr == "direct_routes") {
+        return generateDirectRouteInfo();
+    }
     return "#invalid";
 }
 
@@ -2444,6 +3222,9 @@ void CommonCore::processPriorityCommand(ActionMessage&& command)
               fmt::format("|| priority_cmd:{} from {}",
                           prettyPrintString(command),
                           command.source_id.baseValue()));
+    if (!registrationBatch.empty()) {
+        transmitRegistrationBatch();
+    }
     switch (command.action()) {
         case CMD_PING_PRIORITY:
             if (command.dest_id == global_broker_id_local) {
@@ -2747,6 +3528,19 @@ void CommonCore::processCommand(ActionMessage&& command)
               fmt::format("|| cmd:{} from {}",
                           prettyPrintString(command),
                           command.source_id.baseValue()));
+    if (!registrationBatch.empty()) {
+        switch (command.action()) {
+            case CMD_REG_INPUT:
+            case CMD_REG_ENDPOINT:
+            case CMD_REG_PUB:
+            case CMD_REG_FILTER:
+                break;
+            default:
+                // anything else may depend on the registrations reaching the broker first
+                transmitRegistrationBatch();
+                break;
+        }
+    }
     switch (command.action()) {
         case CMD_IGNORE:
             break;
@@ -2908,6 +3702,10 @@ void CommonCore::processCommand(ActionMessage&& command)
                     }
                 }
             } else {
+                if (command.source_id.isFederate() && !isLocal(command.source_id)) {
+                    // a remote federate is leaving so any direct route to it is no longer needed
+                    removeDirectRoute(command.source_id);
+                }
                 routeMessage(command);
             }
 
@@ -3101,6 +3899,41 @@ void CommonCore::processCommand(ActionMessage&& command)
         case CMD_ADD_NAMED_FILTER:
             checkForNamedInterface(command);
             break;
+        case CMD_LANE_SYNC:
+            if (command.messageID >= 0 &&
+                command.messageID < static_cast<int32_t>(processingLanes.size())) {
+                processingLanes[command.messageID]->syncedSequence.store(command.sequenceID);
+            }
+            break;
+        case CMD_SEND_ROUTE:
+            processDirectRouteCommand(command);
+            break;
+        case CMD_ENDPOINT_LOCATION:
+            if (command.dest_id == global_broker_id_local || isLocal(command.dest_id)) {
+                if (checkActionFlag(command, error_flag)) {
+                    // the endpoint is gone so messages to it go back to being routed by name
+                    auto kfnd = knownExternalEndpoints.find(command.name);
+                    if ((kfnd != knownExternalEndpoints.end()) &&
+                        (kfnd->second == command.getSource())) {
+                        knownExternalEndpoints.erase(kfnd);
+                    }
+                    // a reply without a source means the broker could not find the endpoint
+                    if (command.source_id.isValid()) {
+                        removeDirectRoute(command.source_id);
+                    }
+                } else {
+                    knownExternalEndpoints[command.name] = command.getSource();
+                    if (directRouteEndpoints.erase(command.name) > 0) {
+                        requestDirectRoute(command.source_id);
+                    }
+                }
+                if (pendingEndpointLocations.erase(command.name) > 0) {
+                    releaseLocationHeldMessages();
+                }
+            } else {
+                routeMessage(std::move(command));
+            }
+            break;
         case CMD_ADD_ENDPOINT:
         case CMD_ADD_FILTER:
         case CMD_ADD_SUBSCRIBER:
@@ -3174,6 +4007,22 @@ void CommonCore::processCommand(ActionMessage&& command)
     }
 }
 
+void CommonCore::transmitRegistrationBatch()
+{
+    auto packages = packageMultiMessages(std::move(registrationBatch), defaultPackageSize);
+    registrationBatch.clear();
+    for (auto& package : packages) {
+        transmit(parent_route_id, std::move(package));
+    }
+}
+
+void CommonCore::processQueueIdle()
+{
+    if (!registrationBatch.empty()) {
+        transmitRegistrationBatch();
+    }
+}
+
 void CommonCore::registerInterface(ActionMessage& command)
 {
     if (command.dest_id == parent_broker_id) {
@@ -3238,7 +4087,13 @@ void CommonCore::registerInterface(ActionMessage& command)
                 return;
         }
         if (!command.name.empty()) {
-            transmit(parent_route_id, std::move(command));
+            // registrations tend to come in large groups so hold them until the queue is empty
+            registrationBatch.push_back(std::move(command));
+            if (actionQueue.empty()) {
+                transmitRegistrationBatch();
+            } else {
+                idleProcessingPending = true;
+            }
         }
     } else if (command.dest_id == global_broker_id_local) {
         if (command.action() == CMD_REG_ENDPOINT) {
@@ -3641,6 +4496,9 @@ void CommonCore::processQueryResponse(const ActionMessage& m)
         auto& builder = std::get<0>(mapBuilders[m.counter]);
         auto& requestors = std::get<1>(mapBuilders[m.counter]);
         if (builder.addComponent(m.payload, m.messageID)) {
+            if (m.counter == critical_path) {
+                generateCriticalPathSummary(builder.getJValue());
+            }
             auto str = builder.generate();
             for (int ii = 0; ii < static_cast<int>(requestors.size()) - 1; ++ii) {
                 if (requestors[ii].dest_id == global_broker_id_local) {
@@ -4075,8 +4933,7 @@ void CommonCore::routeMessage(ActionMessage& cmd, global_federate_id dest)
             }
         }
     } else {
-        auto route = getRoute(dest);
-        transmit(route, cmd);
+        transmitToRemote(dest, cmd);
     }
 }
 
@@ -4100,8 +4957,7 @@ void CommonCore::routeMessage(const ActionMessage& cmd)
             }
         }
     } else {
-        auto route = getRoute(cmd.dest_id);
-        transmit(route, cmd);
+        transmitToRemote(cmd.dest_id, cmd);
     }
 }
 
@@ -4128,8 +4984,7 @@ void CommonCore::routeMessage(ActionMessage&& cmd, global_federate_id dest)
             }
         }
     } else {
-        auto route = getRoute(dest);
-        transmit(route, cmd);
+        transmitToRemote(dest, cmd);
     }
 }
 
@@ -4153,8 +5008,7 @@ void CommonCore::routeMessage(ActionMessage&& cmd)
             }
         }
     } else {
-        auto route = getRoute(dest);
-        transmit(route, cmd);
+        transmitToRemote(dest, cmd);
     }
 }
 
@@ -4441,8 +5295,7 @@ void CommonCore::processMessageFilter(ActionMessage& cmd)
                 */
         }
     } else {
-        auto route = getRoute(cmd.dest_id);
-        transmit(route, cmd);
+        transmitToRemote(cmd.dest_id, cmd);
     }
 }
 
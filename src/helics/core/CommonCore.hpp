@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/concurrency/DelayedObjects.hpp"
 #include "gmlc/concurrency/TriggerVariable.hpp"
 #include "gmlc/containers/AirLock.hpp"
+#include "gmlc/containers/BlockingQueue.hpp"
 #include "gmlc/containers/DualMappedPointerVector.hpp"
 #include "gmlc/containers/DualMappedVector.hpp"
 #include "gmlc/containers/MappedPointerVector.hpp"
@@ -26,10 +27,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "json/forwards.h"
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <set>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -42,6 +46,7 @@ class BasicHandleInfo;
 class FilterCoordinator;
 class FilterInfo;
 class TimeoutMonitor;
+class TimerWheel;
 enum class handle_type : char;
 /** enumeration of possible operating conditions for a federate*/
 enum class operation_state : std::uint8_t { operating = 0, error = 5, disconnected = 10 };
@@ -129,6 +134,9 @@ class CommonCore: public Core, public BrokerBase {
                                            const std::string& key,
                                            const std::string& type,
                                            const std::string& units) override final;
+    virtual std::vector<interface_handle>
+        registerInterfaces(local_federate_id federateID,
+                           const std::vector<InterfaceDefinition>& interfaces) override final;
 
     virtual interface_handle getInput(local_federate_id federateID,
                                       const std::string& key) const override final;
@@ -151,12 +159,15 @@ class CommonCore: public Core, public BrokerBase {
     virtual const std::string& getInjectionType(interface_handle handle) const override final;
     virtual const std::string& getExtractionType(interface_handle handle) const override final;
     virtual void setValue(interface_handle handle, const char* data, uint64_t len) override final;
+    virtual void setValue(interface_handle handle, std::string&& data) override final;
     virtual const std::shared_ptr<const data_block>& getValue(interface_handle handle,
                                                               uint32_t* inputIndex) override final;
     virtual const std::vector<std::shared_ptr<const data_block>>&
         getAllValues(interface_handle handle) override final;
     virtual const std::vector<interface_handle>&
         getValueUpdates(local_federate_id federateID) override final;
+    virtual const std::vector<InputUpdate>&
+        getInputUpdates(local_federate_id federateID) override final;
     virtual interface_handle registerEndpoint(local_federate_id federateID,
                                               const std::string& name,
                                               const std::string& type) override final;
@@ -201,6 +212,14 @@ class CommonCore: public Core, public BrokerBase {
     virtual void setFilterOperator(interface_handle filter,
                                    std::shared_ptr<FilterOperator> callback) override final;
 
+    /** add a message originating from a local federate
+    @details if processing lanes are in use the message goes to the lane of the federate,
+    otherwise it goes directly to the main processing queue
+    @param fed the federate sending the message
+    @param message the message to add*/
+    void addFederateMessage(const FederateState* fed, const ActionMessage& message);
+    /** add a message originating from a local federate*/
+    void addFederateMessage(const FederateState* fed, ActionMessage&& message);
     /** set the local identification for the core*/
     void setIdentifier(const std::string& name);
     /** get the local identifier for the core*/
@@ -220,6 +239,14 @@ class CommonCore: public Core, public BrokerBase {
     virtual void
         setQueryCallback(local_federate_id federateID,
                          std::function<std::string(const std::string&)> queryFunction) override;
+    virtual void
+        setCheckpointCallbacks(local_federate_id federateID,
+                               std::function<std::string()> saveFunction,
+                               std::function<void(const std::string&)> restoreFunction) override;
+    virtual void checkpointFederate(local_federate_id federateID,
+                                    const std::string& filename) override;
+    virtual Time restoreFederate(local_federate_id federateID,
+                                 const std::string& filename) override;
     virtual void setGlobal(const std::string& valueName, const std::string& value) override;
     virtual bool connect() override final;
     virtual bool isConnected() const override final;
@@ -244,10 +271,14 @@ class CommonCore: public Core, public BrokerBase {
     virtual void brokerDisconnect() = 0;
 
   protected:
+    virtual std::shared_ptr<helicsCLI11App> generateCLI() override;
+
     virtual void processCommand(ActionMessage&& command) override final;
 
     virtual void processPriorityCommand(ActionMessage&& command) override final;
 
+    virtual void processQueueIdle() override final;
+
     /** transit an ActionMessage to another core or broker
     @param rid the identifier for the route information to send the message to
     @param command the actionMessage to send*/
@@ -278,6 +309,9 @@ class CommonCore: public Core, public BrokerBase {
     const BasicHandleInfo* getHandleInfo(interface_handle handle) const;
     /** get a localEndpoint from the name*/
     const BasicHandleInfo* getLocalEndpoint(const std::string& name) const;
+    /** publish a snapshot of the handle table for lock free lookups if handles or federates
+    have been added since the last one*/
+    void publishHandleSnapshot();
     /** get a filtering function object*/
     FilterCoordinator* getFilterCoordinator(interface_handle handle);
     /** check if all federates managed by the core are ready to enter initialization state*/
@@ -301,12 +335,33 @@ class CommonCore: public Core, public BrokerBase {
     std::string prevIdentifier;  //!< storage for the case of requiring a renaming
     std::map<global_federate_id, route_id>
         routing_table;  //!< map for external routes  <global federate id, route id>
+    /** a direct route request waiting for a reply*/
+    struct PendingDirectRoute {
+        decltype(std::chrono::steady_clock::now()) requestTime;  //!< when the request was sent
+        std::vector<ActionMessage> held;  //!< messages held until the route is known
+    };
+    std::map<global_federate_id, PendingDirectRoute>
+        pendingDirectRoutes;  //!< messages held while a direct route to a federate is set up
+    std::shared_ptr<TimerWheel> routeTimerWheel;  //!< timer wheel for expiring route requests
+    int32_t directRouteTimer{-1};  //!< the timer index for expiring direct route requests
+    int32_t directRouteThreshold{
+        0};  //!< the number of messages to a remote federate before a direct route is set up
+    std::map<global_federate_id, int32_t>
+        remoteTrafficCount;  //!< count of data messages sent to remote federates through the broker
+    std::set<std::string>
+        directRouteEndpoints;  //!< endpoints to set up direct routes to once their location is known
+    std::map<std::string, decltype(std::chrono::steady_clock::now())>
+        pendingEndpointLocations;  //!< endpoint location requests waiting for a broker reply
+    std::vector<std::pair<global_federate_id, ActionMessage>>
+        locationHeldMessages;  //!< remote messages held in order behind a pending location request
     gmlc::containers::SimpleQueue<ActionMessage>
         delayTransmitQueue;  //!< FIFO queue for transmissions to the root that need to be delayed
                              //!< for a certain time
-    std::unordered_map<std::string, route_id>
+    std::unordered_map<std::string, global_handle>
         knownExternalEndpoints;  //!< external map for all known external endpoints with names and
-                                 //!< route
+                                 //!< global handles
+    std::vector<ActionMessage>
+        registrationBatch;  //!< interface registrations waiting to be sent to the broker
 
     std::unique_ptr<TimeoutMonitor>
         timeoutMon;  //!< class to handle timeouts and disconnection notices
@@ -389,6 +444,18 @@ class CommonCore: public Core, public BrokerBase {
     //!< confusion
 
     ordered_guarded<HandleManager> handles;  //!< local handle information;
+    /** immutable table of handle and federate pointers for lookups from the API without locks
+    @details handle and federate storage does not move so the table only needs to be rebuilt if
+    handles are added after it is published,  which is rare after entering execution mode*/
+    struct HandleSnapshot {
+        std::vector<const BasicHandleInfo*> handles;  //!< pointers to the handles by index
+        std::vector<FederateState*> federates;  //!< pointers to the federates by local id
+    };
+    std::atomic<const HandleSnapshot*> handleSnapshot{
+        nullptr};  //!< the most recently published snapshot
+    /** storage for all the published snapshots,  superseded snapshots are kept until the core is
+    destroyed since API calls in other threads may still be using them*/
+    guarded<std::vector<std::unique_ptr<HandleSnapshot>>> handleSnapshots;
     HandleManager loopHandles;  //!< copy of handles to use in the primary processing loop without
                                 //!< thread protection
     std::map<int32_t, std::set<int32_t>>
@@ -416,9 +483,42 @@ class CommonCore: public Core, public BrokerBase {
     std::array<gmlc::containers::AirLock<stx::any>, 4>
         dataAirlocks;  //!< airlocks for updating filter operators and other functions
     gmlc::concurrency::TriggerVariable disconnection;  //!< controller for the disconnection process
+    /** a processing lane for the messages from a subset of the local federates
+    @details publications and time messages to other local federates are delivered from the lane
+    thread,  everything else is forwarded to the main processing loop in order*/
+    struct ProcessingLane {
+        gmlc::containers::BlockingQueue<ActionMessage> queue;  //!< messages from the federates
+        std::thread laneThread;  //!< the thread processing the lane
+        std::atomic<uint32_t> syncedSequence{
+            0};  //!< the last lane marker processed by the main loop
+        std::atomic<int64_t> directCount{0};  //!< the number of messages delivered by the lane
+        std::atomic<int64_t> forwardCount{0};  //!< the number of messages forwarded to the loop
+        std::atomic<int64_t> markerCount{0};  //!< the number of markers sent to the main loop
+    };
+    int32_t processingLaneCount{0};  //!< the number of processing lanes to use, 0 to disable
+    std::vector<std::unique_ptr<ProcessingLane>> processingLanes;  //!< the processing lanes
+    std::atomic<bool> lanesActive{false};  //!< flag indicating the lanes are accepting messages
+    std::shared_mutex laneLock;  //!< held shared by lane pushes and exclusively to stop the lanes
+    std::atomic<bool> filtersPresent{
+        false};  //!< time messages go through the main loop when filters may delay messages
   private:
     /** wait for the core to be registered with the broker*/
     bool waitCoreRegistration();
+    /** start the processing lane threads if lanes were requested*/
+    void startProcessingLanes();
+    /** stop the processing lane threads and forward anything left in the lanes to the main queue*/
+    void stopProcessingLanes();
+    /** the loop run by the thread of a processing lane*/
+    void processLane(ProcessingLane& lane, int32_t laneIndex);
+    /** check whether a message could be delivered directly from a processing lane
+    @param command the message to check
+    @param laneFederates lookup of local federates by global id used by the calling lane
+    @return the destination federate or nullptr if the message needs the main processing loop*/
+    FederateState* getLaneDestination(
+        const ActionMessage& command,
+        std::unordered_map<global_federate_id, FederateState*>& laneFederates) const;
+    /** generate the statistics of the processing lanes as a json string*/
+    std::string generateLaneStatistics() const;
     /** deliver a message to the appropriate location*/
     void deliverMessage(ActionMessage& message);
     /** function to deal with a source filters*/
@@ -442,6 +542,31 @@ class CommonCore: public Core, public BrokerBase {
     @param global_fedid the identifier for the federate
     @return parent_route if unknown, otherwise returns the route_id*/
     route_id getRoute(global_federate_id global_fedid) const;
+    /** transmit a message to a federate on another core
+    @details messages are held while a direct route to the federate is being set up so they cannot
+    pass messages already sent through the broker*/
+    void transmitToRemote(global_federate_id dest, const ActionMessage& cmd);
+    /** ask the core of a remote federate for its address so a direct route can be established
+    @return true if a request was sent*/
+    bool requestDirectRoute(global_federate_id fedID);
+    /** process the CMD_SEND_ROUTE messages used to set up direct routes between cores*/
+    void processDirectRouteCommand(ActionMessage& cmd);
+    /** check if any remote federate is reached through a route other than the broker*/
+    bool usingDirectRoutes() const;
+    /** ask the broker for the location of a named endpoint and hold the message until it is known
+    @details with direct routes in use a message routed by name through the broker could be passed
+    by later messages sent on a direct route*/
+    void holdForEndpointLocation(ActionMessage& message);
+    /** send the held messages up to the first one still waiting on an endpoint location*/
+    void releaseLocationHeldMessages();
+    /** make sure the timer for expiring route and location requests fires by the given time*/
+    void armDirectRouteTimer(decltype(std::chrono::steady_clock::now()) expiration);
+    /** send the messages held for direct route requests without a reply through the broker*/
+    void expireDirectRouteRequests();
+    /** drop the direct route to a federate that left and close the route if nothing else uses it*/
+    void removeDirectRoute(global_federate_id fedID);
+    /** generate the direct routes of the core as a json string*/
+    std::string generateDirectRouteInfo() const;
     /** process a message for potential additions to the filter ordering
     @param command the message to process
     */
@@ -455,6 +580,18 @@ class CommonCore: public Core, public BrokerBase {
     void setAsUsed(BasicHandleInfo* hand);
     /** function to consolidate the registration of interfaces in the core*/
     void registerInterface(ActionMessage& command);
+    /** send any pending interface registrations to the broker in as few messages as possible*/
+    void transmitRegistrationBatch();
+    /** check whether a value should be sent from a publication and get its subscribers
+    @return the publication handle info if the value should be sent,  nullptr otherwise*/
+    const BasicHandleInfo* checkValueTransmission(interface_handle handle,
+                                                  const char* data,
+                                                  uint64_t len,
+                                                  std::vector<global_handle>& subs);
+    /** send a value to the subscribers of a publication*/
+    void transmitValue(const BasicHandleInfo& pubInfo,
+                       const std::vector<global_handle>& subs,
+                       std::string&& data);
     /** function to handle adding a target to an interface*/
     void addTargetToInterface(ActionMessage& command);
     /** function to deal with removing a target from an interface*/
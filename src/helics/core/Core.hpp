@@ -386,6 +386,19 @@ class Core {
     virtual interface_handle getInput(local_federate_id federateID,
                                       const std::string& key) const = 0;
 
+    /**
+     * Register a set of publications, inputs, and endpoints for a federate in a single call.
+     *
+     * May only be invoked in the initialize state.  The keys are checked before any interface is
+     * created so a duplicate key causes the entire set to be rejected.
+     * @param federateID the identifier for the federate to register the interfaces on
+     * @param interfaces the definitions of the interfaces to register
+     * @return the handles of the new interfaces in the same order as the definitions
+     */
+    virtual std::vector<interface_handle>
+        registerInterfaces(local_federate_id federateID,
+                           const std::vector<InterfaceDefinition>& interfaces) = 0;
+
     /**
      * Returns the name or identifier for a specified handle
      */
@@ -460,6 +473,13 @@ class Core {
      @param len the size of the data
      */
     virtual void setValue(interface_handle handle, const char* data, uint64_t len) = 0;
+    /**
+     * Publish specified data to the specified key transferring ownership of the buffer to the core.
+     *
+     @param handle the handle from the publication
+     @param data the raw data to send,  the buffer is moved into the outgoing message
+     */
+    virtual void setValue(interface_handle handle, std::string&& data) = 0;
 
     /**
      * Return the data for the specified handle or the latest input
@@ -487,6 +507,17 @@ class Core {
      */
     virtual const std::vector<interface_handle>& getValueUpdates(local_federate_id federateID) = 0;
 
+    /**
+     * Returns all the inputs that received an update during the last time request along with
+     * their data.
+     * @details this is equivalent to calling getValueUpdates and then getValue and getAllValues for
+     * each of the handles but with a single call into the core.  The data remains valid until the
+     * next time request for the given federate
+     * @param federateID the identification code of the federate to get the updates for
+     * @return a reference to an array of the updated inputs and their data
+     */
+    virtual const std::vector<InputUpdate>& getInputUpdates(local_federate_id federateID) = 0;
+
     /**
      * Message interface.
      * Designed for point-to-point communication patterns.
@@ -735,6 +766,37 @@ class Core {
     virtual void setQueryCallback(local_federate_id federateID,
                                   std::function<std::string(const std::string&)> queryFunction) = 0;
 
+    /** set the callbacks used to include model state in the checkpoints of a federate
+    @param federateID the identifier for the federate
+    @param saveFunction a function returning a binary blob of the model state,  it is called on the
+    thread saving the checkpoint which for checkpoints requested by a time barrier is the thread
+    waiting on the time request
+    @param restoreFunction a function called with the blob from a checkpoint being restored
+    */
+    virtual void
+        setCheckpointCallbacks(local_federate_id federateID,
+                               std::function<std::string()> saveFunction,
+                               std::function<void(const std::string&)> restoreFunction) = 0;
+
+    /** write a binary checkpoint of the state of a federate to a file
+    @details the checkpoint contains the time coordinator state, the pending input values and
+    endpoint messages of the federate, and the model state from the checkpoint callback.  It should
+    be generated at a granted time.  To checkpoint all the federates of a co-simulation at the same
+    time use Broker::setCheckpointBarrier
+    @param federateID the identifier for the federate
+    @param filename the name of the file to write
+    */
+    virtual void checkpointFederate(local_federate_id federateID, const std::string& filename) = 0;
+
+    /** restore the state of a federate from a checkpoint file
+    @details the federate must be in initializing mode with the same interfaces and connections as
+    when the checkpoint was generated,  it is granted the checkpoint time on entering executing mode
+    @param federateID the identifier for the federate
+    @param filename the name of the checkpoint file
+    @return the granted time of the federate when the checkpoint was generated
+    */
+    virtual Time restoreFederate(local_federate_id federateID, const std::string& filename) = 0;
+
     /**
      * setter for the interface information
      * @param handle the identifiers for the interface to set the info data on
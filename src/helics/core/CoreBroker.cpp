@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../common/fmt_format.h"
 #include "BrokerFactory.hpp"
 #include "ForwardingTimeCoordinator.hpp"
+#include "TimeCoordinator.hpp"
 #include "TimeoutMonitor.h"
 #include "fileConnections.hpp"
 #include "gmlc/utilities/stringConversion.h"
@@ -198,6 +199,9 @@ route_id CoreBroker::fillMessageRouteInformation(ActionMessage& mess)
     auto* eptInfo = handles.getEndpoint(endpointName);
     if (eptInfo != nullptr) {
         mess.setDestination(eptInfo->handle);
+        if (mess.action() == CMD_SEND_MESSAGE) {
+            sendEndpointLocation(mess.source_id, *eptInfo);
+        }
         return getRoute(eptInfo->handle.fed_id);
     }
     auto fnd2 = knownExternalEndpoints.find(endpointName);
@@ -207,6 +211,80 @@ route_id CoreBroker::fillMessageRouteInformation(ActionMessage& mess)
     return parent_route_id;
 }
 
+bool CoreBroker::sendEndpointLocation(global_federate_id requester, const BasicHandleInfo& ept)
+{
+    if (!requester.isValid()) {
+        return false;
+    }
+    auto owner = _federates.find(ept.handle.fed_id);
+    if ((owner != _federates.end()) && (owner->state >= connection_state::error)) {
+        // the endpoint is going away so keep the requester routing by name
+        return false;
+    }
+    // only notify a requester once per endpoint, after that the core routes by handle
+    if (!endpointLocationNotices.emplace(requester, ept.handle).second) {
+        return true;
+    }
+    ActionMessage location(CMD_ENDPOINT_LOCATION);
+    location.setSource(ept.handle);
+    location.dest_id = requester;
+    location.name = ept.key;
+    routeMessage(std::move(location));
+    return true;
+}
+
+void CoreBroker::processEndpointLocationRequest(ActionMessage& command)
+{
+    auto* eptInfo = handles.getEndpoint(command.name);
+    if (eptInfo != nullptr) {
+        // the core is waiting on the reply so it is always sent even if a notice went out before
+        endpointLocationNotices.erase(std::make_pair(command.source_id, eptInfo->handle));
+        if (sendEndpointLocation(command.source_id, *eptInfo)) {
+            return;
+        }
+    } else if (!isRootc) {
+        transmit(parent_route_id, command);
+        return;
+    }
+    // an invalid source tells the core the endpoint can only be routed by name
+    ActionMessage notFound(CMD_ENDPOINT_LOCATION);
+    setActionFlag(notFound, error_flag);
+    notFound.dest_id = command.source_id;
+    notFound.name = command.name;
+    routeMessage(std::move(notFound));
+}
+
+void CoreBroker::clearEndpointLocations(global_federate_id fedID, bool requesterRemoved)
+{
+    auto notice = endpointLocationNotices.begin();
+    while (notice != endpointLocationNotices.end()) {
+        if (requesterRemoved && notice->first == fedID) {
+            notice = endpointLocationNotices.erase(notice);
+            continue;
+        }
+        if (notice->second.fed_id != fedID) {
+            ++notice;
+            continue;
+        }
+        // tell the requesting core to go back to routing the endpoint by name
+        auto requester = _federates.find(notice->first);
+        auto* ept = handles.findHandle(notice->second);
+        if ((ept != nullptr) && (requester != _federates.end()) &&
+            (brokerState < broker_state_t::terminating)) {
+            const auto* brk = getBrokerById(requester->parent);
+            if ((brk == nullptr) || (brk->state < connection_state::error)) {
+                ActionMessage eviction(CMD_ENDPOINT_LOCATION);
+                setActionFlag(eviction, error_flag);
+                eviction.setSource(ept->handle);
+                eviction.dest_id = notice->first;
+                eviction.name = ept->key;
+                routeMessage(std::move(eviction));
+            }
+        }
+        notice = endpointLocationNotices.erase(notice);
+    }
+}
+
 bool CoreBroker::isOpenToNewFederates() const
 {
     auto cstate = brokerState.load();
@@ -222,6 +300,9 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
               fmt::format("|| priority_cmd:{} from {}",
                           prettyPrintString(command),
                           command.source_id.baseValue()));
+    if (!linkBatches.empty()) {
+        transmitLinkBatches();
+    }
     switch (command.action()) {
         case CMD_PING_PRIORITY:
             if (command.dest_id == global_broker_id_local) {
@@ -727,6 +808,19 @@ void CoreBroker::processCommand(ActionMessage&& command)
                           prettyPrintString(command),
                           command.source_id.baseValue(),
                           command.dest_id.baseValue()));
+    if (!linkBatches.empty()) {
+        switch (command.action()) {
+            case CMD_REG_INPUT:
+            case CMD_REG_ENDPOINT:
+            case CMD_REG_PUB:
+            case CMD_REG_FILTER:
+                break;
+            default:
+                // anything else may depend on the links reaching the federates first
+                transmitLinkBatches();
+                break;
+        }
+    }
     switch (command.action()) {
         case CMD_IGNORE:
         case CMD_PROTOCOL:
@@ -987,6 +1081,7 @@ void CoreBroker::processCommand(ActionMessage&& command)
             if (fed != _federates.end()) {
                 fed->state = connection_state::disconnected;
             }
+            clearEndpointLocations(command.source_id, false);
             if (!isRootc) {
                 transmit(parent_route_id, command);
             } else if (brokerState < broker_state_t::operating) {
@@ -1073,6 +1168,14 @@ void CoreBroker::processCommand(ActionMessage&& command)
         case CMD_PUB:
             transmit(getRoute(command.dest_id), command);
             break;
+        case CMD_ENDPOINT_LOCATION:
+            if ((command.dest_id == parent_broker_id) ||
+                (command.dest_id == global_broker_id_local)) {
+                processEndpointLocationRequest(command);
+            } else {
+                routeMessage(command);
+            }
+            break;
 
         case CMD_LOG:
             if (isRootc) {
@@ -1740,6 +1843,18 @@ void CoreBroker::clearTimeBarrier()
     addActionMessage(tbarrier);
 }
 
+void CoreBroker::setCheckpointBarrier(Time checkpointTime, const std::string& filePrefix)
+{
+    if (filePrefix.empty()) {
+        throw(InvalidParameter("a checkpoint barrier requires a file prefix"));
+    }
+    ActionMessage tbarrier(CMD_TIME_BARRIER_REQUEST);
+    tbarrier.source_id = global_id.load();
+    tbarrier.actionTime = checkpointTime;
+    tbarrier.payload = filePrefix;
+    addActionMessage(std::move(tbarrier));
+}
+
 bool CoreBroker::isConnected() const
 {
     auto state = brokerState.load(std::memory_order_acquire);
@@ -2002,6 +2117,31 @@ void CoreBroker::executeInitializationOperations()
     logFlush();
 }
 
+void CoreBroker::addToLinkBatch(ActionMessage&& command)
+{
+    linkBatches[getRoute(command.dest_id)].push_back(std::move(command));
+    // registrations tend to come in large groups so the links are sent once the queue is empty
+    idleProcessingPending = true;
+}
+
+void CoreBroker::transmitLinkBatches()
+{
+    for (auto& batch : linkBatches) {
+        auto packages = packageMultiMessages(std::move(batch.second), defaultPackageSize);
+        for (auto& package : packages) {
+            transmit(batch.first, std::move(package));
+        }
+    }
+    linkBatches.clear();
+}
+
+void CoreBroker::processQueueIdle()
+{
+    if (!linkBatches.empty()) {
+        transmitLinkBatches();
+    }
+}
+
 void CoreBroker::FindandNotifyInputTargets(BasicHandleInfo& handleInfo)
 {
     auto Handles = unknownHandles.checkForInputs(handleInfo.key);
@@ -2013,7 +2153,7 @@ void CoreBroker::FindandNotifyInputTargets(BasicHandleInfo& handleInfo)
         m.setSource(handleInfo.handle);
         m.payload = handleInfo.type;
         m.flags = handleInfo.flags;
-        transmit(getRoute(m.dest_id), m);
+        addToLinkBatch(ActionMessage(m));
 
         // notify the subscriber about its publisher
         m.setAction(CMD_ADD_PUBLISHER);
@@ -2025,7 +2165,7 @@ void CoreBroker::FindandNotifyInputTargets(BasicHandleInfo& handleInfo)
             m.setStringData(pub->type, pub->units);
         }
 
-        transmit(getRoute(m.dest_id), std::move(m));
+        addToLinkBatch(std::move(m));
     }
     if (!Handles.empty()) {
         unknownHandles.clearInput(handleInfo.key);
@@ -2042,7 +2182,7 @@ void CoreBroker::FindandNotifyPublicationTargets(BasicHandleInfo& handleInfo)
         m.setDestination(handleInfo.handle);
         m.flags = sub.second;
 
-        transmit(getRoute(m.dest_id), m);
+        addToLinkBatch(ActionMessage(m));
 
         // notify the subscriber about its publisher
         m.setAction(CMD_ADD_PUBLISHER);
@@ -2051,7 +2191,7 @@ void CoreBroker::FindandNotifyPublicationTargets(BasicHandleInfo& handleInfo)
         m.payload = handleInfo.type;
         m.flags = handleInfo.flags;
         m.setStringData(handleInfo.type, handleInfo.units);
-        transmit(getRoute(m.dest_id), std::move(m));
+        addToLinkBatch(std::move(m));
     }
 
     auto Pubtargets = unknownHandles.checkForLinks(handleInfo.key);
@@ -2075,13 +2215,13 @@ void CoreBroker::FindandNotifyEndpointTargets(BasicHandleInfo& handleInfo)
         m.setSource(handleInfo.handle);
         m.setDestination(target.first);
         m.flags = target.second;
-        transmit(getRoute(m.dest_id), m);
+        addToLinkBatch(ActionMessage(m));
 
         // notify the endpoint about its filter
         m.setAction(CMD_ADD_FILTER);
         m.swapSourceDest();
         m.flags = target.second;
-        transmit(getRoute(m.dest_id), m);
+        addToLinkBatch(std::move(m));
     }
 
     if (!Handles.empty()) {
@@ -2104,13 +2244,13 @@ void CoreBroker::FindandNotifyFilterTargets(BasicHandleInfo& handleInfo)
         if ((!handleInfo.type_in.empty()) || (!handleInfo.type_out.empty())) {
             m.setStringData(handleInfo.type_in, handleInfo.type_out);
         }
-        transmit(getRoute(m.dest_id), m);
+        addToLinkBatch(ActionMessage(m));
 
         // notify the filter about an endpoint
         m.setAction(CMD_ADD_ENDPOINT);
         m.swapSourceDest();
         m.clearStringData();
-        transmit(getRoute(m.dest_id), m);
+        addToLinkBatch(std::move(m));
     }
 
     auto FiltDestTargets = unknownHandles.checkForFilterDestTargets(handleInfo.key);
@@ -2165,6 +2305,7 @@ void CoreBroker::processError(ActionMessage& command)
         auto fed = _federates.find(command.source_id);
         if (fed != _federates.end()) {
             fed->state = connection_state::error;
+            clearEndpointLocations(fed->global_id, false);
         }
     } else {
         brk->state = connection_state::error;
@@ -2370,6 +2511,7 @@ void CoreBroker::markAsDisconnected(global_broker_id brkid)
                 if (fed.state != connection_state::error) {
                     fed.state = connection_state::disconnected;
                 }
+                clearEndpointLocations(fed.global_id, true);
             }
         }
     }
@@ -2486,7 +2628,9 @@ enum subqueries : std::uint16_t {
     dependency_graph = 3,
     data_flow_graph = 4,
     version_all = 5,
-    global_state = 6
+    global_state = 6,
+    critical_path = 7,
+    time_blockers = 8
 };
 
 static const std::map<std::string, std::pair<std::uint16_t, bool>> mapIndex{
@@ -2496,6 +2640,8 @@ static const std::map<std::string, std::pair<std::uint16_t, bool>> mapIndex{
     {"data_flow_graph", {data_flow_graph, false}},
     {"version_all", {version_all, false}},
     {"global_state", {global_state, true}},
+    {"critical_path", {critical_path, true}},
+    {"time_blockers", {time_blockers, true}},
 };
 
 std::string CoreBroker::generateQueryAnswer(const std::string& request)
@@ -2516,7 +2662,7 @@ std::string CoreBroker::generateQueryAnswer(const std::string& request)
     if ((request == "queries") || (request == "available_queries")) {
         return "[isinit;isconnected;name;identifier;address;queries;address;counts;summary;federates;brokers;inputs;endpoints;"
                "publications;filters;federate_map;dependency_graph;counter;data_flow_graph;dependencies;dependson;dependents;"
-               "current_time;current_state;global_state;status;global_time;version;version_all;exists]";
+               "current_time;current_state;global_state;status;global_time;version;version_all;exists;flight_recorder;critical_path;time_blockers;compression]";
     }
     if (request == "address") {
         return getAddress();
@@ -2527,6 +2673,12 @@ std::string CoreBroker::generateQueryAnswer(const std::string& request)
     if (request == "counter") {
         return fmt::format("{}", generateMapObjectCounter());
     }
+    if (request == "flight_recorder") {
+        return dumpFlightRecorder();
+    }
+    if (request == "compression") {
+        return generateCompressionStatistics();
+    }
     if (request == "status") {
         Json::Value base;
         base["name"] = getIdentifier();
@@ -2621,6 +2773,9 @@ std::string CoreBroker::generateQueryAnswer(const std::string& request)
 
         initializeMapBuilder(request, index, mi->second.second);
         if (std::get<0>(mapBuilders[index]).isCompleted()) {
+            if (index == critical_path) {
+                generateCriticalPathSummary(std::get<0>(mapBuilders[index]).getJValue());
+            }
             if (!mi->second.second) {
                 auto center = generateMapObjectCounter();
                 std::get<0>(mapBuilders[index]).setCounterCode(center);
@@ -2972,6 +3127,9 @@ void CoreBroker::processQueryResponse(const ActionMessage& m)
         auto& builder = std::get<0>(mapBuilders[m.counter]);
         auto& requestors = std::get<1>(mapBuilders[m.counter]);
         if (builder.addComponent(m.payload, m.messageID)) {
+            if (m.counter == critical_path) {
+                generateCriticalPathSummary(builder.getJValue());
+            }
             auto str = builder.generate();
             for (int ii = 0; ii < static_cast<int>(requestors.size()) - 1; ++ii) {
                 if (requestors[ii].dest_id == global_broker_id_local) {
@@ -27,6 +27,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -115,6 +116,10 @@ class CoreBroker: public Broker, public BrokerBase {
     std::unordered_map<std::string, route_id>
         knownExternalEndpoints;  //!< external map for all known external endpoints with names and
                                  //!< route
+    std::set<std::pair<global_federate_id, global_handle>>
+        endpointLocationNotices;  //!< set of endpoint handles already sent to requesting federates
+    std::map<route_id, std::vector<ActionMessage>>
+        linkBatches;  //!< interface link notifications waiting to be sent out on each route
     std::unordered_map<std::string, std::string> global_values;  //!< storage for global values
     std::mutex name_mutex_;  //!< mutex lock for name and identifier
     std::atomic<int> queryCounter{1};  // counter for active queries going to the local API
@@ -140,6 +145,8 @@ class CoreBroker: public Broker, public BrokerBase {
     @param command the command to process
     */
     void processPriorityCommand(ActionMessage&& command) override;
+    /** send the link notifications held while more registrations were waiting*/
+    virtual void processQueueIdle() override;
 
     /** process configure commands for the broker*/
     void processBrokerConfigureCommands(ActionMessage& cmd);
@@ -164,8 +171,22 @@ class CoreBroker: public Broker, public BrokerBase {
     void propagateError(ActionMessage&& cmd);
     /** broadcast a message to all immediate brokers*/
     void broadcast(ActionMessage& cmd);
-    /**/
+    /** find the route for a message and fill in the destination handle if it is known*/
     route_id fillMessageRouteInformation(ActionMessage& mess);
+    /** notify the core of a federate of the global handle for a named endpoint it is sending to
+    @details this allows subsequent messages to be routed by handle instead of by name
+    @return false if the endpoint is going away and the requester should keep routing by name*/
+    bool sendEndpointLocation(global_federate_id requester, const BasicHandleInfo& ept);
+    /** answer a request from a core for the location of a named endpoint
+    @details requests for endpoints not known to this broker are forwarded to the parent and the
+    root broker replies with an error if the endpoint does not exist*/
+    void processEndpointLocationRequest(ActionMessage& command);
+    /** drop the endpoint location notices for the endpoints of a federate that is leaving
+    @details the cores that were sent the locations are told to route the endpoints by name again
+    @param fedID the federate that disconnected or errored
+    @param requesterRemoved set to true if the core of the federate is gone as well so the notices
+    sent to it can be dropped*/
+    void clearEndpointLocations(global_federate_id fedID, bool requesterRemoved);
 
     /** handle initialization operations*/
     void executeInitializationOperations();
@@ -214,6 +235,9 @@ class CoreBroker: public Broker, public BrokerBase {
 
     virtual void clearTimeBarrier() override final;
 
+    virtual void setCheckpointBarrier(Time checkpointTime,
+                                      const std::string& filePrefix) override final;
+
   private:
     /** implementation details of the connection process
      */
@@ -306,6 +330,10 @@ class CoreBroker: public Broker, public BrokerBase {
 
     void FindandNotifyFilterTargets(BasicHandleInfo& handleInfo);
     void FindandNotifyEndpointTargets(BasicHandleInfo& handleInfo);
+    /** queue a link notification to be sent with others going along the same route*/
+    void addToLinkBatch(ActionMessage&& command);
+    /** send all the queued link notifications*/
+    void transmitLinkBatches();
     /** process a disconnect message*/
     void processDisconnect(ActionMessage& command);
     /** process an error message*/
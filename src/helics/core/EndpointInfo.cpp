@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace helics {
 std::unique_ptr<Message> EndpointInfo::getMessage(Time maxTime)
@@ -19,8 +20,8 @@ std::unique_ptr<Message> EndpointInfo::getMessage(Time maxTime)
     if (handle->empty()) {
         return nullptr;
     }
-    if (handle->front()->time <= maxTime) {
-        auto msg = std::move(handle->front());
+    if (handle->front().message->time <= maxTime) {
+        auto msg = std::move(handle->front().message);
         handle->pop_front();
         return msg;
     }
@@ -30,20 +31,22 @@ std::unique_ptr<Message> EndpointInfo::getMessage(Time maxTime)
 Time EndpointInfo::firstMessageTime() const
 {
     auto handle = message_queue.lock_shared();
-    return (handle->empty()) ? Time::maxVal() : handle->front()->time;
+    return (handle->empty()) ? Time::maxVal() : handle->front().message->time;
 }
 // this is the function which determines message order
 static auto msgSorter = [](const auto& m1, const auto& m2) {
     // first by time
-    return (m1->time != m2->time) ? (m1->time < m2->time) :
-                                    (m1->original_source < m2->original_source);
+    return (m1.message->time != m2.message->time) ? (m1.message->time < m2.message->time) :
+                                                    (m1.source < m2.source);
 };
 
-void EndpointInfo::addMessage(std::unique_ptr<Message> message)
+void EndpointInfo::addMessage(std::unique_ptr<Message> message, global_handle source)
 {
+    QueuedMessage queued{source, std::move(message)};
     auto handle = message_queue.lock();
-    handle->push_back(std::move(message));
-    std::stable_sort(handle->begin(), handle->end(), msgSorter);
+    // the queue is always sorted so insert after any equivalent messages to keep the order stable
+    auto insertLoc = std::upper_bound(handle->begin(), handle->end(), queued, msgSorter);
+    handle->insert(insertLoc, std::move(queued));
 }
 
 void EndpointInfo::clearQueue()
@@ -51,12 +54,23 @@ void EndpointInfo::clearQueue()
     message_queue.lock()->clear();
 }
 
+std::vector<Message> EndpointInfo::getQueuedMessages() const
+{
+    auto handle = message_queue.lock_shared();
+    std::vector<Message> messages;
+    messages.reserve(handle->size());
+    for (const auto& msg : *handle) {
+        messages.push_back(*msg.message);
+    }
+    return messages;
+}
+
 int32_t EndpointInfo::queueSize(Time maxTime) const
 {
     auto handle = message_queue.lock_shared();
     int32_t cnt = 0;
     for (auto& msg : *handle) {
-        if (msg->time <= maxTime) {
+        if (msg.message->time <= maxTime) {
             ++cnt;
         } else {
             break;
@@ -12,6 +12,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 namespace helics {
 /** data class containing the information about an endpoint*/
 class EndpointInfo {
@@ -26,19 +27,28 @@ class EndpointInfo {
     const std::string key;  //!< name of the endpoint
     const std::string type;  //!< type of the endpoint
   private:
-    shared_guarded<std::deque<std::unique_ptr<Message>>>
-        message_queue;  //!< storage for the messages
+    /** a message along with the global handle of the endpoint that sent it*/
+    struct QueuedMessage {
+        global_handle source;  //!< the handle used to order messages with the same time
+        std::unique_ptr<Message> message;  //!< the message itself
+    };
+    shared_guarded<std::deque<QueuedMessage>> message_queue;  //!< storage for the messages
   public:
     bool hasFilter = false;  //!< indicator that the message has a filter
     /** get the next message up to the specified time*/
     std::unique_ptr<Message> getMessage(Time maxTime);
     /** get the number of messages in the queue up to the specified time*/
     int32_t queueSize(Time maxTime) const;
-    /** add a message to the queue*/
-    void addMessage(std::unique_ptr<Message> message);
+    /** add a message to the queue
+    @param message the message to add
+    @param source the handle of the sending endpoint, messages with the same time are ordered by
+    source handle so no names need to be compared*/
+    void addMessage(std::unique_ptr<Message> message, global_handle source = global_handle{});
     /** get the timestamp of the first message in the queue*/
     Time firstMessageTime() const;
     /** clear all the message queues*/
     void clearQueue();
+    /** get a copy of all the messages in the queue*/
+    std::vector<Message> getQueuedMessages() const;
 };
 }  // namespace helics
@@ -11,30 +11,28 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "CoreFederateInfo.hpp"
 #include "EndpointInfo.hpp"
 #include "InputInfo.hpp"
+#include "MessageTimer.hpp"
 #include "PublicationInfo.hpp"
 #include "TimeCoordinator.hpp"
 #include "TimeDependencies.hpp"
+#include "core-exceptions.hpp"
 #include "helics/helics-config.h"
 #include "helics_definitions.hpp"
 #include "queryHelpers.hpp"
+#include "threadAffinity.hpp"
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
 
-#ifndef HELICS_DISABLE_ASIO
-#    include "MessageTimer.hpp"
-#else
-namespace helics {
-class MessageTimer {
-};
-}  // namespace helics
-#endif
-
 #include "../common/fmt_format.h"
 static const std::string emptyStr;
 #define LOG_ERROR(message) logMessage(helics_log_level_error, emptyStr, message)
@@ -197,6 +195,13 @@ void FederateState::generateConfig(Json::Value& base) const
     if (rt_lead > timeZero) {
         base["rt_lead"] = static_cast<double>(rt_lead);
     }
+    if (realtime_high_precision) {
+        base["realtime_high_precision"] = true;
+        base["rt_spin"] = static_cast<double>(rt_spin);
+    }
+    if (rt_cpu_affinity >= 0) {
+        base["rt_cpu_affinity"] = rt_cpu_affinity;
+    }
 }
 
 uint64_t FederateState::getQueueSize(interface_handle id) const
@@ -267,7 +272,7 @@ const std::vector<std::shared_ptr<const data_block>>&
 void FederateState::routeMessage(const ActionMessage& msg)
 {
     if (parent_ != nullptr) {
-        parent_->addActionMessage(msg);
+        parent_->addFederateMessage(this, msg);
     } else {
         queue.push(msg);
     }
@@ -295,6 +300,25 @@ void FederateState::createInterface(handle_type htype,
 {
     std::lock_guard<FederateState> plock(*this);
     // this function could be called externally in a multi-threaded context
+    addInterface(htype, handle, key, type, units);
+}
+
+void FederateState::createInterfaces(const std::vector<InterfaceDefinition>& interfaces,
+                                     const std::vector<interface_handle>& handles)
+{
+    std::lock_guard<FederateState> plock(*this);
+    for (std::size_t ii = 0; ii < interfaces.size() && ii < handles.size(); ++ii) {
+        const auto& def = interfaces[ii];
+        addInterface(static_cast<handle_type>(def.kind), handles[ii], def.key, def.type, def.units);
+    }
+}
+
+void FederateState::addInterface(handle_type htype,
+                                 interface_handle handle,
+                                 const std::string& key,
+                                 const std::string& type,
+                                 const std::string& units)
+{
     switch (htype) {
         case handle_type::publication: {
             interfaceInformation.createPublication(handle, key, type, units);
@@ -458,7 +482,8 @@ iteration_result FederateState::enterExecutingMode(iteration_request iterate)
 
         auto ret = processQueue();
         if (ret == message_processing_result::next_step) {
-            time_granted = timeZero;
+            // a federate restored from a checkpoint starts at the checkpoint time
+            time_granted = timeCoord->getGrantedTime();
             allowed_send_time = timeCoord->allowedSendTime();
         }
         switch (iterate) {
@@ -478,15 +503,19 @@ iteration_result FederateState::enterExecutingMode(iteration_request iterate)
         }
 
         unlock();
-#ifndef HELICS_DISABLE_ASIO
         if ((realtime) && (ret == message_processing_result::next_step)) {
             if (!mTimer) {
                 mTimer = std::make_shared<MessageTimer>(
                     [this](ActionMessage&& mess) { return this->addAction(std::move(mess)); });
             }
+            if (rt_cpu_affinity >= 0) {
+                if (!setThreadCpuAffinity(rt_cpu_affinity)) {
+                    LOG_WARNING(fmt::format("unable to pin federate thread to cpu {}",
+                                            rt_cpu_affinity));
+                }
+            }
             start_clock_time = std::chrono::steady_clock::now();
         }
-#endif
         return static_cast<iteration_result>(ret);
     }
     // the following code is for situation which this has been called multiple times, which really
@@ -512,6 +541,44 @@ iteration_result FederateState::enterExecutingMode(iteration_request iterate)
     return ret;
 }
 
+void FederateState::realTimeWait()
+{
+    auto current_clock_time = std::chrono::steady_clock::now();
+    auto timegap = current_clock_time - start_clock_time;
+    if (time_granted - Time(timegap) > rt_lead) {
+        auto current_lead = (time_granted - rt_lead).to_ns() - timegap;
+        if (realtime_high_precision) {
+            // sleep through most of the gap then spin on the clock to hit the step time
+            auto target = current_clock_time + current_lead;
+            if (current_lead > rt_spin.to_ns()) {
+                std::this_thread::sleep_until(target - rt_spin.to_ns());
+            }
+            while (std::chrono::steady_clock::now() < target) {
+                // spin
+            }
+        } else if (current_lead > std::chrono::milliseconds(5)) {
+            std::this_thread::sleep_for(current_lead);
+        }
+    }
+    auto lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_clock_time - time_granted.to_ns());
+    if (rtLateness.steps == 0) {
+        rtLateness.largest = lateness;
+        rtLateness.smallest = lateness;
+    } else {
+        rtLateness.largest = (std::max)(rtLateness.largest, lateness);
+        rtLateness.smallest = (std::min)(rtLateness.smallest, lateness);
+    }
+    ++rtLateness.steps;
+    if (rt_lag < Time::maxVal() && lateness > rt_lag.to_ns()) {
+        ++rtLateness.lateSteps;
+    }
+    rtLateness.last = lateness;
+    auto seconds = static_cast<double>(lateness.count()) * 1e-9;
+    rtLateness.sum += seconds;
+    rtLateness.sumSquares += seconds * seconds;
+}
+
 std::vector<global_handle> FederateState::getSubscribers(interface_handle handle)
 {
     std::lock_guard<FederateState> fedlock(*this);
@@ -537,7 +604,6 @@ iteration_time FederateState::requestTime(Time nextTime, iteration_request itera
         addAction(treq);
         LOG_TRACE(timeCoord->printTimeStatus());
 // timeCoord->timeRequest (nextTime, iterate, nextValueTime (), nextMessageTime ());
-#ifndef HELICS_DISABLE_ASIO
         if ((realtime) && (rt_lag < Time::maxVal())) {
             auto current_clock_time = std::chrono::steady_clock::now();
             auto timegap = current_clock_time - start_clock_time;
@@ -561,7 +627,6 @@ iteration_time FederateState::requestTime(Time nextTime, iteration_request itera
                 addAction(tforce);
             }
         }
-#endif
         auto ret = processQueue();
         time_granted = timeCoord->getGrantedTime();
         allowed_send_time = timeCoord->allowedSendTime();
@@ -589,23 +654,14 @@ iteration_time FederateState::requestTime(Time nextTime, iteration_request itera
 
                 break;
         }
-#ifndef HELICS_DISABLE_ASIO
         if (realtime) {
             if (rt_lag < Time::maxVal()) {
                 mTimer->cancelTimer(realTimeTimerIndex);
             }
             if (ret == message_processing_result::next_step) {
-                auto current_clock_time = std::chrono::steady_clock::now();
-                auto timegap = current_clock_time - start_clock_time;
-                if (time_granted - Time(timegap) > rt_lead) {
-                    auto current_lead = (time_granted - rt_lead).to_ns() - timegap;
-                    if (current_lead > std::chrono::milliseconds(5)) {
-                        std::this_thread::sleep_for(current_lead);
-                    }
-                }
+                realTimeWait();
             }
         }
-#endif
 
         unlock();
         if ((retTime.grantedTime > nextTime) && (nextTime > lastTime)) {
@@ -699,6 +755,24 @@ const std::vector<interface_handle>& FederateState::getEvents() const
     return events;
 }
 
+const std::vector<InputUpdate>& FederateState::getInputUpdates()
+{
+    inputUpdates.clear();
+    inputUpdates.reserve(events.size());
+    for (auto handle : events) {
+        const auto* inp = interfaces().getInput(handle);
+        if (inp == nullptr) {
+            continue;
+        }
+        InputUpdate update;
+        update.handle = handle;
+        update.data = &inp->getData(nullptr);
+        update.allData = &inp->getAllData();
+        inputUpdates.push_back(update);
+    }
+    return inputUpdates;
+}
+
 message_processing_result FederateState::processDelayQueue() noexcept
 {
     delayedFederates.clear();
@@ -803,7 +877,7 @@ message_processing_result FederateState::processQueue() noexcept
                 gError.messageID = errorCode;
                 gError.payload = errorString;
 
-                parent_->addActionMessage(std::move(gError));
+                parent_->addFederateMessage(this, std::move(gError));
             }
         }
     }
@@ -833,6 +907,17 @@ message_processing_result FederateState::processActionMessage(ActionMessage& cmd
         case CMD_TIME_BARRIER:
         case CMD_TIME_BARRIER_CLEAR:
         case CMD_TIME_UNBLOCK: {
+            if (cmd.action() == CMD_TIME_BARRIER && !cmd.payload.empty()) {
+                checkpointTime = cmd.actionTime;
+                checkpointFilePrefix = cmd.payload;
+                lastCheckpointTime = Time::minVal();
+                if (!timeGranted_mode) {
+                    checkpointAtBarrier();
+                }
+            } else if (cmd.action() != CMD_TIME_BLOCK && cmd.action() != CMD_TIME_UNBLOCK) {
+                checkpointTime = Time::maxVal();
+                checkpointFilePrefix.clear();
+            }
             auto processed = timeCoord->processTimeMessage(cmd);
             if (processed == message_process_result::processed) {
                 if (!timeGranted_mode) {
@@ -1009,6 +1094,9 @@ message_processing_result FederateState::processActionMessage(ActionMessage& cmd
                 }
                 timeCoord->timeRequest(cmd.actionTime, iterate, nextValueTime(), nextMessageTime());
                 timeGranted_mode = false;
+                if (cmd.actionTime >= checkpointTime) {
+                    checkpointAtBarrier();
+                }
                 auto ret = processDelayQueue();
                 if (returnableResult(ret)) {
                     return ret;
@@ -1063,7 +1151,8 @@ message_processing_result FederateState::processActionMessage(ActionMessage& cmd
             if (epi != nullptr) {
                 timeCoord->updateMessageTime(cmd.actionTime);
                 LOG_DATA(fmt::format("receive_message {}", prettyPrintString(cmd)));
-                epi->addMessage(createMessageFromCommand(std::move(cmd)));
+                auto source = cmd.getSource();
+                epi->addMessage(createMessageFromCommand(std::move(cmd)), source);
             }
         } break;
         case CMD_PUB: {
@@ -1361,6 +1450,18 @@ void FederateState::setProperty(int timeProperty, Time propertyVal)
             rt_lag = propertyVal;
             rt_lead = propertyVal;
             break;
+        case defs::properties::rt_spin:
+            rt_spin = propertyVal;
+            break;
+        case defs::properties::output_delay:
+            if (propertyVal < timeCoord->getPromisedLookahead()) {
+                LOG_WARNING(fmt::format(
+                    "output delay {} is below the {} promised to dependents and is raised to it",
+                    static_cast<double>(propertyVal),
+                    static_cast<double>(timeCoord->getPromisedLookahead())));
+            }
+            timeCoord->setProperty(timeProperty, propertyVal);
+            break;
         default:
             timeCoord->setProperty(timeProperty, propertyVal);
             break;
@@ -1386,6 +1487,9 @@ void FederateState::setProperty(int intProperty, int propertyVal)
             rt_lag = helics::Time(static_cast<double>(propertyVal));
             rt_lead = rt_lag;
             break;
+        case defs::properties::rt_cpu_affinity:
+            rt_cpu_affinity = propertyVal;
+            break;
         default:
             timeCoord->setProperty(intProperty, propertyVal);
     }
@@ -1425,6 +1529,16 @@ void FederateState::setOptionFlag(int optionFlag, bool value)
                 realtime = false;
             }
 
+            break;
+        case defs::flags::realtime_high_precision:
+            if (value) {
+                if (state < HELICS_EXECUTING) {
+                    realtime = true;
+                    realtime_high_precision = true;
+                }
+            } else {
+                realtime_high_precision = false;
+            }
             break;
         case defs::flags::source_only:
             if (state == HELICS_CREATED) {
@@ -1481,6 +1595,8 @@ Time FederateState::getTimeProperty(int timeProperty) const
             return rt_lag;
         case defs::properties::rt_lead:
             return rt_lead;
+        case defs::properties::rt_spin:
+            return rt_spin;
         default:
             return timeCoord->getTimeProperty(timeProperty);
     }
@@ -1498,6 +1614,8 @@ bool FederateState::getOptionFlag(int optionFlag) const
             return interfaceInformation.getChangeUpdateFlag();
         case defs::flags::realtime:
             return realtime;
+        case defs::flags::realtime_high_precision:
+            return realtime_high_precision;
         case defs::flags::observer:
             return observer;
         case defs::flags::source_only:
@@ -1545,6 +1663,8 @@ int FederateState::getIntegerProperty(int intProperty) const
         case defs::properties::file_log_level:
         case defs::properties::console_log_level:
             return logLevel;
+        case defs::properties::rt_cpu_affinity:
+            return rt_cpu_affinity;
         default:
             return timeCoord->getIntegerProperty(intProperty);
     }
@@ -1634,6 +1754,200 @@ Time FederateState::nextMessageTime() const
     return firstMessageTime;
 }
 
+static const std::string checkpointFileHeader{"HELICS_CHECKPOINT_V1"};
+
+static void appendCheckpointSection(std::string& checkpoint, const std::string& section)
+{
+    auto size = static_cast<std::uint64_t>(section.size());
+    for (int ii = 7; ii >= 0; --ii) {
+        checkpoint.push_back(static_cast<char>((size >> (8U * ii)) & 0xFFU));
+    }
+    checkpoint.append(section);
+}
+
+static std::string readCheckpointSection(const std::string& checkpoint, std::size_t& offset)
+{
+    if (checkpoint.size() < offset + 8) {
+        throw(InvalidParameter("checkpoint file is truncated"));
+    }
+    std::uint64_t size{0};
+    for (int ii = 0; ii < 8; ++ii) {
+        size = (size << 8U) + static_cast<unsigned char>(checkpoint[offset + ii]);
+    }
+    offset += 8;
+    if (checkpoint.size() - offset < size) {
+        throw(InvalidParameter("checkpoint file is truncated"));
+    }
+    auto section = checkpoint.substr(offset, static_cast<std::size_t>(size));
+    offset += static_cast<std::size_t>(size);
+    return section;
+}
+
+void FederateState::saveCheckpoint(const std::string& filename) const
+{
+    std::string checkpoint = checkpointFileHeader;
+    appendCheckpointSection(checkpoint, generateCheckpoint());
+    appendCheckpointSection(checkpoint,
+                            (checkpointSaveCallback) ? checkpointSaveCallback() : std::string());
+
+    std::ofstream out(filename, std::ios::out | std::ios::binary);
+    if (!out) {
+        throw(InvalidParameter("unable to open checkpoint file " + filename));
+    }
+    out.write(checkpoint.data(), static_cast<std::streamsize>(checkpoint.size()));
+}
+
+Time FederateState::restoreCheckpoint(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw(InvalidParameter("unable to open checkpoint file " + filename));
+    }
+    std::string checkpoint((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (checkpoint.compare(0, checkpointFileHeader.size(), checkpointFileHeader) != 0) {
+        throw(InvalidParameter(filename + " is not a HELICS checkpoint file"));
+    }
+    std::size_t offset = checkpointFileHeader.size();
+    auto coreState = readCheckpointSection(checkpoint, offset);
+    auto modelState = readCheckpointSection(checkpoint, offset);
+
+    auto checkpointTime = loadCheckpoint(coreState);
+    if (checkpointRestoreCallback) {
+        checkpointRestoreCallback(modelState);
+    }
+    return checkpointTime;
+}
+
+void FederateState::checkpointAtBarrier()
+{
+    if (checkpointFilePrefix.empty() || state != HELICS_EXECUTING ||
+        time_granted >= checkpointTime) {
+        return;
+    }
+    // the file is rewritten on every request past the barrier so it holds the state the
+    // federate has when the barrier stops it
+    try {
+        saveCheckpoint(checkpointFilePrefix + name + ".hckp");
+        lastCheckpointTime = time_granted;
+        LOG_TIMING(fmt::format("checkpoint saved at time {}", static_cast<double>(time_granted)));
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR(std::string("unable to save checkpoint: ") + e.what());
+    }
+}
+
+std::string FederateState::generateCheckpoint() const
+{
+    std::string checkpoint;
+    ActionMessage timeRecord(CMD_TIME_GRANT);
+    timeRecord.name = name;
+    timeCoord->generateCheckpoint(timeRecord);
+    checkpoint.append(timeRecord.packetize());
+
+    for (const auto& inp : interfaceInformation.getInputs()) {
+        ActionMessage inputRecord(CMD_REG_INPUT);
+        inputRecord.name = inp->key;
+        checkpoint.append(inputRecord.packetize());
+        for (int ii = 0; ii < static_cast<int>(inp->input_sources.size()); ++ii) {
+            ActionMessage value(CMD_PUB);
+            value.setStringData(inp->source_info[ii].key);
+            if (inp->current_data[ii]) {
+                // the current value is marked so it is restored without generating an update
+                setActionFlag(value, indicator_flag);
+                value.actionTime = inp->current_data_time[ii].first;
+                value.counter = static_cast<uint16_t>(inp->current_data_time[ii].second);
+                value.payload = inp->current_data[ii]->to_string();
+                checkpoint.append(value.packetize());
+                clearActionFlag(value, indicator_flag);
+            }
+            for (const auto& record : inp->getDataQueue(ii)) {
+                value.actionTime = record.time;
+                value.counter = static_cast<uint16_t>(record.iteration);
+                value.payload = record.data->to_string();
+                checkpoint.append(value.packetize());
+            }
+        }
+    }
+    for (const auto& ept : interfaceInformation.getEndpoints()) {
+        ActionMessage endpointRecord(CMD_REG_ENDPOINT);
+        endpointRecord.name = ept->key;
+        checkpoint.append(endpointRecord.packetize());
+        for (auto& msg : ept->getQueuedMessages()) {
+            ActionMessage message(std::make_unique<Message>(std::move(msg)));
+            checkpoint.append(message.packetize());
+        }
+    }
+    return checkpoint;
+}
+
+Time FederateState::loadCheckpoint(const std::string& checkpoint)
+{
+    Time savedTime{timeZero};
+    InputInfo* inp{nullptr};
+    std::size_t inputIndex{0};
+    EndpointInfo* ept{nullptr};
+    const char* data = checkpoint.data();
+    int remaining = static_cast<int>(checkpoint.size());
+    while (remaining > 0) {
+        ActionMessage cmd;
+        auto used = cmd.depacketize(data, remaining);
+        if (used <= 0) {
+            throw(InvalidParameter("checkpoint data is not valid"));
+        }
+        data += used;
+        remaining -= used;
+        switch (cmd.action()) {
+            case CMD_TIME_GRANT:
+                savedTime = cmd.actionTime;
+                timeCoord->restoreCheckpoint(cmd);
+                break;
+            case CMD_REG_INPUT:
+                if (!cmd.name.empty()) {
+                    inp = interfaceInformation.getInput(cmd.name);
+                } else {
+                    // unnamed inputs are matched by their registration order
+                    auto inputs = interfaceInformation.getInputs();
+                    inp = (inputIndex < inputs->size()) ? (*inputs)[inputIndex] : nullptr;
+                }
+                ++inputIndex;
+                break;
+            case CMD_PUB:
+                if (inp == nullptr) {
+                    break;
+                }
+                for (int ii = 0; ii < static_cast<int>(inp->source_info.size()); ++ii) {
+                    if (inp->source_info[ii].key != cmd.getString(0)) {
+                        continue;
+                    }
+                    if (checkActionFlag(cmd, indicator_flag)) {
+                        inp->current_data[ii] =
+                            std::make_shared<const data_block>(std::move(cmd.payload));
+                        inp->current_data_time[ii] = {cmd.actionTime, cmd.counter};
+                    } else {
+                        inp->addData(inp->input_sources[ii],
+                                     cmd.actionTime,
+                                     cmd.counter,
+                                     std::make_shared<const data_block>(std::move(cmd.payload)));
+                    }
+                    break;
+                }
+                break;
+            case CMD_REG_ENDPOINT:
+                ept = interfaceInformation.getEndpoint(cmd.name);
+                break;
+            case CMD_SEND_MESSAGE:
+                if (ept != nullptr) {
+                    auto source = cmd.getSource();
+                    ept->addMessage(createMessageFromCommand(std::move(cmd)), source);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return savedTime;
+}
+
 void FederateState::setCoreObject(CommonCore* parent)
 {
     spinlock();
@@ -1747,6 +2061,25 @@ std::string FederateState::processQueryActual(const std::string& query) const
         base["state"] = fedStateString(state.load());
         return generateJsonString(base);
     }
+    if (query == "realtime") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["realtime"] = realtime;
+        base["high_precision"] = realtime_high_precision;
+        base["steps"] = static_cast<Json::Int64>(rtLateness.steps);
+        base["late_steps"] = static_cast<Json::Int64>(rtLateness.lateSteps);
+        if (rtLateness.steps > 0) {
+            auto count = static_cast<double>(rtLateness.steps);
+            auto mean = rtLateness.sum / count;
+            base["lateness"] = static_cast<double>(rtLateness.last.count()) * 1e-9;
+            base["mean_lateness"] = mean;
+            base["max_lateness"] = static_cast<double>(rtLateness.largest.count()) * 1e-9;
+            base["min_lateness"] = static_cast<double>(rtLateness.smallest.count()) * 1e-9;
+            base["stddev_lateness"] =
+                std::sqrt((std::max)(rtLateness.sumSquares / count - mean * mean, 0.0));
+        }
+        return generateJsonString(base);
+    }
     if (query == "timeconfig") {
         Json::Value base;
         timeCoord->generateConfig(base);
@@ -1781,6 +2114,26 @@ std::string FederateState::processQueryActual(const std::string& query) const
         base["send_time"] = static_cast<double>(timeCoord->allowedSendTime());
         return generateJsonString(base);
     }
+    if (query == "time_blockers" || query == "critical_path") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_id.load().baseValue();
+        base["parent"] = parent_->getGlobalId().baseValue();
+        base["granted_time"] = static_cast<double>(timeCoord->getGrantedTime());
+        timeCoord->generateGrantStatistics(base);
+        return generateJsonString(base);
+    }
+    if (query == "checkpoint") {
+        Json::Value base;
+        base["name"] = getIdentifier();
+        base["id"] = global_id.load().baseValue();
+        base["granted_time"] = static_cast<double>(time_granted);
+        base["checkpoint_time"] = static_cast<double>(checkpointTime);
+        base["file"] = (checkpointFilePrefix.empty()) ? std::string() :
+                                                        checkpointFilePrefix + name + ".hckp";
+        base["saved_time"] = static_cast<double>(lastCheckpointTime);
+        return generateJsonString(base);
+    }
     if (query == "dependency_graph") {
         Json::Value base;
         base["name"] = getIdentifier();
@@ -1810,7 +2163,7 @@ std::string FederateState::processQuery(const std::string& query) const
         qstring = processQueryActual(query);
     } else if ((query == "queries") || (query == "available_queries")) {
         qstring =
-            "publications;inputs;endpoints;interfaces;subscriptions;current_state;global_state;dependencies;timeconfig;config;dependents;current_time";
+            "publications;inputs;endpoints;interfaces;subscriptions;current_state;global_state;dependencies;timeconfig;config;dependents;current_time;realtime;time_blockers;checkpoint";
     } else {  // the rest might to prevent a race condition
         if (try_lock()) {
             qstring = processQueryActual(query);
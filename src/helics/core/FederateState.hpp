@@ -87,7 +87,20 @@ class FederateState {
         start_clock_time;  //!< time the initialization mode started for real time capture
     Time rt_lag{timeZero};  //!< max lag for the rt control
     Time rt_lead{timeZero};  //!< min lag for the realtime control
+    Time rt_spin{0.001};  //!< the time before a step the high precision mode starts spinning
     int32_t realTimeTimerIndex{-1};  //!< the timer index for the real time timer;
+    int rt_cpu_affinity{-1};  //!< the cpu to pin the federate thread to
+    bool realtime_high_precision{false};  //!< use a sleep then spin wait for real time steps
+    /** statistics on how far the real time grants are from the wall clock*/
+    struct {
+        int64_t steps{0};  //!< the number of real time steps granted
+        int64_t lateSteps{0};  //!< the number of steps granted later than rt_lag allows
+        std::chrono::nanoseconds last{0};  //!< the lateness of the most recent step
+        std::chrono::nanoseconds largest{0};  //!< the largest lateness
+        std::chrono::nanoseconds smallest{0};  //!< the smallest lateness (most early)
+        double sum{0.0};  //!< sum of the lateness in seconds
+        double sumSquares{0.0};  //!< sum of the squared lateness for the standard deviation
+    } rtLateness;
   public:
     std::atomic<bool> init_requested{
         false};  //!< this federate has requested entry to initialization
@@ -110,6 +123,7 @@ class FederateState {
     std::map<global_federate_id, std::deque<ActionMessage>>
         delayQueues;  //!< queue for delaying processing of messages for a time
     std::vector<interface_handle> events;  //!< list of value events to process
+    std::vector<InputUpdate> inputUpdates;  //!< the value events along with their data
     std::vector<global_federate_id> delayedFederates;  //!< list of federates to delay messages from
     Time time_granted{startupTime};  //!< the most recent granted time;
     Time allowed_send_time{startupTime};  //!< the next time a message can be sent;
@@ -120,6 +134,13 @@ class FederateState {
         loggerFunction;  //!< callback for logging functions
     std::function<std::string(const std::string&)>
         queryCallback;  //!< a callback for additional queries
+    std::function<std::string()>
+        checkpointSaveCallback;  //!< callback to generate model state for a checkpoint
+    std::function<void(const std::string&)>
+        checkpointRestoreCallback;  //!< callback to restore model state from a checkpoint
+    Time checkpointTime{Time::maxVal()};  //!< the time of a barrier requesting a checkpoint
+    std::string checkpointFilePrefix;  //!< the file prefix for checkpoints requested by a barrier
+    Time lastCheckpointTime{Time::minVal()};  //!< the granted time of the last barrier checkpoint
     /** find the next Value Event*/
     Time nextValueTime() const;
     /** find the next Message Event*/
@@ -242,6 +263,12 @@ class FederateState {
     int loggingLevel() const { return logLevel; }
 
   private:
+    /** add an interface to the interface information,  the federate must be locked*/
+    void addInterface(handle_type htype,
+                      interface_handle handle,
+                      const std::string& key,
+                      const std::string& type,
+                      const std::string& units);
     /** process the federate queue until returnable event
     @details processQueue will process messages until one of 3 things occur
     1.  the initialization state has been entered
@@ -279,6 +306,9 @@ class FederateState {
     @param currentTime the time of the update
     */
     void fillEventVectorNextIteration(Time currentTime);
+    /** wait for the wall clock to reach the time a real time step should be granted and record
+     * the lateness of the grant*/
+    void realTimeWait();
     /** add a dependency to the timing coordination*/
     void addDependency(global_federate_id fedToDependOn);
     /** add a dependent federate*/
@@ -296,6 +326,9 @@ class FederateState {
     /**get a reference to the handles of subscriptions with value updates
      */
     const std::vector<interface_handle>& getEvents() const;
+    /** get the inputs with value updates along with their data
+    @details the federate should be locked while the array is generated*/
+    const std::vector<InputUpdate>& getInputUpdates();
     /** get a vector of the federates this one depends on
      */
     std::vector<global_federate_id> getDependencies() const;
@@ -335,6 +368,38 @@ class FederateState {
     iteration_result genericUnspecifiedQueueProcess();
     /** function to process the queue until a disconnect_fed_ack is received*/
     void finalize();
+    /** write a checkpoint of the federate to a file
+    @details the file contains the state of the federate in the core followed by the model state
+    from the checkpoint save callback*/
+    void saveCheckpoint(const std::string& filename) const;
+    /** restore the federate from a checkpoint file
+    @details interfaces are matched by name so the federate should be in initializing mode with the
+    same interfaces as when the checkpoint was generated,  the model state is passed to the
+    checkpoint restore callback
+    @return the granted time of the federate when the checkpoint was generated*/
+    Time restoreCheckpoint(const std::string& filename);
+    /** set the callbacks used to include model state in checkpoints*/
+    void setCheckpointCallbacks(std::function<std::string()> saveFunction,
+                                std::function<void(const std::string&)> restoreFunction)
+    {
+        checkpointSaveCallback = std::move(saveFunction);
+        checkpointRestoreCallback = std::move(restoreFunction);
+    }
+
+  private:
+    /** generate a binary checkpoint of the federate
+    @details the checkpoint is a sequence of packetized ActionMessages containing the time
+    coordinator state and the pending data of all the inputs and endpoints, values and messages
+    still in transit are not included*/
+    std::string generateCheckpoint() const;
+    /** load the time state, input data and endpoint messages from a binary checkpoint
+    @details the current input values are restored without marking them as updated
+    @return the granted time of the federate when the checkpoint was generated*/
+    Time loadCheckpoint(const std::string& checkpoint);
+    /** save the checkpoint requested by a time barrier if the federate has not passed it*/
+    void checkpointAtBarrier();
+
+  public:
 
     /** add an action message to the queue*/
     void addAction(const ActionMessage& action);
@@ -388,6 +453,11 @@ class FederateState {
                          const std::string& key,
                          const std::string& type,
                          const std::string& units);
+    /** create a set of interfaces under a single lock
+    @param interfaces the definitions of the interfaces
+    @param handles the handles assigned to each interface by the core*/
+    void createInterfaces(const std::vector<InterfaceDefinition>& interfaces,
+                          const std::vector<interface_handle>& handles);
     /** close an interface*/
     void closeInterface(interface_handle handle, handle_type type);
 };
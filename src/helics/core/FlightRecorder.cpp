@@ -0,0 +1,201 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "FlightRecorder.hpp"
+
+#include "ActionMessage.hpp"
+#include "core-exceptions.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace helics {
+/** marker at the start of a flight recorder file*/
+static constexpr char flightFileMagic[8] = {'H', 'E', 'L', 'I', 'C', 'S', 'F', 'R'};
+static constexpr uint32_t flightFileVersion{1};
+/** marker to detect files written on a machine with a different byte order*/
+static constexpr uint32_t byteOrderMark{0x01020304};
+
+static_assert(sizeof(FlightRecord) == 56, "flight records should be a fixed size");
+
+FlightRecorder::FlightRecorder(std::size_t capacity):
+    startTime(std::chrono::steady_clock::now()),
+    startSystemTime(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count())
+{
+    std::size_t size{1};
+    while (size <= capacity) {
+        size <<= 1U;
+    }
+    records.resize(size);
+    stamps = std::make_unique<std::atomic<uint64_t>[]>(size);
+    for (std::size_t ii = 0; ii < size; ++ii) {
+        stamps[ii].store(0, std::memory_order_relaxed);
+    }
+    mask = size - 1;
+}
+
+/** get the stamp of a slot holding the complete record of a sequence number*/
+static constexpr uint64_t completeStamp(uint64_t sequence)
+{
+    return 2 * sequence + 2;
+}
+
+uint64_t FlightRecorder::record(const ActionMessage& cmd)
+{
+    auto sequence = writeIndex.load(std::memory_order_relaxed);
+    auto& stamp = stamps[sequence & mask];
+    stamp.store(completeStamp(sequence) - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    auto& rec = records[sequence & mask];
+    rec.clockTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - startTime)
+                        .count();
+    rec.actionTime = cmd.actionTime.getBaseTimeCode();
+    rec.action = static_cast<int32_t>(cmd.action());
+    rec.messageID = cmd.messageID;
+    rec.sourceId = cmd.source_id.baseValue();
+    rec.sourceHandle = cmd.source_handle.baseValue();
+    rec.destId = cmd.dest_id.baseValue();
+    rec.destHandle = cmd.dest_handle.baseValue();
+    rec.payloadSize = static_cast<uint32_t>(cmd.payload.size());
+    rec.processingTime = 0;
+    rec.flags = cmd.flags;
+    rec.counter = cmd.counter;
+    stamp.store(completeStamp(sequence), std::memory_order_release);
+    writeIndex.store(sequence + 1, std::memory_order_release);
+    return sequence;
+}
+
+void FlightRecorder::finishRecord(uint64_t sequence)
+{
+    auto& stamp = stamps[sequence & mask];
+    if (stamp.load(std::memory_order_relaxed) != completeStamp(sequence)) {
+        // the slot already holds a newer record
+        return;
+    }
+    auto& rec = records[sequence & mask];
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count() -
+        rec.clockTime;
+    stamp.store(completeStamp(sequence) - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    rec.processingTime = static_cast<uint32_t>(
+        (std::min)(elapsed, static_cast<int64_t>((std::numeric_limits<uint32_t>::max)())));
+    stamp.store(completeStamp(sequence), std::memory_order_release);
+}
+
+std::vector<FlightRecord> FlightRecorder::snapshot() const
+{
+    auto end = writeIndex.load(std::memory_order_acquire);
+    const uint64_t size = records.size();
+    auto start = (end > size - 1) ? end - (size - 1) : uint64_t{0};
+    std::vector<FlightRecord> result;
+    result.reserve(end - start);
+    FlightRecord rec;
+    for (auto sequence = start; sequence < end; ++sequence) {
+        const auto& stamp = stamps[sequence & mask];
+        // a record being finished is only held for a few stores so retry a few times
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            auto before = stamp.load(std::memory_order_acquire);
+            if (before > completeStamp(sequence)) {
+                // overwritten by a newer record
+                break;
+            }
+            if (before == completeStamp(sequence)) {
+                std::memcpy(&rec, &records[sequence & mask], sizeof(FlightRecord));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (stamp.load(std::memory_order_relaxed) == before) {
+                    result.push_back(rec);
+                    break;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::size_t FlightRecorder::writeFile(const std::string& fileName,
+                                      const std::string& sourceName) const
+{
+    auto total = totalRecorded();
+    auto recs = snapshot();
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return 0;
+    }
+    const uint32_t recordSize{sizeof(FlightRecord)};
+    const auto nameSize = static_cast<uint32_t>(sourceName.size());
+    const auto count = static_cast<uint64_t>(recs.size());
+    out.write(flightFileMagic, sizeof(flightFileMagic));
+    out.write(reinterpret_cast<const char*>(&byteOrderMark), sizeof(byteOrderMark));
+    out.write(reinterpret_cast<const char*>(&flightFileVersion), sizeof(flightFileVersion));
+    out.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    out.write(reinterpret_cast<const char*>(&nameSize), sizeof(nameSize));
+    out.write(reinterpret_cast<const char*>(&startSystemTime), sizeof(startSystemTime));
+    out.write(reinterpret_cast<const char*>(&total), sizeof(total));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(sourceName.data(), nameSize);
+    out.write(reinterpret_cast<const char*>(recs.data()),
+              static_cast<std::streamsize>(recs.size() * sizeof(FlightRecord)));
+    return (out) ? recs.size() : 0;
+}
+
+FlightRecorder::FileContents FlightRecorder::readFile(const std::string& fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) {
+        throw(InvalidParameter("unable to open flight recorder file " + fileName));
+    }
+    char magic[sizeof(flightFileMagic)];
+    uint32_t order{0};
+    uint32_t version{0};
+    uint32_t recordSize{0};
+    uint32_t nameSize{0};
+    uint64_t count{0};
+    FileContents contents;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&order), sizeof(order));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&recordSize), sizeof(recordSize));
+    in.read(reinterpret_cast<char*>(&nameSize), sizeof(nameSize));
+    in.read(reinterpret_cast<char*>(&contents.startTime), sizeof(contents.startTime));
+    in.read(reinterpret_cast<char*>(&contents.totalRecorded), sizeof(contents.totalRecorded));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, flightFileMagic, sizeof(magic)) != 0) {
+        throw(InvalidParameter(fileName + " is not a flight recorder file"));
+    }
+    if (order != byteOrderMark) {
+        throw(InvalidParameter(fileName + " was written on a machine with a different byte order"));
+    }
+    if (version != flightFileVersion || recordSize != sizeof(FlightRecord)) {
+        throw(InvalidParameter(fileName + " has an unsupported flight recorder version"));
+    }
+    // check the header sizes against the file before allocating anything
+    const auto dataStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto remaining = static_cast<uint64_t>(in.tellg() - dataStart);
+    in.seekg(dataStart);
+    if (nameSize > remaining || count > (remaining - nameSize) / sizeof(FlightRecord)) {
+        throw(InvalidParameter(fileName + " is truncated"));
+    }
+    contents.name.resize(nameSize);
+    in.read(&contents.name[0], nameSize);
+    contents.records.resize(static_cast<std::size_t>(count));
+    in.read(reinterpret_cast<char*>(contents.records.data()),
+            static_cast<std::streamsize>(count * sizeof(FlightRecord)));
+    if (!in) {
+        throw(InvalidParameter(fileName + " is truncated"));
+    }
+    return contents;
+}
+
+}  // namespace helics
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace helics {
+class ActionMessage;
+
+/** compact fixed size record of a single message processed by a broker or core*/
+struct FlightRecord {
+    int64_t clockTime{0};  //!< steady clock time the message was processed in ns from the start
+    int64_t actionTime{0};  //!< the action time of the message in base time units
+    int32_t action{0};  //!< the action of the message
+    int32_t messageID{0};  //!< the message ID field
+    int32_t sourceId{0};  //!< the source federate or broker id
+    int32_t sourceHandle{0};  //!< the source handle
+    int32_t destId{0};  //!< the destination federate or broker id
+    int32_t destHandle{0};  //!< the destination handle
+    uint32_t payloadSize{0};  //!< the size of the payload
+    uint32_t processingTime{0};  //!< the time it took to process the message in ns
+    uint16_t flags{0};  //!< the message flags
+    uint16_t counter{0};  //!< the message counter
+    uint32_t padding{0};  //!< unused, keeps the record size a multiple of 8
+};
+
+/** a bounded ring buffer keeping the most recent messages processed by a broker or core
+@details there is a single writer, the processing thread, which never blocks or allocates after
+construction.  Other threads can take a snapshot at any time; each slot carries a sequence stamp
+which is checked around the copy of a record so records which were being written or overwritten
+while the snapshot was copied are dropped from it.
+*/
+class FlightRecorder {
+  public:
+    /** the contents of a flight recorder file*/
+    struct FileContents {
+        std::string name;  //!< the name of the broker or core that generated the file
+        int64_t startTime{0};  //!< the system clock time of the clockTime origin in ns since epoch
+        uint64_t totalRecorded{0};  //!< the total number of messages recorded
+        std::vector<FlightRecord> records;  //!< the records in the file, oldest first
+    };
+    /** construct a recorder
+    @param capacity the minimum number of records to keep, the buffer is sized to the next power of 2
+    with one slot reserved for the record being written*/
+    explicit FlightRecorder(std::size_t capacity);
+
+    /** record a message
+    @return the sequence number of the record to use with finishRecord*/
+    uint64_t record(const ActionMessage& cmd);
+    /** set the processing time of a record to the time elapsed since it was recorded*/
+    void finishRecord(uint64_t sequence);
+    /** get a copy of the current records, oldest first*/
+    std::vector<FlightRecord> snapshot() const;
+    /** get the number of records the buffer holds*/
+    std::size_t capacity() const { return records.size() - 1; }
+    /** get the total number of messages recorded*/
+    uint64_t totalRecorded() const { return writeIndex.load(std::memory_order_acquire); }
+    /** write the current records to a binary file
+    @param fileName the file to write
+    @param sourceName the name of the broker or core the recorder belongs to
+    @return the number of records written*/
+    std::size_t writeFile(const std::string& fileName, const std::string& sourceName) const;
+    /** read a binary flight recorder file
+    @throw InvalidParameter if the file cannot be read or is not a flight recorder file*/
+    static FileContents readFile(const std::string& fileName);
+
+  private:
+    using time_type = decltype(std::chrono::steady_clock::now());
+    std::vector<FlightRecord> records;  //!< the ring buffer
+    /** the stamp of each slot, odd while the slot is being written and 2*(sequence+1) when the
+     * record with that sequence number is complete*/
+    std::unique_ptr<std::atomic<uint64_t>[]> stamps;
+    uint64_t mask{0};  //!< mask for converting a sequence number into an index
+    std::atomic<uint64_t> writeIndex{0};  //!< the sequence number of the next record
+    const time_type startTime;  //!< the steady clock origin of the record clock times
+    const int64_t startSystemTime;  //!< the system clock time of startTime
+};
+}  // namespace helics
@@ -75,6 +75,7 @@ class minTimeSet {
     Time minminDe = Time::maxVal();
     Time minDe = minminDe;
     global_federate_id minFed;
+    global_federate_id minNextFed;
     DependencyInfo::time_state_t tState = DependencyInfo::time_state_t::time_requested;
 };
 
@@ -89,6 +90,7 @@ static minTimeSet generateMinTimeSet(const TimeDependencies& dependencies,
         }
         if (dep.Tnext < mTime.minNext) {
             mTime.minNext = dep.Tnext;
+            mTime.minNextFed = dep.limitingFederate();
             mTime.tState = dep.time_state;
         } else if (dep.Tnext == mTime.minNext) {
             if (dep.time_state == DependencyInfo::time_state_t::time_granted) {
@@ -132,6 +134,7 @@ void ForwardingTimeCoordinator::updateTimeFactors()
 
     Time prev_next = time_next;
     time_next = mTime.minNext;
+    minNextFed = mTime.minNextFed;
 
     if (mTime.minDe != time_minDe) {
         update = true;
@@ -173,7 +176,8 @@ void ForwardingTimeCoordinator::sendTimeRequest() const
     if (time_state == DependencyInfo::time_state_t::time_granted) {
         ActionMessage upd(CMD_TIME_GRANT);
         upd.source_id = source_id;
-        //    upd.source_handle = lastMinFed;
+        // pass along the federate limiting the time for critical path analysis
+        upd.source_handle = interface_handle(minNextFed.baseValue());
         upd.actionTime = time_next;
         if (iterating) {
             setActionFlag(upd, iteration_requested_flag);
@@ -182,7 +186,7 @@ void ForwardingTimeCoordinator::sendTimeRequest() const
     } else {
         ActionMessage upd(CMD_TIME_REQUEST);
         upd.source_id = source_id;
-        //    upd.source_handle = lastMinFed;
+        upd.source_handle = interface_handle(minNextFed.baseValue());
         upd.actionTime = time_next;
         upd.Te = time_minDe;
         upd.Tdemin = time_minminDe;
@@ -296,6 +300,7 @@ ActionMessage
     ActionMessage nTime(msg);
 
     nTime.actionTime = mTime.minNext;
+    nTime.source_handle = interface_handle(mTime.minNextFed.baseValue());
     nTime.Tdemin = mTime.minminDe;
     nTime.Te = mTime.minDe;
     nTime.dest_id = iFed;
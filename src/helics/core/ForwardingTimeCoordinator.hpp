@@ -31,6 +31,7 @@ class ForwardingTimeCoordinator {
     DependencyInfo::time_state_t time_state{
         DependencyInfo::time_state_t::time_requested};  //!< the current forwarding time state
     global_federate_id lastMinFed{};  //!< the latest minimum fed
+    global_federate_id minNextFed{};  //!< the federate limiting the forwarded next time
     // Core::local_federate_id parent = invalid_fed_id;  //!< the id for the parent object which
     // should also be a ForwardingTimeCoordinator
     TimeDependencies dependencies;  //!< federates which this Federate is temporally dependent on
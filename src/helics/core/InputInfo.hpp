@@ -132,6 +132,9 @@ class InputInfo {
     void removeSource(const std::string& sourceName, Time minTime);
     /** clear all non-current data*/
     void clearFutureData();
+    /** get the queue of pending data from a particular source
+    @param index the index of the source in input_sources*/
+    const std::vector<dataRecord>& getDataQueue(int index) const { return data_queues[index]; }
 
     const std::string& getInjectionType() const;
     const std::string& getInjectionUnits() const;
@@ -7,26 +7,22 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "MessageTimer.hpp"
 
+#include <exception>
 #include <iostream>
 #include <utility>
 
 namespace helics {
 MessageTimer::MessageTimer(std::function<void(ActionMessage&&)> sFunction):
-    sendFunction(std::move(sFunction)), contextPtr(AsioContextManager::getContextPointer()),
-    loopHandle(contextPtr->startContextLoop())
+    sendFunction(std::move(sFunction)), wheel(TimerWheel::getSharedWheel())
 {
 }
 
-static void processTimerCallback(std::shared_ptr<MessageTimer> mtimer,
-                                 int32_t index,
-                                 const std::error_code& ec)
+MessageTimer::~MessageTimer()
 {
-    if (ec != asio::error::operation_aborted) {
-        try {
-            mtimer->sendMessage(index);
-        }
-        catch (std::exception& e) {
-            std::cerr << "exception caught from sendMessage:" << e.what() << std::endl;
+    // the callbacks refer to this object so they must be released before it is gone
+    for (auto timer : timers) {
+        if (timer >= 0) {
+            wheel->releaseTimer(timer);
         }
     }
 }
@@ -38,24 +34,19 @@ int32_t MessageTimer::addTimerFromNow(std::chrono::nanoseconds time, ActionMessa
 
 int32_t MessageTimer::addTimer(time_type expirationTime, ActionMessage mess)
 {
-    // these two calls need to be before the lock
-    auto timer = std::make_shared<asio::steady_timer>(contextPtr->getBaseContext());
-    timer->expires_at(expirationTime);
-
     std::unique_lock<std::mutex> lock(timerLock);
 
     auto index = static_cast<int32_t>(timers.size());
-    auto timerCallback = [ptr = shared_from_this(), index](const std::error_code& ec) {
-        processTimerCallback(ptr, index, ec);
-    };
     buffers.push_back(std::move(mess));
     expirationTimes.push_back(expirationTime);
-    timers.push_back(std::move(timer));
     if (expirationTime > std::chrono::steady_clock::now()) {
-        timers.back()->async_wait(timerCallback);
+        timers.push_back(
+            wheel->addTimer(expirationTime, [this, index]() { timerCallback(index); }));
     } else {
+        // already expired so send it now,  the wheel timer is created if the timer is updated
+        timers.push_back(-1);
         lock.unlock();
-        timerCallback(std::error_code{});
+        timerCallback(index);
     }
 
     return index;
@@ -66,7 +57,9 @@ void MessageTimer::cancelTimer(int32_t index)
     std::lock_guard<std::mutex> lock(timerLock);
     if ((index >= 0) && (index < static_cast<int32_t>(timers.size()))) {
         buffers[index].setAction(CMD_IGNORE);
-        timers[index]->cancel();
+        if (timers[index] >= 0) {
+            wheel->cancelTimer(timers[index]);
+        }
     }
 }
 
@@ -76,8 +69,10 @@ void MessageTimer::cancelAll()
     for (auto& buf : buffers) {
         buf.setAction(CMD_IGNORE);
     }
-    for (auto& tmr : timers) {
-        tmr->cancel();
+    for (auto timer : timers) {
+        if (timer >= 0) {
+            wheel->cancelTimer(timer);
+        }
     }
 }
 
@@ -85,15 +80,9 @@ void MessageTimer::updateTimer(int32_t timerIndex, time_type expirationTime, Act
 {
     std::lock_guard<std::mutex> lock(timerLock);
     if ((timerIndex >= 0) && (timerIndex < static_cast<int32_t>(timers.size()))) {
-        timers[timerIndex]->expires_at(expirationTime);
         expirationTimes[timerIndex] = expirationTime;
         buffers[timerIndex] = std::move(mess);
-
-        auto timerCallback = [ptr = shared_from_this(), timerIndex](const std::error_code& ec) {
-            processTimerCallback(ptr, timerIndex, ec);
-        };
-
-        timers[timerIndex]->async_wait(timerCallback);
+        armTimer(timerIndex, expirationTime);
     }
 }
 
@@ -101,15 +90,10 @@ bool MessageTimer::addTimeToTimer(int32_t timerIndex, std::chrono::nanoseconds t
 {
     std::lock_guard<std::mutex> lock(timerLock);
     if ((timerIndex >= 0) && (timerIndex < static_cast<int32_t>(timers.size()))) {
-        auto newTime = timers[timerIndex]->expires_at() + time;
-        timers[timerIndex]->expires_at(newTime);
-        auto timerCallback = [ptr = shared_from_this(), timerIndex](const std::error_code& ec) {
-            processTimerCallback(ptr, timerIndex, ec);
-        };
+        auto newTime = expirationTimes[timerIndex] + time;
         expirationTimes[timerIndex] = newTime;
-        auto ret = (buffers[timerIndex].action() != CMD_IGNORE);
-        timers[timerIndex]->async_wait(timerCallback);
-        return ret;
+        armTimer(timerIndex, newTime);
+        return (buffers[timerIndex].action() != CMD_IGNORE);
     }
     return false;
 }
@@ -118,14 +102,9 @@ bool MessageTimer::updateTimer(int32_t timerIndex, time_type expirationTime)
 {
     std::lock_guard<std::mutex> lock(timerLock);
     if ((timerIndex >= 0) && (timerIndex < static_cast<int32_t>(timers.size()))) {
-        timers[timerIndex]->expires_at(expirationTime);
-        auto timerCallback = [ptr = shared_from_this(), timerIndex](const std::error_code& ec) {
-            processTimerCallback(ptr, timerIndex, ec);
-        };
         expirationTimes[timerIndex] = expirationTime;
-        auto ret = (buffers[timerIndex].action() != CMD_IGNORE);
-        timers[timerIndex]->async_wait(timerCallback);
-        return ret;
+        armTimer(timerIndex, expirationTime);
+        return (buffers[timerIndex].action() != CMD_IGNORE);
     }
     return false;
 }
@@ -154,4 +133,24 @@ void MessageTimer::sendMessage(int32_t timerIndex)
     }
 }
 
+void MessageTimer::armTimer(int32_t timerIndex, time_type expirationTime)
+{
+    if (timers[timerIndex] < 0) {
+        timers[timerIndex] =
+            wheel->addTimer(expirationTime, [this, timerIndex]() { timerCallback(timerIndex); });
+    } else {
+        wheel->updateTimer(timers[timerIndex], expirationTime);
+    }
+}
+
+void MessageTimer::timerCallback(int32_t timerIndex)
+{
+    try {
+        sendMessage(timerIndex);
+    }
+    catch (std::exception& e) {
+        std::cerr << "exception caught from sendMessage:" << e.what() << std::endl;
+    }
+}
+
 }  // namespace helics
@@ -6,21 +6,24 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
-#include "../common/AsioContextManager.h"
 #include "ActionMessage.hpp"
+#include "TimerWheel.hpp"
 
-#include <asio/steady_timer.hpp>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 namespace helics {
 /** class containing a message timer for sending messages at particular points in time
+@details the timers are serviced by the shared TimerWheel
  */
-class MessageTimer: public std::enable_shared_from_this<MessageTimer> {
+class MessageTimer {
   public:
     using time_type = decltype(std::chrono::steady_clock::now());
     explicit MessageTimer(std::function<void(ActionMessage&&)> sFunction);
+    /** destructor releases all the timers*/
+    ~MessageTimer();
     /** add a timer and message to the queue
     @return an index for referencing the timer in the future*/
     int32_t addTimerFromNow(std::chrono::nanoseconds time, ActionMessage mess);
@@ -47,15 +50,18 @@ class MessageTimer: public std::enable_shared_from_this<MessageTimer> {
     void sendMessage(int32_t timerIndex);
 
   private:
+    /** set the wheel timer for a timer index,  creating it if the timer was never on the wheel
+    @details must be called with the timerLock held*/
+    void armTimer(int32_t timerIndex, time_type expirationTime);
+    /** the function called by the timer wheel when a timer expires*/
+    void timerCallback(int32_t timerIndex);
+
     std::mutex timerLock;  //!< lock protecting the timer buffers
     std::vector<ActionMessage> buffers;
     std::vector<time_type> expirationTimes;
     const std::function<void(ActionMessage&&)>
         sendFunction;  //!< the callback to use when sending a message
-    std::vector<std::shared_ptr<asio::steady_timer>> timers;
-    std::shared_ptr<AsioContextManager>
-        contextPtr;  //!< context manager to for handling real time operations
-    decltype(contextPtr->startContextLoop())
-        loopHandle;  //!< loop controller for async real time operations
+    std::vector<int32_t> timers;  //!< the timer wheel index of each timer, -1 if not on the wheel
+    std::shared_ptr<TimerWheel> wheel;  //!< the timer wheel servicing the timers
 };
 }  // namespace helics
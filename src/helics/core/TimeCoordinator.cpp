@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "json/json.h"
 #include <algorithm>
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
@@ -48,6 +49,9 @@ void TimeCoordinator::enteringExecMode(iteration_request mode)
     checkingExec = true;
     ActionMessage execreq(CMD_EXEC_REQUEST);
     execreq.source_id = source_id;
+    // the dependents use the output delay as a lookahead when this federate is granted a time
+    promisedLookahead = std::max(promisedLookahead, info.outputDelay);
+    execreq.actionTime = promisedLookahead;
     if (iterating != iteration_request::no_iterations) {
         setIterationFlags(execreq, iterating);
     }
@@ -142,6 +146,12 @@ void TimeCoordinator::timeRequest(Time nextTime,
                                   Time newValueTime,
                                   Time newMessageTime)
 {
+    auto requestTime = std::chrono::steady_clock::now();
+    if (grantStats.grants > 0) {
+        grantStats.computeTime += requestTime - grantStats.lastGrant;
+    }
+    grantStats.requestStart = requestTime;
+    grantStats.blocker = global_federate_id{};
     iterating = iterate;
 
     if (iterating != iteration_request::no_iterations) {
@@ -242,6 +252,21 @@ void TimeCoordinator::updateValueTime(Time valueUpdateTime)
     }
 }
 
+void TimeCoordinator::generateCheckpoint(ActionMessage& record) const
+{
+    record.actionTime = time_granted;
+    record.Te = time_grantBase;
+}
+
+void TimeCoordinator::restoreCheckpoint(const ActionMessage& record)
+{
+    if (executionMode) {
+        return;
+    }
+    time_restored = std::max(record.actionTime, timeZero);
+    time_restoredBase = std::max(record.Te, timeZero);
+}
+
 void TimeCoordinator::generateConfig(Json::Value& base) const
 {
     base["uninterruptible"] = info.uninterruptible;
@@ -266,6 +291,106 @@ void TimeCoordinator::generateConfig(Json::Value& base) const
     }
 }
 
+static double toSeconds(std::chrono::nanoseconds duration)
+{
+    return static_cast<double>(duration.count()) * 1e-9;
+}
+
+void TimeCoordinator::generateGrantStatistics(Json::Value& base) const
+{
+    base["grants"] = static_cast<Json::Int64>(grantStats.grants);
+    base["compute_time"] = toSeconds(grantStats.computeTime);
+    base["wait_time"] = toSeconds(grantStats.waitTime);
+    base["max_wait"] = toSeconds(grantStats.maxWait);
+    if (grantStats.lastBlocker.isValid()) {
+        base["last_blocker"] = grantStats.lastBlocker.baseValue();
+    }
+    std::vector<std::pair<global_federate_id, std::pair<int64_t, std::chrono::nanoseconds>>>
+        blockers(grantStats.blockers.begin(), grantStats.blockers.end());
+    std::sort(blockers.begin(), blockers.end(), [](const auto& blk1, const auto& blk2) {
+        return blk1.second.second > blk2.second.second;
+    });
+    base["blockers"] = Json::arrayValue;
+    for (const auto& blk : blockers) {
+        Json::Value blocker;
+        blocker["id"] = blk.first.baseValue();
+        blocker["grants"] = static_cast<Json::Int64>(blk.second.first);
+        blocker["wait_time"] = toSeconds(blk.second.second);
+        base["blockers"].append(blocker);
+    }
+}
+
+/** the statistics accumulated for a federate in the critical path summary*/
+struct criticalPathEntry {
+    std::string name;
+    int64_t grants{0};
+    double computeTime{0.0};
+    double waitTime{0.0};
+    int64_t blockedGrants{0};  //!< the number of grants of other federates it held back
+    double blockingTime{0.0};  //!< the wall clock time other federates waited on it
+};
+
+/** collect the federate entries from all levels of a query tree*/
+static void collectGrantStatistics(Json::Value& node,
+                                   std::map<int32_t, criticalPathEntry>& entries,
+                                   bool root)
+{
+    if (!root) {
+        // drop summaries generated at lower levels of the hierarchy
+        node.removeMember("critical_path");
+    }
+    if (node.isMember("federates") && node["federates"].isArray()) {
+        for (auto& fed : node["federates"]) {
+            if (!fed.isMember("grants")) {
+                continue;
+            }
+            auto& entry = entries[fed["id"].asInt()];
+            entry.name = fed["name"].asString();
+            entry.grants = fed["grants"].asInt64();
+            entry.computeTime = fed["compute_time"].asDouble();
+            entry.waitTime = fed["wait_time"].asDouble();
+            for (const auto& blk : fed["blockers"]) {
+                auto& blocker = entries[blk["id"].asInt()];
+                blocker.blockedGrants += blk["grants"].asInt64();
+                blocker.blockingTime += blk["wait_time"].asDouble();
+            }
+        }
+    }
+    for (const auto* level : {"cores", "brokers"}) {
+        if (node.isMember(level) && node[level].isArray()) {
+            for (auto& sub : node[level]) {
+                collectGrantStatistics(sub, entries, false);
+            }
+        }
+    }
+}
+
+void generateCriticalPathSummary(Json::Value& base)
+{
+    std::map<int32_t, criticalPathEntry> entries;
+    collectGrantStatistics(base, entries, true);
+    std::vector<std::pair<int32_t, criticalPathEntry>> ranked(entries.begin(), entries.end());
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& ent1, const auto& ent2) {
+        return ent1.second.blockingTime > ent2.second.blockingTime;
+    });
+    base["critical_path"] = Json::arrayValue;
+    for (const auto& ent : ranked) {
+        Json::Value fed;
+        fed["id"] = ent.first;
+        fed["name"] = (ent.second.name.empty()) ? std::to_string(ent.first) : ent.second.name;
+        fed["blocking_time"] = ent.second.blockingTime;
+        fed["blocked_grants"] = static_cast<Json::Int64>(ent.second.blockedGrants);
+        fed["grants"] = static_cast<Json::Int64>(ent.second.grants);
+        fed["compute_time"] = ent.second.computeTime;
+        fed["wait_time"] = ent.second.waitTime;
+        auto total = ent.second.computeTime + ent.second.waitTime;
+        if (total > 0.0) {
+            fed["compute_fraction"] = ent.second.computeTime / total;
+        }
+        base["critical_path"].append(fed);
+    }
+}
+
 bool TimeCoordinator::hasActiveTimeDependencies() const
 {
     return dependencies.hasActiveTimeDependencies();
@@ -343,9 +468,11 @@ bool TimeCoordinator::updateTimeFactors()
     Time minNext = Time::maxVal();
     Time minminDe = std::min(time_value, time_message);
     Time minDe = minminDe;
+    minNextFed = global_federate_id{};
     for (auto& dep : dependencies) {
         if (dep.Tnext < minNext) {
             minNext = dep.Tnext;
+            minNextFed = dep.limitingFederate();
         }
         if (dep.Tdemin >= dep.Tnext) {
             if (dep.Tdemin < minminDe) {
@@ -438,6 +565,8 @@ message_processing_result TimeCoordinator::checkTimeGrant()
         }
     }
 
+    // the dependency with the smallest next time is what is holding back the grant
+    grantStats.blocker = minNextFed;
     // if we haven't returned we may need to update the time messages
     if ((!dependents.empty()) && (update)) {
         sendTimeRequest();
@@ -464,6 +593,20 @@ void TimeCoordinator::sendTimeRequest() const
 
 void TimeCoordinator::updateTimeGrant()
 {
+    auto grantTime = std::chrono::steady_clock::now();
+    auto wait =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(grantTime - grantStats.requestStart);
+    ++grantStats.grants;
+    grantStats.waitTime += wait;
+    grantStats.maxWait = std::max(grantStats.maxWait, wait);
+    grantStats.lastGrant = grantTime;
+    grantStats.lastBlocker = grantStats.blocker;
+    if (grantStats.blocker.isValid()) {
+        auto& blocked = grantStats.blockers[grantStats.blocker];
+        ++blocked.first;
+        blocked.second += wait;
+    }
+    grantStats.blocker = global_federate_id{};
     if (iterating != iteration_request::force_iteration) {
         time_granted = time_exec;
         time_grantBase = time_granted;
@@ -604,8 +747,8 @@ message_processing_result TimeCoordinator::checkExecEntry()
     }
 
     if (ret == message_processing_result::next_step) {
-        time_granted = timeZero;
-        time_grantBase = time_granted;
+        time_granted = time_restored;
+        time_grantBase = time_restoredBase;
         executionMode = true;
         iteration = 0;
 
@@ -774,7 +917,8 @@ void TimeCoordinator::setProperty(int timeProperty, Time propertyVal)
 {
     switch (timeProperty) {
         case defs::properties::output_delay:
-            info.outputDelay = propertyVal;
+            // the dependents rely on the lookahead promised on entering executing mode
+            info.outputDelay = std::max(propertyVal, promisedLookahead);
             break;
         case defs::properties::input_delay:
             info.inputDelay = propertyVal;
@@ -12,7 +12,9 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "json/forwards.h"
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -65,6 +67,10 @@ class TimeCoordinator {
         Time::minVal();  //!< time to use as a basis for calculating the next grantable
     //!< time(usually time granted unless values are changing)
     Time time_block = Time::maxVal();  //!< a blocking time to not grant time >= the specified time
+    Time time_restored = timeZero;  //!< the time to grant when entering execution mode
+    Time time_restoredBase = timeZero;  //!< the grant base to use when entering execution mode
+    Time promisedLookahead =
+        timeZero;  //!< the output delay promised to the dependents when requesting execution
     shared_guarded_m<std::vector<global_federate_id>>
         dependent_federates;  //!< these are to maintain an accessible record of dependent federates
     shared_guarded_m<std::vector<global_federate_id>>
@@ -78,6 +84,20 @@ class TimeCoordinator {
     tcoptions info;  //!< basic time control information
     std::function<void(const ActionMessage&)>
         sendMessageFunction;  //!< callback used to send the messages
+    /** wall clock statistics on the time grants and what held them back*/
+    struct {
+        int64_t grants{0};  //!< the number of time grants
+        std::chrono::nanoseconds computeTime{0};  //!< time spent between a grant and the request
+        std::chrono::nanoseconds waitTime{0};  //!< time spent between a request and the grant
+        std::chrono::nanoseconds maxWait{0};  //!< the longest wait for a grant
+        decltype(std::chrono::steady_clock::now()) requestStart;  //!< when the request was made
+        decltype(std::chrono::steady_clock::now()) lastGrant;  //!< when the last grant was made
+        global_federate_id blocker;  //!< the dependency holding back the current request
+        global_federate_id lastBlocker;  //!< the dependency that held back the last grant
+        /** count of grants held back and total wait attributed to each dependency*/
+        std::map<global_federate_id, std::pair<int64_t, std::chrono::nanoseconds>> blockers;
+    } grantStats;
+    global_federate_id minNextFed;  //!< the federate limiting the allowed time
 
   public:
     global_federate_id source_id{
@@ -119,6 +139,8 @@ class TimeCoordinator {
     Time getGrantedTime() const { return time_granted; }
     /** get the current granted time*/
     Time allowedSendTime() const { return time_granted + info.outputDelay; }
+    /** get the output delay promised to the dependents,  the output delay cannot go below it*/
+    Time getPromisedLookahead() const { return promisedLookahead; }
     /** get a list of actual dependencies*/
     std::vector<global_federate_id> getDependencies() const;
     /** get a reference to the dependents vector*/
@@ -222,5 +244,20 @@ class TimeCoordinator {
     bool hasActiveTimeDependencies() const;
     /** generate a configuration string(JSON)*/
     void generateConfig(Json::Value& base) const;
+    /** generate the wall clock statistics on the time grants and their blocking dependencies*/
+    void generateGrantStatistics(Json::Value& base) const;
+    /** store the time state of the coordinator in a checkpoint record*/
+    void generateCheckpoint(ActionMessage& record) const;
+    /** restore the time state of the coordinator from a checkpoint record
+    @details the restored granted time is granted on entering execution mode*/
+    void restoreCheckpoint(const ActionMessage& record);
 };
+
+/** add a summary of the federates holding back the federation to the result of a critical_path
+query
+@details the summary ranks the federates by the wall clock time the other federates spent waiting
+on them
+@param base the json tree generated from the query containing the grant statistics of federates
+*/
+void generateCriticalPathSummary(Json::Value& base);
 }  // namespace helics
@@ -14,6 +14,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <cassert>
 
 namespace helics {
+/** the earliest time a dependency granted a specific time can generate an output*/
+static Time promisedTime(Time grantTime, Time lookahead)
+{
+    return (grantTime < Time::maxVal() - lookahead) ? grantTime + lookahead : Time::maxVal();
+}
+
 bool DependencyInfo::ProcessMessage(const ActionMessage& m)
 {
     switch (m.action()) {
@@ -21,13 +27,16 @@ bool DependencyInfo::ProcessMessage(const ActionMessage& m)
             time_state = checkActionFlag(m, iteration_requested_flag) ?
                 time_state_t::exec_requested_iterative :
                 time_state_t::exec_requested;
+            // the request carries the output delay the federate promises for the rest of the
+            // co-simulation
+            lookahead = std::max(m.actionTime, timeZero);
             break;
         case CMD_EXEC_GRANT:
             if (!checkActionFlag(m, iteration_requested_flag)) {
                 time_state = time_state_t::time_granted;
-                Tnext = timeZero;
-                Tdemin = timeZero;
-                Te = timeZero;
+                Tnext = lookahead;
+                Tdemin = Tnext;
+                Te = Tnext;
             } else {
                 time_state = time_state_t::initialized;
             }
@@ -56,7 +65,9 @@ bool DependencyInfo::ProcessMessage(const ActionMessage& m)
             //    printf("%d Grant from %d time %f\n", fedID, m.source_id,
             //    static_cast<double>(m.actionTime));
             //   assert(m.actionTime >= Tnext);
-            Tnext = m.actionTime;
+            // while the federate works on the granted time nothing it sends can arrive before the
+            // lookahead expires so that is the time promised to the dependents
+            Tnext = promisedTime(m.actionTime, lookahead);
             Te = Tnext;
             Tdemin = Tnext;
             minFed = global_federate_id(m.source_handle.baseValue());
@@ -28,7 +28,8 @@ class DependencyInfo {
     };
 
     global_federate_id fedID{};  //!< identifier for the dependency
-    global_federate_id minFed{};  //!< identifier for the min dependency
+    global_federate_id minFed{};  //!< the federate ultimately limiting the next time of the
+                                  //!< dependency if it forwards time for others
     time_state_t time_state{time_state_t::initialized};  //!< the current state of the dependency
     bool cyclic{false};  //!< indicator that the dependency is cyclic and should be reset more
                          //!< completely on grant
@@ -37,6 +38,7 @@ class DependencyInfo {
     Time Te{timeZero};  //!< the next currently scheduled event
     Time Tdemin{timeZero};  //!< min dependency event time
     Time forwardEvent{Time::maxVal()};  //!< a predicted event
+    Time lookahead{timeZero};  //!< the delay the dependency guarantees on all its outputs
     /** default constructor*/
     DependencyInfo() = default;
     /** construct from a federate id*/
@@ -47,6 +49,8 @@ class DependencyInfo {
     dependencies
     @return the results of processing the message*/
     bool ProcessMessage(const ActionMessage& m);
+    /** get the federate responsible for the next time of the dependency*/
+    global_federate_id limitingFederate() const { return (minFed.isFederate()) ? minFed : fedID; }
 };
 
 /** class for managing a set of dependencies*/
@@ -9,12 +9,24 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "CommonCore.hpp"
 #include "CoreBroker.hpp"
+#include "TimerWheel.hpp"
 #include "loggingHelper.hpp"
 
 #include <string>
 #include <utility>
 
 namespace helics {
+TimeoutMonitor::TimeoutMonitor(): wheel(TimerWheel::getSharedWheel()) {}
+
+TimeoutMonitor::~TimeoutMonitor()
+{
+    for (auto& conn : connections) {
+        if (conn.timeoutTimer >= 0) {
+            wheel->releaseTimer(conn.timeoutTimer);
+        }
+    }
+}
+
 void TimeoutMonitor::tick(CommonCore* core)
 {
     if (parentConnection.waitingForPingReply) {
@@ -111,15 +123,12 @@ void TimeoutMonitor::tick(CoreBroker* brk)
         }
     }
 
-    for (auto& conn : connections) {
-        if (conn.waitingForPingReply) {
-            waiting = true;
-            if (now - conn.lastPing > timeout) {
-                ActionMessage cerror(CMD_CONNECTION_ERROR);
-                cerror.dest_id = brk->global_broker_id_local;
-                cerror.source_id = conn.connection;
-                brk->addActionMessage(cerror);
-            } else {  // ping again
+    // the timeouts on sub connections are handled by the timer wheel so only the ping needs to be
+    // resent here
+    if (waitingConnections > 0) {
+        waiting = true;
+        for (auto& conn : connections) {
+            if (conn.waitingForPingReply) {
                 ActionMessage png(CMD_PING);
                 png.source_id = brk->global_broker_id_local;
                 png.dest_id = conn.connection;
@@ -177,26 +186,38 @@ void TimeoutMonitor::pingSub(CoreBroker* brk)
     auto now = std::chrono::steady_clock::now();
     bool activePing = false;
     for (auto& brkr : brk->_brokers) {
-        size_t cindex = connections.size();
-        for (size_t ii = 0; ii < cindex; ++ii) {
-            if (connections[ii].connection == brkr.global_id) {
-                cindex = ii;
-                break;
-            }
-        }
-        if (cindex == connections.size()) {
+        size_t cindex;
+        auto fnd = connectionIndex.find(brkr.global_id);
+        if (fnd != connectionIndex.end()) {
+            cindex = fnd->second;
+        } else {
+            cindex = connections.size();
             connections.emplace_back();
             connections[cindex].connection = brkr.global_id;
             connections[cindex].disablePing = brkr._disable_ping;
+            connectionIndex.emplace(brkr.global_id, cindex);
         }
-
+        auto& conn = connections[cindex];
         if (brkr.state < connection_state::error) {
-            if (connections[cindex].disablePing) {
+            if (conn.disablePing) {
                 continue;
             }
-            connections[cindex].activeConnection = true;
-            connections[cindex].waitingForPingReply = true;
-            connections[cindex].lastPing = now;
+            conn.activeConnection = true;
+            if (!conn.waitingForPingReply) {
+                conn.waitingForPingReply = true;
+                ++waitingConnections;
+            }
+            conn.lastPing = now;
+            auto expiration = now + timeout;
+            if (conn.timeoutTimer < 0) {
+                ActionMessage cerror(CMD_CONNECTION_ERROR);
+                cerror.dest_id = brk->global_broker_id_local;
+                cerror.source_id = conn.connection;
+                conn.timeoutTimer =
+                    wheel->addTimer(expiration, [brk, cerror]() { brk->addActionMessage(cerror); });
+            } else {
+                wheel->updateTimer(conn.timeoutTimer, expiration);
+            }
             // send the ping
             ActionMessage png(brkr._core ? CMD_PING : CMD_BROKER_PING);
             png.source_id = brk->global_broker_id_local;
@@ -204,7 +225,8 @@ void TimeoutMonitor::pingSub(CoreBroker* brk)
             brk->transmit(brkr.route, png);
             activePing = true;
         } else {
-            connections[cindex].activeConnection = false;
+            conn.activeConnection = false;
+            clearWaiting(conn);
         }
     }
     if (activePing) {
@@ -222,7 +244,18 @@ void TimeoutMonitor::reset()
     parentConnection.waitingForPingReply = false;
     waitingForConnection = false;
     for (auto& conn : connections) {
+        clearWaiting(conn);
+    }
+}
+
+void TimeoutMonitor::clearWaiting(linkConnection& conn)
+{
+    if (conn.waitingForPingReply) {
         conn.waitingForPingReply = false;
+        --waitingConnections;
+    }
+    if (conn.timeoutTimer >= 0) {
+        wheel->cancelTimer(conn.timeoutTimer);
     }
 }
 
@@ -232,17 +265,14 @@ void TimeoutMonitor::pingReply(const ActionMessage& cmd, CoreBroker* brk)
         parentConnection.waitingForPingReply = false;
         waitingForConnection = false;
     } else {
-        bool waiting{false};
-        bool waswaiting{false};
-        for (auto& conn : connections) {
-            if (cmd.source_id == global_federate_id(conn.connection)) {
-                waswaiting = conn.waitingForPingReply;
-                conn.waitingForPingReply = false;
-            }
-            if (conn.waitingForPingReply) {
-                waiting = true;
-            }
+        auto fnd = connectionIndex.find(cmd.source_id);
+        if (fnd == connectionIndex.end()) {
+            return;
         }
+        auto& conn = connections[fnd->second];
+        bool waswaiting = conn.waitingForPingReply;
+        clearWaiting(conn);
+        bool waiting = (waitingConnections > 0);
         if (!waiting && waswaiting) {
             if (brk != nullptr) {
                 ActionMessage noforward(CMD_BROKER_CONFIGURE);
@@ -8,12 +8,15 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "global_federate_id.hpp"
 
 #include <chrono>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace helics {
 class CommonCore;
 class CoreBroker;
 class ActionMessage;
+class TimerWheel;
 
 /** struct for managing the timeouts on the individual connections*/
 struct linkConnection {
@@ -21,11 +24,17 @@ struct linkConnection {
     bool activeConnection{false};  //!< indicator that the connection is active
     bool disablePing{false};  //!< indicator that the connection doesn't respond to pings
     global_federate_id connection{0};  //!< the id of the connection
+    int32_t timeoutTimer{-1};  //!< the index of the timeout timer on the timer wheel
     decltype(std::chrono::steady_clock::now()) lastPing;
 };
 /** class to handle timeouts and other issues for cores and brokers*/
 class TimeoutMonitor {
   public:
+    TimeoutMonitor();
+    /** destructor releases any outstanding timeout timers*/
+    ~TimeoutMonitor();
+    TimeoutMonitor(const TimeoutMonitor&) = delete;
+    TimeoutMonitor& operator=(const TimeoutMonitor&) = delete;
     /** tick function for a core,  executes one tick*/
     void tick(CommonCore* core);
     /** tick function for a broker,  executes one tick*/
@@ -53,8 +62,13 @@ class TimeoutMonitor {
     decltype(std::chrono::steady_clock::now()) startWaiting;  //!< time that the waiting has started
     linkConnection parentConnection;  //!< the connection information for the parent
     std::vector<linkConnection> connections;  //!< connection information for the other connections
+    std::unordered_map<global_federate_id, size_t>
+        connectionIndex;  //!< lookup for the location of a connection in connections
+    int waitingConnections{0};  //!< the number of sub connections waiting for a ping reply
+    std::shared_ptr<TimerWheel> wheel;  //!< the timer wheel handling the connection timeouts
 
-    // int tickCounter;
+    /** mark a sub connection as no longer waiting and cancel its timeout*/
+    void clearWaiting(linkConnection& conn);
 };
 
 }  // namespace helics
@@ -0,0 +1,339 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "TimerWheel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace helics {
+TimerWheel::TimerWheel(std::chrono::nanoseconds tickResolution):
+    tickSize(tickResolution), startTime(std::chrono::steady_clock::now())
+{
+    slots.fill(noTimer);
+    serviceThread = std::thread([this]() { serviceLoop(); });
+}
+
+TimerWheel::~TimerWheel()
+{
+    {
+        std::lock_guard<std::mutex> lock(wheelLock);
+        halt = true;
+    }
+    wakeCondition.notify_one();
+    if (serviceThread.joinable()) {
+        if (serviceThread.get_id() == std::this_thread::get_id()) {
+            // the wheel should not be destroyed from a callback but don't terminate if it is
+            serviceThread.detach();
+        } else {
+            serviceThread.join();
+        }
+    }
+}
+
+std::shared_ptr<TimerWheel> TimerWheel::getSharedWheel()
+{
+    static std::mutex sharedWheelLock;
+    static std::weak_ptr<TimerWheel> sharedWheel;
+    std::lock_guard<std::mutex> lock(sharedWheelLock);
+    auto wheel = sharedWheel.lock();
+    if (!wheel) {
+        wheel = std::make_shared<TimerWheel>();
+        sharedWheel = wheel;
+    }
+    return wheel;
+}
+
+int32_t TimerWheel::addTimer(time_type expirationTime, std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    int32_t index;
+    if (freeTimers.empty()) {
+        index = static_cast<int32_t>(timers.size());
+        timers.emplace_back();
+    } else {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    }
+    auto& timer = timers[index];
+    timer.inUse = true;
+    timer.callback = std::move(callback);
+    timer.expirationTime = expirationTime;
+    timer.expirationTick = toTick(expirationTime);
+    ++timer.generation;
+    link(index);
+    checkWake(timer.expirationTick);
+    return index;
+}
+
+bool TimerWheel::updateTimer(int32_t index, time_type expirationTime)
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    if ((index < 0) || (index >= static_cast<int32_t>(timers.size())) || (!timers[index].inUse)) {
+        return false;
+    }
+    auto& timer = timers[index];
+    if (timer.slot != noTimer) {
+        unlink(index);
+    }
+    timer.expirationTime = expirationTime;
+    timer.expirationTick = toTick(expirationTime);
+    ++timer.generation;
+    link(index);
+    checkWake(timer.expirationTick);
+    return true;
+}
+
+bool TimerWheel::updateTimer(int32_t index,
+                             time_type expirationTime,
+                             std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    if ((index < 0) || (index >= static_cast<int32_t>(timers.size())) || (!timers[index].inUse)) {
+        return false;
+    }
+    auto& timer = timers[index];
+    if (timer.slot != noTimer) {
+        unlink(index);
+    }
+    timer.callback = std::move(callback);
+    timer.expirationTime = expirationTime;
+    timer.expirationTick = toTick(expirationTime);
+    ++timer.generation;
+    link(index);
+    checkWake(timer.expirationTick);
+    return true;
+}
+
+void TimerWheel::cancelTimer(int32_t index)
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    if ((index < 0) || (index >= static_cast<int32_t>(timers.size())) || (!timers[index].inUse)) {
+        return;
+    }
+    if (timers[index].slot != noTimer) {
+        unlink(index);
+    }
+    ++timers[index].generation;
+}
+
+void TimerWheel::releaseTimer(int32_t index)
+{
+    std::unique_lock<std::mutex> lock(wheelLock);
+    if ((index < 0) || (index >= static_cast<int32_t>(timers.size())) || (!timers[index].inUse)) {
+        return;
+    }
+    if (timers[index].slot != noTimer) {
+        unlink(index);
+    }
+    ++timers[index].generation;
+    if (serviceThread.get_id() != std::this_thread::get_id()) {
+        callbackCondition.wait(lock, [this, index]() { return runningTimer != index; });
+    }
+    timers[index].inUse = false;
+    timers[index].callback = nullptr;
+    freeTimers.push_back(index);
+}
+
+TimerWheel::time_type TimerWheel::getExpirationTime(int32_t index) const
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    if ((index < 0) || (index >= static_cast<int32_t>(timers.size()))) {
+        return time_type{};
+    }
+    return timers[index].expirationTime;
+}
+
+bool TimerWheel::isActive(int32_t index) const
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    if ((index < 0) || (index >= static_cast<int32_t>(timers.size()))) {
+        return false;
+    }
+    return (timers[index].slot != noTimer);
+}
+
+int TimerWheel::activeTimers() const
+{
+    std::lock_guard<std::mutex> lock(wheelLock);
+    int count{0};
+    for (auto levelCount : levelCounts) {
+        count += levelCount;
+    }
+    return count;
+}
+
+uint64_t TimerWheel::toTick(time_type time) const
+{
+    if (time <= startTime) {
+        return 0;
+    }
+    auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(time - startTime);
+    // round up so a timer never fires before its expiration time
+    return static_cast<uint64_t>((delay.count() + tickSize.count() - 1) / tickSize.count());
+}
+
+TimerWheel::time_type TimerWheel::tickTime(uint64_t tick) const
+{
+    return startTime +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(tickSize *
+                                                                         static_cast<int64_t>(tick));
+}
+
+void TimerWheel::link(int32_t index)
+{
+    auto& timer = timers[index];
+    uint64_t tick = std::max(timer.expirationTick, currentTick);
+    uint64_t delta = tick - currentTick;
+    int level{0};
+    while ((level < levelCount - 1) && (delta >= (uint64_t{1} << (slotBits * (level + 1))))) {
+        ++level;
+    }
+    if (level == levelCount - 1) {
+        const uint64_t maxDelta{(uint64_t{1} << (slotBits * levelCount)) - 1};
+        if (delta > maxDelta) {
+            // beyond the range of the wheel so park it in the furthest slot, it gets placed
+            // again when that slot cascades
+            tick = currentTick + maxDelta;
+        }
+    }
+    auto slot = level * slotCount + static_cast<int>((tick >> (slotBits * level)) & slotMask);
+    timer.slot = slot;
+    timer.prev = noTimer;
+    timer.next = slots[slot];
+    if (timer.next != noTimer) {
+        timers[timer.next].prev = index;
+    }
+    slots[slot] = index;
+    ++levelCounts[slot / slotCount];
+}
+
+void TimerWheel::unlink(int32_t index)
+{
+    auto& timer = timers[index];
+    if (timer.prev != noTimer) {
+        timers[timer.prev].next = timer.next;
+    } else {
+        slots[timer.slot] = timer.next;
+    }
+    if (timer.next != noTimer) {
+        timers[timer.next].prev = timer.prev;
+    }
+    --levelCounts[timer.slot / slotCount];
+    timer.slot = noTimer;
+    timer.next = noTimer;
+    timer.prev = noTimer;
+}
+
+void TimerWheel::cascade(int level)
+{
+    auto slot =
+        level * slotCount + static_cast<int>((currentTick >> (slotBits * level)) & slotMask);
+    auto index = slots[slot];
+    while (index != noTimer) {
+        auto next = timers[index].next;
+        unlink(index);
+        link(index);
+        index = next;
+    }
+}
+
+uint64_t TimerWheel::nextWakeTick() const
+{
+    bool upperTimers{false};
+    for (int level = 1; level < levelCount; ++level) {
+        if (levelCounts[level] > 0) {
+            upperTimers = true;
+            break;
+        }
+    }
+    // the next cascade might move timers down to the first level so don't look past it
+    const uint64_t nextCascade{((currentTick >> slotBits) + 1) << slotBits};
+    if (levelCounts[0] > 0) {
+        const uint64_t lastTick = (upperTimers) ? nextCascade : currentTick + slotCount;
+        for (uint64_t tick = currentTick; tick < lastTick; ++tick) {
+            if (slots[tick & slotMask] != noTimer) {
+                return tick;
+            }
+        }
+    }
+    return (upperTimers) ? nextCascade : UINT64_MAX;
+}
+
+void TimerWheel::checkWake(uint64_t tick)
+{
+    if (tick < wakeTick) {
+        wakeTick = tick;
+        wakeCondition.notify_one();
+    }
+}
+
+void TimerWheel::serviceLoop()
+{
+    std::vector<std::pair<int32_t, uint32_t>> expired;
+    std::unique_lock<std::mutex> lock(wheelLock);
+    while (!halt) {
+        auto now = std::chrono::steady_clock::now();
+        auto nowTick = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count() /
+            tickSize.count());
+        while (currentTick <= nowTick && !halt) {
+            if ((currentTick & slotMask) == 0) {
+                for (int level = 1; level < levelCount; ++level) {
+                    cascade(level);
+                    if (((currentTick >> (slotBits * level)) & slotMask) != 0) {
+                        break;
+                    }
+                }
+            }
+            auto slot = static_cast<int>(currentTick & slotMask);
+            auto index = slots[slot];
+            while (index != noTimer) {
+                auto next = timers[index].next;
+                unlink(index);
+                expired.emplace_back(index, timers[index].generation);
+                index = next;
+            }
+            ++currentTick;
+            for (const auto& timer : expired) {
+                auto& entry = timers[timer.first];
+                if ((!entry.inUse) || (entry.generation != timer.second) || (!entry.callback)) {
+                    // the timer was changed after it expired
+                    continue;
+                }
+                auto callback = entry.callback;
+                runningTimer = timer.first;
+                lock.unlock();
+                try {
+                    callback();
+                }
+                catch (...) {
+                    // an exception from a callback should not stop the other timers
+                }
+                lock.lock();
+                runningTimer = noTimer;
+                callbackCondition.notify_all();
+            }
+            expired.clear();
+            if ((levelCounts[0] == 0) && ((currentTick & slotMask) != 0)) {
+                // nothing can fire before the next cascade
+                currentTick = std::min(((currentTick >> slotBits) + 1) << slotBits, nowTick + 1);
+            }
+        }
+        wakeTick = nextWakeTick();
+        if (halt) {
+            break;
+        }
+        if (wakeTick == UINT64_MAX) {
+            wakeCondition.wait(lock);
+        } else {
+            wakeCondition.wait_until(lock, tickTime(wakeTick));
+        }
+    }
+}
+
+}  // namespace helics
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace helics {
+/** class implementing a hierarchical timer wheel
+@details all timers are serviced by a single thread,  adding, updating, and canceling a timer are
+constant time operations. Timers are identified by an index which stays valid until it is released
+so a timer can be rearmed any number of times.  Timers never fire before their expiration time but
+may fire up to one tick after it.
+*/
+class TimerWheel {
+  public:
+    using time_type = decltype(std::chrono::steady_clock::now());
+    /** construct a timer wheel with a specific tick resolution*/
+    explicit TimerWheel(std::chrono::nanoseconds tickResolution = std::chrono::milliseconds(1));
+    /** destructor stops the servicing thread*/
+    ~TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /** get a timer wheel shared by all objects in the process*/
+    static std::shared_ptr<TimerWheel> getSharedWheel();
+
+    /** add a timer
+    @param expirationTime the time the callback should be executed
+    @param callback the function to call when the timer expires, it is called from the servicing
+    thread so should not block
+    @return an index for referencing the timer in the future*/
+    int32_t addTimer(time_type expirationTime, std::function<void()> callback);
+    /** set a new expiration time for a timer,  rearming it if it has fired or been canceled
+    @return true if the timer exists*/
+    bool updateTimer(int32_t index, time_type expirationTime);
+    /** set a new expiration time and callback for a timer
+    @return true if the timer exists*/
+    bool updateTimer(int32_t index, time_type expirationTime, std::function<void()> callback);
+    /** cancel a timer without releasing its index*/
+    void cancelTimer(int32_t index);
+    /** cancel a timer and release its index for reuse
+    @details if the callback is executing on another thread the call waits for it to complete*/
+    void releaseTimer(int32_t index);
+    /** get the current expiration time of a timer*/
+    time_type getExpirationTime(int32_t index) const;
+    /** check if a timer is waiting to fire*/
+    bool isActive(int32_t index) const;
+    /** get the number of timers waiting to fire*/
+    int activeTimers() const;
+
+  private:
+    static constexpr int slotBits{8};
+    static constexpr int slotCount{1 << slotBits};
+    static constexpr int levelCount{4};
+    static constexpr uint64_t slotMask{slotCount - 1};
+    static constexpr int32_t noTimer{-1};
+    /** the stored information for each timer*/
+    struct TimerEntry {
+        uint64_t expirationTick{0};  //!< the tick the timer fires on
+        time_type expirationTime;  //!< the requested expiration time
+        std::function<void()> callback;  //!< the function to call on expiration
+        int32_t next{noTimer};  //!< the next timer in the same slot
+        int32_t prev{noTimer};  //!< the previous timer in the same slot
+        int32_t slot{noTimer};  //!< the slot the timer is linked into
+        uint32_t generation{0};  //!< counter to detect changes after a timer was collected to fire
+        bool inUse{false};  //!< the index is allocated
+    };
+
+    mutable std::mutex wheelLock;  //!< lock protecting all the timer data
+    std::condition_variable wakeCondition;  //!< condition to wake up the servicing thread
+    std::condition_variable callbackCondition;  //!< condition to signal a callback completed
+    const std::chrono::nanoseconds tickSize;  //!< the resolution of the wheel
+    const time_type startTime;  //!< the reference time for tick 0
+    uint64_t currentTick{0};  //!< the next tick to be processed
+    uint64_t wakeTick{UINT64_MAX};  //!< the tick the servicing thread is sleeping until
+    std::array<int32_t, levelCount * slotCount> slots;  //!< the first timer in each slot
+    std::array<int, levelCount> levelCounts{};  //!< the number of timers in each level
+    std::vector<TimerEntry> timers;  //!< storage for all the timers
+    std::vector<int32_t> freeTimers;  //!< released timer indices available for reuse
+    int32_t runningTimer{noTimer};  //!< the timer whose callback is executing
+    bool halt{false};  //!< flag indicating the servicing thread should stop
+    std::thread serviceThread;  //!< the thread servicing all the timers
+
+    /** convert a time into the tick it fires on*/
+    uint64_t toTick(time_type time) const;
+    /** get the time point a tick starts at*/
+    time_type tickTime(uint64_t tick) const;
+    /** link a timer into the wheel based on its expiration tick*/
+    void link(int32_t index);
+    /** remove a timer from its slot*/
+    void unlink(int32_t index);
+    /** move all the timers in a slot to lower levels*/
+    void cascade(int level);
+    /** get the tick the servicing thread next needs to run*/
+    uint64_t nextWakeTick() const;
+    /** wake the servicing thread if a timer needs it earlier*/
+    void checkWake(uint64_t tick);
+    /** the loop executed by the servicing thread*/
+    void serviceLoop();
+};
+}  // namespace helics
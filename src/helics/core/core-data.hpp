@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include "federate_id.hpp"
 #include "helics-time.hpp"
 #include "helics/helics-config.h"
 
@@ -237,6 +238,32 @@ class NullFilterOperator final: public FilterOperator {
     }
 };
 
+/** an input updated by a time request along with its data
+@details the pointers refer to storage in the core which remains valid until the next time request
+from the federate*/
+struct InputUpdate {
+    interface_handle handle;  //!< the handle of the updated input
+    /** the most recent data for the input*/
+    const std::shared_ptr<const data_block>* data{nullptr};
+    /** the data from every source of the input*/
+    const std::vector<std::shared_ptr<const data_block>>* allData{nullptr};
+};
+
+/** the kinds of interfaces which can be registered in bulk*/
+enum class interface_kind : char {
+    publication = 'p',  //!< a publication
+    input = 'i',  //!< a named or unnamed input
+    endpoint = 'e',  //!< an endpoint
+};
+
+/** the description of an interface to register through Core::registerInterfaces*/
+struct InterfaceDefinition {
+    interface_kind kind{interface_kind::publication};  //!< the kind of interface
+    std::string key;  //!< the name of the interface,  may be empty for inputs
+    std::string type;  //!< the type of the interface
+    std::string units;  //!< the units of the interface (ignored for endpoints)
+};
+
 /** helper template to check whether an index is actually valid for a particular vector
 @tparam SizedDataType a vector like data type that must have a size function
 @param testSize an index to test
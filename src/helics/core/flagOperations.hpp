@@ -25,6 +25,8 @@ enum operation_flags : uint16_t {
     clone_flag =
         9,  //!< flag indicating the filter is a clone filter or the data needs to be cloned
     extra_flag2 = 8,  //!< extra flag
+    compressed_payload_flag =
+        10,  //!< flag indicating the payload has been compressed for transport
     destination_processing_flag =
         11,  //!< flag indicating the message is for destination processing
     disconnected_flag = 12,  //!< flag indicating that a broker/federate is disconnected
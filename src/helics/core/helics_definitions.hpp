@@ -54,6 +54,8 @@ namespace defs {
         forward_compute = helics_flag_forward_compute,
         /** flag indicating that a federate needs to run in real time*/
         realtime = helics_flag_realtime,
+        /** flag indicating that a real time federate should spin to hit its step times*/
+        realtime_high_precision = helics_flag_realtime_high_precision,
         /** flag indicating that the federate will only interact on a single thread*/
         single_thread_federate = helics_flag_single_thread_federate,
         /** used to delay a core from entering initialization mode even if it would otherwise be
@@ -114,12 +116,16 @@ namespace defs {
         rt_lag = helics_property_time_rt_lag,
         rt_lead = helics_property_time_rt_lead,
         rt_tolerance = helics_property_time_rt_tolerance,
+        rt_spin = helics_property_time_rt_spin,
         input_delay = helics_property_time_input_delay,
         output_delay = helics_property_time_output_delay,
         max_iterations = helics_property_int_max_iterations,
         log_level = helics_property_int_log_level,
         file_log_level = helics_property_int_file_log_level,
-        console_log_level = helics_property_int_console_log_level
+        console_log_level = helics_property_int_console_log_level,
+        rt_cpu_affinity = helics_property_int_rt_cpu_affinity,
+        callback_threads = helics_property_int_callback_threads,
+        callback_ordering = helics_property_int_callback_ordering
     };
 
     /** options for handles */
@@ -0,0 +1,14 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+namespace helics {
+/** pin the calling thread to a specific cpu
+@param cpu the index of the cpu to run on, negative values leave the thread unpinned
+@return true if the thread affinity was set*/
+bool setThreadCpuAffinity(int cpu);
+}  // namespace helics
@@ -39,6 +39,7 @@ set(helics_shared_private_headers
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/AsyncFedCallInfo.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/FilterOperations.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/FilterFederateManager.hpp
+    ${HELICS_LIBRARY_SOURCE_DIR}/application_api/CallbackDispatcher.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/cxx_shared_library/BrokerFactory.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/cxx_shared_library/CoreFactory.hpp
 )
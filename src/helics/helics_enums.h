@@ -108,6 +108,9 @@ typedef enum {
     helics_flag_forward_compute = 14,
     /** flag indicating that a federate needs to run in real time*/
     helics_flag_realtime = 16,
+    /** flag indicating that a real time federate should use a sleep then spin wait to hit its
+       step times precisely at the cost of a busy processor*/
+    helics_flag_realtime_high_precision = 17,
     /** flag indicating that the federate will only interact on a single thread*/
     helics_flag_single_thread_federate = 27,
     /** used to not display warnings on mismatched requested times*/
@@ -209,6 +212,9 @@ typedef enum {
     /** the property controlling real time tolerance for a federate sets both rt_lag and
        rt_lead*/
     helics_property_time_rt_tolerance = 145,
+    /** the property controlling how long before a real time step a high precision real time
+       federate stops sleeping and spins*/
+    helics_property_time_rt_spin = 146,
     /** the property controlling input delay for a federate*/
     helics_property_time_input_delay = 148,
     /** the property controlling output delay for a federate*/
@@ -222,9 +228,30 @@ typedef enum {
     helics_property_int_file_log_level = 272,
     /** integer property controlling the log level for file logging in a federate see \ref
        helics_log_levels*/
-    helics_property_int_console_log_level = 274
+    helics_property_int_console_log_level = 274,
+    /** integer property pinning the thread of a real time federate to a specific cpu, -1 for no
+       pinning*/
+    helics_property_int_rt_cpu_affinity = 282,
+    /** integer property setting the number of worker threads used to run input and endpoint
+       callbacks, 0 runs the callbacks on the thread making the time request*/
+    helics_property_int_callback_threads = 284,
+    /** integer property controlling the ordering of input and endpoint callbacks run on worker
+       threads see \ref helics_callback_orderings*/
+    helics_property_int_callback_ordering = 286
 } helics_properties;
 
+/** enumeration of the ordering of input and endpoint callbacks*/
+typedef enum {
+    /** callbacks run one at a time in the order of the updates on the thread making the time
+       request*/
+    helics_callback_ordering_global = 0,
+    /** callbacks for the same input or endpoint run in order, callbacks for different interfaces
+       can run in parallel*/
+    helics_callback_ordering_per_interface = 1,
+    /** callbacks can run in any order and in parallel*/
+    helics_callback_ordering_none = 2
+} helics_callback_orderings;
+
 /** enumeration of the multi_input operations*/
 typedef enum {
     /** time and priority order the inputs from the core library*/
@@ -48,6 +48,7 @@ class CommsBroker: public BrokerT {
     virtual void addRoute(route_id rid, int interfaceId, const std::string& routeInfo) override;
 
     virtual void removeRoute(route_id rid) override;
+    virtual std::string generateCompressionStatistics() const override;
     /** get a pointer to the comms object*/
     COMMS* getCommsObjectPointer();
 };
@@ -119,6 +119,12 @@ void CommsBroker<COMMS, BrokerT>::removeRoute(route_id rid)
     comms->removeRoute(rid);
 }
 
+template<class COMMS, class BrokerT>
+std::string CommsBroker<COMMS, BrokerT>::generateCompressionStatistics() const
+{
+    return comms->getCompressionStatistics();
+}
+
 template<class COMMS, class BrokerT>
 COMMS* CommsBroker<COMMS, BrokerT>::getCommsObjectPointer()
 {
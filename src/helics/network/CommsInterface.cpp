@@ -6,7 +6,10 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "CommsInterface.hpp"
 
+#include "../common/JsonProcessingFunctions.hpp"
+#include "../common/LzCompression.hpp"
 #include "../core/core-exceptions.hpp"
+#include "../core/flagOperations.hpp"
 #include "NetworkBrokerData.hpp"
 #include "gmlc/utilities/stringOps.h"
 
@@ -112,6 +115,10 @@ void CommsInterface::loadNetworkInfo(const NetworkBrokerData& netInfo)
         maxMessageCount = netInfo.maxMessageCount;
         brokerInitString = netInfo.brokerInitString;
         autoBroker = netInfo.autobroker;
+        compression = netInfo.compression;
+        if (netInfo.compressionThreshold > 0) {
+            compressionThreshold = static_cast<std::size_t>(netInfo.compressionThreshold);
+        }
         switch (netInfo.server_mode) {
             case NetworkBrokerData::server_mode_options::server_active:
             case NetworkBrokerData::server_mode_options::server_default_active:
@@ -159,6 +166,11 @@ void CommsInterface::propertyUnLock()
 
 void CommsInterface::transmit(route_id rid, const ActionMessage& cmd)
 {
+    if (directDispatch || (compression && cmd.payload.size() >= compressionThreshold)) {
+        ActionMessage dcmd(cmd);
+        transmit(rid, std::move(dcmd));
+        return;
+    }
     if (isPriorityCommand(cmd)) {
         txQueue.emplacePriority(rid, cmd);
     } else {
@@ -168,6 +180,17 @@ void CommsInterface::transmit(route_id rid, const ActionMessage& cmd)
 
 void CommsInterface::transmit(route_id rid, ActionMessage&& cmd)
 {
+    if (directDispatch && directTransmit(rid, cmd)) {
+        return;
+    }
+    queueTransmit(rid, std::move(cmd));
+}
+
+void CommsInterface::queueTransmit(route_id rid, ActionMessage&& cmd)
+{
+    if (compression && cmd.payload.size() >= compressionThreshold) {
+        compressPayload(rid, cmd);
+    }
     if (isPriorityCommand(cmd)) {
         txQueue.emplacePriority(rid, std::move(cmd));
     } else {
@@ -182,6 +205,9 @@ void CommsInterface::addRoute(route_id rid, const std::string& routeInfo)
     rt.messageID = NEW_ROUTE;
     rt.setExtraData(rid.baseValue());
     transmit(control_route, std::move(rt));
+    if (compression) {
+        setRouteCompression(rid, routeAcceptsCompression(routeInfo));
+    }
 }
 
 void CommsInterface::removeRoute(route_id rid)
@@ -190,6 +216,86 @@ void CommsInterface::removeRoute(route_id rid)
     rt.messageID = REMOVE_ROUTE;
     rt.setExtraData(rid.baseValue());
     transmit(control_route, rt);
+    setRouteCompression(rid, false);
+}
+
+void CommsInterface::setRouteCompression(route_id rid, bool compress)
+{
+    std::lock_guard<std::mutex> lock(compressionLock);
+    if (compress) {
+        compressedRoutes.insert(rid);
+    } else {
+        compressedRoutes.erase(rid);
+    }
+}
+
+bool CommsInterface::routeAcceptsCompression(const std::string& /*routeInfo*/) const
+{
+    return false;
+}
+
+void CommsInterface::compressPayload(route_id rid, ActionMessage& cmd)
+{
+    // the time request serialization does not include the payload
+    if (isProtocolCommand(cmd) || cmd.action() == CMD_TIME_REQUEST ||
+        checkActionFlag(cmd, compressed_payload_flag)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(compressionLock);
+        if (compressedRoutes.find(rid) == compressedRoutes.end()) {
+            return;
+        }
+    }
+    auto compressed = lzCompress(cmd.payload.data(), cmd.payload.size());
+    if (compressed.empty()) {
+        ++incompressibleMessages;
+        return;
+    }
+    ++compressedMessages;
+    originalBytes += static_cast<std::int64_t>(cmd.payload.size());
+    compressedBytes += static_cast<std::int64_t>(compressed.size());
+    cmd.payload = std::move(compressed);
+    setActionFlag(cmd, compressed_payload_flag);
+}
+
+void CommsInterface::decompressPayload(ActionMessage& cmd)
+{
+    std::string payload;
+    if (!lzDecompress(cmd.payload.data(), cmd.payload.size(), payload)) {
+        // the flag may have been set on a message that was never compressed
+        ++decompressionErrors;
+        return;
+    }
+    ++decompressedMessages;
+    receivedCompressedBytes += static_cast<std::int64_t>(cmd.payload.size());
+    decompressedBytes += static_cast<std::int64_t>(payload.size());
+    cmd.payload = std::move(payload);
+    clearActionFlag(cmd, compressed_payload_flag);
+}
+
+std::string CommsInterface::getCompressionStatistics() const
+{
+    Json::Value stats;
+    stats["enabled"] = compression;
+    stats["threshold"] = static_cast<Json::UInt64>(compressionThreshold);
+    {
+        std::lock_guard<std::mutex> lock(compressionLock);
+        stats["compressed_routes"] = static_cast<Json::UInt64>(compressedRoutes.size());
+    }
+    stats["compressed_messages"] = static_cast<Json::Int64>(compressedMessages.load());
+    stats["incompressible_messages"] = static_cast<Json::Int64>(incompressibleMessages.load());
+    auto original = originalBytes.load();
+    auto reduced = compressedBytes.load();
+    stats["original_bytes"] = static_cast<Json::Int64>(original);
+    stats["compressed_bytes"] = static_cast<Json::Int64>(reduced);
+    stats["ratio"] =
+        (reduced > 0) ? static_cast<double>(original) / static_cast<double>(reduced) : 0.0;
+    stats["decompressed_messages"] = static_cast<Json::Int64>(decompressedMessages.load());
+    stats["received_compressed_bytes"] = static_cast<Json::Int64>(receivedCompressedBytes.load());
+    stats["decompressed_bytes"] = static_cast<Json::Int64>(decompressedBytes.load());
+    stats["decompression_errors"] = static_cast<Json::Int64>(decompressionErrors.load());
+    return generateJsonString(stats);
 }
 
 void CommsInterface::setTxStatus(connection_status txStatus)
@@ -477,7 +583,17 @@ bool CommsInterface::reconnect()
 void CommsInterface::setCallback(std::function<void(ActionMessage&&)> callback)
 {
     if (propertyLock()) {
-        ActionCallback = std::move(callback);
+        if (callback) {
+            // compressed payloads are restored before the message is handed off
+            ActionCallback = [this, callback = std::move(callback)](ActionMessage&& cmd) {
+                if (checkActionFlag(cmd, compressed_payload_flag) && !isProtocolCommand(cmd)) {
+                    decompressPayload(cmd);
+                }
+                callback(std::move(cmd));
+            };
+        } else {
+            ActionCallback = nullptr;
+        }
         propertyUnLock();
     }
 }
@@ -508,6 +624,11 @@ void CommsInterface::setFlag(const std::string& flag, bool val)
 {
     if (flag == "server_mode") {
         setServerMode(val);
+    } else if (flag == "compression") {
+        if (propertyLock()) {
+            compression = val;
+            propertyUnLock();
+        }
     } else {
         logWarning(std::string("unrecognized flag :") + flag);
     }
@@ -583,6 +704,11 @@ void CommsInterface::reconnectTransmitter()
     transmit(control_route, rt);
 }
 
+bool CommsInterface::directTransmit(route_id /*rid*/, ActionMessage& /*cmd*/)
+{
+    return false;
+}
+
 void CommsInterface::reconnectReceiver()
 {
     ActionMessage cmd(CMD_PROTOCOL);
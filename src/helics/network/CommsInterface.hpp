@@ -12,8 +12,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/containers/BlockingPriorityQueue.hpp"
 #include "helics/core/ActionMessage.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <utility>
@@ -90,6 +94,9 @@ class CommsInterface {
     /** enable or disable the server mode for the comms*/
     void setServerMode(bool serverActive);
 
+    /** get a json string with statistics on the payload compression*/
+    std::string getCompressionStatistics() const;
+
     /** generate a log message as a warning*/
     void logWarning(const std::string& message) const;
     /** generate a log message as an error*/
@@ -148,6 +155,11 @@ class CommsInterface {
     std::atomic<bool> disconnecting{
         false};  //!< flag indicating that the comm system is in the process of disconnecting
     interface_networks interfaceNetwork = interface_networks::local;
+    bool directDispatch{false};  //!< messages are delivered through directTransmit if possible
+    bool compression{false};  //!< compress payloads sent on routes that accept compression
+    std::size_t compressionThreshold{4096};  //!< the smallest payload to compress
+    /** place a message in the transmit queue without trying direct delivery*/
+    void queueTransmit(route_id rid, ActionMessage&& cmd);
 
   private:
     std::thread queue_transmitter;  //!< single thread for sending data
@@ -159,6 +171,34 @@ class CommsInterface {
     virtual void closeReceiver();  //!< function to instruct the receiver loop to close
     virtual void reconnectTransmitter();  //!< function to reconnect the transmitter
     virtual void reconnectReceiver();  //!< function to reconnect the receiver
+    /** deliver a message to its destination from the calling thread bypassing the transmit queue
+    @details only called if directDispatch is set
+    @param rid the route to send the message on
+    @param cmd the message to deliver, it is only moved from if the function returns true
+    @return true if the message was delivered, false if it should go through the transmit queue*/
+    virtual bool directTransmit(route_id rid, ActionMessage& cmd);
+    /** check if a new route leads to a receiver that agreed to receive compressed payloads
+    @param routeInfo the address of the route*/
+    virtual bool routeAcceptsCompression(const std::string& routeInfo) const;
+    /** compress the payload of a message if it is sent on a compressed route*/
+    void compressPayload(route_id rid, ActionMessage& cmd);
+    /** restore the payload of a message received with a compressed payload*/
+    void decompressPayload(ActionMessage& cmd);
+    mutable std::mutex compressionLock;  //!< lock protecting the set of compressed routes
+    std::set<route_id> compressedRoutes;  //!< the routes payloads are compressed on
+    std::atomic<std::int64_t> compressedMessages{0};  //!< the number of payloads compressed
+    std::atomic<std::int64_t> incompressibleMessages{
+        0};  //!< the number of payloads that could not be made smaller
+    std::atomic<std::int64_t> originalBytes{0};  //!< the original size of compressed payloads
+    std::atomic<std::int64_t> compressedBytes{0};  //!< the compressed size of compressed payloads
+    std::atomic<std::int64_t> decompressedMessages{0};  //!< the number of payloads decompressed
+    std::atomic<std::int64_t> receivedCompressedBytes{
+        0};  //!< the size of the received payloads before decompression
+    std::atomic<std::int64_t> decompressedBytes{
+        0};  //!< the size of the received payloads after decompression
+    std::atomic<std::int64_t> decompressionErrors{
+        0};  //!< the number of payloads that failed to decompress
+
   protected:
     void setTxStatus(connection_status txStatus);
     void setRxStatus(connection_status rxStatus);
@@ -172,6 +212,8 @@ class CommsInterface {
     void join_tx_rx_thread();
     /** get the generated randomID for this comm interface*/
     const std::string& getRandomID() const { return randomID; }
+    /** set whether payloads sent on a route are compressed*/
+    void setRouteCompression(route_id rid, bool compress);
 
   private:
     gmlc::concurrency::TripWireDetector
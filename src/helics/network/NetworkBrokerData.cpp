@@ -94,6 +94,20 @@ std::shared_ptr<helicsCLI11App>
     nbparser->add_flag("--autobroker",
                        autobroker,
                        "allow a broker to be automatically created if one is not available");
+    nbparser->add_flag(
+        "--direct_dispatch",
+        directDispatch,
+        "deliver messages directly to in process brokers and cores from the sending thread instead of through a transmit thread");
+    nbparser->add_flag(
+        "--compression",
+        compression,
+        "compress large message payloads on connections where the other side also has compression enabled");
+    nbparser
+        ->add_option("--compression_threshold",
+                     compressionThreshold,
+                     "the size in bytes of the smallest payload to compress")
+        ->capture_default_str()
+        ->check(CLI::PositiveNumber);
     nbparser->add_option("--brokerinit",
                          brokerInitString,
                          "the initialization string for the broker");
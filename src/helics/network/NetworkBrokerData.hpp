@@ -53,6 +53,7 @@ class NetworkBrokerData {
     int maxMessageSize{16 * 256};  //!< maximum message size
     int maxMessageCount{256};  //!< maximum message count
     int maxRetries{5};  //!< the maximum number of retries to establish a network connection
+    int compressionThreshold{4096};  //!< the smallest payload that is compressed
     interface_networks interfaceNetwork{interface_networks::local};
     bool reuse_address{false};  //!< allow reuse of binding address
     bool use_os_port{false};  //!< specify that any automatic port allocation should use operating
@@ -62,6 +63,10 @@ class NetworkBrokerData {
         false};  //!< flag indicating that the name should be appended to the address
     bool noAckConnection{false};  //!< flag indicating that a connection ack message is not required
                                   //!< for broker connections
+    bool directDispatch{false};  //!< flag indicating in process messages should be delivered
+                                 //!< directly without going through a transmit thread
+    bool compression{false};  //!< flag indicating that payloads should be compressed on links
+                              //!< where the other side agrees to compression
     server_mode_options server_mode{server_mode_options::unspecified};  //!< setup a server mode
   public:
     NetworkBrokerData() = default;
@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../common/fmt_format.h"
 #include "NetworkBrokerData.hpp"
 #include "helics/core/ActionMessage.hpp"
+#include "helics/core/flagOperations.hpp"
 
 #include <memory>
 #include <string>
@@ -180,6 +181,20 @@ void NetworkCommsInterface::setFlag(const std::string& flag, bool val)
     }
 }
 
+/** the string index a compression request carries the interface of the requester in*/
+constexpr int compressionInterfaceString{2};
+
+/** get the interface of an address in the form used by getAddress so the interface sent with a
+compression request matches the route address the requester registers with*/
+static std::string compressionInterface(const std::string& address)
+{
+    auto iface = stripProtocol(address);
+    if ((iface == "*") || (iface == "0.0.0.0")) {
+        iface = "127.0.0.1";
+    }
+    return iface;
+}
+
 ActionMessage NetworkCommsInterface::generateReplyToIncomingMessage(ActionMessage& cmd)
 {
     if (isProtocolCommand(cmd)) {
@@ -199,11 +214,27 @@ ActionMessage NetworkCommsInterface::generateReplyToIncomingMessage(ActionMessag
                 portReply.source_id = global_federate_id(PortNumber);
                 portReply.setExtraData(openPort);
                 portReply.counter = cmd.counter;
+                if (compression && checkActionFlag(cmd, compressed_payload_flag) &&
+                    !cmd.getString(compressionInterfaceString).empty()) {
+                    std::lock_guard<std::mutex> lock(compressionPortLock);
+                    compressionPorts.emplace(
+                        compressionInterface(cmd.getString(compressionInterfaceString)), openPort);
+                    setActionFlag(portReply, compressed_payload_flag);
+                }
                 return portReply;
             } break;
             case CONNECTION_REQUEST: {
                 ActionMessage connAck(CMD_PROTOCOL);
                 connAck.messageID = CONNECTION_ACK;
+                // the requester sends its interface and port with a request for compression
+                if (compression && checkActionFlag(cmd, compressed_payload_flag) &&
+                    cmd.getExtraData() > 0 && !cmd.getString(compressionInterfaceString).empty()) {
+                    std::lock_guard<std::mutex> lock(compressionPortLock);
+                    compressionPorts.emplace(
+                        compressionInterface(cmd.getString(compressionInterfaceString)),
+                        cmd.getExtraData());
+                    setActionFlag(connAck, compressed_payload_flag);
+                }
                 return connAck;
             } break;
             default:
@@ -241,14 +272,43 @@ ActionMessage NetworkCommsInterface::generatePortRequest(int cnt) const
     req.payload = stripProtocol(localTargetAddress);
     req.counter = cnt;
     req.setStringData(brokerName, brokerInitString);
+    addCompressionRequest(req);
     return req;
 }
 
+void NetworkCommsInterface::addCompressionRequest(ActionMessage& req) const
+{
+    if (compression) {
+        setActionFlag(req, compressed_payload_flag);
+        req.setExtraData(PortNumber);
+        req.setString(compressionInterfaceString, compressionInterface(localTargetAddress));
+    }
+}
+
+void NetworkCommsInterface::loadCompressionReply(const ActionMessage& reply)
+{
+    if (compression && checkActionFlag(reply, compressed_payload_flag)) {
+        setRouteCompression(parent_route_id, true);
+    }
+}
+
+bool NetworkCommsInterface::routeAcceptsCompression(const std::string& routeInfo) const
+{
+    auto interfaceAndPort = extractInterfaceandPort(routeInfo);
+    if (interfaceAndPort.second <= 0) {
+        return false;
+    }
+    interfaceAndPort.first = compressionInterface(interfaceAndPort.first);
+    std::lock_guard<std::mutex> lock(compressionPortLock);
+    return (compressionPorts.find(interfaceAndPort) != compressionPorts.end());
+}
+
 void NetworkCommsInterface::loadPortDefinitions(const ActionMessage& cmd)
 {
     if (cmd.action() == CMD_PROTOCOL) {
         if (cmd.messageID == PORT_DEFINITIONS) {
             PortNumber = cmd.getExtraData();
+            loadCompressionReply(cmd);
             if ((openPorts.getDefaultStartingPort() < 0)) {
                 if (PortNumber < getDefaultBrokerPort() + 100) {
                     openPorts.setStartingPortNumber(getDefaultBrokerPort() + 100 +
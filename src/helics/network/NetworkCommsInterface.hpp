@@ -10,8 +10,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/helics-config.h"
 
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 
 namespace helics {
 /** implementation for the communication interface that uses ZMQ messages to communicate*/
@@ -66,6 +68,10 @@ class NetworkCommsInterface: public CommsInterface {
 
   private:
     PortAllocator openPorts;  //!< a structure to deal with port allocations
+    mutable std::mutex compressionPortLock;  //!< lock protecting compressionPorts
+    std::set<std::pair<std::string, int>>
+        compressionPorts;  //!< the interfaces and ports of connections that requested compression
+    virtual bool routeAcceptsCompression(const std::string& routeInfo) const override;
 
   public:
     /** find an open port for a subBroker*/
@@ -84,6 +90,12 @@ class NetworkCommsInterface: public CommsInterface {
   protected:
     ActionMessage generatePortRequest(int cnt = 1) const;
     void loadPortDefinitions(const ActionMessage& cmd);
+    /** add a request for compressed payloads to a port or connection request if compression is
+    enabled*/
+    void addCompressionRequest(ActionMessage& req) const;
+    /** enable compression on the route to the broker if the reply to a port or connection request
+    accepted compression*/
+    void loadCompressionReply(const ActionMessage& reply);
 };
 
 }  // namespace helics
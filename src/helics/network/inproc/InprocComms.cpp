@@ -42,6 +42,7 @@ namespace inproc {
         //{
         //    autoPortNumber = false;
         //}
+        directDispatch = netInfo.directDispatch;
         propertyUnLock();
     }
 
@@ -142,90 +143,150 @@ namespace inproc {
             }
         }
 
-        setTxStatus(connection_status::connected);
         std::map<route_id, std::shared_ptr<BrokerBase>> routes;
         bool haltLoop{false};
+        auto processCommand = [&, this](route_id rid,
+                                        ActionMessage&& cmd,
+                                        std::map<route_id, std::shared_ptr<BrokerBase>>& rts) {
+            if (isProtocolCommand(cmd) && rid == control_route) {
+                if (processRouteCommand(cmd, rts)) {
+                    return;
+                }
+                switch (cmd.messageID) {
+                    case CLOSE_RECEIVER:
+                        setRxStatus(connection_status::terminated);
+                        return;
+                    case DISCONNECT:
+                        haltLoop = true;
+                        return;
+                    default:
+                        break;
+                }
+            }
+            deliver(rid, std::move(cmd), tbroker, rts);
+        };
+        if (directDispatch) {
+            auto targets = directTargets.lock();
+            targets->parent = tbroker;
+            // anything queued before direct delivery starts goes first to maintain ordering
+            auto queued = txQueue.try_pop();
+            while (queued) {
+                processCommand(queued->first, std::move(queued->second), targets->routes);
+                queued = txQueue.try_pop();
+            }
+            targets->active = true;
+        }
+        setTxStatus(connection_status::connected);
         while (!haltLoop) {
             route_id rid;
             ActionMessage cmd;
 
             std::tie(rid, cmd) = txQueue.pop();
-            bool processed = false;
-            if (isProtocolCommand(cmd)) {
-                if (rid == control_route) {
-                    switch (cmd.messageID) {
-                        case NEW_ROUTE: {
-                            auto& newroute = cmd.payload;
-                            bool foundRoute = false;
-                            auto core = CoreFactory::findCore(newroute);
-                            if (core) {
-                                auto tcore = std::dynamic_pointer_cast<CommonCore>(core);
-                                if (tcore) {
-                                    routes.emplace(route_id{cmd.getExtraData()}, std::move(tcore));
-                                    foundRoute = true;
-                                }
-                            }
-                            auto brk = BrokerFactory::findBroker(newroute);
-
-                            if (brk) {
-                                auto cbrk = std::dynamic_pointer_cast<CoreBroker>(brk);
-                                if (cbrk) {
-                                    routes.emplace(route_id{cmd.getExtraData()}, std::move(cbrk));
-                                    foundRoute = true;
-                                }
-                            }
-                            if (!foundRoute) {
-                                logError(std::string("unable to establish Route to ") + newroute);
-                            }
-                            processed = true;
-                        } break;
-                        case REMOVE_ROUTE:
-                            routes.erase(route_id{cmd.getExtraData()});
-                            processed = true;
-                            break;
-                        case CLOSE_RECEIVER:
-                            setRxStatus(connection_status::terminated);
-                            processed = true;
-                            break;
-                        case DISCONNECT:
-                            haltLoop = true;
-                            continue;
+            processCommand(rid, std::move(cmd), routes);
+        }  // while (!haltLoop)
+
+        if (directDispatch) {
+            auto targets = directTargets.lock();
+            targets->active = false;
+            targets->routes.clear();
+            targets->parent = nullptr;
+        }
+        routes.clear();
+        tbroker = nullptr;
+
+        setTxStatus(connection_status::terminated);
+    }
+
+    bool InprocComms::processRouteCommand(const ActionMessage& cmd,
+                                          std::map<route_id, std::shared_ptr<BrokerBase>>& routes)
+    {
+        switch (cmd.messageID) {
+            case NEW_ROUTE: {
+                const auto& newroute = cmd.payload;
+                bool foundRoute = false;
+                auto core = CoreFactory::findCore(newroute);
+                if (core) {
+                    auto tcore = std::dynamic_pointer_cast<CommonCore>(core);
+                    if (tcore) {
+                        routes.emplace(route_id{cmd.getExtraData()}, std::move(tcore));
+                        foundRoute = true;
                     }
                 }
-            }
-            if (processed) {
-                continue;
-            }
+                auto brk = BrokerFactory::findBroker(newroute);
 
-            if (rid == parent_route_id) {
-                if (tbroker) {
-                    tbroker->addActionMessage(std::move(cmd));
-                } else {
-                    logWarning(fmt::format(
-                        "message directed to broker of comm system with no broker, message dropped {}",
-                        prettyPrintString(cmd)));
-                }
-            } else {
-                auto rt_find = routes.find(rid);
-                if (rt_find != routes.end()) {
-                    rt_find->second->addActionMessage(std::move(cmd));
-                } else {
-                    if (tbroker) {
-                        tbroker->addActionMessage(std::move(cmd));
-                    } else {
-                        if (!isDisconnectCommand(cmd)) {
-                            logWarning(std::string("unknown route, message dropped ") +
-                                       prettyPrintString(cmd));
-                        }
+                if (brk) {
+                    auto cbrk = std::dynamic_pointer_cast<CoreBroker>(brk);
+                    if (cbrk) {
+                        routes.emplace(route_id{cmd.getExtraData()}, std::move(cbrk));
+                        foundRoute = true;
                     }
                 }
+                if (!foundRoute) {
+                    logError(std::string("unable to establish Route to ") + newroute);
+                }
+                return true;
             }
-        }  // while (!haltLoop)
+            case REMOVE_ROUTE:
+                routes.erase(route_id{cmd.getExtraData()});
+                return true;
+            default:
+                return false;
+        }
+    }
 
-        routes.clear();
-        tbroker = nullptr;
+    void InprocComms::deliver(route_id rid,
+                              ActionMessage&& cmd,
+                              const std::shared_ptr<BrokerBase>& parent,
+                              const std::map<route_id, std::shared_ptr<BrokerBase>>& routes)
+    {
+        if (rid == parent_route_id) {
+            if (parent) {
+                parent->addActionMessage(std::move(cmd));
+            } else {
+                logWarning(fmt::format(
+                    "message directed to broker of comm system with no broker, message dropped {}",
+                    prettyPrintString(cmd)));
+            }
+            return;
+        }
+        auto rt_find = routes.find(rid);
+        if (rt_find != routes.end()) {
+            rt_find->second->addActionMessage(std::move(cmd));
+        } else if (parent) {
+            parent->addActionMessage(std::move(cmd));
+        } else if (!isDisconnectCommand(cmd)) {
+            logWarning(std::string("unknown route, message dropped ") + prettyPrintString(cmd));
+        }
+    }
 
-        setTxStatus(connection_status::terminated);
+    bool InprocComms::directTransmit(route_id rid, ActionMessage& cmd)
+    {
+        if (rid == control_route) {
+            if (!isProtocolCommand(cmd)) {
+                return false;
+            }
+            if (cmd.messageID != NEW_ROUTE && cmd.messageID != REMOVE_ROUTE) {
+                // the connection control goes through the transmit thread
+                return false;
+            }
+            auto targets = directTargets.lock();
+            if (!targets->active) {
+                // queued under the lock so it cannot land behind the drain at activation
+                queueTransmit(rid, std::move(cmd));
+                return true;
+            }
+            processRouteCommand(cmd, targets->routes);
+            return true;
+        }
+        auto targets = directTargets.lock_shared();
+        if (!targets->active) {
+            // not connected yet so queue the message to keep the ordering, the transmit thread
+            // drains the queue holding the exclusive lock before direct delivery starts
+            queueTransmit(rid, std::move(cmd));
+            return true;
+        }
+        deliver(rid, std::move(cmd), targets->parent, targets->routes);
+        return true;
     }
 
     std::string InprocComms::getAddress() const { return localTargetAddress; }
@@ -6,14 +6,18 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include "../../common/GuardedTypes.hpp"
 #include "../CommsInterface.hpp"
 #include "helics/helics-config.h"
 
 #include <future>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 
 namespace helics {
+class BrokerBase;
 namespace inproc {
     /** implementation for the communication interface that uses ZMQ messages to communicate*/
     class InprocComms final: public CommsInterface {
@@ -28,6 +32,25 @@ namespace inproc {
       private:
         virtual void queue_rx_function() override;  //!< the functional loop for the receive queue
         virtual void queue_tx_function() override;  //!< the loop for transmitting data
+        virtual bool directTransmit(route_id rid, ActionMessage& cmd) override;
+        /** the in process objects messages are delivered to*/
+        struct routeTargets {
+            std::shared_ptr<BrokerBase> parent;  //!< the broker the comms connect to
+            std::map<route_id, std::shared_ptr<BrokerBase>> routes;  //!< the direct routes
+            bool active{false};  //!< direct delivery has started
+        };
+        /** the targets used for direct dispatch, shared by all the transmitting threads*/
+        shared_guarded<routeTargets> directTargets;
+        /** process a route control message
+        @return true if the message was a route control message*/
+        bool processRouteCommand(const ActionMessage& cmd,
+                                 std::map<route_id, std::shared_ptr<BrokerBase>>& routes);
+        /** deliver a message to the target of a route*/
+        void deliver(route_id rid,
+                     ActionMessage&& cmd,
+                     const std::shared_ptr<BrokerBase>& parent,
+                     const std::map<route_id, std::shared_ptr<BrokerBase>>& routes);
+
       public:
         /** return a dummy port number*/
         int getPort() const { return -1; }
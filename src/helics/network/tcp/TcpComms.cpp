@@ -250,6 +250,7 @@ namespace tcp {
                 m.messageID = (PortNumber <= 0) ? REQUEST_PORTS : CONNECTION_REQUEST;
 
                 m.setStringData(brokerName, brokerInitString);
+                addCompressionRequest(m);
                 try {
                     brokerConnection->send(m.packetize());
                 }
@@ -281,6 +282,7 @@ namespace tcp {
                         }
                         if (mess->second.messageID == CONNECTION_ACK) {
                             if (PortNumber > 0) {
+                                loadCompressionReply(mess->second);
                                 connectionEstablished = true;
                                 continue;
                             }
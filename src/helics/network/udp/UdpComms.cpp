@@ -11,8 +11,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../../core/ActionMessage.hpp"
 #include "../NetworkBrokerData.hpp"
 #include "../networkDefaults.hpp"
+#include "UdpDatagrams.h"
 
 #include <asio/ip/udp.hpp>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
@@ -120,42 +122,60 @@ namespace udp {
             }
         }
 
-        std::vector<char> data(10192);
-        udp::endpoint remote_endp;
+        DatagramReceiver receiver;
+        FragmentAssembler assembler;
+        std::vector<char> assembled;
         std::error_code error;
         std::error_code ignored_error;
-        setRxStatus(connection_status::connected);
-        while (true) {
-            auto len = socket.receive_from(asio::buffer(data), remote_endp, 0, error);
-            if (error) {
-                setRxStatus(connection_status::error);
-                return;
-            }
-            if (len == 5) {
-                std::string str(data.data(), len);
-                if (str == "close") {
-                    break;
-                }
+        // ask for room for a full batch of datagrams,  the system may limit it to less
+        socket.set_option(udp::socket::receive_buffer_size(maxDatagramSize * datagramBatchSize),
+                          ignored_error);
+        // process a complete message and return false if the receiver should stop
+        auto processMessage = [&](const char* data, std::size_t len, const udp::endpoint& remote) {
+            if (len == 5 && std::memcmp(data, "close", 5) == 0) {
+                return false;
             }
-            ActionMessage M(data.data(), len);
+            ActionMessage M(data, len);
             if (!isValidCommand(M)) {
                 logWarning("invalid command received udp");
-                continue;
+                return true;
             }
             if (isProtocolCommand(M)) {
                 if (M.messageID == CLOSE_RECEIVER) {
-                    break;
+                    return false;
                 }
                 auto reply = generateReplyToIncomingMessage(M);
                 if (reply.messageID == DISCONNECT) {
-                    break;
+                    return false;
                 }
                 if (reply.action() != CMD_IGNORE) {
-                    socket.send_to(asio::buffer(reply.to_string()), remote_endp, 0, ignored_error);
+                    socket.send_to(asio::buffer(reply.to_string()), remote, 0, ignored_error);
                 }
             } else {
                 ActionCallback(std::move(M));
             }
+            return true;
+        };
+        setRxStatus(connection_status::connected);
+        bool continueReceiving{true};
+        while (continueReceiving) {
+            auto count = receiver.receive(socket, error);
+            if (error) {
+                setRxStatus(connection_status::error);
+                return;
+            }
+            for (std::size_t ii = 0; ii < count && continueReceiving; ++ii) {
+                const auto* data = receiver.data(ii);
+                auto len = receiver.size(ii);
+                if (isFragment(data, len)) {
+                    if (assembler.addFragment(receiver.source(ii), data, len, assembled)) {
+                        continueReceiving =
+                            processMessage(assembled.data(), assembled.size(), receiver.source(ii));
+                    }
+                } else {
+                    continueReceiving = processMessage(data, len, receiver.source(ii));
+                }
+            }
         }
         disconnecting = true;
         setRxStatus(connection_status::terminated);
@@ -199,6 +219,7 @@ namespace udp {
                     ActionMessage m(CMD_PROTOCOL_PRIORITY);
                     m.messageID = (PortNumber <= 0) ? REQUEST_PORTS : CONNECTION_REQUEST;
                     m.setStringData(brokerName, brokerInitString);
+                    addCompressionRequest(m);
                     transmitSocket.send_to(asio::buffer(m.to_string()), broker_endpoint, 0, error);
                     if (error) {
                         logError(
@@ -256,6 +277,7 @@ namespace udp {
                             connectionEstablished = true;
                         } else if (m.messageID == CONNECTION_ACK) {
                             if (PortNumber.load() > 0) {
+                                loadCompressionReply(m);
                                 connectionEstablished = true;
                                 continue;
                             }
@@ -319,14 +341,16 @@ namespace udp {
             rxEndpoint = *result;
         }
 
-        setTxStatus(connection_status::connected);
+        DatagramBatch batch;
+        auto transmitFailure = [this](const udp::endpoint& destination,
+                                      const std::error_code& sendError) {
+            logWarning(fmt::format("transmit failure sending to {}:{} {}",
+                                   destination.address().to_string(),
+                                   destination.port(),
+                                   sendError.message()));
+        };
         bool continueProcessing{true};
-        while (continueProcessing) {
-            route_id rid;
-            ActionMessage cmd;
-
-            std::tie(rid, cmd) = txQueue.pop();
-            bool processed = false;
+        auto processCommand = [&](route_id rid, ActionMessage& cmd) {
             if (isProtocolCommand(cmd)) {
                 if (rid == control_route) {
                     switch (cmd.messageID) {
@@ -346,80 +370,39 @@ namespace udp {
                             catch (std::exception&) {
                                 // TODO(someone): do something???
                             }
-                            processed = true;
-                        } break;
+                            return;
+                        }
                         case REMOVE_ROUTE:
                             routes.erase(route_id{cmd.getExtraData()});
-                            processed = true;
-                            break;
+                            return;
                         case CLOSE_RECEIVER:
-                            transmitSocket.send_to(asio::buffer(cmd.to_string()),
-                                                   rxEndpoint,
-                                                   0,
-                                                   error);
-                            if (error) {
-                                logError(fmt::format(
-                                    "transmit failure on sending 'close' to receiver  {}",
-                                    error.message()));
-                            }
+                            batch.add(cmd, rxEndpoint);
                             closingRx = true;
-                            processed = true;
-                            break;
+                            return;
                         case DISCONNECT:
                             continueProcessing = false;
-                            processed = true;
-                            break;
+                            return;
                     }
                 }
             }
-            if (processed) {
-                continue;
-            }
 
             if (rid == parent_route_id) {
                 if (hasBroker) {
-                    transmitSocket.send_to(asio::buffer(cmd.to_string()),
-                                           broker_endpoint,
-                                           0,
-                                           error);
-                    if (error) {
-                        logWarning(
-                            fmt::format("transmit failure sending to broker  {}", error.message()));
-                    }
+                    batch.add(cmd, broker_endpoint);
                 } else {
                     logWarning(fmt::format(
                         "message directed to broker of comm system with no broker, message dropped {}",
                         prettyPrintString(cmd)));
                 }
             } else if (rid == control_route) {  // send to rx thread loop
-                transmitSocket.send_to(asio::buffer(cmd.to_string()), rxEndpoint, 0, error);
-                if (error) {
-                    logWarning(
-                        fmt::format("transmit failure sending control message to receiver  {}",
-                                    error.message()));
-                }
+                batch.add(cmd, rxEndpoint);
             } else {
                 auto rt_find = routes.find(rid);
                 if (rt_find != routes.end()) {
-                    transmitSocket.send_to(asio::buffer(cmd.to_string()),
-                                           rt_find->second,
-                                           0,
-                                           error);
-                    if (error) {
-                        logWarning(fmt::format("transmit failure sending to route {}:{}",
-                                               rid.baseValue(),
-                                               error.message()));
-                    }
+                    batch.add(cmd, rt_find->second);
                 } else {
                     if (hasBroker) {
-                        transmitSocket.send_to(asio::buffer(cmd.to_string()),
-                                               broker_endpoint,
-                                               0,
-                                               error);
-                        if (error) {
-                            logWarning(fmt::format("transmit failure sending to broker  {}",
-                                                   error.message()));
-                        }
+                        batch.add(cmd, broker_endpoint);
                     } else {
                         if (!isDisconnectCommand(cmd)) {
                             logWarning(std::string("(udp) unknown route, message dropped ") +
@@ -428,6 +411,26 @@ namespace udp {
                     }
                 }
             }
+        };
+
+        setTxStatus(connection_status::connected);
+        while (continueProcessing) {
+            route_id rid;
+            ActionMessage cmd;
+
+            std::tie(rid, cmd) = txQueue.pop();
+            processCommand(rid, cmd);
+            // gather anything else already waiting into the same batch of datagrams
+            while (continueProcessing && !batch.full()) {
+                auto queued = txQueue.try_pop();
+                if (!queued) {
+                    break;
+                }
+                processCommand(queued->first, queued->second);
+            }
+            if (!batch.empty()) {
+                batch.send(transmitSocket, transmitFailure);
+            }
         }
         routes.clear();
         if (getRxStatus() == connection_status::connected) {
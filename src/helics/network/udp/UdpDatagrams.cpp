@@ -0,0 +1,281 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "UdpDatagrams.h"
+
+#include "../../core/ActionMessage.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#    include <cerrno>
+#    include <sys/socket.h>
+#    include <sys/uio.h>
+#endif
+
+namespace helics {
+namespace udp {
+    using asio::ip::udp;
+
+    /** the marker in the first byte of a datagram containing a fragment
+    @details serialized messages start with an endianness byte or the packetization marker so
+    this can't be confused with a complete message*/
+    constexpr char fragmentMarker{'\xF7'};
+    /** marker(1)+reserved(1)+index(2)+sequence(4)+count(2)+reserved(2)+total size(4)*/
+    constexpr std::size_t fragmentHeaderSize{16};
+    constexpr std::size_t maxFragmentPayload{maxDatagramSize - fragmentHeaderSize};
+    /** the largest message that will be reassembled*/
+    constexpr std::uint32_t maxMessageSize{1U << 25U};
+
+    static void writeUint(char* data, std::uint32_t value, int bytes)
+    {
+        for (int ii = bytes - 1; ii >= 0; --ii) {
+            data[ii] = static_cast<char>(value & 0xFFU);
+            value >>= 8U;
+        }
+    }
+
+    static std::uint32_t readUint(const char* data, int bytes)
+    {
+        std::uint32_t value{0};
+        for (int ii = 0; ii < bytes; ++ii) {
+            value = (value << 8U) | static_cast<std::uint8_t>(data[ii]);
+        }
+        return value;
+    }
+
+    bool isFragment(const char* data, std::size_t size)
+    {
+        return (size > fragmentHeaderSize) && (data[0] == fragmentMarker);
+    }
+
+    DatagramBatch::DatagramBatch()
+    {
+        buffer.reserve(bufferLimit + maxDatagramSize);
+        datagrams.reserve(datagramBatchSize);
+    }
+
+    char* DatagramBatch::append(std::size_t size, const udp::endpoint& destination)
+    {
+        datagram dgram;
+        dgram.offset = buffer.size();
+        dgram.size = size;
+        dgram.destination = destination;
+        datagrams.push_back(dgram);
+        buffer.resize(buffer.size() + size);
+        return buffer.data() + dgram.offset;
+    }
+
+    void DatagramBatch::add(const ActionMessage& cmd, const udp::endpoint& destination)
+    {
+        auto size = static_cast<std::size_t>(cmd.serializedByteCount());
+        if (size <= static_cast<std::size_t>(maxDatagramSize)) {
+            // serialize directly into the batch buffer
+            auto* location = append(size, destination);
+            auto actual = cmd.toByteArray(location, static_cast<int>(size));
+            if (actual < 0) {
+                buffer.resize(datagrams.back().offset);
+                datagrams.pop_back();
+            } else {
+                datagrams.back().size = static_cast<std::size_t>(actual);
+                buffer.resize(datagrams.back().offset + datagrams.back().size);
+            }
+            return;
+        }
+        scratch.resize(size);
+        auto actual = cmd.toByteArray(scratch.data(), static_cast<int>(size));
+        if (actual <= 0 || static_cast<std::uint32_t>(actual) > maxMessageSize) {
+            return;
+        }
+        const auto total = static_cast<std::size_t>(actual);
+        const auto count = (total + maxFragmentPayload - 1) / maxFragmentPayload;
+        const auto seq = sequence++;
+        for (std::size_t index = 0; index < count; ++index) {
+            const auto offset = index * maxFragmentPayload;
+            const auto payloadSize = (std::min)(maxFragmentPayload, total - offset);
+            auto* location = append(fragmentHeaderSize + payloadSize, destination);
+            location[0] = fragmentMarker;
+            location[1] = 0;
+            writeUint(location + 2, static_cast<std::uint32_t>(index), 2);
+            writeUint(location + 4, seq, 4);
+            writeUint(location + 8, static_cast<std::uint32_t>(count), 2);
+            writeUint(location + 10, 0, 2);
+            writeUint(location + 12, static_cast<std::uint32_t>(total), 4);
+            std::memcpy(location + fragmentHeaderSize, scratch.data() + offset, payloadSize);
+        }
+    }
+
+    void DatagramBatch::add(const char* data, std::size_t size, const udp::endpoint& destination)
+    {
+        if (size > static_cast<std::size_t>(maxDatagramSize)) {
+            return;
+        }
+        std::memcpy(append(size, destination), data, size);
+    }
+
+    void DatagramBatch::clear()
+    {
+        buffer.clear();
+        datagrams.clear();
+    }
+
+    void DatagramBatch::send(udp::socket& socket, const error_callback& errorCallback)
+    {
+#ifdef __linux__
+        mmsghdr headers[datagramBatchSize];
+        iovec vectors[datagramBatchSize];
+        std::size_t sent{0};
+        while (sent < datagrams.size()) {
+            const auto count =
+                (std::min)(datagrams.size() - sent, static_cast<std::size_t>(datagramBatchSize));
+            for (std::size_t ii = 0; ii < count; ++ii) {
+                auto& dgram = datagrams[sent + ii];
+                vectors[ii].iov_base = buffer.data() + dgram.offset;
+                vectors[ii].iov_len = dgram.size;
+                auto& hdr = headers[ii].msg_hdr;
+                hdr = msghdr{};
+                hdr.msg_name = dgram.destination.data();
+                hdr.msg_namelen = static_cast<socklen_t>(dgram.destination.size());
+                hdr.msg_iov = &vectors[ii];
+                hdr.msg_iovlen = 1;
+            }
+            auto res =
+                ::sendmmsg(socket.native_handle(), headers, static_cast<unsigned int>(count), 0);
+            if (res < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // the first datagram failed so report it and move on to the rest
+                if (errorCallback) {
+                    errorCallback(datagrams[sent].destination,
+                                  std::error_code(errno, std::system_category()));
+                }
+                ++sent;
+            } else {
+                sent += static_cast<std::size_t>(res);
+            }
+        }
+#else
+        std::error_code error;
+        for (auto& dgram : datagrams) {
+            socket.send_to(asio::buffer(buffer.data() + dgram.offset, dgram.size),
+                           dgram.destination,
+                           0,
+                           error);
+            if (error && errorCallback) {
+                errorCallback(dgram.destination, error);
+            }
+        }
+#endif
+        clear();
+    }
+
+    DatagramReceiver::DatagramReceiver():
+        buffer(static_cast<std::size_t>(datagramBatchSize) * maxDatagramSize),
+        sizes(datagramBatchSize, 0), sources(datagramBatchSize)
+    {
+    }
+
+    std::size_t DatagramReceiver::receive(udp::socket& socket, std::error_code& error)
+    {
+#ifdef __linux__
+        mmsghdr headers[datagramBatchSize];
+        iovec vectors[datagramBatchSize];
+        for (int ii = 0; ii < datagramBatchSize; ++ii) {
+            vectors[ii].iov_base = buffer.data() + ii * static_cast<std::size_t>(maxDatagramSize);
+            vectors[ii].iov_len = maxDatagramSize;
+            auto& hdr = headers[ii].msg_hdr;
+            hdr = msghdr{};
+            hdr.msg_name = sources[ii].data();
+            hdr.msg_namelen = static_cast<socklen_t>(sources[ii].capacity());
+            hdr.msg_iov = &vectors[ii];
+            hdr.msg_iovlen = 1;
+            headers[ii].msg_len = 0;
+        }
+        int res{-1};
+        do {
+            // block for the first datagram then take whatever else is waiting
+            res = ::recvmmsg(
+                socket.native_handle(), headers, datagramBatchSize, MSG_WAITFORONE, nullptr);
+        } while (res < 0 && errno == EINTR);
+        if (res < 0) {
+            error = std::error_code(errno, std::system_category());
+            return 0;
+        }
+        for (int ii = 0; ii < res; ++ii) {
+            sizes[ii] = headers[ii].msg_len;
+            sources[ii].resize(headers[ii].msg_hdr.msg_namelen);
+        }
+        return static_cast<std::size_t>(res);
+#else
+        sizes[0] = socket.receive_from(asio::buffer(buffer.data(), maxDatagramSize),
+                                       sources[0],
+                                       0,
+                                       error);
+        return (error) ? 0 : 1;
+#endif
+    }
+
+    bool FragmentAssembler::addFragment(const udp::endpoint& source,
+                                        const char* data,
+                                        std::size_t size,
+                                        std::vector<char>& message)
+    {
+        if (!isFragment(data, size)) {
+            return false;
+        }
+        const auto index = readUint(data + 2, 2);
+        const auto seq = readUint(data + 4, 4);
+        const auto count = readUint(data + 8, 2);
+        const auto total = readUint(data + 12, 4);
+        if (total == 0 || total > maxMessageSize || index >= count ||
+            count != (total + maxFragmentPayload - 1) / maxFragmentPayload) {
+            return false;
+        }
+        const auto offset = index * maxFragmentPayload;
+        const auto payloadSize = (std::min)(maxFragmentPayload, total - offset);
+        if (size != fragmentHeaderSize + payloadSize) {
+            return false;
+        }
+        auto key = std::make_pair(source, seq);
+        auto fnd = partials.find(key);
+        if (fnd == partials.end()) {
+            if (partials.size() >= maxPending) {
+                // fragments lost in transit leave messages that never complete so drop the oldest
+                auto oldest = std::min_element(partials.begin(),
+                                               partials.end(),
+                                               [](const auto& part1, const auto& part2) {
+                                                   return part1.second.order < part2.second.order;
+                                               });
+                partials.erase(oldest);
+            }
+            fnd = partials.emplace(key, partialMessage{}).first;
+            auto& part = fnd->second;
+            part.data.resize(total);
+            part.received.assign(count, false);
+            part.remaining = count;
+            part.order = arrivals++;
+        }
+        auto& part = fnd->second;
+        if (part.data.size() != total || part.received.size() != count) {
+            return false;
+        }
+        if (part.received[index]) {
+            return false;
+        }
+        std::memcpy(part.data.data() + offset, data + fragmentHeaderSize, payloadSize);
+        part.received[index] = true;
+        if (--part.remaining > 0) {
+            return false;
+        }
+        message = std::move(part.data);
+        partials.erase(fnd);
+        return true;
+    }
+
+}  // namespace udp
+}  // namespace helics
@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <asio/ip/udp.hpp>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace helics {
+class ActionMessage;
+
+namespace udp {
+    /** the largest datagram sent by the udp comms,  larger messages are split into fragments*/
+    constexpr int maxDatagramSize{65000};
+    /** the number of datagrams sent or received in a single system call*/
+    constexpr int datagramBatchSize{32};
+
+    /** check if a datagram contains a fragment of a larger message*/
+    bool isFragment(const char* data, std::size_t size);
+
+    /** a set of serialized messages waiting to be sent
+    @details the datagrams are stored in a single buffer which is reused between sends,  on linux
+    the whole batch is sent with sendmmsg.  Messages larger than a datagram are split into
+    fragments tagged with a sequence number so the receiver can reassemble them*/
+    class DatagramBatch {
+      public:
+        using error_callback =
+            std::function<void(const asio::ip::udp::endpoint&, const std::error_code&)>;
+        DatagramBatch();
+        /** add a message to the batch
+        @param cmd the message to serialize
+        @param destination the endpoint to send the message to*/
+        void add(const ActionMessage& cmd, const asio::ip::udp::endpoint& destination);
+        /** add raw data to the batch,  the data must fit in a single datagram*/
+        void add(const char* data, std::size_t size, const asio::ip::udp::endpoint& destination);
+        /** check if the batch has reached the size it should be sent at*/
+        bool full() const
+        {
+            return (datagrams.size() >= static_cast<std::size_t>(datagramBatchSize)) ||
+                (buffer.size() >= bufferLimit);
+        }
+        /** check if the batch has no datagrams*/
+        bool empty() const { return datagrams.empty(); }
+        /** get the number of datagrams in the batch*/
+        std::size_t size() const { return datagrams.size(); }
+        /** get the data of a datagram in the batch*/
+        const char* data(std::size_t index) const
+        {
+            return buffer.data() + datagrams[index].offset;
+        }
+        /** get the size of a datagram in the batch*/
+        std::size_t datagramSize(std::size_t index) const { return datagrams[index].size; }
+        /** send all the datagrams and clear the batch
+        @param socket the socket to transmit through
+        @param errorCallback function called with the destination and error of any failed send*/
+        void send(asio::ip::udp::socket& socket, const error_callback& errorCallback);
+        /** remove all the datagrams without sending them*/
+        void clear();
+
+      private:
+        /** the location of a datagram in the buffer and where it is going*/
+        struct datagram {
+            std::size_t offset{0};
+            std::size_t size{0};
+            asio::ip::udp::endpoint destination;
+        };
+        /** the buffer size that triggers a send*/
+        static constexpr std::size_t bufferLimit{256 * 1024};
+        std::vector<char> buffer;  //!< storage for all the serialized data
+        std::vector<datagram> datagrams;  //!< the datagrams in the batch
+        std::vector<char> scratch;  //!< storage for serializing messages that need fragmenting
+        std::uint32_t sequence{0};  //!< the sequence number of the next fragmented message
+        /** append a datagram of a particular size and return a pointer to its storage*/
+        char* append(std::size_t size, const asio::ip::udp::endpoint& destination);
+    };
+
+    /** a set of buffers for receiving several datagrams at once
+    @details on linux the datagrams are read with recvmmsg,  elsewhere one datagram is read per
+    call*/
+    class DatagramReceiver {
+      public:
+        DatagramReceiver();
+        /** wait for at least one datagram and read any others that are available
+        @return the number of datagrams read*/
+        std::size_t receive(asio::ip::udp::socket& socket, std::error_code& error);
+        /** get the data of a received datagram*/
+        const char* data(std::size_t index) const
+        {
+            return buffer.data() + index * static_cast<std::size_t>(maxDatagramSize);
+        }
+        /** get the size of a received datagram*/
+        std::size_t size(std::size_t index) const { return sizes[index]; }
+        /** get the source of a received datagram*/
+        const asio::ip::udp::endpoint& source(std::size_t index) const { return sources[index]; }
+
+      private:
+        std::vector<char> buffer;  //!< storage for all the datagrams
+        std::vector<std::size_t> sizes;  //!< the size of each datagram
+        std::vector<asio::ip::udp::endpoint> sources;  //!< the source of each datagram
+    };
+
+    /** reassembles messages split into fragments by a DatagramBatch*/
+    class FragmentAssembler {
+      public:
+        /** add a fragment to the message it is a part of
+        @param source the endpoint the fragment came from
+        @param data the datagram containing the fragment
+        @param size the size of the datagram
+        @param message storage for the reassembled message when it is complete
+        @return true if the fragment completed a message which is now in message*/
+        bool addFragment(const asio::ip::udp::endpoint& source,
+                         const char* data,
+                         std::size_t size,
+                         std::vector<char>& message);
+        /** get the number of messages waiting on more fragments*/
+        std::size_t pendingCount() const { return partials.size(); }
+
+      private:
+        /** the number of incomplete messages kept before the oldest is discarded*/
+        static constexpr std::size_t maxPending{64};
+        /** a partially received message*/
+        struct partialMessage {
+            std::vector<char> data;
+            std::vector<bool> received;
+            std::uint32_t remaining{0};
+            std::uint64_t order{0};
+        };
+        std::map<std::pair<asio::ip::udp::endpoint, std::uint32_t>, partialMessage> partials;
+        std::uint64_t arrivals{0};  //!< counter for ordering the partial messages
+    };
+
+}  // namespace udp
+}  // namespace helics
@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "ZmqCommsCommon.h"
 #include "ZmqContextManager.h"
 #include "ZmqHelper.h"
+#include "ZmqMessageFrames.h"
 #include "ZmqRequestSets.h"
 #include "zmqSocketDescriptor.h"
 
@@ -64,10 +65,13 @@ namespace zeromq {
                 return (-1);
             }
         }
-        ActionMessage M(static_cast<char*>(msg.data()), msg.size());
+        return processIncomingMessage(ActionMessage(static_cast<char*>(msg.data()), msg.size()));
+    }
+
+    int ZmqComms::processIncomingMessage(ActionMessage&& M)
+    {
         if (!isValidCommand(M)) {
             logError("invalid command received");
-            ActionMessage Q(static_cast<char*>(msg.data()), msg.size());
             return 0;
         }
         if (isProtocolCommand(M)) {
@@ -85,6 +89,22 @@ namespace zeromq {
         return 0;
     }
 
+    int ZmqComms::processIncomingFrames(zmq::message_t& msg, zmq::socket_t& sock)
+    {
+        if (!isFramedMessage(msg)) {
+            return processIncomingMessage(msg);
+        }
+        rxMessages.clear();
+        extractMessages(sock, msg, rxMessages);
+        for (auto& M : rxMessages) {
+            auto status = processIncomingMessage(std::move(M));
+            if (status < 0) {
+                return status;
+            }
+        }
+        return 0;
+    }
+
     int ZmqComms::replyToIncomingMessage(zmq::message_t& msg, zmq::socket_t& sock)
     {
         ActionMessage M(static_cast<char*>(msg.data()), msg.size());
@@ -209,7 +229,7 @@ namespace zeromq {
                 }
                 if (zmq::has_message(poller[1])) {
                     pullSocket.recv(msg);
-                    auto status = processIncomingMessage(msg);
+                    auto status = processIncomingFrames(msg, pullSocket);
                     if (status < 0) {
                         break;
                     }
@@ -429,16 +449,31 @@ namespace zeromq {
             brokerPushSocket.connect(makePortAddress(brokerTargetAddress, brokerPort));
         }
         setTxStatus(connection_status::connected);
-        zmq::message_t msg;
+        MessageFrames frames;
+        zmq::socket_t* framesTarget{nullptr};
+        // send the gathered messages as one multipart message
+        auto sendFrames = [&frames, &framesTarget]() {
+            if (!frames.empty()) {
+                frames.send(*framesTarget);
+            }
+            framesTarget = nullptr;
+        };
+        auto queueFrame = [&](zmq::socket_t& socket, ActionMessage& cmd) {
+            if (framesTarget != &socket) {
+                sendFrames();
+                framesTarget = &socket;
+            }
+            frames.add(cmd);
+            if (frames.full()) {
+                sendFrames();
+            }
+        };
         bool continueProcessing{true};
-        while (continueProcessing) {
-            route_id rid;
-            ActionMessage cmd;
-
-            std::tie(rid, cmd) = txQueue.pop();
-            bool processed = false;
+        auto processCommand = [&](route_id rid, ActionMessage& cmd) {
             if (isProtocolCommand(cmd)) {
                 if (control_route == rid) {
+                    // the sockets may be changed so anything gathered must go out first
+                    sendFrames();
                     switch (cmd.messageID) {
                         case RECONNECT_TRANSMITTER:
                             setTxStatus(connection_status::connected);
@@ -467,31 +502,25 @@ namespace zeromq {
                                 logError(std::string("unable to connect route") + cmd.payload +
                                          "::" + e.what());
                             }
-                            processed = true;
-                        } break;
+                            return;
+                        }
                         case REMOVE_ROUTE:
                             routes.erase(route_id{cmd.getExtraData()});
-                            processed = true;
-                            break;
+                            return;
                         case DISCONNECT:
                             continueProcessing = false;
-                            processed = true;
-                            break;
+                            return;
                     }
                 }
             }
-            if (processed) {
-                continue;
-            }
-            cmd.to_vector(buffer);
             if (rid == parent_route_id) {
                 if (hasBroker) {
-                    brokerPushSocket.send(zmq::const_buffer(buffer.data(), buffer.size()),
-                                          zmq::send_flags::none);
+                    queueFrame(brokerPushSocket, cmd);
                 } else {
                     logWarning("no route to broker for message");
                 }
             } else if (rid == control_route) {  // send to rx thread loop
+                cmd.to_vector(buffer);
                 try {
                     controlSocket.send(zmq::const_buffer(buffer.data(), buffer.size()),
                                        zmq::send_flags::dontwait);
@@ -499,18 +528,18 @@ namespace zeromq {
                 catch (const zmq::error_t& e) {
                     if ((getRxStatus() == connection_status::terminated) ||
                         (getRxStatus() == connection_status::error)) {
-                        break;
+                        continueProcessing = false;
+                        return;
                     }
                     logError(e.what());
                 }
-                continue;
             } else {
                 auto rt_find = routes.find(rid);
                 if (rt_find != routes.end()) {
-                    rt_find->second.send(zmq::const_buffer(buffer.data(), buffer.size()));
+                    queueFrame(rt_find->second, cmd);
                 } else {
                     if (hasBroker) {
-                        brokerPushSocket.send(zmq::const_buffer(buffer.data(), buffer.size()));
+                        queueFrame(brokerPushSocket, cmd);
                     } else {
                         if (!isDisconnectCommand(cmd)) {
                             logWarning(
@@ -520,6 +549,23 @@ namespace zeromq {
                     }
                 }
             }
+        };
+
+        while (continueProcessing) {
+            route_id rid;
+            ActionMessage cmd;
+
+            std::tie(rid, cmd) = txQueue.pop();
+            processCommand(rid, cmd);
+            // gather anything else already waiting so small messages share a send
+            while (continueProcessing) {
+                auto queued = txQueue.try_pop();
+                if (!queued) {
+                    break;
+                }
+                processCommand(queued->first, queued->second);
+            }
+            sendFrames();
         }
         brokerPushSocket.close();
 
@@ -12,6 +12,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <atomic>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace zmq {
 class message_t;
@@ -39,12 +40,20 @@ namespace zeromq {
         /** process an incoming message
     return code for required action 0=NONE, -1 TERMINATE*/
         int processIncomingMessage(zmq::message_t& msg);
+        /** process an incoming message that has already been extracted from a frame
+    return code for required action 0=NONE, -1 TERMINATE*/
+        int processIncomingMessage(ActionMessage&& M);
+        /** process all the messages in an incoming multipart message
+    return code for required action 0=NONE, -1 TERMINATE*/
+        int processIncomingFrames(zmq::message_t& msg, zmq::socket_t& sock);
         /** process an incoming message and send and ack in response
     return code for required action 0=NONE, -1 TERMINATE*/
         int replyToIncomingMessage(zmq::message_t& msg, zmq::socket_t& sock);
 
         int initializeBrokerConnections(zmq::socket_t& controlSocket);
 
+        std::vector<ActionMessage> rxMessages;  //!< storage for messages extracted from frames
+
       public:
         std::string getPushAddress() const;
     };
@@ -12,6 +12,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "ZmqCommsCommon.h"
 #include "ZmqContextManager.h"
 #include "ZmqHelper.h"
+#include "ZmqMessageFrames.h"
 #include "ZmqRequestSets.h"
 #include "zmqSocketDescriptor.h"
 
@@ -75,15 +76,20 @@ namespace zeromq {
     int ZmqCommsSS::processIncomingMessage(zmq::message_t& msg,
                                            std::map<std::string, std::string>& connection_info)
     {
-        int status = 0;
         if (msg.size() == 5) {
             std::string str(static_cast<char*>(msg.data()), msg.size());
             if (str == "close") {
                 return (-1);
             }
         }
-        ActionMessage M(static_cast<char*>(msg.data()), msg.size());
+        return processIncomingMessage(ActionMessage(static_cast<char*>(msg.data()), msg.size()),
+                                      connection_info);
+    }
 
+    int ZmqCommsSS::processIncomingMessage(ActionMessage&& M,
+                                           std::map<std::string, std::string>& connection_info)
+    {
+        int status = 0;
         if (!isValidCommand(M)) {
             std::cerr << "invalid command received" << M.action() << std::endl;
             return 0;
@@ -301,7 +307,6 @@ namespace zeromq {
 
     void ZmqCommsSS::queue_tx_function()
     {
-        std::vector<char> buffer;
         auto ctx = ZmqContextManager::getContextPointer();
         zmq::message_t msg;
 
@@ -347,6 +352,33 @@ namespace zeromq {
 
         int status{0};
 
+        MessageFrames frames;
+        zmq::socket_t* framesSocket{nullptr};
+        std::string framesRoute;  // the identity to address the frames to on the router socket
+        // send the gathered messages as one multipart message
+        auto sendFrames = [&frames, &framesSocket, &framesRoute]() {
+            if (!frames.empty()) {
+                if (!framesRoute.empty()) {
+                    // Need to first send identity and empty string
+                    framesSocket->send(framesRoute, zmq::send_flags::sndmore);
+                    framesSocket->send(std::string{}, zmq::send_flags::sndmore);
+                }
+                frames.send(*framesSocket, zmq::send_flags::dontwait);
+            }
+            framesSocket = nullptr;
+        };
+        auto queueFrame = [&](zmq::socket_t& socket, const std::string& route, ActionMessage& cmd) {
+            if ((framesSocket != &socket) || (framesRoute != route)) {
+                sendFrames();
+                framesSocket = &socket;
+                framesRoute = route;
+            }
+            frames.add(cmd);
+            if (frames.full()) {
+                sendFrames();
+            }
+        };
+
         bool haltLoop{false};
         //  std::vector<ActionMessage> txlist;
         while (!haltLoop) {
@@ -378,13 +410,9 @@ namespace zeromq {
                     }
                 }
                 if (!processed) {
-                    buffer.clear();
-                    cmd.to_vector(buffer);
                     if (rid == parent_route_id) {
                         if (hasBroker) {
-                            std::string empty;
-                            brokerConnection.send(zmq::const_buffer(buffer.data(), buffer.size()),
-                                                  zmq::send_flags::dontwait);
+                            queueFrame(brokerConnection, std::string{}, cmd);
                         } else {
                             logWarning("no route to broker for message");
                         }
@@ -399,19 +427,10 @@ namespace zeromq {
                         // If route found send out through the front end socket connection
                         auto rt_find = routes.find(rid);
                         if (rt_find != routes.end()) {
-                            std::string route_name = rt_find->second;
-                            std::string empty;
-                            // Need to first send identity and empty string
-                            brokerSocket.send(route_name, zmq::send_flags::sndmore);
-                            brokerSocket.send(empty, zmq::send_flags::sndmore);
-                            // Send the actual data
-                            brokerSocket.send(zmq::const_buffer(buffer.data(), buffer.size()),
-                                              zmq::send_flags::dontwait);
+                            queueFrame(brokerSocket, rt_find->second, cmd);
                         } else {
                             if (hasBroker) {
-                                brokerConnection.send(zmq::const_buffer(buffer.data(),
-                                                                        buffer.size()),
-                                                      zmq::send_flags::dontwait);
+                                queueFrame(brokerConnection, std::string{}, cmd);
                             } else {
                                 if (!isDisconnectCommand(cmd)) {
                                     logWarning(
@@ -428,6 +447,7 @@ namespace zeromq {
                     tx_msg = txQueue.try_pop();
                 }
             }
+            sendFrames();
 
             count = 0;
             rc = 1;
@@ -473,6 +493,16 @@ namespace zeromq {
         }
     }
 
+    /** acknowledge a connection to the sender identified by identity*/
+    static void sendConnectionAck(zmq::socket_t& socket, const std::string& identity)
+    {
+        ActionMessage rep(CMD_PROTOCOL);
+        rep.messageID = CONNECTION_ACK;
+        socket.send(identity, zmq::send_flags::sndmore);
+        socket.send(std::string{}, zmq::send_flags::sndmore);
+        socket.send(rep.to_string(), zmq::send_flags::dontwait);
+    }
+
     int ZmqCommsSS::processRxMessage(zmq::socket_t& socket,
                                      std::map<std::string, std::string>& connection_info)
     {
@@ -482,15 +512,26 @@ namespace zeromq {
 
         socket.recv(msg1);
         socket.recv(msg2);
-        status = processIncomingMessage(msg2, connection_info);
-
-        if (status == 3) {
-            ActionMessage rep(CMD_PROTOCOL);
-            rep.messageID = CONNECTION_ACK;
-            socket.send(msg1, zmq::send_flags::sndmore);
-            socket.send(std::string{}, zmq::send_flags::sndmore);
-            socket.send(rep.to_string(), zmq::send_flags::dontwait);
-            status = 0;
+        const std::string identity(static_cast<char*>(msg1.data()), msg1.size());
+        if (!isFramedMessage(msg2)) {
+            status = processIncomingMessage(msg2, connection_info);
+            if (status == 3) {
+                sendConnectionAck(socket, identity);
+                status = 0;
+            }
+            return status;
+        }
+        std::vector<ActionMessage> messages;
+        extractMessages(socket, msg2, messages);
+        for (auto& M : messages) {
+            auto mstatus = processIncomingMessage(std::move(M), connection_info);
+            if (mstatus == 3) {
+                sendConnectionAck(socket, identity);
+            } else if (mstatus < 0) {
+                return mstatus;
+            } else if (mstatus != 0) {
+                status = mstatus;
+            }
         }
         return status;
     }
@@ -41,6 +41,10 @@ namespace zeromq {
     return code for required action 0=NONE, -1 TERMINATE*/
         int processIncomingMessage(zmq::message_t& msg,
                                    std::map<std::string, std::string>& connection_info);
+        /** process an incoming message that has already been extracted from a frame
+    return code for required action 0=NONE, -1 TERMINATE*/
+        int processIncomingMessage(ActionMessage&& M,
+                                   std::map<std::string, std::string>& connection_info);
         /** process Tx control cmd message
         return code for required action TRUE=close connection, FALSE=continue*/
         bool processTxControlCmd(const ActionMessage& cmd,
@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "ZmqMessageFrames.h"
+
+#include "../../core/ActionMessage.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace helics {
+namespace zeromq {
+    // a plain serialized message starts with the endianness flag 0 or 1 and a packetized message
+    // with 0xF3, so the frame types can be told apart from the first byte
+    /** marker for a frame containing several serialized messages*/
+    constexpr char batchFrameMarker{'\xF4'};
+    /** marker for a header frame whose payload is in the next frame*/
+    constexpr char splitHeaderMarker{'\xF5'};
+    /** the size of the marker and the length of the first message in a batch frame*/
+    constexpr std::size_t batchHeaderSize{5};
+
+    static void writeLength(char* data, std::uint32_t length)
+    {
+        data[0] = static_cast<char>((length >> 24U) & 0xFFU);
+        data[1] = static_cast<char>((length >> 16U) & 0xFFU);
+        data[2] = static_cast<char>((length >> 8U) & 0xFFU);
+        data[3] = static_cast<char>(length & 0xFFU);
+    }
+
+    static std::uint32_t readLength(const char* data)
+    {
+        return (static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[0])) << 24U) |
+            (static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[1])) << 16U) |
+            (static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[2])) << 8U) |
+            static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[3]));
+    }
+
+    /** zmq deallocation function for frames that point into a heap allocated string*/
+    static void releaseString(void* /*data*/, void* hint)
+    {
+        delete static_cast<std::string*>(hint);
+    }
+
+    /** generate a frame that takes ownership of a string without copying it*/
+    static zmq::message_t stringFrame(std::unique_ptr<std::string> buffer, std::size_t offset)
+    {
+        auto* str = buffer.release();
+        return zmq::message_t(&((*str)[0]) + offset, str->size() - offset, releaseString, str);
+    }
+
+    bool isFramedMessage(const zmq::message_t& msg)
+    {
+        if (msg.size() == 0) {
+            return false;
+        }
+        auto marker = *static_cast<const char*>(msg.data());
+        return (marker == batchFrameMarker) || (marker == splitHeaderMarker);
+    }
+
+    void MessageFrames::add(ActionMessage& cmd)
+    {
+        if ((cmd.payload.size() >= zeroCopyPayloadSize) && (cmd.action() != CMD_TIME_REQUEST)) {
+            closeBatch();
+            auto payload = std::make_unique<std::string>(std::move(cmd.payload));
+            cmd.payload.clear();
+            zmq::message_t header(static_cast<std::size_t>(cmd.serializedByteCount()) + 1);
+            auto* data = static_cast<char*>(header.data());
+            data[0] = splitHeaderMarker;
+            cmd.toByteArray(data + 1, static_cast<int>(header.size() - 1));
+            pendingBytes += header.size() + payload->size();
+            frames.push_back(std::move(header));
+            frames.push_back(stringFrame(std::move(payload), 0));
+            ++messageCount;
+            return;
+        }
+        if (!batch) {
+            batch = std::make_unique<std::string>();
+            batch->reserve(1024);
+        }
+        auto msgSize = static_cast<std::size_t>(cmd.serializedByteCount());
+        auto start = batch->size();
+        if (batchCount == 0) {
+            batch->resize(batchHeaderSize + msgSize);
+            (*batch)[0] = batchFrameMarker;
+            start = 1;
+        } else {
+            batch->resize(start + sizeof(std::uint32_t) + msgSize);
+        }
+        writeLength(&((*batch)[start]), static_cast<std::uint32_t>(msgSize));
+        cmd.toByteArray(&((*batch)[start + sizeof(std::uint32_t)]), static_cast<int>(msgSize));
+        pendingBytes += msgSize + sizeof(std::uint32_t);
+        ++batchCount;
+        ++messageCount;
+    }
+
+    void MessageFrames::closeBatch()
+    {
+        if (batchCount == 0) {
+            return;
+        }
+        // a single message is sent in the plain format so any receiver can interpret it
+        frames.push_back(stringFrame(std::move(batch), (batchCount == 1) ? batchHeaderSize : 0));
+        batchCount = 0;
+    }
+
+    void MessageFrames::send(zmq::socket_t& socket, zmq::send_flags flags)
+    {
+        closeBatch();
+        auto sending = std::move(frames);
+        frames.clear();
+        messageCount = 0;
+        pendingBytes = 0;
+        for (std::size_t ii = 0; ii < sending.size(); ++ii) {
+            socket.send(sending[ii],
+                        (ii + 1 < sending.size()) ? zmq::send_flags::sndmore : flags);
+        }
+    }
+
+    void MessageFrames::clear()
+    {
+        frames.clear();
+        batch.reset();
+        batchCount = 0;
+        messageCount = 0;
+        pendingBytes = 0;
+    }
+
+    std::size_t extractMessages(zmq::socket_t& socket,
+                                zmq::message_t& msg,
+                                std::vector<ActionMessage>& messages)
+    {
+        auto initialCount = messages.size();
+        zmq::message_t frame;
+        zmq::message_t* current = &msg;
+        while (true) {
+            const auto* data = static_cast<const char*>(current->data());
+            const auto size = current->size();
+            if ((size > 0) && (data[0] == batchFrameMarker)) {
+                std::size_t loc{1};
+                while (loc + sizeof(std::uint32_t) <= size) {
+                    auto msgSize = static_cast<std::size_t>(readLength(data + loc));
+                    loc += sizeof(std::uint32_t);
+                    if (loc + msgSize > size) {
+                        break;
+                    }
+                    messages.emplace_back(data + loc, msgSize);
+                    loc += msgSize;
+                }
+            } else if ((size > 0) && (data[0] == splitHeaderMarker)) {
+                ActionMessage header(data + 1, size - 1);
+                if (current->more()) {
+                    zmq::message_t payload;
+                    socket.recv(payload);
+                    header.payload.assign(static_cast<const char*>(payload.data()),
+                                          payload.size());
+                    messages.push_back(std::move(header));
+                    if (!payload.more()) {
+                        break;
+                    }
+                } else {
+                    messages.push_back(std::move(header));
+                    break;
+                }
+            } else {
+                messages.emplace_back(data, size);
+            }
+            if (!current->more()) {
+                break;
+            }
+            socket.recv(frame);
+            current = &frame;
+        }
+        return messages.size() - initialCount;
+    }
+
+}  // namespace zeromq
+}  // namespace helics
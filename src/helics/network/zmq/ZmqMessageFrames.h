@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "cppzmq/zmq.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace helics {
+class ActionMessage;
+
+namespace zeromq {
+    /** payloads of at least this many bytes are sent in their own frame without being copied*/
+    constexpr std::size_t zeroCopyPayloadSize{8192};
+    /** the largest number of messages gathered into a single send*/
+    constexpr int maxFramedMessages{128};
+
+    /** check if a received frame was generated by a MessageFrames object and may contain more
+    than one message or be followed by a payload frame*/
+    bool isFramedMessage(const zmq::message_t& msg);
+
+    /** a set of messages sent to a zmq socket as a single multipart message
+    @details small messages are serialized one after another into a single batch frame,  a message
+    with a large payload is sent as a header frame followed by a frame holding the payload.  The
+    payload string is moved out of the message and handed to zmq which releases it once it has
+    been transmitted,  so the payload is never copied on transmission.  A set containing a single
+    small message is sent as a plain serialized message*/
+    class MessageFrames {
+      public:
+        /** add a message to the set
+        @details the payload of a large message is moved out of cmd*/
+        void add(ActionMessage& cmd);
+        /** check if the set has reached the size it should be sent at*/
+        bool full() const
+        {
+            return (messageCount >= maxFramedMessages) || (pendingBytes >= bytesLimit);
+        }
+        /** check if the set has no messages*/
+        bool empty() const { return messageCount == 0; }
+        /** get the number of messages in the set*/
+        int size() const { return messageCount; }
+        /** send all the frames and clear the set
+        @param socket the socket to transmit through
+        @param flags the send flags used for the final frame,  all the other frames are sent with
+        sndmore*/
+        void send(zmq::socket_t& socket, zmq::send_flags flags = zmq::send_flags::none);
+        /** remove all the messages without sending them*/
+        void clear();
+
+      private:
+        /** the number of buffered bytes that triggers a send*/
+        static constexpr std::size_t bytesLimit{256 * 1024};
+        std::vector<zmq::message_t> frames;  //!< the completed frames
+        std::unique_ptr<std::string> batch;  //!< serialized small messages not yet in a frame
+        int batchCount{0};  //!< the number of messages in the batch
+        int messageCount{0};  //!< the total number of messages in the set
+        std::size_t pendingBytes{0};  //!< the number of bytes in the set
+        /** move the current batch into a frame*/
+        void closeBatch();
+    };
+
+    /** extract all the messages from a received multipart message
+    @param socket the socket to read the remaining frames of the message from
+    @param msg the first frame of the message which has already been received
+    @param[out] messages the vector to append the extracted messages to
+    @return the number of messages extracted*/
+    std::size_t extractMessages(zmq::socket_t& socket,
+                                zmq::message_t& msg,
+                                std::vector<ActionMessage>& messages);
+}  // namespace zeromq
+}  // namespace helics
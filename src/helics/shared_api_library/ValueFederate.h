@@ -275,6 +275,30 @@ HELICS_EXPORT helics_input helicsFederateGetSubscription(helics_federate fed, co
  */
 HELICS_EXPORT void helicsFederateClearUpdates(helics_federate fed);
 
+/**
+ * Get the number of inputs updated by the most recent time request.
+ *
+ * @details Used with helicsFederateGetUpdatedInput to iterate over the updated inputs without checking every input of the federate.
+ *
+ * @param fed The value federate object.
+ *
+ * @return The number of inputs updated by the last time request, 0 if fed is not a valid value federate.
+ */
+HELICS_EXPORT int helicsFederateGetUpdatedInputCount(helics_federate fed);
+
+/**
+ * Get an input updated by the most recent time request.
+ *
+ * @param fed The value federate object.
+ * @param index The position in the updated inputs, between 0 and the value returned by helicsFederateGetUpdatedInputCount.
+ * @forcpponly
+ * @param[in,out] err A pointer to an error object for catching errors.
+ * @endforcpponly
+ *
+ * @return A helics_input, which will be NULL if the index is not valid.
+ */
+HELICS_EXPORT helics_input helicsFederateGetUpdatedInput(helics_federate fed, int index, helics_error* err);
+
 /**
  * Register the publications via JSON publication string.
  *
@@ -635,6 +659,27 @@ HELICS_EXPORT int helicsInputGetVectorSize(helics_input ipt);
  */
 HELICS_EXPORT void helicsInputGetVector(helics_input ipt, double data[], int maxLength, int* actualSize, helics_error* err);
 
+/**
+ * Get a vector from a subscription into a caller supplied buffer.
+ *
+ * @details The value is converted once and copied directly into the buffer.  Unlike helicsInputGetVector the actual size is the full
+ * length of the value even if it is larger than the buffer,  so a caller can detect truncation and retry with a larger buffer.
+ *
+ * @param ipt The input to get the result for.
+ * @forcpponly
+ * @param[out] vectorBuffer The location to store the data.
+ * @param bufferLength The number of doubles vectorBuffer can hold.
+ * @param[out] actualSize Location to place the full length of the vector.
+ * @param[in,out] err An error object that will contain an error code and string if any error occurred during the execution of the function.
+ * @endforcpponly
+ *
+ * @beginPythonOnly
+ * @param vectorBuffer A writable buffer of float64 values such as a numpy array or a memoryview cast to "d", the values are written in place.
+ * @return the full length of the vector
+ * @endPythonOnly
+ */
+HELICS_EXPORT void helicsInputGetVectorBuffer(helics_input ipt, double* vectorBuffer, int bufferLength, int* actualSize, helics_error* err);
+
 /**
  * Get a named point from a subscription.
  *
@@ -479,6 +479,49 @@ void helicsFederateClearUpdates(helics_federate fed)
     // LCOV_EXCL_STOP
 }
 
+int helicsFederateGetUpdatedInputCount(helics_federate fed)
+{
+    auto* vfedObj = getValueFed(fed, nullptr);
+    if (vfedObj == nullptr) {
+        return 0;
+    }
+    return static_cast<int>(vfedObj->queryLastUpdates().size());
+}
+
+helics_input helicsFederateGetUpdatedInput(helics_federate fed, int index, helics_error* err)
+{
+    auto fedObj = getValueFedSharedPtr(fed, err);
+    if (!fedObj) {
+        return nullptr;
+    }
+    try {
+        const auto& updates = fedObj->queryLastUpdates();
+        if ((index < 0) || (index >= static_cast<int>(updates.size()))) {
+            assignError(err, helics_error_invalid_argument, invalidInputIndex);
+            return nullptr;
+        }
+        auto inputIndex = static_cast<size_t>(updates[index]);
+        // reuse the input objects so iterating every time step doesn't keep allocating new ones
+        auto& cache = reinterpret_cast<helics::FedObject*>(fed)->indexedInputs;
+        if (inputIndex >= cache.size()) {
+            cache.resize(inputIndex + 1, nullptr);
+        }
+        if (cache[inputIndex] == nullptr) {
+            auto inp = std::make_unique<helics::InputObject>();
+            inp->inputPtr = &fedObj->getInput(static_cast<int>(inputIndex));
+            inp->fedptr = std::move(fedObj);
+            cache[inputIndex] = reinterpret_cast<helics::InputObject*>(addInput(fed, std::move(inp)));
+        }
+        return cache[inputIndex];
+    }
+    // LCOV_EXCL_START
+    catch (...) {
+        helicsErrorHandler(err);
+        return nullptr;
+    }
+    // LCOV_EXCL_STOP
+}
+
 /* getting and publishing values */
 void helicsPublicationPublishRaw(helics_publication pub, const void* data, int datalen, helics_error* err)
 {
@@ -932,6 +975,33 @@ void helicsInputGetVector(helics_input inp, double data[], int maxlen, int* actu
     // LCOV_EXCL_STOP
 }
 
+void helicsInputGetVectorBuffer(helics_input inp, double* vectorBuffer, int bufferLength, int* actualSize, helics_error* err)
+{
+    auto* inpObj = verifyInput(inp, err);
+    if (actualSize != nullptr) {
+        *actualSize = 0;
+    }
+    if (inpObj == nullptr) {
+        return;
+    }
+    try {
+        const auto& vec = inpObj->inputPtr->getValueRef<std::vector<double>>();
+        if ((vectorBuffer != nullptr) && (bufferLength > 0)) {
+            int length = std::min(static_cast<int>(vec.size()), bufferLength);
+            std::memcpy(vectorBuffer, vec.data(), length * sizeof(double));
+        }
+        inpObj->inputPtr->clearUpdate();
+        if (actualSize != nullptr) {
+            *actualSize = static_cast<int>(vec.size());
+        }
+    }
+    // LCOV_EXCL_START
+    catch (...) {
+        helicsErrorHandler(err);
+    }
+    // LCOV_EXCL_STOP
+}
+
 void helicsInputGetNamedPoint(helics_input inp, char* outputString, int maxStringLen, int* actualLength, double* val, helics_error* err)
 {
     auto* inpObj = verifyInput(inp, err);
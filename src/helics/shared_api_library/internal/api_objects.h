@@ -87,6 +87,7 @@ class FedObject {
     std::shared_ptr<Federate> fedptr;
     MessageHolder messages;
     std::vector<std::unique_ptr<InputObject>> inputs;
+    std::vector<InputObject*> indexedInputs;  //!< input objects by the index of the input
     std::vector<std::unique_ptr<PublicationObject>> pubs;
     std::vector<std::unique_ptr<EndpointObject>> epts;
     std::vector<std::unique_ptr<FilterObject>> filters;
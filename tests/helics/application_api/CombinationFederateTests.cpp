@@ -8,15 +8,19 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/CombinationFederate.hpp"
 #include "helics/application_api/CoreApp.hpp"
 #include "helics/application_api/Endpoints.hpp"
+#include "helics/application_api/Inputs.hpp"
 #include "helics/application_api/Publications.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/Core.hpp"
 #include "helics/core/CoreFactory.hpp"
 #include "helics/core/core-exceptions.hpp"
 #include "testFixtures.hpp"
 
+#include <cstdio>
 #include <future>
 #include <gtest/gtest.h>
+#include <thread>
 
 class combofed_single_type_tests:
     public ::testing::TestWithParam<const char*>,
@@ -341,3 +345,102 @@ TEST(comboFederate, constructor3)
     mf1.finalize();
     EXPECT_TRUE(cr.waitForDisconnect(std::chrono::milliseconds(500)));
 }
+
+TEST(comboFederate, checkpoint_restore)
+{
+    const std::string checkpointFile{"combo_checkpoint.hckp"};
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreInitString = "--autobroker";
+    {
+        helics::CombinationFederate cFed("cfed", fi);
+        auto& pub = cFed.registerGlobalPublication<double>("cpub");
+        auto& inp = cFed.registerSubscription("cpub");
+        auto& ept = cFed.registerGlobalEndpoint("cept");
+        cFed.setCheckpointCallbacks([]() { return std::string("model_state"); }, {});
+        cFed.enterExecutingMode();
+        pub.publish(3.5);
+        ept.send("cept", std::string("future message"), 5.0);
+        EXPECT_EQ(cFed.requestTime(2.0), 2.0);
+        EXPECT_DOUBLE_EQ(inp.getValue<double>(), 3.5);
+        cFed.saveCheckpoint(checkpointFile);
+        cFed.finalize();
+    }
+
+    helics::CombinationFederate rFed("cfed", fi);
+    rFed.registerGlobalPublication<double>("cpub");
+    auto& rinp = rFed.registerSubscription("cpub");
+    auto& rept = rFed.registerGlobalEndpoint("cept");
+    std::string modelState;
+    rFed.setCheckpointCallbacks({}, [&modelState](const std::string& state) {
+        modelState = state;
+    });
+    EXPECT_THROW(rFed.restoreCheckpoint(checkpointFile), helics::InvalidFunctionCall);
+    rFed.enterInitializingMode();
+    auto checkpointTime = rFed.restoreCheckpoint(checkpointFile);
+    EXPECT_EQ(checkpointTime, 2.0);
+    EXPECT_EQ(modelState, "model_state");
+
+    rFed.enterExecutingMode();
+    EXPECT_EQ(rFed.getCurrentTime(), checkpointTime);
+    EXPECT_FALSE(rinp.isUpdated());
+    EXPECT_DOUBLE_EQ(rinp.getValue<double>(), 3.5);
+    EXPECT_EQ(rFed.requestTime(10.0), 5.0);
+    auto m = rept.getMessage();
+    ASSERT_TRUE(m);
+    EXPECT_EQ(m->data.to_string(), "future message");
+    rFed.finalize();
+    std::remove(checkpointFile.c_str());
+}
+
+TEST_P(combofed_single_type_tests, checkpoint_barrier)
+{
+    SetupTest<helics::CombinationFederate>(GetParam(), 2);
+    auto cFed1 = GetFederateAs<helics::CombinationFederate>(0);
+    auto cFed2 = GetFederateAs<helics::CombinationFederate>(1);
+    const std::string checkpointFile = "barrier_" + cFed2->getName() + ".hckp";
+
+    auto& pub = cFed1->registerGlobalPublication<double>("bpub");
+    cFed2->registerSubscription("bpub");
+    brokers[0]->setCheckpointBarrier(3.0, "barrier_");
+
+    cFed1->enterExecutingModeAsync();
+    cFed2->enterExecutingMode();
+    cFed1->enterExecutingModeComplete();
+    pub.publish(4.5);
+    cFed1->requestTimeAsync(2.0);
+    EXPECT_EQ(cFed2->requestTime(2.0), 2.0);
+    EXPECT_EQ(cFed1->requestTimeComplete(), 2.0);
+
+    // both federates are held at the barrier and write a checkpoint at their granted time
+    cFed1->requestTimeAsync(5.0);
+    cFed2->requestTimeAsync(5.0);
+    double savedTime{-1.0};
+    for (int ii = 0; ii < 20; ++ii) {
+        auto res = loadJsonStr(brokers[0]->query(cFed2->getName(), "checkpoint"));
+        savedTime = res["saved_time"].asDouble();
+        if (savedTime == 2.0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_EQ(savedTime, 2.0);
+    EXPECT_FALSE(cFed2->isAsyncOperationCompleted());
+    brokers[0]->clearTimeBarrier();
+    EXPECT_EQ(cFed1->requestTimeComplete(), 5.0);
+    EXPECT_EQ(cFed2->requestTimeComplete(), 5.0);
+    cFed1->finalize();
+    cFed2->finalize();
+
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreInitString = "--autobroker";
+    helics::CombinationFederate rFed("rfed", fi);
+    auto& rinp = rFed.registerSubscription("bpub");
+    rFed.enterInitializingMode();
+    EXPECT_EQ(rFed.restoreCheckpoint(checkpointFile), 2.0);
+    rFed.enterExecutingMode();
+    EXPECT_EQ(rFed.getCurrentTime(), 2.0);
+    EXPECT_FALSE(rinp.isUpdated());
+    EXPECT_DOUBLE_EQ(rinp.getValue<double>(), 4.5);
+    rFed.finalize();
+    std::remove(checkpointFile.c_str());
+}
@@ -113,6 +113,33 @@ TEST(logging_tests, file_logging_p2)
     ghc::filesystem::remove(lfilename, ec);
 }
 
+TEST(logging_tests, file_logging_async)
+{
+    const std::string lfilename = "logfile_async.txt";
+    std::error_code ec;
+    if (ghc::filesystem::exists(lfilename)) {
+        ghc::filesystem::remove(lfilename, ec);
+    }
+    helics::FederateInfo fi(CORE_TYPE_TO_TEST);
+    fi.coreInitString =
+        "--autobroker --logfile logfile_async.txt --fileloglevel=5 --asynclog --logbuffer=256";
+
+    auto Fed = std::make_shared<helics::Federate>("test1", fi);
+
+    Fed->enterExecutingMode();
+    Fed->finalize();
+    auto cr = Fed->getCorePointer();
+    Fed.reset();
+
+    cr->waitForDisconnect();
+    cr.reset();
+    helics::cleanupHelicsLibrary();
+    // the background writer is drained when the core is destroyed
+    ASSERT_TRUE(ghc::filesystem::exists(lfilename));
+    EXPECT_GT(ghc::filesystem::file_size(lfilename), 0U);
+    ghc::filesystem::remove(lfilename, ec);
+}
+
 TEST(logging_tests, check_log_message)
 {
     helics::FederateInfo fi(CORE_TYPE_TO_TEST);
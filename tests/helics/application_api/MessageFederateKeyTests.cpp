@@ -29,6 +29,18 @@ class mfed_single_type_tests:
 class mfed_type_tests: public ::testing::TestWithParam<const char*>, public FederateTestFixture {
 };
 
+/** count the direct routes reported by the core of a federate*/
+static int directRouteCount(const std::shared_ptr<helics::MessageFederate>& fed)
+{
+    auto res = fed->query("core", "direct_routes");
+    int count{0};
+    for (auto loc = res.find("\"federate\""); loc != std::string::npos;
+         loc = res.find("\"federate\"", loc + 1)) {
+        ++count;
+    }
+    return count;
+}
+
 class mfed_all_type_tests:
     public ::testing::TestWithParam<const char*>,
     public FederateTestFixture {
@@ -226,6 +238,239 @@ TEST_F(mfed_tests, send_receive_2fed_extra)
     EXPECT_TRUE(mFed2->getCurrentMode() == helics::Federate::modes::finalize);
 }
 
+TEST_F(mfed_tests, send_receive_2core_repeated)
+{
+    // after the first message the cores route by handle so check that later messages still arrive
+    // with the correct names
+    SetupTest<helics::MessageFederate>("test_2", 2);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+    auto epid = mFed1->registerEndpoint("ep1");
+    auto epid2 = mFed2->registerGlobalEndpoint("ep2", "random");
+
+    mFed1->setProperty(helics_property_time_delta, 1.0);
+    mFed2->setProperty(helics_property_time_delta, 1.0);
+    auto f1finish = std::async(std::launch::async, [&]() { mFed1->enterExecutingMode(); });
+    mFed2->enterExecutingMode();
+    f1finish.wait();
+
+    for (int ii = 1; ii <= 4; ++ii) {
+        mFed1->sendMessage(epid, "ep2", helics::data_block(10 * ii, 'a'));
+        mFed2->sendMessage(epid2, "fed0/ep1", helics::data_block(10 * ii, 'b'));
+        auto f1time = std::async(std::launch::async, [&]() { return mFed1->requestTime(ii); });
+        auto gtime = mFed2->requestTime(ii);
+        EXPECT_EQ(gtime, static_cast<double>(ii));
+        EXPECT_EQ(f1time.get(), static_cast<double>(ii));
+
+        auto M1 = mFed1->getMessage(epid);
+        ASSERT_TRUE(M1);
+        EXPECT_EQ(M1->data.size(), static_cast<size_t>(10 * ii));
+        EXPECT_EQ(M1->source, "ep2");
+        EXPECT_EQ(M1->dest, "fed0/ep1");
+
+        auto M2 = mFed2->getMessage(epid2);
+        ASSERT_TRUE(M2);
+        EXPECT_EQ(M2->data.size(), static_cast<size_t>(10 * ii));
+        EXPECT_EQ(M2->original_source, "fed0/ep1");
+        EXPECT_EQ(M2->dest, "ep2");
+    }
+    mFed1->finalizeAsync();
+    mFed2->finalize();
+    mFed1->finalizeComplete();
+}
+
+TEST_F(mfed_tests, send_receive_2core_direct_route)
+{
+    SetupTest<helics::MessageFederate>("test_2", 2);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+    auto& ep1 = mFed1->registerGlobalEndpoint("ep1");
+    auto& ep2 = mFed2->registerGlobalEndpoint("ep2");
+    mFed1->registerKnownCommunicationPath(ep1, "ep2");
+    mFed2->registerKnownCommunicationPath(ep2, "ep1");
+
+    mFed1->setProperty(helics_property_time_delta, 1.0);
+    mFed2->setProperty(helics_property_time_delta, 1.0);
+    auto f1finish = std::async(std::launch::async, [&]() { mFed1->enterExecutingMode(); });
+    mFed2->enterExecutingMode();
+    f1finish.wait();
+
+    for (int ii = 1; ii <= 5; ++ii) {
+        // several messages per step so any reordering while switching routes shows up
+        for (int jj = 1; jj <= 3; ++jj) {
+            mFed1->sendMessage(ep1, "ep2", helics::data_block(10 * ii + jj, 'a'));
+            mFed2->sendMessage(ep2, "ep1", helics::data_block(10 * ii + jj, 'b'));
+        }
+        auto f1time = std::async(std::launch::async, [&]() { return mFed1->requestTime(ii); });
+        auto gtime = mFed2->requestTime(ii);
+        EXPECT_EQ(gtime, static_cast<double>(ii));
+        EXPECT_EQ(f1time.get(), static_cast<double>(ii));
+
+        for (int jj = 1; jj <= 3; ++jj) {
+            auto M1 = ep1.getMessage();
+            ASSERT_TRUE(M1);
+            EXPECT_EQ(M1->data.size(), static_cast<size_t>(10 * ii + jj));
+            EXPECT_EQ(M1->source, "ep2");
+            auto M2 = ep2.getMessage();
+            ASSERT_TRUE(M2);
+            EXPECT_EQ(M2->data.size(), static_cast<size_t>(10 * ii + jj));
+            EXPECT_EQ(M2->source, "ep1");
+        }
+        EXPECT_FALSE(ep1.hasMessage());
+        EXPECT_FALSE(ep2.hasMessage());
+    }
+    EXPECT_EQ(directRouteCount(mFed1), 1);
+    EXPECT_EQ(directRouteCount(mFed2), 1);
+    mFed2->finalize();
+    // the route to the core of the departed federate gets removed
+    int routes = directRouteCount(mFed1);
+    for (int ii = 0; ii < 20 && routes > 0; ++ii) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        routes = directRouteCount(mFed1);
+    }
+    EXPECT_EQ(routes, 0);
+    mFed1->finalize();
+}
+
+TEST_F(mfed_tests, send_receive_2core_auto_route)
+{
+    extraCoreArgs = "--direct_route_threshold=2";
+    SetupTest<helics::MessageFederate>("test_2", 2);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+    auto& ep1 = mFed1->registerGlobalEndpoint("ep1");
+    auto& ep2 = mFed2->registerGlobalEndpoint("ep2");
+
+    mFed1->setProperty(helics_property_time_delta, 1.0);
+    mFed2->setProperty(helics_property_time_delta, 1.0);
+    auto f1finish = std::async(std::launch::async, [&]() { mFed1->enterExecutingMode(); });
+    mFed2->enterExecutingMode();
+    f1finish.wait();
+
+    for (int ii = 1; ii <= 5; ++ii) {
+        for (int jj = 1; jj <= 3; ++jj) {
+            mFed1->sendMessage(ep1, "ep2", helics::data_block(10 * ii + jj, 'a'));
+        }
+        auto f1time = std::async(std::launch::async, [&]() { return mFed1->requestTime(ii); });
+        auto gtime = mFed2->requestTime(ii);
+        EXPECT_EQ(gtime, static_cast<double>(ii));
+        EXPECT_EQ(f1time.get(), static_cast<double>(ii));
+
+        for (int jj = 1; jj <= 3; ++jj) {
+            auto M2 = ep2.getMessage();
+            ASSERT_TRUE(M2);
+            EXPECT_EQ(M2->data.size(), static_cast<size_t>(10 * ii + jj));
+        }
+        EXPECT_FALSE(ep2.hasMessage());
+    }
+    EXPECT_EQ(directRouteCount(mFed1), 1);
+    mFed1->finalizeAsync();
+    mFed2->finalize();
+    mFed1->finalizeComplete();
+}
+
+TEST_F(mfed_tests, send_receive_2core_auto_route_new_endpoint)
+{
+    extraCoreArgs = "--direct_route_threshold=2";
+    SetupTest<helics::MessageFederate>("test_2", 2);
+    auto mFed1 = GetFederateAs<helics::MessageFederate>(0);
+    auto mFed2 = GetFederateAs<helics::MessageFederate>(1);
+    auto& ep1 = mFed1->registerGlobalEndpoint("ep1");
+    auto& ep2 = mFed2->registerGlobalEndpoint("ep2");
+    auto& ep3 = mFed2->registerGlobalEndpoint("ep3");
+
+    mFed1->setProperty(helics_property_time_delta, 1.0);
+    mFed2->setProperty(helics_property_time_delta, 1.0);
+    auto f1finish = std::async(std::launch::async, [&]() { mFed1->enterExecutingMode(); });
+    mFed2->enterExecutingMode();
+    f1finish.wait();
+
+    for (int ii = 1; ii <= 5; ++ii) {
+        mFed1->sendMessage(ep1, "ep2", helics::data_block(10 * ii + 1, 'a'));
+        if (ii >= 3) {
+            // the direct route is in use so the first message to ep3 is sent before its location
+            // is known and must still arrive before the time grant sent on the direct route
+            mFed1->sendMessage(ep1, "ep3", helics::data_block(10 * ii + 2, 'b'));
+        }
+        mFed1->sendMessage(ep1, "ep2", helics::data_block(10 * ii + 3, 'a'));
+        auto f1time = std::async(std::launch::async, [&]() { return mFed1->requestTime(ii); });
+        auto gtime = mFed2->requestTime(ii);
+        EXPECT_EQ(gtime, static_cast<double>(ii));
+        EXPECT_EQ(f1time.get(), static_cast<double>(ii));
+
+        auto M1 = ep2.getMessage();
+        ASSERT_TRUE(M1);
+        EXPECT_EQ(M1->data.size(), static_cast<size_t>(10 * ii + 1));
+        auto M2 = ep2.getMessage();
+        ASSERT_TRUE(M2);
+        EXPECT_EQ(M2->data.size(), static_cast<size_t>(10 * ii + 3));
+        EXPECT_FALSE(ep2.hasMessage());
+        if (ii >= 3) {
+            auto M3 = ep3.getMessage();
+            ASSERT_TRUE(M3);
+            EXPECT_EQ(M3->data.size(), static_cast<size_t>(10 * ii + 2));
+        }
+        EXPECT_FALSE(ep3.hasMessage());
+    }
+    EXPECT_EQ(directRouteCount(mFed1), 1);
+    mFed1->finalizeAsync();
+    mFed2->finalize();
+    mFed1->finalizeComplete();
+}
+
+TEST_F(mfed_tests, send_receive_processing_lanes)
+{
+    extraCoreArgs = "--processing_lanes=3";
+    SetupTest<helics::MessageFederate>("test", 3, 1.0);
+    std::vector<std::shared_ptr<helics::MessageFederate>> mFeds;
+    std::vector<helics::Endpoint*> eps;
+    for (int ii = 0; ii < 3; ++ii) {
+        auto mFed = GetFederateAs<helics::MessageFederate>(ii);
+        eps.push_back(&mFed->registerGlobalEndpoint("ep" + std::to_string(ii)));
+        mFeds.push_back(mFed);
+    }
+    std::vector<std::future<void>> execs;
+    for (auto& mFed : mFeds) {
+        execs.push_back(std::async(std::launch::async, [mFed]() { mFed->enterExecutingMode(); }));
+    }
+    for (auto& exec : execs) {
+        exec.get();
+    }
+
+    for (int step = 1; step <= 5; ++step) {
+        std::vector<std::future<helics::Time>> grants;
+        for (int ii = 0; ii < 3; ++ii) {
+            grants.push_back(std::async(std::launch::async, [&, ii]() {
+                // the messages go through the main loop and the time requests must not pass them
+                for (int jj = 1; jj <= 3; ++jj) {
+                    mFeds[ii]->sendMessage(*eps[ii],
+                                           "ep" + std::to_string((ii + 1) % 3),
+                                           helics::data_block(10 * step + jj, 'a'));
+                }
+                return mFeds[ii]->requestTime(step);
+            }));
+        }
+        for (auto& grant : grants) {
+            EXPECT_EQ(grant.get(), static_cast<double>(step));
+        }
+        for (int ii = 0; ii < 3; ++ii) {
+            for (int jj = 1; jj <= 3; ++jj) {
+                auto M = eps[ii]->getMessage();
+                ASSERT_TRUE(M);
+                EXPECT_EQ(M->data.size(), static_cast<size_t>(10 * step + jj));
+                EXPECT_EQ(M->source, "ep" + std::to_string((ii + 2) % 3));
+            }
+            EXPECT_FALSE(eps[ii]->hasMessage());
+        }
+    }
+    for (auto& mFed : mFeds) {
+        mFed->finalizeAsync();
+    }
+    for (auto& mFed : mFeds) {
+        mFed->finalizeComplete();
+    }
+}
+
 TEST_P(mfed_type_tests, send_receive_2fed_obj)
 {
     using namespace helics;
@@ -210,3 +210,27 @@ TEST(valueConverter_tests, errors)
     EXPECT_LT(vb1.size(), 12u);
     EXPECT_GT(vb1.size(), 8u);
 }
+
+/** check the direct encoders produce the same data as the converters*/
+TEST(valueConverter_tests, direct_vector_encoding)
+{
+    std::vector<double> vals{1.5, -2.25, 3.0e10, 0.0};
+    auto encoded = helics::encodeVector(vals.data(), vals.size());
+    EXPECT_EQ(encoded, helics::ValueConverter<std::vector<double>>::convert(vals).to_string());
+    EXPECT_EQ(helics::ValueConverter<std::vector<double>>::interpret(encoded), vals);
+
+    std::vector<int64_t> ivals{4, -7, 1LL << 40};
+    std::vector<double> asDoubles(ivals.begin(), ivals.end());
+    EXPECT_EQ(helics::encodeVector(ivals.data(), ivals.size()),
+              helics::ValueConverter<std::vector<double>>::convert(asDoubles).to_string());
+    std::vector<int32_t> svals{4, -7, 19};
+    std::vector<double> svalDoubles(svals.begin(), svals.end());
+    EXPECT_EQ(helics::encodeVector(svals.data(), svals.size()),
+              helics::ValueConverter<std::vector<double>>::convert(svalDoubles).to_string());
+
+    std::vector<std::complex<double>> cvals{{1.0, -1.0}, {0.5, 2.5}};
+    auto cencoded = helics::encodeComplexVector(cvals.data(), cvals.size());
+    EXPECT_EQ(cencoded,
+              helics::ValueConverter<std::vector<std::complex<double>>>::convert(cvals).to_string());
+    EXPECT_EQ(helics::ValueConverter<std::vector<std::complex<double>>>::interpret(cencoded), cvals);
+}
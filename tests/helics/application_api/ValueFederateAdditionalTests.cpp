@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/core/CoreFactory.hpp"
 #include "testFixtures.hpp"
 
+#include <atomic>
 #include <future>
 #include <gtest/gtest.h>
 
@@ -1060,6 +1061,95 @@ TEST(valuefederate, update_query)
     Fed1->finalize();
 }
 
+TEST(valuefederate, last_update_query)
+{
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreName = "core_last_upd_query";
+    fi.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    auto& p1 = Fed1->registerGlobalPublication<double>("pub1");
+    auto& p2 = Fed1->registerGlobalPublication<double>("pub2");
+    auto& p3 = Fed1->registerGlobalPublication<double>("pub3");
+
+    Fed1->registerSubscription("pub1");
+    auto& s2 = Fed1->registerSubscription("pub2");
+    Fed1->registerSubscription("pub3");
+    int callbackCount{0};
+    Fed1->setInputNotificationCallback([&callbackCount](helics::Input& /*inp*/,
+                                                         helics::Time /*time*/) {
+        ++callbackCount;
+    });
+
+    Fed1->enterExecutingMode();
+    p1.publish(1.0);
+    p3.publish(3.0);
+    Fed1->requestNextStep();
+    auto upd = Fed1->queryLastUpdates();
+    ASSERT_EQ(upd.size(), 2U);
+    EXPECT_EQ(upd[0], 0);
+    EXPECT_EQ(upd[1], 2);
+    EXPECT_EQ(callbackCount, 2);
+    // retrieving the values doesn't change the list
+    EXPECT_EQ(Fed1->getInput(upd[1]).getValue<double>(), 3.0);
+    EXPECT_EQ(Fed1->queryLastUpdates().size(), 2U);
+
+    p2.publish(2.0);
+    Fed1->requestNextStep();
+    upd = Fed1->queryLastUpdates();
+    ASSERT_EQ(upd.size(), 1U);
+    EXPECT_EQ(upd[0], 1);
+    EXPECT_EQ(s2.getValue<double>(), 2.0);
+    EXPECT_EQ(callbackCount, 3);
+
+    Fed1->requestNextStep();
+    EXPECT_TRUE(Fed1->queryLastUpdates().empty());
+
+    Fed1->finalize();
+}
+
+TEST(valuefederate, parallel_callbacks)
+{
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreName = "core_par_callbacks";
+    fi.coreInitString = "-f 1 --autobroker";
+    fi.setProperty(helics_property_int_callback_threads, 3);
+    fi.setProperty(helics_property_int_callback_ordering, helics_callback_ordering_none);
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    EXPECT_EQ(Fed1->getIntegerProperty(helics_property_int_callback_threads), 3);
+    std::vector<helics::Publication*> pubs;
+    for (int ii = 0; ii < 8; ++ii) {
+        auto& pub = Fed1->registerGlobalPublication<double>("pub" + std::to_string(ii));
+        Fed1->registerSubscription(pub.getKey());
+        pubs.push_back(&pub);
+    }
+    std::atomic<int> callbackCount{0};
+    Fed1->setInputNotificationCallback(
+        [&callbackCount](helics::Input& inp, helics::Time /*time*/) {
+            if (inp.getValue<double>() > 0.0) {
+                ++callbackCount;
+            }
+        });
+
+    Fed1->enterExecutingMode();
+    for (auto* pub : pubs) {
+        pub->publish(2.0);
+    }
+    Fed1->requestNextStep();
+    // all the callbacks are complete before the time request returns
+    EXPECT_EQ(callbackCount.load(), 8);
+    auto metrics = Fed1->query("callbacks");
+    EXPECT_NE(metrics.find("\"parallel_callbacks\" : 8"), std::string::npos);
+
+    Fed1->setProperty(helics_property_int_callback_ordering, helics_callback_ordering_global);
+    pubs[0]->publish(3.0);
+    pubs[1]->publish(3.0);
+    Fed1->requestNextStep();
+    EXPECT_EQ(callbackCount.load(), 10);
+    Fed1->finalize();
+}
+
 TEST(valuefederate, indexed_targets)
 {
     helics::FederateInfo fi(helics::core_type::TEST);
@@ -1135,6 +1225,84 @@ TEST(valuefederate, file_and_config)
     broker->disconnect();
 }
 
+TEST(valuefederate, array_publish)
+{
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreName = "core_array_publish";
+    fi.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    auto& p1 = Fed1->registerGlobalPublication<std::vector<double>>("pub1");
+    auto& p2 = Fed1->registerGlobalPublication<std::vector<std::complex<double>>>("pub2");
+    auto& p3 = Fed1->registerGlobalPublication<double>("pub3");
+    auto& s1 = Fed1->registerSubscription("pub1");
+    auto& s2 = Fed1->registerSubscription("pub2");
+    auto& s3 = Fed1->registerSubscription("pub3");
+    Fed1->enterExecutingMode();
+
+    const double dvals[] = {1.0, 2.5, -3.5};
+    const std::complex<double> cvals[] = {{1.0, 2.0}, {-3.0, 4.0}};
+    p1.publish(dvals, 3);
+    p2.publish(cvals, 2);
+    p3.publish(dvals, 3);
+    Fed1->requestNextStep();
+    EXPECT_EQ(s1.getValue<std::vector<double>>(), std::vector<double>({1.0, 2.5, -3.5}));
+    EXPECT_EQ(s2.getValue<std::vector<std::complex<double>>>(),
+              std::vector<std::complex<double>>({{1.0, 2.0}, {-3.0, 4.0}}));
+    // non vector publications still convert the values
+    EXPECT_EQ(s3.getValue<double>(), 1.0);
+
+    const int64_t ivals[] = {5, -6};
+    const int32_t svals[] = {7, 8, 9};
+    p1.publish(ivals, 2);
+    Fed1->requestNextStep();
+    EXPECT_EQ(s1.getValue<std::vector<double>>(), std::vector<double>({5.0, -6.0}));
+    p1.publish(svals, 3);
+    p3.publish(svals, 3);
+    Fed1->requestNextStep();
+    EXPECT_EQ(s1.getValue<std::vector<double>>(), std::vector<double>({7.0, 8.0, 9.0}));
+    EXPECT_EQ(s3.getValue<double>(), 7.0);
+    Fed1->finalize();
+}
+
+/** load a configuration larger than a single registration batch*/
+TEST(valuefederate, large_config)
+{
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreName = "core_large_config";
+    fi.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fi);
+    constexpr int interfaceCount{5000};
+    std::string config = "{\"defaultglobal\":true,\"publications\":[";
+    for (int ii = 0; ii < interfaceCount; ++ii) {
+        config += "{\"key\":\"pub" + std::to_string(ii) + "\",\"type\":\"double\"},";
+    }
+    // a repeated key updates the existing publication
+    config += "{\"key\":\"pub0\",\"info\":\"repeat\"}],\"subscriptions\":[";
+    for (int ii = 0; ii < interfaceCount; ++ii) {
+        config += "{\"key\":\"pub" + std::to_string(ii) + "\"},";
+    }
+    config.back() = ']';
+    config.push_back('}');
+    Fed1->registerInterfaces(config);
+
+    EXPECT_EQ(Fed1->getPublicationCount(), interfaceCount);
+    EXPECT_EQ(Fed1->getInputCount(), interfaceCount);
+    auto& pub = Fed1->getPublication("pub4500");
+    ASSERT_TRUE(pub.isValid());
+    EXPECT_EQ(pub.getName(), "pub4500");
+    EXPECT_EQ(Fed1->getInfo(Fed1->getPublication(0).getHandle()), "repeat");
+    auto& sub = Fed1->getSubscription("pub4500");
+    ASSERT_TRUE(sub.isValid());
+
+    Fed1->enterExecutingMode();
+    pub.publish(4.5);
+    Fed1->requestNextStep();
+    EXPECT_EQ(sub.getValue<double>(), 4.5);
+    Fed1->finalize();
+}
+
 TEST(valuefederate, duplicate_targets)
 {
     helics::FederateInfo fi(helics::core_type::TEST);
@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/Publications.hpp"
 #include "helics/application_api/Subscriptions.hpp"
 #include "helics/application_api/ValueFederate.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/helics_definitions.hpp"
 #include "helics/helics_enums.h"
 
@@ -347,6 +348,56 @@ TEST_F(valuefed_tests, dual_transfer_coreApp_link)
     EXPECT_TRUE(res);
 }
 
+TEST_F(valuefed_tests, ring_transfer_processing_lanes)
+{
+    extraCoreArgs = "--processing_lanes=2";
+    SetupTest<helics::ValueFederate>("test", 4, 1.0);
+    std::vector<std::shared_ptr<helics::ValueFederate>> vFeds;
+    std::vector<helics::Publication*> pubs;
+    std::vector<helics::Input*> subs;
+    for (int ii = 0; ii < 4; ++ii) {
+        auto vFed = GetFederateAs<helics::ValueFederate>(ii);
+        pubs.push_back(&vFed->registerGlobalPublication<int>("pub" + std::to_string(ii)));
+        // each federate subscribes to the previous one so values cross between the lanes
+        subs.push_back(&vFed->registerSubscription("pub" + std::to_string((ii + 3) % 4)));
+        vFeds.push_back(vFed);
+    }
+    std::vector<std::future<void>> execs;
+    for (auto& vFed : vFeds) {
+        execs.push_back(std::async(std::launch::async, [vFed]() { vFed->enterExecutingMode(); }));
+    }
+    for (auto& exec : execs) {
+        exec.get();
+    }
+
+    for (int step = 1; step <= 10; ++step) {
+        std::vector<std::future<helics::Time>> grants;
+        for (int ii = 0; ii < 4; ++ii) {
+            grants.push_back(std::async(std::launch::async, [&, ii]() {
+                pubs[ii]->publish(step * 10 + ii);
+                return vFeds[ii]->requestTime(step);
+            }));
+        }
+        for (auto& grant : grants) {
+            EXPECT_EQ(grant.get(), static_cast<double>(step));
+        }
+        for (int ii = 0; ii < 4; ++ii) {
+            EXPECT_EQ(subs[ii]->getValue<int>(), step * 10 + (ii + 3) % 4);
+        }
+    }
+    auto res = vFeds[0]->query("core", "processing_lanes");
+    auto val = loadJsonStr(res);
+    EXPECT_EQ(val["lanes"].asInt(), 2);
+    EXPECT_GT(val["direct"].asInt64(), 0);
+
+    for (auto& vFed : vFeds) {
+        vFed->finalizeAsync();
+    }
+    for (auto& vFed : vFeds) {
+        vFed->finalizeComplete();
+    }
+}
+
 TEST_P(valuefed_all_type_tests, dual_transfer_broker_link_late)
 {
     SetupTest<helics::ValueFederate>(GetParam(), 2);
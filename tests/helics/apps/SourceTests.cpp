@@ -191,6 +191,51 @@ TEST(source_tests, sine_source_test)
     fut.get();
 }
 
+TEST(source_tests, bulk_source_test)
+{
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreName = "score-bulk";
+    fi.coreInitString = "-f 2 --autobroker";
+    helics::apps::Source src1("source1", fi);
+
+    auto index = src1.addBulkSignalGenerator("ramps", "ramp", 3);
+    auto gen = src1.getBulkGenerator(index);
+    ASSERT_TRUE(gen);
+    gen->setChannels("level", {1.0, 2.0, 3.0});
+    gen->set("ramp", 0.5);
+    src1.addBulkPublication("bulk1", "ramps", 3, 1.0);
+    src1.setStartTime("bulk1", 1.0);
+    src1.addBulkPublication("bulk2", "ramps", 3, 1.0, false);
+    src1.setStartTime("bulk2", 1.0);
+
+    helics::ValueFederate vfed("block1", fi);
+    auto& sub1 = vfed.registerSubscription("bulk1");
+    auto& sub2 = vfed.registerSubscription("bulk2_2");
+    auto fut = std::async(std::launch::async, [&src1]() {
+        src1.runTo(5);
+        src1.finalize();
+    });
+    vfed.enterExecutingMode();
+    auto retTime = vfed.requestTime(5);
+    EXPECT_EQ(retTime, 1.0);
+    auto vals = sub1.getValue<std::vector<double>>();
+    ASSERT_EQ(vals.size(), 3U);
+    EXPECT_DOUBLE_EQ(vals[0], 1.5);
+    EXPECT_DOUBLE_EQ(vals[1], 2.5);
+    EXPECT_DOUBLE_EQ(vals[2], 3.5);
+    EXPECT_DOUBLE_EQ(sub2.getValue<double>(), 3.5);
+
+    retTime = vfed.requestTime(5);
+    EXPECT_EQ(retTime, 2.0);
+    vals = sub1.getValue<std::vector<double>>();
+    ASSERT_EQ(vals.size(), 3U);
+    EXPECT_DOUBLE_EQ(vals[0], 2.0);
+    EXPECT_DOUBLE_EQ(vals[2], 4.0);
+    EXPECT_DOUBLE_EQ(sub2.getValue<double>(), 4.0);
+    vfed.finalize();
+    fut.get();
+}
+
 TEST(source_tests, simple_source_test_file)
 {
     helics::FederateInfo fi(helics::core_type::TEST);
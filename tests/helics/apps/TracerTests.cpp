@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/libguarded/guarded.hpp"
 #include "gmlc/utilities/stringOps.h"
 #include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueConverter.hpp"
 #include "helics/apps/BrokerApp.hpp"
 #include "helics/apps/Tracer.hpp"
 
@@ -134,6 +135,56 @@ TEST(tracer_tests, tracer_test_message)
     fut.get();
 }
 
+TEST(tracer_tests, tracer_batch_values)
+{
+    gmlc::libguarded::guarded<std::vector<helics::apps::TracedValue>> values;
+    std::atomic<int> batchCount{0};
+    helics::FederateInfo fi(helics::core_type::TEST);
+    fi.coreName = "tcore-tracer-batch";
+    fi.coreInitString = "-f 2 --autobroker";
+    helics::apps::Tracer trace1("trace1", fi);
+
+    trace1.addSubscription("pub1");
+    trace1.addSubscription("pub2");
+    trace1.setBatchValueCallback(
+        [&values, &batchCount](const std::vector<helics::apps::TracedValue>& batch) {
+            auto vals = values.lock();
+            vals->insert(vals->end(), batch.begin(), batch.end());
+            ++batchCount;
+        });
+    helics::ValueFederate vfed("block1", fi);
+    helics::Publication pub1(helics::GLOBAL, &vfed, "pub1", helics::data_type::helics_double);
+    helics::Publication pub2(helics::GLOBAL, &vfed, "pub2", helics::data_type::helics_double);
+    auto fut = std::async(std::launch::async, [&trace1]() { trace1.runTo(4); });
+    vfed.enterExecutingMode();
+    auto retTime = vfed.requestTime(1);
+    EXPECT_EQ(retTime, 1.0);
+    pub1.publish(3.4);
+    pub2.publish(5.6);
+
+    retTime = vfed.requestTime(2.0);
+    EXPECT_EQ(retTime, 2.0);
+    pub2.publish(4.7);
+
+    retTime = vfed.requestTime(5);
+    EXPECT_EQ(retTime, 5.0);
+    vfed.finalize();
+    fut.get();
+    trace1.finalize();
+
+    auto vals = values.lock();
+    ASSERT_EQ(vals->size(), 3U);
+    EXPECT_EQ(batchCount.load(), 2);
+    EXPECT_EQ((*vals)[0].time, 1.0);
+    EXPECT_EQ(trace1.getSubscriptionTarget((*vals)[0].index), "pub1");
+    EXPECT_DOUBLE_EQ(helics::ValueConverter<double>::interpret((*vals)[0].value), 3.4);
+    EXPECT_EQ(trace1.getSubscriptionTarget((*vals)[1].index), "pub2");
+    EXPECT_DOUBLE_EQ(helics::ValueConverter<double>::interpret((*vals)[1].value), 5.6);
+    EXPECT_EQ((*vals)[2].time, 2.0);
+    EXPECT_EQ((*vals)[2].index, (*vals)[1].index);
+    EXPECT_DOUBLE_EQ(helics::ValueConverter<double>::interpret((*vals)[2].value), 4.7);
+}
+
 static constexpr const char* simple_files[] = {"example1.recorder",
                                                "example2.record",
                                                "example3rec.json",
@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/common/LzCompression.hpp"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace helics;
+
+TEST(lz_compression_tests, repeated_data)
+{
+    std::string data(100000, 'a');
+    auto compressed = lzCompress(data.data(), data.size());
+    ASSERT_FALSE(compressed.empty());
+    EXPECT_LT(compressed.size(), 1000U);
+    std::string result;
+    EXPECT_TRUE(lzDecompress(compressed.data(), compressed.size(), result));
+    EXPECT_EQ(result, data);
+}
+
+TEST(lz_compression_tests, vector_data)
+{
+    std::vector<double> values(5000);
+    for (std::size_t ii = 0; ii < values.size(); ++ii) {
+        values[ii] = static_cast<double>(ii % 100) * 0.25;
+    }
+    std::string data(values.size() * sizeof(double), '\0');
+    std::memcpy(&data[0], values.data(), data.size());
+    auto compressed = lzCompress(data.data(), data.size());
+    ASSERT_FALSE(compressed.empty());
+    EXPECT_LT(compressed.size(), data.size() / 4);
+    std::string result;
+    EXPECT_TRUE(lzDecompress(compressed.data(), compressed.size(), result));
+    EXPECT_EQ(result, data);
+}
+
+TEST(lz_compression_tests, random_data)
+{
+    std::mt19937 gen(354);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::string data(10000, '\0');
+    for (auto& dv : data) {
+        dv = static_cast<char>(dist(gen));
+    }
+    // random data is not compressible so nothing is returned
+    EXPECT_TRUE(lzCompress(data.data(), data.size()).empty());
+    EXPECT_TRUE(lzCompress(data.data(), 6).empty());
+}
+
+TEST(lz_compression_tests, mixed_data)
+{
+    std::mt19937 gen(9876);
+    std::uniform_int_distribution<int> dist(0, 3);
+    for (std::size_t size : {13U, 64U, 257U, 4096U, 65536U, 100000U}) {
+        std::string data(size, '\0');
+        for (auto& dv : data) {
+            dv = static_cast<char>('a' + dist(gen));
+        }
+        auto compressed = lzCompress(data.data(), data.size());
+        if (compressed.empty()) {
+            continue;
+        }
+        EXPECT_LT(compressed.size(), data.size());
+        std::string result;
+        EXPECT_TRUE(lzDecompress(compressed.data(), compressed.size(), result));
+        EXPECT_EQ(result, data);
+    }
+}
+
+TEST(lz_compression_tests, invalid_blocks)
+{
+    std::string data(5000, 'b');
+    data.replace(1000, 10, "0123456789");
+    auto compressed = lzCompress(data.data(), data.size());
+    ASSERT_FALSE(compressed.empty());
+    std::string result;
+    EXPECT_FALSE(lzDecompress(compressed.data(), 3, result));
+    EXPECT_FALSE(lzDecompress(compressed.data(), compressed.size() - 1, result));
+
+    auto badSize = compressed;
+    badSize[2] = static_cast<char>(badSize[2] + 1);
+    EXPECT_FALSE(lzDecompress(badSize.data(), badSize.size(), result));
+
+    std::mt19937 gen(25);
+    std::uniform_int_distribution<std::size_t> loc(0, compressed.size() - 1);
+    for (int ii = 0; ii < 200; ++ii) {
+        // corrupted blocks must be rejected or decoded without reading out of bounds
+        auto corrupted = compressed;
+        corrupted[loc(gen)] ^= static_cast<char>(0x5A);
+        lzDecompress(corrupted.data(), corrupted.size(), result);
+    }
+}
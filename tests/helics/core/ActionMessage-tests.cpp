@@ -407,3 +407,57 @@ TEST(ActionMessage_tests, check_packetization)
     EXPECT_EQ(cmd.flags, cmd2.flags);
     EXPECT_TRUE(cmd.getStringData() == cmd2.getStringData());
 }
+
+TEST(ActionMessage_tests, package_multi_messages)
+{
+    std::vector<helics::ActionMessage> commands;
+    for (int ii = 0; ii < 600; ++ii) {
+        helics::ActionMessage cmd(helics::CMD_REG_PUB);
+        cmd.source_handle = interface_handle(ii);
+        cmd.name = "publication_" + std::to_string(ii);
+        commands.push_back(cmd);
+    }
+    auto packages = packageMultiMessages(std::move(commands), 1 << 20);
+    // limited to 255 commands per package
+    ASSERT_EQ(packages.size(), 3U);
+    int index{0};
+    for (auto& package : packages) {
+        EXPECT_TRUE(package.action() == helics::CMD_MULTI_MESSAGE);
+        for (int ii = 0; ii < package.counter; ++ii) {
+            helics::ActionMessage cmd(package.getString(ii));
+            EXPECT_TRUE(cmd.action() == helics::CMD_REG_PUB);
+            EXPECT_EQ(cmd.source_handle.baseValue(), index);
+            EXPECT_EQ(cmd.name, "publication_" + std::to_string(index));
+            ++index;
+        }
+    }
+    EXPECT_EQ(index, 600);
+}
+
+TEST(ActionMessage_tests, package_multi_messages_size_limit)
+{
+    std::vector<helics::ActionMessage> commands;
+    for (int ii = 0; ii < 10; ++ii) {
+        helics::ActionMessage cmd(helics::CMD_REG_INPUT);
+        cmd.name = std::string(300, static_cast<char>('a' + ii));
+        commands.push_back(cmd);
+    }
+    helics::ActionMessage large(helics::CMD_REG_ENDPOINT);
+    large.name = std::string(5000, 'e');
+    commands.push_back(large);
+
+    auto packages = packageMultiMessages(std::move(commands), 1000);
+    ASSERT_GE(packages.size(), 4U);
+    for (size_t ii = 0; ii + 1 < packages.size(); ++ii) {
+        EXPECT_LE(packages[ii].serializedByteCount(), 1000);
+    }
+    // a command larger than the limit is passed through by itself
+    EXPECT_TRUE(packages.back().action() == helics::CMD_REG_ENDPOINT);
+    EXPECT_EQ(packages.back().name, large.name);
+
+    std::vector<helics::ActionMessage> single;
+    single.push_back(large);
+    packages = packageMultiMessages(std::move(single), 1000);
+    ASSERT_EQ(packages.size(), 1U);
+    EXPECT_TRUE(packages.front().action() == helics::CMD_REG_ENDPOINT);
+}
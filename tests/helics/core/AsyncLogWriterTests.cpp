@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/core/AsyncLogWriter.hpp"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace helics;
+
+TEST(asyncLogWriter_tests, write_order)
+{
+    std::vector<std::string> messages;
+    {
+        AsyncLogWriter writer(64, [&messages](std::vector<AsyncLogWriter::LogEntry>& entries) {
+            for (auto& entry : entries) {
+                messages.push_back(entry.message);
+            }
+        });
+        EXPECT_EQ(writer.capacity(), 64U);
+        for (int ii = 0; ii < 20; ++ii) {
+            EXPECT_TRUE(writer.push({2, 0, false, "test", std::to_string(ii)}));
+        }
+        writer.flush();
+        ASSERT_EQ(messages.size(), 20U);
+        for (int ii = 0; ii < 20; ++ii) {
+            EXPECT_EQ(messages[ii], std::to_string(ii));
+        }
+        EXPECT_EQ(writer.droppedCount(), 0U);
+    }
+}
+
+TEST(asyncLogWriter_tests, drain_on_destruction)
+{
+    std::atomic<int> count{0};
+    {
+        AsyncLogWriter writer(256, [&count](std::vector<AsyncLogWriter::LogEntry>& entries) {
+            count += static_cast<int>(entries.size());
+        });
+        for (int ii = 0; ii < 100; ++ii) {
+            writer.push({2, 0, false, "test", "message"});
+        }
+    }
+    EXPECT_EQ(count.load(), 100);
+}
+
+TEST(asyncLogWriter_tests, drop_when_full)
+{
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> count{0};
+    std::atomic<int> reports{0};
+    AsyncLogWriter writer(8, [&](std::vector<AsyncLogWriter::LogEntry>& entries) {
+        // hold up the writer so the queue fills
+        released.wait();
+        for (auto& entry : entries) {
+            if (entry.name == "logging") {
+                ++reports;
+            } else {
+                ++count;
+            }
+        }
+    });
+    int accepted{0};
+    for (int ii = 0; ii < 50; ++ii) {
+        if (writer.push({2, 0, false, "test", "message"})) {
+            ++accepted;
+        }
+    }
+    EXPECT_LT(accepted, 50);
+    EXPECT_EQ(writer.droppedCount(), static_cast<uint64_t>(50 - accepted));
+    release.set_value();
+    writer.flush();
+    EXPECT_EQ(count.load(), accepted);
+    // the drop count gets reported through the writer
+    int ii{0};
+    while (reports.load() == 0 && ii < 100) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ++ii;
+    }
+    EXPECT_GE(reports.load(), 1);
+}
+
+TEST(asyncLogWriter_tests, multiple_producers)
+{
+    std::atomic<int> count{0};
+    AsyncLogWriter writer(1024, [&count](std::vector<AsyncLogWriter::LogEntry>& entries) {
+        for (auto& entry : entries) {
+            if (entry.name != "logging") {
+                ++count;
+            }
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int ii = 0; ii < 4; ++ii) {
+        producers.emplace_back([&writer]() {
+            for (int jj = 0; jj < 2000; ++jj) {
+                writer.push({2, 0, false, "test", "message"});
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    writer.flush();
+    EXPECT_EQ(static_cast<uint64_t>(count.load()) + writer.droppedCount(), 8000U);
+}
+
+TEST(asyncLogWriter_tests, execute)
+{
+    std::atomic<int> count{0};
+    std::atomic<bool> writing{false};
+    AsyncLogWriter writer(64, [&count, &writing](std::vector<AsyncLogWriter::LogEntry>& entries) {
+        writing = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        count += static_cast<int>(entries.size());
+        writing = false;
+    });
+    for (int ii = 0; ii < 20; ++ii) {
+        writer.push({2, 0, false, "test", "message"});
+    }
+    int countAtTask{-1};
+    bool writingAtTask{true};
+    writer.execute([&]() {
+        countAtTask = count.load();
+        writingAtTask = writing.load();
+    });
+    EXPECT_EQ(countAtTask, 20);
+    EXPECT_FALSE(writingAtTask);
+}
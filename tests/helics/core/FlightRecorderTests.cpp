@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/FlightRecorder.hpp"
+#include "helics/core/core-exceptions.hpp"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace helics;
+
+TEST(flightRecorder_tests, capacity)
+{
+    FlightRecorder rec1(100);
+    EXPECT_EQ(rec1.capacity(), 127U);
+    FlightRecorder rec2(63);
+    EXPECT_EQ(rec2.capacity(), 63U);
+    EXPECT_EQ(rec2.totalRecorded(), 0U);
+    EXPECT_TRUE(rec2.snapshot().empty());
+}
+
+TEST(flightRecorder_tests, record)
+{
+    FlightRecorder recorder(16);
+    ActionMessage cmd(CMD_PUB);
+    cmd.source_id = global_federate_id(131072);
+    cmd.source_handle = interface_handle(4);
+    cmd.dest_id = global_federate_id(131073);
+    cmd.dest_handle = interface_handle(7);
+    cmd.actionTime = 1.5;
+    cmd.payload = "test payload";
+    cmd.counter = 3;
+    auto index = recorder.record(cmd);
+    recorder.finishRecord(index);
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 1U);
+    const auto& rec = records[0];
+    EXPECT_EQ(rec.action, static_cast<int32_t>(CMD_PUB));
+    EXPECT_EQ(rec.sourceId, 131072);
+    EXPECT_EQ(rec.sourceHandle, 4);
+    EXPECT_EQ(rec.destId, 131073);
+    EXPECT_EQ(rec.destHandle, 7);
+    EXPECT_EQ(rec.actionTime, cmd.actionTime.getBaseTimeCode());
+    EXPECT_EQ(rec.payloadSize, 12U);
+    EXPECT_EQ(rec.counter, 3);
+}
+
+TEST(flightRecorder_tests, wraparound)
+{
+    FlightRecorder recorder(15);
+    ActionMessage cmd(CMD_TIME_REQUEST);
+    for (int ii = 0; ii < 40; ++ii) {
+        cmd.messageID = ii;
+        recorder.record(cmd);
+    }
+    EXPECT_EQ(recorder.totalRecorded(), 40U);
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 15U);
+    for (int ii = 0; ii < 15; ++ii) {
+        EXPECT_EQ(records[ii].messageID, 25 + ii);
+    }
+}
+
+TEST(flightRecorder_tests, file_round_trip)
+{
+    FlightRecorder recorder(7);
+    ActionMessage cmd(CMD_SEND_MESSAGE);
+    for (int ii = 0; ii < 12; ++ii) {
+        cmd.messageID = ii;
+        recorder.finishRecord(recorder.record(cmd));
+    }
+    const std::string fileName{"flight_round_trip.hfr"};
+    EXPECT_EQ(recorder.writeFile(fileName, "core1"), 7U);
+    auto contents = FlightRecorder::readFile(fileName);
+    EXPECT_EQ(contents.name, "core1");
+    EXPECT_EQ(contents.totalRecorded, 12U);
+    ASSERT_EQ(contents.records.size(), 7U);
+    EXPECT_EQ(contents.records.front().messageID, 5);
+    EXPECT_EQ(contents.records.back().messageID, 11);
+    EXPECT_EQ(contents.records.back().action, static_cast<int32_t>(CMD_SEND_MESSAGE));
+    std::remove(fileName.c_str());
+}
+
+TEST(flightRecorder_tests, bad_file)
+{
+    const std::string fileName{"flight_bad.hfr"};
+    {
+        std::ofstream out(fileName);
+        out << "this is not a flight recorder file";
+    }
+    EXPECT_THROW(FlightRecorder::readFile(fileName), InvalidParameter);
+    std::remove(fileName.c_str());
+    EXPECT_THROW(FlightRecorder::readFile("nonexistent_flight.hfr"), InvalidParameter);
+}
+
+TEST(flightRecorder_tests, bad_record_count)
+{
+    FlightRecorder recorder(7);
+    ActionMessage cmd(CMD_SEND_MESSAGE);
+    recorder.finishRecord(recorder.record(cmd));
+    const std::string fileName{"flight_bad_count.hfr"};
+    EXPECT_EQ(recorder.writeFile(fileName, "core1"), 1U);
+    {
+        // overwrite the record count in the header with a huge value
+        std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+        const uint64_t count{0x0FFFFFFFFFFFFFFFULL};
+        file.seekp(40);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_THROW(FlightRecorder::readFile(fileName), InvalidParameter);
+    std::remove(fileName.c_str());
+}
+
+TEST(flightRecorder_tests, concurrent_snapshot)
+{
+    FlightRecorder recorder(31);
+    std::atomic<bool> done{false};
+    std::thread writer([&recorder, &done]() {
+        ActionMessage cmd(CMD_TIME_REQUEST);
+        for (int ii = 0; ii < 200000; ++ii) {
+            cmd.messageID = ii;
+            cmd.source_handle = interface_handle(ii);
+            cmd.dest_handle = interface_handle(ii);
+            recorder.finishRecord(recorder.record(cmd));
+        }
+        done = true;
+    });
+    while (!done) {
+        auto records = recorder.snapshot();
+        for (std::size_t ii = 0; ii < records.size(); ++ii) {
+            // every record must be complete and the records must be in sequence
+            ASSERT_EQ(records[ii].sourceHandle, records[ii].messageID);
+            ASSERT_EQ(records[ii].destHandle, records[ii].messageID);
+            if (ii > 0) {
+                ASSERT_EQ(records[ii].messageID, records[ii - 1].messageID + 1);
+            }
+        }
+    }
+    writer.join();
+}
@@ -164,8 +164,12 @@ TEST(InfoClass_tests, endpointinfo_test)
     EXPECT_EQ(endPI.queueSize(maxT), 3);
     EXPECT_EQ(endPI.firstMessageTime(), minT);
 
+    // the source endpoint handles of the messages from aFed and bFed
+    helics::global_handle aSource{helics::global_federate_id(1), helics::interface_handle(2)};
+    helics::global_handle bSource{helics::global_federate_id(2), helics::interface_handle(1)};
+
     // Add a message at a time somewhere in between the others
-    endPI.addMessage(std::move(msg_time_one_b));
+    endPI.addMessage(std::move(msg_time_one_b), bSource);
     EXPECT_EQ(endPI.queueSize(minT), 1);
     EXPECT_EQ(endPI.queueSize(zeroT), 2);
     EXPECT_EQ(endPI.queueSize(1), 3);
@@ -190,8 +194,8 @@ TEST(InfoClass_tests, endpointinfo_test)
     EXPECT_EQ(endPI.firstMessageTime(), helics::Time(1));
     EXPECT_EQ(endPI.queueSize(1), 1);
 
-    // Insert another message at time 1 (aFed) to test ordering by original source name
-    endPI.addMessage(std::move(msg_time_one_a));
+    // Insert another message at time 1 (aFed) to test ordering by source handle
+    endPI.addMessage(std::move(msg_time_one_a), aSource);
     EXPECT_EQ(endPI.firstMessageTime(), helics::Time(1));
     EXPECT_EQ(endPI.queueSize(1), 2);
     msg = endPI.getMessage(1);
@@ -213,9 +217,9 @@ TEST(InfoClass_tests, endpointinfo_test)
     msg_time_one_b->original_source = "bFed";
     msg_time_one_b->time = helics::Time(1);
 
-    // Perform the same source name federate test, but reverse order of add messages
-    endPI.addMessage(std::move(msg_time_one_a));
-    endPI.addMessage(std::move(msg_time_one_b));
+    // Perform the same source handle test, but reverse order of add messages
+    endPI.addMessage(std::move(msg_time_one_a), aSource);
+    endPI.addMessage(std::move(msg_time_one_b), bSource);
     EXPECT_EQ(endPI.queueSize(1), 2);
     msg = endPI.getMessage(1);
     EXPECT_EQ(msg->data.to_string(), "oneAT");
@@ -5,6 +5,7 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 #include "gmlc/libguarded/atomic_guarded.hpp"
+#include "helics/common/AsioContextManager.h"
 #include "helics/core/MessageTimer.hpp"
 
 #include "gtest/gtest.h"
@@ -65,6 +66,21 @@ TEST(messageTimer_tests, shorttime_test)
     }
 }
 
+TEST(messageTimer_tests, expired_timer_sends_once)
+{
+    std::atomic<int> count{0};
+    auto cback = [&](ActionMessage&& /*m*/) { ++count; };
+    auto mtimer = std::make_shared<MessageTimer>(cback);
+    auto index = mtimer->addTimerFromNow(-5ms, CMD_PROTOCOL);
+    EXPECT_EQ(count.load(), 1);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(count.load(), 1);
+    // a timer that was sent immediately can still be rearmed
+    mtimer->updateTimer(index, std::chrono::steady_clock::now() + 5ms, CMD_PROTOCOL);
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(count.load(), 2);
+}
+
 TEST(messageTimer_tests_ci_skip, basic_test_update)
 {
     std::mutex mlock;
@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/TimeCoordinator.hpp"
+#include "helics/core/helics_definitions.hpp"
 
 #include "gtest/gtest.h"
 
@@ -138,3 +139,63 @@ TEST(timeCoord_tests, dependent_test_message)
     EXPECT_EQ(deps.size(), 1U);
     EXPECT_TRUE(deps[0] == fed3);
 }
+
+/** take a coordinator with a single dependency through the entry to executing mode*/
+static void enterExecWithDependency(TimeCoordinator& ftc, Time dependencyLookahead)
+{
+    ftc.source_id = fed3;
+    ftc.addDependency(fed2);
+    ftc.enteringExecMode(iteration_request::no_iterations);
+
+    ActionMessage execReq(CMD_EXEC_REQUEST);
+    execReq.source_id = fed2;
+    execReq.actionTime = dependencyLookahead;
+    ftc.processTimeMessage(execReq);
+    EXPECT_EQ(ftc.checkExecEntry(), message_processing_result::next_step);
+
+    ActionMessage execGrant(CMD_EXEC_GRANT);
+    execGrant.source_id = fed2;
+    ftc.processTimeMessage(execGrant);
+}
+
+TEST(timeCoord_tests, dependency_lookahead)
+{
+    TimeCoordinator ftc;
+    enterExecWithDependency(ftc, 0.5);
+    // the dependency promised nothing before 0.5 so a request before that doesn't need to wait
+    ftc.timeRequest(0.3, iteration_request::no_iterations, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), message_processing_result::next_step);
+    EXPECT_EQ(ftc.getGrantedTime(), 0.3);
+
+    // while the dependency works on time 1.0 it can't send anything before 1.5
+    ActionMessage grant(CMD_TIME_GRANT);
+    grant.source_id = fed2;
+    grant.actionTime = 1.0;
+    ftc.processTimeMessage(grant);
+    ftc.timeRequest(1.4, iteration_request::no_iterations, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), message_processing_result::next_step);
+    EXPECT_EQ(ftc.getGrantedTime(), 1.4);
+
+    ftc.timeRequest(1.6, iteration_request::no_iterations, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), message_processing_result::continue_processing);
+}
+
+TEST(timeCoord_tests, dependency_no_lookahead)
+{
+    TimeCoordinator ftc;
+    enterExecWithDependency(ftc, timeZero);
+    ftc.timeRequest(0.3, iteration_request::no_iterations, Time::maxVal(), Time::maxVal());
+    EXPECT_EQ(ftc.checkTimeGrant(), message_processing_result::continue_processing);
+}
+
+TEST(timeCoord_tests, lookahead_promise)
+{
+    TimeCoordinator ftc;
+    ftc.setProperty(helics_property_time_output_delay, Time(0.5));
+    ftc.enteringExecMode(iteration_request::no_iterations);
+    // the lookahead sent to the dependents can't be reduced afterwards
+    ftc.setProperty(helics_property_time_output_delay, Time(0.1));
+    EXPECT_EQ(ftc.getTimeProperty(helics_property_time_output_delay), 0.5);
+    ftc.setProperty(helics_property_time_output_delay, Time(0.7));
+    EXPECT_EQ(ftc.getTimeProperty(helics_property_time_output_delay), 0.7);
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2017-2020,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/core/TimerWheel.hpp"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+
+using namespace helics;
+using namespace std::literals::chrono_literals;
+
+TEST(timerWheel_tests, basic_fire)
+{
+    TimerWheel wheel;
+    std::atomic<int> count{0};
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<int64_t> delay{0};
+    wheel.addTimer(start + 50ms, [&]() {
+        delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+        ++count;
+    });
+    EXPECT_EQ(wheel.activeTimers(), 1);
+    int ii = 0;
+    while (count.load() == 0 && ii < 100) {
+        std::this_thread::sleep_for(20ms);
+        ++ii;
+    }
+    EXPECT_EQ(count.load(), 1);
+    EXPECT_GE(delay.load(), 50);
+    EXPECT_EQ(wheel.activeTimers(), 0);
+}
+
+TEST(timerWheel_tests, cancel_update)
+{
+    TimerWheel wheel;
+    std::atomic<int> count1{0};
+    std::atomic<int> count2{0};
+    auto start = std::chrono::steady_clock::now();
+    auto t1 = wheel.addTimer(start + 100ms, [&]() { ++count1; });
+    auto t2 = wheel.addTimer(start + 20ms, [&]() { ++count2; });
+    wheel.cancelTimer(t1);
+    EXPECT_FALSE(wheel.isActive(t1));
+    EXPECT_TRUE(wheel.updateTimer(t2, start + 80ms));
+    std::this_thread::sleep_for(40ms);
+    EXPECT_EQ(count2.load(), 0);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(count1.load(), 0);
+    EXPECT_EQ(count2.load(), 1);
+    // rearm the canceled timer
+    EXPECT_TRUE(wheel.updateTimer(t1, std::chrono::steady_clock::now() + 10ms));
+    std::this_thread::sleep_for(150ms);
+    EXPECT_EQ(count1.load(), 1);
+}
+
+TEST(timerWheel_tests, release_reuse)
+{
+    TimerWheel wheel;
+    auto t1 = wheel.addTimer(std::chrono::steady_clock::now() + 10s, []() {});
+    wheel.releaseTimer(t1);
+    EXPECT_FALSE(wheel.updateTimer(t1, std::chrono::steady_clock::now()));
+    auto t2 = wheel.addTimer(std::chrono::steady_clock::now() + 10s, []() {});
+    EXPECT_EQ(t1, t2);
+    wheel.releaseTimer(t2);
+    EXPECT_EQ(wheel.activeTimers(), 0);
+}
+
+TEST(timerWheel_tests, many_timers)
+{
+    TimerWheel wheel;
+    std::atomic<int> count{0};
+    std::atomic<int> early{0};
+    auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < 1000; ++ii) {
+        auto expiration = start + std::chrono::milliseconds(ii % 600);
+        wheel.addTimer(expiration, [&, expiration]() {
+            if (std::chrono::steady_clock::now() < expiration) {
+                ++early;
+            }
+            ++count;
+        });
+    }
+    int ii = 0;
+    while (count.load() < 1000 && ii < 200) {
+        std::this_thread::sleep_for(20ms);
+        ++ii;
+    }
+    EXPECT_EQ(count.load(), 1000);
+    EXPECT_EQ(early.load(), 0);
+}
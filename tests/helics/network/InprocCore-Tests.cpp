@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/core/inproc/InprocCore.h"
 
 #include "gtest/gtest.h"
+#include <future>
 
 using helics::Core;
 using namespace helics::CoreFactory;
@@ -185,6 +186,55 @@ TEST(InprocCore_tests, send_receive_test)
     helics::CoreFactory::cleanUpCores();
 }
 
+TEST(InprocCore_tests, direct_dispatch_test)
+{
+    auto broker = helics::BrokerFactory::create(helics::core_type::INPROC,
+                                                "brkdirect",
+                                                "-f 2 --direct_dispatch");
+    ASSERT_TRUE(broker);
+    std::string configureString =
+        std::string("-f 1 --direct_dispatch --broker=") + broker->getIdentifier();
+    auto core1 = create(helics::core_type::INPROC, configureString);
+    auto core2 = create(helics::core_type::INPROC, configureString);
+    core1->connect();
+    core2->connect();
+    ASSERT_TRUE(core1->isConnected());
+    ASSERT_TRUE(core2->isConnected());
+
+    auto id1 = core1->registerFederate("sim1", helics::CoreFederateInfo());
+    auto id2 = core2->registerFederate("sim2", helics::CoreFederateInfo());
+    auto end1 = core1->registerEndpoint(id1, "end1", "type");
+    auto end2 = core2->registerEndpoint(id2, "end2", "type");
+
+    auto f2 = std::async(std::launch::async, [&]() {
+        core2->enterInitializingMode(id2);
+        core2->enterExecutingMode(id2);
+    });
+    core1->enterInitializingMode(id1);
+    core1->enterExecutingMode(id1);
+    f2.get();
+
+    std::string str1 = "hello world";
+    core1->send(end1, "end2", str1.data(), str1.size());
+    auto f3 = std::async(std::launch::async, [&]() { return core2->timeRequest(id2, 1.0); });
+    core1->timeRequest(id1, 1.0);
+    f3.get();
+    ASSERT_EQ(core2->receiveCount(end2), 1);
+    auto msg = core2->receive(end2);
+    ASSERT_TRUE(msg);
+    EXPECT_EQ(msg->data.to_string(), str1);
+
+    core1->finalize(id1);
+    core2->finalize(id2);
+    core1->disconnect();
+    core2->disconnect();
+    broker->disconnect();
+    core1 = nullptr;
+    core2 = nullptr;
+    broker = nullptr;
+    helics::CoreFactory::cleanUpCores();
+}
+
 TEST(InprocCore_tests, messagefilter_callback_test)
 {
     // Create filter operator
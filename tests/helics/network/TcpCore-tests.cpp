@@ -6,11 +6,13 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/common/AsioContextManager.h"
 #include "helics/common/GuardedTypes.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/Core.hpp"
 #include "helics/core/CoreFactory.hpp"
 #include "helics/core/core-types.hpp"
+#include "helics/core/flagOperations.hpp"
 #include "helics/network/networkDefaults.hpp"
 #include "helics/network/tcp/TcpBroker.h"
 #include "helics/network/tcp/TcpComms.h"
@@ -419,6 +421,118 @@ TEST(TcpCore, tcpComm_transmit_add_route)
     std::this_thread::sleep_for(100ms);
 }
 
+TEST(TcpCore, tcpComm_transmit_compressed)
+{
+    std::this_thread::sleep_for(300ms);
+    std::atomic<int> counter{0};
+    std::atomic<int> counter2{0};
+    std::atomic<int> counter3{0};
+
+    std::string host = "localhost";
+    helics::tcp::TcpComms comm;
+    helics::tcp::TcpComms comm2;
+    helics::tcp::TcpComms comm3;
+
+    comm.loadTargetInfo(host, host);
+    comm2.loadTargetInfo(host, std::string());
+    comm3.loadTargetInfo(host, host);
+    auto srv = AsioContextManager::getContextPointer();
+    auto contextLoop = srv->startContextLoop();
+
+    comm.setBrokerPort(DEFAULT_TCP_BROKER_PORT_NUMBER + 3);
+    comm.setFlag("reuse_address", true);
+    comm.setFlag("compression", true);
+    comm.setName("tests");
+    comm2.setName("broker");
+    comm2.setFlag("reuse_address", true);
+    comm2.setFlag("compression", true);
+    // comm3 does not agree to compression so nothing sent to it is compressed
+    comm3.setName("test3");
+    comm3.setBrokerPort(DEFAULT_TCP_BROKER_PORT_NUMBER + 3);
+    comm3.setFlag("reuse_address", true);
+    comm2.setPortNumber(DEFAULT_TCP_BROKER_PORT_NUMBER + 3);
+    comm.setPortNumber(TCP_SECONDARY_PORT);
+    comm3.setPortNumber(23920);
+
+    guarded<helics::ActionMessage> act;
+    guarded<helics::ActionMessage> act2;
+    guarded<helics::ActionMessage> act3;
+
+    comm.setCallback([&counter, &act](helics::ActionMessage&& m) {
+        ++counter;
+        act = std::move(m);
+    });
+    comm2.setCallback([&counter2, &act2](helics::ActionMessage&& m) {
+        ++counter2;
+        act2 = std::move(m);
+    });
+    comm3.setCallback([&counter3, &act3](helics::ActionMessage&& m) {
+        ++counter3;
+        act3 = std::move(m);
+    });
+
+    ASSERT_TRUE(comm2.connect());
+    ASSERT_TRUE(comm.connect());
+    ASSERT_TRUE(comm3.connect());
+
+    std::string payload;
+    for (int ii = 0; ii < 5000; ++ii) {
+        payload.append(std::to_string(ii % 50));
+        payload.push_back(';');
+    }
+    helics::ActionMessage data(helics::CMD_SEND_MESSAGE);
+    data.payload = payload;
+
+    comm.transmit(helics::parent_route_id, data);
+    std::this_thread::sleep_for(250ms);
+    if (counter2 != 1) {
+        std::this_thread::sleep_for(500ms);
+    }
+    ASSERT_EQ(counter2, 1);
+    EXPECT_EQ(act2.lock()->payload, payload);
+    EXPECT_FALSE(checkActionFlag(*act2.lock(), compressed_payload_flag));
+
+    comm2.addRoute(helics::route_id(3), comm3.getAddress());
+    comm2.addRoute(helics::route_id(4), comm.getAddress());
+    comm2.transmit(helics::route_id(3), data);
+    comm2.transmit(helics::route_id(4), data);
+
+    std::this_thread::sleep_for(250ms);
+    if (counter != 1 || counter3 != 1) {
+        std::this_thread::sleep_for(500ms);
+    }
+    ASSERT_EQ(counter, 1);
+    EXPECT_EQ(act.lock()->payload, payload);
+    ASSERT_EQ(counter3, 1);
+    EXPECT_EQ(act3.lock()->payload, payload);
+
+    auto stats = loadJsonStr(comm.getCompressionStatistics());
+    EXPECT_TRUE(stats["enabled"].asBool());
+    EXPECT_EQ(stats["compressed_messages"].asInt(), 1);
+    EXPECT_EQ(stats["decompressed_messages"].asInt(), 1);
+    EXPECT_LT(stats["compressed_bytes"].asInt(), stats["original_bytes"].asInt());
+
+    stats = loadJsonStr(comm2.getCompressionStatistics());
+    EXPECT_EQ(stats["compressed_routes"].asInt(), 1);
+    EXPECT_EQ(stats["compressed_messages"].asInt(), 1);
+    EXPECT_EQ(stats["decompressed_messages"].asInt(), 1);
+
+    stats = loadJsonStr(comm3.getCompressionStatistics());
+    EXPECT_FALSE(stats["enabled"].asBool());
+    EXPECT_EQ(stats["decompressed_messages"].asInt(), 0);
+
+    // a peer on another interface with the same port number never asked for compression
+    comm2.addRoute(helics::route_id(5), "127.0.0.2:" + std::to_string(comm.getPort()));
+    stats = loadJsonStr(comm2.getCompressionStatistics());
+    EXPECT_EQ(stats["compressed_routes"].asInt(), 1);
+
+    comm.disconnect();
+    comm3.disconnect();
+    comm2.disconnect();
+
+    std::this_thread::sleep_for(100ms);
+}
+
 TEST(TcpCore, tcpCore_initialization)
 {
     std::this_thread::sleep_for(300ms);
@@ -195,6 +195,65 @@ TEST(UdpCore, udpComm_transmit_through)
     std::this_thread::sleep_for(100ms);
 }
 
+TEST(UdpCore, udpComm_transmit_large)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    std::atomic<int> counter2{0};
+    guarded<helics::ActionMessage> act2;
+
+    std::string host = "localhost";
+    helics::udp::UdpComms comm;
+    comm.loadTargetInfo(host, host);
+    helics::udp::UdpComms comm2;
+    comm2.loadTargetInfo(host, "");
+
+    comm.setBrokerPort(UDP_BROKER_PORT);
+    comm.setName("tests");
+    comm2.setName("test2");
+    comm2.setPortNumber(UDP_BROKER_PORT);
+    comm.setPortNumber(UDP_SECONDARY_PORT);
+
+    comm.setCallback([](const helics::ActionMessage& /*m*/) {});
+    comm2.setCallback([&counter2, &act2](const helics::ActionMessage& m) {
+        if (m.action() == helics::CMD_SEND_MESSAGE) {
+            act2 = m;
+        }
+        ++counter2;
+    });
+
+    auto connected_fut = std::async(std::launch::async, [&comm] { return comm.connect(); });
+
+    bool connected = comm2.connect();
+    ASSERT_TRUE(connected);
+    connected = connected_fut.get();
+    ASSERT_TRUE(connected);
+
+    // larger than a single datagram so it must be fragmented and reassembled
+    helics::ActionMessage large(helics::CMD_SEND_MESSAGE);
+    large.payload.resize(100000);
+    for (std::size_t ii = 0; ii < large.payload.size(); ++ii) {
+        large.payload[ii] = static_cast<char>(ii % 251);
+    }
+    comm.transmit(helics::parent_route_id, large);
+    for (int ii = 0; ii < 50; ++ii) {
+        comm.transmit(helics::parent_route_id, helics::CMD_ACK);
+    }
+
+    int cnt = 0;
+    while (counter2 < 51) {
+        std::this_thread::sleep_for(100ms);
+        if (cnt++ > 20) {
+            break;
+        }
+    }
+    ASSERT_EQ(counter2, 51);
+    EXPECT_EQ(act2.lock()->payload, large.payload);
+
+    comm.disconnect();
+    comm2.disconnect();
+    std::this_thread::sleep_for(100ms);
+}
+
 TEST(UdpCore, udpComm_transmit_add_route)
 {
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -399,6 +399,67 @@ TEST(ZMQCore, zmqComm_transmit_through)
     std::this_thread::sleep_for(200ms);
 }
 
+TEST(ZMQCore, zmqComm_transmit_large)
+{
+    // sleep to clear any residual from the previous test
+    std::this_thread::sleep_for(300ms);
+    std::atomic<int> counter2{0};
+    guarded<helics::ActionMessage> act2;
+
+    helics::zeromq::ZmqComms comm;
+    helics::zeromq::ZmqComms comm2;
+
+    comm.loadTargetInfo(host, host);
+    comm2.loadTargetInfo(host, "");
+
+    comm.setBrokerPort(23405);
+    comm.setName("tests");
+    comm2.setName("test2");
+    comm2.setPortNumber(23405);
+    comm.setPortNumber(23407);
+
+    comm.setCallback([](const helics::ActionMessage& /*m*/) {});
+    comm2.setCallback([&counter2, &act2](const helics::ActionMessage& m) {
+        if (m.action() == helics::CMD_SEND_MESSAGE) {
+            act2 = m;
+        }
+        ++counter2;
+    });
+
+    bool connected = comm2.connect();
+    ASSERT_TRUE(connected);
+    connected = comm.connect();
+    ASSERT_TRUE(connected);
+
+    // the payload is sent in a separate frame and the small messages are batched
+    helics::ActionMessage large(helics::CMD_SEND_MESSAGE);
+    large.payload.resize(100000);
+    for (std::size_t ii = 0; ii < large.payload.size(); ++ii) {
+        large.payload[ii] = static_cast<char>(ii % 251);
+    }
+    for (int ii = 0; ii < 20; ++ii) {
+        comm.transmit(helics::parent_route_id, helics::CMD_ACK);
+    }
+    comm.transmit(helics::parent_route_id, large);
+    for (int ii = 0; ii < 30; ++ii) {
+        comm.transmit(helics::parent_route_id, helics::CMD_ACK);
+    }
+
+    int cnt = 0;
+    while (counter2 < 51) {
+        std::this_thread::sleep_for(100ms);
+        if (cnt++ > 20) {
+            break;
+        }
+    }
+    ASSERT_EQ(counter2, 51);
+    EXPECT_EQ(act2.lock()->payload, large.payload);
+
+    comm.disconnect();
+    comm2.disconnect();
+    std::this_thread::sleep_for(200ms);
+}
+
 TEST(ZMQCore, zmqComm_transmit_add_route)
 {
     // sleep to clear any residual from the previous test
@@ -84,6 +84,67 @@ TEST(ZMQSSCore, transmit)
     std::this_thread::sleep_for(100ms);
 }
 
+TEST(ZMQSSCore, transmit_large)
+{
+    std::this_thread::sleep_for(400ms);
+    std::atomic<int> counter2{0};
+    guarded<helics::ActionMessage> act2;
+
+    helics::zeromq::ZmqCommsSS comm;
+    helics::zeromq::ZmqCommsSS comm2;
+    comm.loadTargetInfo(host, host);
+    // comm2 is the broker
+    comm2.loadTargetInfo(host, std::string{});
+
+    comm.setBrokerPort(DEFAULT_ZMQSS_BROKER_PORT_NUMBER);
+    comm.setName("test_comms");
+    comm.setServerMode(false);
+    comm2.setName("test_broker");
+    comm2.setPortNumber(DEFAULT_ZMQSS_BROKER_PORT_NUMBER);
+    comm2.setServerMode(true);
+
+    comm.setCallback([](const helics::ActionMessage& /*m*/) {});
+    comm2.setCallback([&counter2, &act2](const helics::ActionMessage& m) {
+        if (m.action() == helics::CMD_SEND_MESSAGE) {
+            act2 = m;
+        }
+        ++counter2;
+    });
+    auto connected_fut = std::async(std::launch::async, [&comm] { return comm.connect(); });
+    bool connected2 = comm2.connect();
+    ASSERT_TRUE(connected2);
+    bool connected1 = connected_fut.get();
+    if (!connected1) {  // lets just try again if it is not connected
+        connected1 = comm.connect();
+    }
+    ASSERT_TRUE(connected1);
+
+    // the payload is sent in a separate frame and the small messages are batched
+    helics::ActionMessage large(helics::CMD_SEND_MESSAGE);
+    large.payload.resize(100000);
+    for (std::size_t ii = 0; ii < large.payload.size(); ++ii) {
+        large.payload[ii] = static_cast<char>(ii % 251);
+    }
+    comm.transmit(helics::parent_route_id, large);
+    for (int ii = 0; ii < 30; ++ii) {
+        comm.transmit(helics::parent_route_id, helics::CMD_ACK);
+    }
+
+    int cnt = 0;
+    while (counter2 < 31) {
+        std::this_thread::sleep_for(100ms);
+        if (cnt++ > 20) {
+            break;
+        }
+    }
+    ASSERT_EQ(counter2, 31);
+    EXPECT_EQ(act2.lock()->payload, large.payload);
+
+    comm2.disconnect();
+    comm.disconnect();
+    std::this_thread::sleep_for(100ms);
+}
+
 TEST(ZMQSSCore, addroute)
 {
     std::this_thread::sleep_for(400ms);
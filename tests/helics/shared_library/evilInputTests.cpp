@@ -2160,6 +2160,26 @@ TEST(evil_value_federate_test, helicsFederateClearUpdates)
     EXPECT_NO_THROW(helicsFederateClearUpdates(evil_federate));
 }
 
+TEST(evil_value_federate_test, helicsFederateGetUpdatedInput)
+{
+    // int helicsFederateGetUpdatedInputCount(helics_federate fed);
+    // helics_input helicsFederateGetUpdatedInput(helics_federate fed, int index, helics_error*
+    // err);
+    char rdata[256];
+    auto evil_federate = reinterpret_cast<helics_federate>(rdata);
+    EXPECT_EQ(helicsFederateGetUpdatedInputCount(nullptr), 0);
+    EXPECT_EQ(helicsFederateGetUpdatedInputCount(evil_federate), 0);
+    auto err = helicsErrorInitialize();
+    err.error_code = 45;
+    auto res1 = helicsFederateGetUpdatedInput(nullptr, 0, &err);
+    EXPECT_EQ(res1, nullptr);
+    EXPECT_EQ(err.error_code, 45);
+    helicsErrorClear(&err);
+    auto res2 = helicsFederateGetUpdatedInput(evil_federate, 0, &err);
+    EXPECT_EQ(res2, nullptr);
+    EXPECT_NE(err.error_code, 0);
+}
+
 TEST(evil_value_federate_test, helicsFederateRegisterFromPublicationJSON)
 {
     // void helicsFederateRegisterFromPublicationJSON(helics_federate fed, const char* json,
@@ -248,6 +248,50 @@ TEST_F(vfed2_tests, json_register_publish)
     CE(helicsFederateFinalize(vFed1, &err));
 }
 
+TEST_F(vfed2_tests, updated_input_iteration)
+{
+    SetupTest(helicsCreateValueFederate, "test", 1, 1.0);
+    auto vFed1 = GetFederateAt(0);
+    auto pub1 = helicsFederateRegisterGlobalTypePublication(vFed1, "pub1", "double", "", &err);
+    auto pub2 = helicsFederateRegisterGlobalTypePublication(vFed1, "pub2", "double", "", &err);
+    auto pub3 = helicsFederateRegisterGlobalTypePublication(vFed1, "pub3", "double", "", &err);
+    auto sub1 = helicsFederateRegisterSubscription(vFed1, "pub1", "", &err);
+    helicsFederateRegisterSubscription(vFed1, "pub2", "", &err);
+    auto sub3 = helicsFederateRegisterSubscription(vFed1, "pub3", "", &err);
+    CE(helicsFederateEnterExecutingMode(vFed1, &err));
+    EXPECT_EQ(helicsFederateGetUpdatedInputCount(vFed1), 0);
+
+    CE(helicsPublicationPublishDouble(pub1, 2.5, &err));
+    CE(helicsPublicationPublishDouble(pub3, 4.5, &err));
+    CE(helicsFederateRequestTime(vFed1, 1.0, &err));
+    ASSERT_EQ(helicsFederateGetUpdatedInputCount(vFed1), 2);
+    double sum{0.0};
+    for (int ii = 0; ii < helicsFederateGetUpdatedInputCount(vFed1); ++ii) {
+        auto inp = helicsFederateGetUpdatedInput(vFed1, ii, &err);
+        ASSERT_TRUE(inp != nullptr);
+        EXPECT_TRUE(helicsInputIsUpdated(inp) == helics_true);
+        sum += helicsInputGetDouble(inp, &err);
+    }
+    EXPECT_DOUBLE_EQ(sum, 7.0);
+    EXPECT_EQ(helicsFederateGetUpdatedInput(vFed1, 2, &err), nullptr);
+    EXPECT_NE(err.error_code, 0);
+    helicsErrorClear(&err);
+
+    // the same inputs are returned on every time step
+    auto first = helicsFederateGetUpdatedInput(vFed1, 0, &err);
+    CE(helicsPublicationPublishDouble(pub1, 3.5, &err));
+    CE(helicsPublicationPublishDouble(pub2, 1.5, &err));
+    CE(helicsFederateRequestTime(vFed1, 2.0, &err));
+    ASSERT_EQ(helicsFederateGetUpdatedInputCount(vFed1), 2);
+    EXPECT_EQ(helicsFederateGetUpdatedInput(vFed1, 0, &err), first);
+    EXPECT_DOUBLE_EQ(helicsInputGetDouble(sub1, &err), 3.5);
+    EXPECT_TRUE(helicsInputIsUpdated(sub3) == helics_false);
+
+    CE(helicsFederateRequestTime(vFed1, 3.0, &err));
+    EXPECT_EQ(helicsFederateGetUpdatedInputCount(vFed1), 0);
+    CE(helicsFederateFinalize(vFed1, &err));
+}
+
 INSTANTIATE_TEST_SUITE_P(vfed_tests,
                          vfed2_simple_type_tests,
                          ::testing::ValuesIn(core_types_simple));
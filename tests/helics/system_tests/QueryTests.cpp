@@ -266,6 +266,43 @@ TEST_F(query, global_time)
     helics::cleanupHelicsLibrary();
 }
 
+TEST_F(query, critical_path)
+{
+    SetupTest<helics::ValueFederate>("test_3", 2);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+
+    vFed1->enterExecutingModeAsync();
+    vFed2->enterExecutingMode();
+    vFed1->enterExecutingModeComplete();
+
+    // vFed2 has to wait on vFed1 which is busy
+    vFed2->requestTimeAsync(1.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    vFed1->requestTime(1.0);
+    vFed2->requestTimeComplete();
+
+    auto res = vFed2->query("time_blockers");
+    auto val = loadJsonStr(res);
+    EXPECT_EQ(val["grants"].asInt(), 1);
+    ASSERT_EQ(val["blockers"].size(), 1U);
+    EXPECT_EQ(val["blockers"][0]["grants"].asInt(), 1);
+    EXPECT_GT(val["blockers"][0]["wait_time"].asDouble(), 0.1);
+
+    res = vFed1->query("root", "critical_path");
+    val = loadJsonStr(res);
+    ASSERT_GE(val["critical_path"].size(), 2U);
+    EXPECT_EQ(val["critical_path"][0]["name"].asString(), vFed1->getName());
+    EXPECT_GT(val["critical_path"][0]["blocking_time"].asDouble(), 0.1);
+    EXPECT_EQ(val["critical_path"][0]["blocked_grants"].asInt(), 1);
+    // the summary is only generated at the top level
+    EXPECT_FALSE(val["brokers"][0].isMember("critical_path"));
+
+    vFed1->finalize();
+    vFed2->finalize();
+    helics::cleanupHelicsLibrary();
+}
+
 TEST_F(query, current_time)
 {
     SetupTest<helics::MessageFederate>("test_3", 2);
@@ -7,6 +7,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 
 #include "../application_api/testFixtures.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/application_api/Publications.hpp"
 #include "helics/application_api/Subscriptions.hpp"
 #include "helics/application_api/ValueFederate.hpp"
@@ -173,3 +174,36 @@ TEST_F(federate_realtime_tests, federate_trigger_tests_ci_skip)
     fed->finalize();
     broker->disconnect();
 }
+
+TEST_F(federate_realtime_tests, high_precision_ci_skip)
+{
+    auto broker = AddBroker("test", 1);
+    helics::FederateInfo fi(CORE_TYPE_TO_TEST);
+    fi.coreName = "cprecise";
+    fi.coreInitString = std::string("-f 1 --broker=") + broker->getIdentifier();
+    fi.setFlagOption(helics::defs::flags::realtime_high_precision);
+    fi.setProperty(helics::defs::properties::period, 0.001);
+    auto fed = std::make_shared<helics::ValueFederate>("test1", fi);
+    EXPECT_TRUE(fed->getFlagOption(helics::defs::flags::realtime));
+
+    fed->enterExecutingMode();
+    auto now = std::chrono::steady_clock::now();
+    helics::Time reqTime = 0.001;
+    int early = 0;
+    for (int ii = 0; ii < 200; ++ii) {
+        auto gtime = fed->requestTime(reqTime);
+        EXPECT_EQ(gtime, reqTime);
+        if (helics::Time(std::chrono::steady_clock::now() - now) < reqTime - 0.0005) {
+            ++early;
+        }
+        reqTime += 0.001;
+    }
+    EXPECT_EQ(early, 0);
+    auto res = loadJsonStr(fed->query("realtime"));
+    EXPECT_TRUE(res["high_precision"].asBool());
+    EXPECT_EQ(res["steps"].asInt(), 200);
+    EXPECT_LT(res["mean_lateness"].asDouble(), 0.005);
+    EXPECT_GE(res["min_lateness"].asDouble(), 0.0);
+    fed->finalize();
+    broker->disconnect();
+}
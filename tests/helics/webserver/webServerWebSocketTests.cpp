@@ -53,6 +53,7 @@ class webTest: public ::testing::Test {
         webs->enableWebSocketServer(true);
         config["websocket"] = Json::objectValue;
         config["websocket"]["port"] = 26247;
+        config["websocket"]["push_period"] = 0.1;
         webs->startServer(&config);
 
         // These objects perform our I/O
@@ -422,3 +423,88 @@ TEST_F(webTest, timeBlock)
     v1["broker"] = "brk_timerws";
     sendText(generateJsonString(v1));
 }
+
+TEST_F(webTest, subscription)
+{
+    auto brk = addBroker(helics::core_type::TEST, "--name=brk_sub -f1");
+    auto cr = addCore(helics::core_type::TEST, "--name=c_sub -f1 --broker=brk_sub");
+    EXPECT_TRUE(cr->connect());
+
+    // use a separate connection so the pushed updates don't interfere with the other tests
+    net::io_context subioc;
+    tcp::resolver resolver(subioc);
+    websocket::stream<tcp::socket> substream(subioc);
+    auto const results = resolver.resolve(localhost, "26247");
+    net::connect(substream.next_layer(), results.begin(), results.end());
+    substream.handshake(localhost, "/");
+    beast::flat_buffer subbuffer;
+    auto readJson = [&]() {
+        subbuffer.consume(subbuffer.size());
+        substream.read(subbuffer);
+        return loadJson(std::string{boost::asio::buffer_cast<const char*>(subbuffer.data()),
+                                    subbuffer.size()});
+    };
+
+    Json::Value sub;
+    sub["command"] = "subscribe";
+    sub["broker"] = "brk_sub";
+    sub["topics"] = "state,counters";
+    substream.write(net::buffer(generateJsonString(sub)));
+    auto val = readJson();
+    EXPECT_EQ(val["status"].asInt(), 0);
+    EXPECT_STREQ(val["broker"].asCString(), "brk_sub");
+
+    val = readJson();
+    EXPECT_STREQ(val["type"].asCString(), "snapshot");
+    EXPECT_TRUE(val["values"]["status/connected"].asBool());
+    EXPECT_TRUE(val["values"].isMember("counters/federates"));
+    EXPECT_FALSE(val["values"].isMember("time/cores"));
+
+    helics::ValueFederate vFed("fed_sub", cr);
+    bool found{false};
+    for (int ii = 0; ii < 10 && !found; ++ii) {
+        val = readJson();
+        EXPECT_STREQ(val["type"].asCString(), "delta");
+        // deltas only contain the values that changed
+        EXPECT_FALSE(val["values"].isMember("status/connected"));
+        found = val["values"].isMember("state/federates/fed_sub/state");
+    }
+    EXPECT_TRUE(found);
+
+    sub["command"] = "unsubscribe";
+    substream.write(net::buffer(generateJsonString(sub)));
+    // an update may already be queued ahead of the response
+    do {
+        val = readJson();
+    } while (!val.isMember("status"));
+    EXPECT_EQ(val["status"].asInt(), 0);
+
+    sub["command"] = "subscribe";
+    sub["topics"] = "bad_topic";
+    substream.write(net::buffer(generateJsonString(sub)));
+    val = readJson();
+    EXPECT_NE(val["status"].asInt(), 0);
+
+    // malformed requests get an error response and leave the session usable
+    sub["topics"] = "[\"state\"";
+    substream.write(net::buffer(generateJsonString(sub)));
+    val = readJson();
+    EXPECT_EQ(val["status"].asInt(), static_cast<int>(http::status::bad_request));
+    EXPECT_TRUE(val.isMember("error"));
+
+    sub["topics"] = "[{\"state\":1}]";
+    substream.write(net::buffer(generateJsonString(sub)));
+    val = readJson();
+    EXPECT_EQ(val["status"].asInt(), static_cast<int>(http::status::bad_request));
+
+    sub["topics"] = "state";
+    sub["period"] = "not_a_time";
+    substream.write(net::buffer(generateJsonString(sub)));
+    val = readJson();
+    EXPECT_EQ(val["status"].asInt(), static_cast<int>(http::status::bad_request));
+    EXPECT_TRUE(val.isMember("error"));
+
+    substream.close(websocket::close_code::normal);
+    vFed.finalize();
+    brk->disconnect();
+}
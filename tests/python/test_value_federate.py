@@ -1,5 +1,7 @@
+import array
 import os
 import time
+
 import pytest as pt
 import helics as h
 
@@ -389,6 +391,65 @@ def test_value_federate_runFederateTestVectorD(vFed):
     assert value == [3, 4, 5]
 
 
+def test_value_federate_runFederateTestVectorBuffer(vFed):
+    defaultValue = array.array("d", [0.0, 1.0, 2.0])
+    testValue = array.array("d", [3.0, 4.0, 5.0, 6.0])
+    pubid = h.helicsFederateRegisterGlobalPublication(vFed, "pub1", h.helics_data_type_vector, "")
+    subid = h.helicsFederateRegisterSubscription(vFed, "pub1", "")
+    h.helicsInputSetDefaultVector(subid, defaultValue)
+
+    h.helicsFederateEnterExecutingMode(vFed)
+
+    h.helicsPublicationPublishVector(pubid, memoryview(testValue))
+
+    value = h.helicsInputGetVectorView(subid)
+    assert value.tolist() == [0.0, 1.0, 2.0]
+
+    grantedtime = h.helicsFederateRequestTime(vFed, 1.0)
+    assert grantedtime == 0.01
+
+    buffer = array.array("d", [0.0, 0.0])
+    count = h.helicsInputGetVectorBuffer(subid, buffer)
+    assert count == 4
+    assert buffer.tolist() == [3.0, 4.0]
+
+    value = h.helicsInputGetVectorView(subid)
+    assert value.tolist() == [3.0, 4.0, 5.0, 6.0]
+
+    with pt.raises(ValueError):
+        h.helicsInputGetVectorBuffer(subid, array.array("i", [0, 0]))
+
+
+def test_value_federate_runFederateTestVectorNumpy(vFed):
+    np = pt.importorskip("numpy")
+    defaultValue = np.array([0.0, 1.0, 2.0])
+    testValue = np.array([3.0, 4.0, 5.0, 6.0])
+    pubid = h.helicsFederateRegisterGlobalPublication(vFed, "pub1", h.helics_data_type_vector, "")
+    subid = h.helicsFederateRegisterSubscription(vFed, "pub1", "")
+    h.helicsInputSetDefaultVector(subid, defaultValue)
+
+    h.helicsFederateEnterExecutingMode(vFed)
+
+    h.helicsPublicationPublishVector(pubid, testValue)
+
+    value = h.helicsInputGetVectorArray(subid)
+    assert isinstance(value, np.ndarray)
+    assert value.dtype == np.float64
+    assert np.array_equal(value, defaultValue)
+
+    grantedtime = h.helicsFederateRequestTime(vFed, 1.0)
+    assert grantedtime == 0.01
+
+    value = h.helicsInputGetVectorArray(subid)
+    assert isinstance(value, np.ndarray)
+    assert np.array_equal(value, testValue)
+
+    buffer = np.zeros(4)
+    count = h.helicsInputGetVectorBuffer(subid, buffer)
+    assert count == 4
+    assert np.array_equal(buffer, testValue)
+
+
 @pt.fixture
 def helicsBroker():
     initstring = "-f 1 --name=mainbroker"